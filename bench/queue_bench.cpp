@@ -0,0 +1,82 @@
+// std::priority_queue 与不同分叉数的 easystl::priority_queue 的对比
+//
+// 队列中保持 n 个元素，每次操作先 pop 再 push 一个更大的随机优先级，
+// 模拟定时器与事件队列的用法。
+//
+// 用法：queue_bench [元素个数]
+
+#include "queue.h"
+#include "vector.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+
+const std::size_t kOps = std::size_t(1) << 22;
+
+template <class Queue>
+double measure(Queue &q, const std::vector<std::uint64_t> &delta,
+               std::uint64_t &sink) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kOps; ++i) {
+        const std::uint64_t now = q.top();
+        q.pop();
+        q.push(now + delta[i]);
+    }
+    sink += q.top();
+    return std::chrono::duration<double, std::nano>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           static_cast<double>(kOps);
+}
+
+template <class Queue>
+double measure_fill(std::size_t n, const std::vector<std::uint64_t> &delta,
+                    std::uint64_t &sink) {
+    Queue q;
+    for (std::size_t i = 0; i < n; ++i) {
+        q.push(delta[i % delta.size()]);
+    }
+    return measure(q, delta, sink);
+}
+
+template <std::size_t Arity>
+using easy_queue =
+    easystl::priority_queue<std::uint64_t, easystl::vector<std::uint64_t>,
+                            easystl::greater<std::uint64_t>, Arity>;
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::size_t n = std::size_t(1) << 20;
+    if (argc > 1) {
+        n = static_cast<std::size_t>(std::atoll(argv[1]));
+    }
+    std::mt19937_64 gen(1);
+    std::vector<std::uint64_t> delta(kOps);
+    for (auto &d : delta) {
+        d = gen() % (std::uint64_t(1) << 32);
+    }
+
+    std::uint64_t sink = 0;
+    typedef std::priority_queue<std::uint64_t, std::vector<std::uint64_t>,
+                                std::greater<std::uint64_t>>
+        std_queue;
+    const double s = measure_fill<std_queue>(n, delta, sink);
+    const double d2 = measure_fill<easy_queue<2>>(n, delta, sink);
+    const double d4 = measure_fill<easy_queue<4>>(n, delta, sink);
+    const double d8 = measure_fill<easy_queue<8>>(n, delta, sink);
+    std::printf("n = %zu (sink %llu)\n", n,
+                static_cast<unsigned long long>(sink));
+    std::printf("std::priority_queue        %6.1f ns/op\n", s);
+    std::printf("easystl::priority_queue<2> %6.1f ns/op\n", d2);
+    std::printf("easystl::priority_queue<4> %6.1f ns/op\n", d4);
+    std::printf("easystl::priority_queue<8> %6.1f ns/op\n", d8);
+    return 0;
+}
@@ -0,0 +1,156 @@
+// easystl::scheduler 与单个加锁队列的简单线程池的对比
+//
+// flat：由主线程提交大量很小的任务
+// tree：任务递归地产生子任务，形成一棵完全二叉树，只有叶子做计算
+//
+// 用法：scheduler_bench [线程数]
+
+#include "scheduler.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 所有线程共享一个 std::deque，由一把锁保护
+class mutex_queue_pool {
+    std::mutex M_mutex;
+    std::condition_variable M_wake;
+    std::deque<std::function<void()>> M_tasks;
+    std::vector<std::thread> M_threads;
+    bool M_stop;
+
+  public:
+    explicit mutex_queue_pool(std::size_t threads) : M_stop(false) {
+        for (std::size_t i = 0; i < threads; ++i) {
+            M_threads.emplace_back([this] { M_loop(); });
+        }
+    }
+
+    ~mutex_queue_pool() {
+        {
+            std::lock_guard<std::mutex> lock(M_mutex);
+            M_stop = true;
+        }
+        M_wake.notify_all();
+        for (std::thread &t : M_threads) {
+            t.join();
+        }
+    }
+
+    template <class Fn> void submit(Fn &&fn) {
+        {
+            std::lock_guard<std::mutex> lock(M_mutex);
+            M_tasks.emplace_back(std::forward<Fn>(fn));
+        }
+        M_wake.notify_one();
+    }
+
+  private:
+    void M_loop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(M_mutex);
+                M_wake.wait(lock,
+                            [this] { return M_stop || !M_tasks.empty(); });
+                if (M_tasks.empty()) {
+                    return;
+                }
+                task = std::move(M_tasks.front());
+                M_tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+std::atomic<std::uint64_t> g_sink(0);
+std::atomic<std::size_t> g_done(0);
+
+// 每个任务的计算量
+void work(std::uint64_t seed) {
+    std::uint64_t x = seed | 1;
+    for (int i = 0; i < 64; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    g_sink.fetch_add(x & 1, std::memory_order_relaxed);
+    g_done.fetch_add(1, std::memory_order_relaxed);
+}
+
+void wait_done(std::size_t n) {
+    while (g_done.load(std::memory_order_acquire) != n) {
+        std::this_thread::yield();
+    }
+    g_done.store(0, std::memory_order_relaxed);
+}
+
+template <class Pool>
+void tree(Pool &pool, unsigned depth, std::uint64_t id) {
+    if (depth == 0) {
+        work(id);
+        return;
+    }
+    pool.submit([&pool, depth, id] { tree(pool, depth - 1, id * 2); });
+    pool.submit([&pool, depth, id] { tree(pool, depth - 1, id * 2 + 1); });
+}
+
+template <class Pool>
+double run_flat(Pool &pool, std::size_t n) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        pool.submit([i] { work(i); });
+    }
+    wait_done(n);
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+template <class Pool>
+double run_tree(Pool &pool, unsigned depth) {
+    const auto start = std::chrono::steady_clock::now();
+    pool.submit([&pool, depth] { tree(pool, depth, 1); });
+    wait_done(std::size_t(1) << depth);
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::size_t threads = easystl::scheduler::default_size();
+    if (argc > 1) {
+        threads = static_cast<std::size_t>(std::atoi(argv[1]));
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    const std::size_t flat_tasks = 1 << 20;
+    const unsigned tree_depth = 20;
+
+    std::printf("threads: %zu\n", threads);
+    {
+        mutex_queue_pool pool(threads);
+        const double flat = run_flat(pool, flat_tasks);
+        const double deep = run_tree(pool, tree_depth);
+        std::printf("mutex queue  flat %8.1f ms  tree %8.1f ms\n", flat, deep);
+    }
+    {
+        easystl::scheduler pool(threads);
+        const double flat = run_flat(pool, flat_tasks);
+        const double deep = run_tree(pool, tree_depth);
+        std::printf("scheduler    flat %8.1f ms  tree %8.1f ms\n", flat, deep);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// 有序数组上的 std::lower_bound、easystl::lower_bound 与 eytzinger_index 的对比
+//
+// 用法：search_bench [元素个数]
+
+#include "algo.h"
+#include "eytzinger_index.h"
+#include "vector.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <class Fn>
+double measure(const std::vector<std::uint32_t> &queries, Fn fn,
+               std::size_t &sink) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint32_t q : queries) {
+        sink += fn(q);
+    }
+    return std::chrono::duration<double, std::nano>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           static_cast<double>(queries.size());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::size_t n = std::size_t(1) << 24;
+    if (argc > 1) {
+        n = static_cast<std::size_t>(std::atoll(argv[1]));
+    }
+    std::mt19937 gen(1);
+    easystl::vector<std::uint32_t> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back(static_cast<std::uint32_t>(gen()));
+    }
+    easystl::sort(keys.begin(), keys.end());
+    std::vector<std::uint32_t> queries(1 << 22);
+    for (auto &q : queries) {
+        q = static_cast<std::uint32_t>(gen());
+    }
+    easystl::eytzinger_index<std::uint32_t> index(keys);
+
+    const std::uint32_t *first = keys.data();
+    const std::uint32_t *last = keys.data() + keys.size();
+    std::size_t sink = 0;
+    const double s = measure(
+        queries,
+        [=](std::uint32_t q) {
+            return static_cast<std::size_t>(std::lower_bound(first, last, q) -
+                                            first);
+        },
+        sink);
+    const double e = measure(
+        queries,
+        [=](std::uint32_t q) {
+            return static_cast<std::size_t>(
+                easystl::lower_bound(first, last, q) - first);
+        },
+        sink);
+    const double z = measure(
+        queries, [&index](std::uint32_t q) { return index.lower_bound(q); },
+        sink);
+    std::printf("n = %zu (sink %zu)\n", n, sink);
+    std::printf("std::lower_bound      %6.1f ns/query\n", s);
+    std::printf("easystl::lower_bound  %6.1f ns/query\n", e);
+    std::printf("eytzinger_index       %6.1f ns/query\n", z);
+    return 0;
+}
@@ -2,14 +2,412 @@
 #define EASYSTL_ALGO_H
 
 #include "algobase.h"
+#include "allocator.h"
+#include "construct.h"
+#include "functional.h"
+#include "heap_algo.h"
 #include "iterator.h"
+#include "simd.h"
+#include "utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define EASYSTL_ALGO_SSE2 1
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define EASYSTL_ALGO_SSSE3 1
+#endif
 
 namespace easystl {
 
+// 查找与最值算法的默认比较：直接使用 operator<，不把两边转换成同一类型
+struct search_less {
+    template <class T, class U>
+    bool operator()(const T &lhs, const U &rhs) const {
+        return lhs < rhs;
+    }
+};
+
+// unique 的默认相等判断：直接使用 operator==
+struct unique_equal {
+    template <class T, class U>
+    bool operator()(const T &lhs, const U &rhs) const {
+        return lhs == rhs;
+    }
+};
+
+/*
+ * find
+ * 在 [first, last) 区间内查找等于 value 的元素，返回指向它的迭代器
+ * 连续存储的算术类型、value 与元素类型相同时交给 simd::find
+ * */
+template <class InputIter, class T>
+InputIter find_dispatch(InputIter first, InputIter last, const T &value) {
+    while (first != last && !(*first == value)) {
+        ++first;
+    }
+    return first;
+}
+
+template <class Tp, class Up>
+typename std::enable_if<
+    simd::is_vectorizable<Tp>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+    Tp *>::type
+find_dispatch(Tp *first, Tp *last, const Up &value) {
+    return const_cast<Tp *>(simd::find<Up>(first, last, value));
+}
+
+template <class InputIter, class T>
+InputIter find(InputIter first, InputIter last, const T &value) {
+    return easystl::niter_wrap(first,
+                               find_dispatch(easystl::niter_base(first),
+                                             easystl::niter_base(last), value));
+}
+
+/*
+ * find_if
+ * 在 [first, last) 区间内查找第一个令一元操作 pred 为 true 的元素
+ * */
+template <class InputIter, class UnaryPredicate>
+InputIter find_if(InputIter first, InputIter last, UnaryPredicate pred) {
+    while (first != last && !pred(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+/*
+ * count
+ * 对 [first, last) 区间内的元素与给定值进行比较，返回相等的元素个数
+ * 连续存储的算术类型、value 与元素类型相同时交给 simd::count
+ * */
+template <class InputIter, class T>
+typename iterator_traits<InputIter>::difference_type
+count_dispatch(InputIter first, InputIter last, const T &value) {
+    typename iterator_traits<InputIter>::difference_type n = 0;
+    for (; first != last; ++first) {
+        if (*first == value) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+template <class Tp, class Up>
+typename std::enable_if<
+    simd::is_vectorizable<Tp>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+    std::ptrdiff_t>::type
+count_dispatch(Tp *first, Tp *last, const Up &value) {
+    return static_cast<std::ptrdiff_t>(simd::count<Up>(first, last, value));
+}
+
+template <class InputIter, class T>
+typename iterator_traits<InputIter>::difference_type
+count(InputIter first, InputIter last, const T &value) {
+    return count_dispatch(easystl::niter_base(first),
+                          easystl::niter_base(last), value);
+}
+
+/*
+ * count_if
+ * 对 [first, last) 区间内的每个元素都进行一元 pred 操作，返回结果为 true 的个数
+ * */
+template <class InputIter, class UnaryPredicate>
+typename iterator_traits<InputIter>::difference_type
+count_if(InputIter first, InputIter last, UnaryPredicate pred) {
+    typename iterator_traits<InputIter>::difference_type n = 0;
+    for (; first != last; ++first) {
+        if (pred(*first)) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+/*
+ * min_element / max_element / minmax_element
+ * min_element 返回第一个最小的元素，max_element 返回第一个最大的元素，
+ * minmax_element 返回第一个最小与最后一个最大的元素。使用默认比较且为连续
+ * 存储的算术类型时，先用 simd::min_max 求出最值，再用 simd::find 找到位置；
+ * 浮点数中有 NaN 时退回逐个比较，结果与逐个比较相同
+ * */
+template <class ForwardIter, class Compared>
+ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp) {
+    if (first == last) {
+        return first;
+    }
+    ForwardIter result = first;
+    while (++first != last) {
+        if (comp(*first, *result)) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <class ForwardIter, class Compared>
+ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp) {
+    if (first == last) {
+        return first;
+    }
+    ForwardIter result = first;
+    while (++first != last) {
+        if (comp(*result, *first)) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <class ForwardIter, class Compared>
+pair<ForwardIter, ForwardIter>
+minmax_element(ForwardIter first, ForwardIter last, Compared comp) {
+    pair<ForwardIter, ForwardIter> result(first, first);
+    if (first == last) {
+        return result;
+    }
+    while (++first != last) {
+        if (comp(*first, *result.first)) {
+            result.first = first;
+        }
+        if (!comp(*first, *result.second)) {
+            result.second = first;
+        }
+    }
+    return result;
+}
+
+template <class ForwardIter>
+ForwardIter min_element_dispatch(ForwardIter first, ForwardIter last) {
+    return easystl::min_element(first, last, search_less());
+}
+
+template <class Tp>
+typename std::enable_if<simd::is_vectorizable<Tp>::value, Tp *>::type
+min_element_dispatch(Tp *first, Tp *last) {
+    typedef typename std::remove_const<Tp>::type T;
+    T mn, mx;
+    if (!simd::min_max<T>(first, last, mn, mx)) {
+        return easystl::min_element(first, last, search_less());
+    }
+    return const_cast<Tp *>(simd::find<T>(first, last, mn));
+}
+
+template <class ForwardIter>
+ForwardIter max_element_dispatch(ForwardIter first, ForwardIter last) {
+    return easystl::max_element(first, last, search_less());
+}
+
+template <class Tp>
+typename std::enable_if<simd::is_vectorizable<Tp>::value, Tp *>::type
+max_element_dispatch(Tp *first, Tp *last) {
+    typedef typename std::remove_const<Tp>::type T;
+    T mn, mx;
+    if (!simd::min_max<T>(first, last, mn, mx)) {
+        return easystl::max_element(first, last, search_less());
+    }
+    return const_cast<Tp *>(simd::find<T>(first, last, mx));
+}
+
+template <class ForwardIter>
+pair<ForwardIter, ForwardIter> minmax_element_dispatch(ForwardIter first,
+                                                       ForwardIter last) {
+    return easystl::minmax_element(first, last, search_less());
+}
+
+template <class Tp>
+typename std::enable_if<simd::is_vectorizable<Tp>::value,
+                        pair<Tp *, Tp *>>::type
+minmax_element_dispatch(Tp *first, Tp *last) {
+    typedef typename std::remove_const<Tp>::type T;
+    T mn, mx;
+    if (!simd::min_max<T>(first, last, mn, mx)) {
+        return easystl::minmax_element(first, last, search_less());
+    }
+    return pair<Tp *, Tp *>(
+        const_cast<Tp *>(simd::find<T>(first, last, mn)),
+        const_cast<Tp *>(simd::find_last<T>(first, last, mx)));
+}
+
+template <class ForwardIter>
+ForwardIter min_element(ForwardIter first, ForwardIter last) {
+    return easystl::niter_wrap(
+        first, min_element_dispatch(easystl::niter_base(first),
+                                    easystl::niter_base(last)));
+}
+
+template <class ForwardIter>
+ForwardIter max_element(ForwardIter first, ForwardIter last) {
+    return easystl::niter_wrap(
+        first, max_element_dispatch(easystl::niter_base(first),
+                                    easystl::niter_base(last)));
+}
+
+template <class ForwardIter>
+pair<ForwardIter, ForwardIter> minmax_element(ForwardIter first,
+                                              ForwardIter last) {
+    auto result = minmax_element_dispatch(easystl::niter_base(first),
+                                          easystl::niter_base(last));
+    return pair<ForwardIter, ForwardIter>(
+        easystl::niter_wrap(first, result.first),
+        easystl::niter_wrap(first, result.second));
+}
+
+/*
+ * transform
+ * 第一个版本以函数对象 unary_op 作用于 [first, last) 中的每个元素并将结果保存至
+ * result 中；第二个版本以函数对象 binary_op 作用于两个序列 [first1, last1)、
+ * [first2, last2) 的相同位置
+ * */
+template <class InputIter, class OutputIter, class UnaryOperation>
+OutputIter transform(InputIter first, InputIter last, OutputIter result,
+                     UnaryOperation unary_op) {
+    for (; first != last; ++first, ++result) {
+        *result = unary_op(*first);
+    }
+    return result;
+}
+
+template <class InputIter1, class InputIter2, class OutputIter,
+          class BinaryOperation>
+OutputIter transform(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                     OutputIter result, BinaryOperation binary_op) {
+    for (; first1 != last1; ++first1, ++first2, ++result) {
+        *result = binary_op(*first1, *first2);
+    }
+    return result;
+}
+
 /*
  * reverse
  * 将 [first, last) 区间内的元素反转
+ * 连续存储、大小为 1、2、4、8 字节的 trivially copyable 类型从两端各取一块，
+ * 块内用 SIMD 重排元素后交换位置：运行时检测到 AVX2 时每块 32 字节（vpshufb、
+ * vpermq，与 simd.h 相同的分派方式），否则每块 16 字节（编译时打开 SSSE3 时
+ * 1 字节元素使用 pshufb）
  * */
+#ifdef EASYSTL_ALGO_SSE2
+template <std::size_t Size> struct reverse_lanes;
+
+template <> struct reverse_lanes<8> {
+    static __m128i apply(__m128i v) noexcept {
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+#ifdef EASYSTL_SIMD_AVX2
+    EASYSTL_SIMD_AVX2_TARGET static __m256i apply(__m256i v) noexcept {
+        return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+#endif
+};
+
+template <> struct reverse_lanes<4> {
+    static __m128i apply(__m128i v) noexcept {
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+#ifdef EASYSTL_SIMD_AVX2
+    EASYSTL_SIMD_AVX2_TARGET static __m256i apply(__m256i v) noexcept {
+        return _mm256_permutevar8x32_epi32(
+            v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+#endif
+};
+
+template <> struct reverse_lanes<2> {
+    static __m128i apply(__m128i v) noexcept {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+#ifdef EASYSTL_SIMD_AVX2
+    EASYSTL_SIMD_AVX2_TARGET static __m256i apply(__m256i v) noexcept {
+        const __m256i mask = _mm256_setr_epi8(
+            14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1, 14, 15, 12,
+            13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+        return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask),
+                                        _MM_SHUFFLE(1, 0, 3, 2));
+    }
+#endif
+};
+
+template <> struct reverse_lanes<1> {
+    static __m128i apply(__m128i v) noexcept {
+#ifdef EASYSTL_ALGO_SSSE3
+        return _mm_shuffle_epi8(v, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                                 7, 6, 5, 4, 3, 2, 1, 0));
+#else
+        // 先反转 16 位的字，再交换每个字中的两个字节
+        v = reverse_lanes<2>::apply(v);
+        return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+    }
+#ifdef EASYSTL_SIMD_AVX2
+    EASYSTL_SIMD_AVX2_TARGET static __m256i apply(__m256i v) noexcept {
+        const __m256i mask = _mm256_setr_epi8(
+            15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13,
+            12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask),
+                                        _MM_SHUFFLE(1, 0, 3, 2));
+    }
+#endif
+};
+
+#ifdef EASYSTL_SIMD_AVX2
+// 从两端各交换 32 字节的块，直到剩余不足 64 字节
+template <std::size_t Size>
+EASYSTL_SIMD_AVX2_TARGET void
+reverse_bytes_avx2(unsigned char *&first, unsigned char *&last) noexcept {
+    for (; last - first >= 64; first += 32, last -= 32) {
+        const __m256i a =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        const __m256i b =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last - 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(first),
+                            reverse_lanes<Size>::apply(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(last - 32),
+                            reverse_lanes<Size>::apply(a));
+    }
+}
+#endif
+#endif // EASYSTL_ALGO_SSE2
+
+// 反转 [first, last) 中大小为 Size 字节的元素
+template <std::size_t Size>
+void unchecked_reverse_bytes(unsigned char *first,
+                             unsigned char *last) noexcept {
+#if defined(EASYSTL_ALGO_SSE2) && defined(EASYSTL_SIMD_AVX2)
+    if (last - first >= 64 && simd::has_avx2()) {
+        reverse_bytes_avx2<Size>(first, last);
+    }
+#endif
+#ifdef EASYSTL_ALGO_SSE2
+    for (; last - first >= 32; first += 16, last -= 16) {
+        const __m128i a =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        const __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(last - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(first),
+                         reverse_lanes<Size>::apply(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(last - 16),
+                         reverse_lanes<Size>::apply(a));
+    }
+#endif
+    unsigned char tmp[Size];
+    for (; last - first >= static_cast<std::ptrdiff_t>(2 * Size);
+         first += Size) {
+        last -= Size;
+        std::memcpy(tmp, first, Size);
+        std::memcpy(first, last, Size);
+        std::memcpy(last, tmp, Size);
+    }
+}
+
 template <class BidirectionalIter>
 void reverse_dispatch(BidirectionalIter first, BidirectionalIter last,
                       bidirectional_iterator_tag) {
@@ -17,7 +415,7 @@ void reverse_dispatch(BidirectionalIter first, BidirectionalIter last,
         if (first == last || first == --last) {
             return;
         }
-        iter_swap(first++, last);
+        easystl::iter_swap(first++, last);
     }
 }
 
@@ -25,12 +423,1212 @@ template <class RandomIter>
 void reverse_dispatch(RandomIter first, RandomIter last,
                       random_access_iterator_tag) {
     while (first < last) {
-        iter_swap(first++, --last);
+        easystl::iter_swap(first++, --last);
     }
 }
 
+template <class Tp>
+struct is_simd_reversible
+    : m_bool_constant<std::is_trivially_copyable<Tp>::value &&
+                      (sizeof(Tp) == 1 || sizeof(Tp) == 2 ||
+                       sizeof(Tp) == 4 || sizeof(Tp) == 8)> {};
+
+template <class Tp>
+typename std::enable_if<is_simd_reversible<Tp>::value>::type
+reverse_dispatch(Tp *first, Tp *last, random_access_iterator_tag) {
+    unchecked_reverse_bytes<sizeof(Tp)>(
+        reinterpret_cast<unsigned char *>(first),
+        reinterpret_cast<unsigned char *>(last));
+}
+
 template <class Iter> void reverse(Iter first, Iter last) {
-    reverse_dispatch(first, last, iterator_category(first));
+    reverse_dispatch(easystl::niter_base(first), easystl::niter_base(last),
+                     iterator_category(first));
+}
+
+/*
+ * rotate
+ * 将 [first, middle) 内的元素和 [middle, last) 内的元素互换，返回原来 first
+ * 所指元素的新位置：
+ * (1)前向与双向迭代器逐个交换，每个元素至多交换两次
+ * (2)随机访问迭代器使用 Gries-Mills 块交换：每次把较短的一段与另一段相邻的
+ *    等长部分整块交换，较短的一段即到达最终位置
+ * (3)连续存储的 trivially copyable 类型，较短的一段不超过 512 字节时放入栈上的
+ *    缓冲区，其余部分 memmove 一次；否则按字节做块交换
+ * */
+template <class ForwardIter>
+ForwardIter rotate_dispatch(ForwardIter first, ForwardIter middle,
+                            ForwardIter last, forward_iterator_tag) {
+    ForwardIter first2 = middle;
+    do {
+        easystl::iter_swap(first++, first2++);
+        if (first == middle) {
+            middle = first2;
+        }
+    } while (first2 != last);
+    ForwardIter result = first;
+    first2 = middle;
+    while (first2 != last) {
+        easystl::iter_swap(first++, first2++);
+        if (first == middle) {
+            middle = first2;
+        } else if (first2 == last) {
+            first2 = middle;
+        }
+    }
+    return result;
+}
+
+template <class RandomIter>
+RandomIter rotate_dispatch(RandomIter first, RandomIter middle,
+                           RandomIter last, random_access_iterator_tag) {
+    RandomIter result = first + (last - middle);
+    while (first != middle && middle != last) {
+        const auto left = middle - first;
+        const auto right = last - middle;
+        if (left <= right) {
+            // [first, middle) 与其后等长的部分交换后到达最终位置
+            for (RandomIter a = first, b = middle; a != middle; ++a, ++b) {
+                easystl::iter_swap(a, b);
+            }
+            first = middle;
+            middle += left;
+        } else {
+            // [middle, last) 与 [first, first + right) 交换后到达最终位置
+            for (RandomIter a = first, b = middle; b != last; ++a, ++b) {
+                easystl::iter_swap(a, b);
+            }
+            first += right;
+        }
+    }
+    return result;
+}
+
+// 交换 [a, a + n) 与 [b, b + n) 中的字节，两段不重叠
+inline void unchecked_swap_bytes(unsigned char *a, unsigned char *b,
+                                 std::size_t n) noexcept {
+    std::size_t i = 0;
+#ifdef EASYSTL_ALGO_SSE2
+    for (; i + 32 <= n; i += 32) {
+        __m128i *pa = reinterpret_cast<__m128i *>(a + i);
+        __m128i *pb = reinterpret_cast<__m128i *>(b + i);
+        const __m128i a0 = _mm_loadu_si128(pa);
+        const __m128i a1 = _mm_loadu_si128(pa + 1);
+        const __m128i b0 = _mm_loadu_si128(pb);
+        const __m128i b1 = _mm_loadu_si128(pb + 1);
+        _mm_storeu_si128(pa, b0);
+        _mm_storeu_si128(pa + 1, b1);
+        _mm_storeu_si128(pb, a0);
+        _mm_storeu_si128(pb + 1, a1);
+    }
+#endif
+    for (; i < n; ++i) {
+        const unsigned char t = a[i];
+        a[i] = b[i];
+        b[i] = t;
+    }
+}
+
+template <class Tp>
+typename std::enable_if<std::is_trivially_copyable<Tp>::value, Tp *>::type
+rotate_dispatch(Tp *first, Tp *middle, Tp *last, random_access_iterator_tag) {
+    unsigned char *f = reinterpret_cast<unsigned char *>(first);
+    unsigned char *m = reinterpret_cast<unsigned char *>(middle);
+    unsigned char *l = reinterpret_cast<unsigned char *>(last);
+    Tp *const result = first + (last - middle);
+    std::size_t left = static_cast<std::size_t>(m - f);
+    std::size_t right = static_cast<std::size_t>(l - m);
+    unsigned char buf[512];
+    while (left != 0 && right != 0) {
+        if (left <= sizeof(buf) || right <= sizeof(buf)) {
+            if (left <= right) {
+                std::memcpy(buf, f, left);
+                std::memmove(f, m, right);
+                std::memcpy(f + right, buf, left);
+            } else {
+                std::memcpy(buf, m, right);
+                std::memmove(f + right, f, left);
+                std::memcpy(f, buf, right);
+            }
+            break;
+        }
+        if (left <= right) {
+            unchecked_swap_bytes(f, m, left);
+            f = m;
+            m += left;
+            right -= left;
+        } else {
+            unchecked_swap_bytes(f, m, right);
+            f += right;
+            left -= right;
+        }
+    }
+    return result;
+}
+
+template <class ForwardIter>
+ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last) {
+    if (first == middle) {
+        return last;
+    }
+    if (middle == last) {
+        return first;
+    }
+    return easystl::niter_wrap(
+        first, rotate_dispatch(easystl::niter_base(first),
+                               easystl::niter_base(middle),
+                               easystl::niter_base(last),
+                               iterator_category(first)));
+}
+
+/*
+ * remove / remove_if
+ * 把不等于 value（不满足 pred）的元素依次移到区间前部，返回新的末尾，之后的
+ * 元素处于有效但未指定的状态：
+ * (1)先找到第一个要删除的元素，之前的元素不做任何移动
+ * (2)连续存储的小 trivially copyable 类型不用分支：每个元素都写到输出位置，
+ *    输出位置是否前进由比较结果决定，删除的位置没有规律时不会预测失败
+ * (3)4 或 8 字节的算术类型交给 simd 流压缩，每次处理一个向量
+ * */
+template <class Tp>
+struct is_branchless_compactable
+    : m_bool_constant<std::is_trivially_copy_assignable<Tp>::value &&
+                      sizeof(Tp) <= 16> {};
+
+template <class T> struct remove_equal_pred {
+    const T &value;
+    template <class U> bool operator()(const U &x) const {
+        return x == value;
+    }
+};
+
+template <class ForwardIter, class Predicate>
+ForwardIter remove_if_dispatch(ForwardIter first, ForwardIter last,
+                               Predicate &pred) {
+    ForwardIter out = first;
+    for (++first; first != last; ++first) {
+        if (!pred(*first)) {
+            *out = easystl::move(*first);
+            ++out;
+        }
+    }
+    return out;
+}
+
+template <class Tp, class Predicate>
+typename std::enable_if<is_branchless_compactable<Tp>::value, Tp *>::type
+remove_if_dispatch(Tp *first, Tp *last, Predicate &pred) {
+    Tp *out = first++;
+    simd::remove_if(first, last, out, pred);
+    for (; first != last; ++first) {
+        const bool removed = pred(*first);
+        *out = *first;
+        out += removed ? 0 : 1;
+    }
+    return out;
+}
+
+template <class ForwardIter, class Predicate>
+ForwardIter remove_if(ForwardIter first, ForwardIter last, Predicate pred) {
+    first = easystl::find_if(first, last, pred);
+    if (first == last) {
+        return first;
+    }
+    return easystl::niter_wrap(
+        first, remove_if_dispatch(easystl::niter_base(first),
+                                  easystl::niter_base(last), pred));
+}
+
+template <class ForwardIter, class T>
+ForwardIter remove_dispatch(ForwardIter first, ForwardIter last,
+                            const T &value) {
+    remove_equal_pred<T> pred = {value};
+    return remove_if_dispatch(first, last, pred);
+}
+
+template <class Tp, class Up>
+typename std::enable_if<
+    simd::is_compactable<Tp>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+    Tp *>::type
+remove_dispatch(Tp *first, Tp *last, const Up &value) {
+    Tp *out = first++;
+    simd::remove(first, last, out, value);
+    for (; first != last; ++first) {
+        const bool removed = *first == value;
+        *out = *first;
+        out += removed ? 0 : 1;
+    }
+    return out;
+}
+
+template <class ForwardIter, class T>
+ForwardIter remove(ForwardIter first, ForwardIter last, const T &value) {
+    first = easystl::find(first, last, value);
+    if (first == last) {
+        return first;
+    }
+    return easystl::niter_wrap(
+        first, remove_dispatch(easystl::niter_base(first),
+                               easystl::niter_base(last), value));
+}
+
+/*
+ * unique
+ * 版本1：相邻的相等元素只保留第一个，返回新的末尾
+ * 版本2：以二元谓词 pred 判断相等
+ * 版本1 在连续存储的 4 或 8 字节算术类型上交给 simd 流压缩，每个元素与原序列
+ * 中的前一个元素比较；operator== 满足传递性，结果与逐个比较相同
+ * */
+template <class ForwardIter, class BinaryPredicate>
+ForwardIter unique(ForwardIter first, ForwardIter last,
+                   BinaryPredicate pred) {
+    if (first == last) {
+        return last;
+    }
+    ForwardIter out = first;
+    while (++first != last) {
+        if (!pred(*out, *first) && ++out != first) {
+            *out = easystl::move(*first);
+        }
+    }
+    return ++out;
+}
+
+template <class ForwardIter>
+ForwardIter unique_dispatch(ForwardIter first, ForwardIter last) {
+    return easystl::unique(first, last, unique_equal());
+}
+
+template <class Tp>
+typename std::enable_if<simd::is_compactable<Tp>::value &&
+                            !std::is_const<Tp>::value,
+                        Tp *>::type
+unique_dispatch(Tp *first, Tp *last) {
+    if (first == last) {
+        return last;
+    }
+    Tp *out = ++first;
+    simd::unique(first, last, out);
+    for (; first != last; ++first) {
+        if (!(*(out - 1) == *first)) {
+            *out++ = *first;
+        }
+    }
+    return out;
+}
+
+template <class ForwardIter>
+ForwardIter unique(ForwardIter first, ForwardIter last) {
+    return easystl::niter_wrap(first,
+                               unique_dispatch(easystl::niter_base(first),
+                                               easystl::niter_base(last)));
+}
+
+/*
+ * partition
+ * 把满足 pred 的元素移到不满足的元素之前，返回分界点，不保持相对顺序
+ * (1)前向迭代器从前往后把满足 pred 的元素交换到前部
+ * (2)双向迭代器从两端向中间查找放错一侧的元素，每对只交换一次
+ * */
+template <class ForwardIter, class Predicate>
+ForwardIter partition_dispatch(ForwardIter first, ForwardIter last,
+                               Predicate &pred, forward_iterator_tag) {
+    while (first != last && pred(*first)) {
+        ++first;
+    }
+    if (first == last) {
+        return first;
+    }
+    for (ForwardIter i = first; ++i != last;) {
+        if (pred(*i)) {
+            easystl::iter_swap(i, first);
+            ++first;
+        }
+    }
+    return first;
+}
+
+template <class BidirectionalIter, class Predicate>
+BidirectionalIter partition_dispatch(BidirectionalIter first,
+                                     BidirectionalIter last, Predicate &pred,
+                                     bidirectional_iterator_tag) {
+    while (true) {
+        while (true) {
+            if (first == last) {
+                return first;
+            }
+            if (!pred(*first)) {
+                break;
+            }
+            ++first;
+        }
+        do {
+            if (first == --last) {
+                return first;
+            }
+        } while (!pred(*last));
+        easystl::iter_swap(first, last);
+        ++first;
+    }
+}
+
+template <class ForwardIter, class Predicate>
+ForwardIter partition(ForwardIter first, ForwardIter last, Predicate pred) {
+    return partition_dispatch(first, last, pred, iterator_category(first));
+}
+
+/*
+ * stable_partition
+ * 与 partition 相同，但保持两部分中元素的相对顺序。不满足 pred 的元素先移到
+ * 缓冲区，满足的元素在原区间中前移，最后把缓冲区的元素移回末尾。
+ * 连续存储的 4 或 8 字节算术类型两部分都交给 simd 流压缩
+ * */
+template <class BidirectionalIter, class Predicate>
+BidirectionalIter stable_partition_dispatch(BidirectionalIter first,
+                                            BidirectionalIter last,
+                                            Predicate &pred) {
+    typedef typename iterator_traits<BidirectionalIter>::value_type T;
+    while (first != last && pred(*first)) {
+        ++first;
+    }
+    if (first == last) {
+        return first;
+    }
+    // *first 不满足 pred
+    std::size_t n = 0;
+    for (BidirectionalIter i = first; i != last; ++i) {
+        ++n;
+    }
+    easystl::allocator<T> alloc;
+    T *buf = alloc.allocate(n);
+    T *bend = buf;
+    BidirectionalIter out = first;
+    // [out, first) 中的元素已经移走，个数与缓冲区中的元素相同。pred 或移动
+    // 抛出异常时把缓冲区的元素移回这些位置，不丢失元素
+    try {
+        easystl::construct(bend, easystl::move(*first));
+        ++bend;
+        for (++first; first != last; ++first) {
+            if (pred(*first)) {
+                *out = easystl::move(*first);
+                ++out;
+            } else {
+                easystl::construct(bend, easystl::move(*first));
+                ++bend;
+            }
+        }
+    } catch (...) {
+        easystl::move(buf, bend, out);
+        easystl::destroy(buf, bend);
+        alloc.deallocate(buf, n);
+        throw;
+    }
+    easystl::move(buf, bend, out);
+    easystl::destroy(buf, bend);
+    alloc.deallocate(buf, n);
+    return out;
+}
+
+template <class Tp, class Predicate>
+typename std::enable_if<simd::is_compactable<Tp>::value &&
+                            !std::is_const<Tp>::value,
+                        Tp *>::type
+stable_partition_dispatch(Tp *first, Tp *last, Predicate &pred) {
+    const auto n = static_cast<std::size_t>(last - first);
+    if (n == 0) {
+        return first;
+    }
+    easystl::allocator<Tp> alloc;
+    Tp *buf = alloc.allocate(n);
+    Tp *rest = buf;
+    Tp *out = first;
+    // simd::partition 在写入之前求出整个向量的 pred，抛出异常时 [out, first)
+    // 的长度同样等于缓冲区中的元素个数
+    try {
+        simd::partition(first, last, out, rest, pred);
+        for (; first != last; ++first) {
+            const bool keep = pred(*first);
+            const Tp v = *first;
+            *out = v;
+            *rest = v;
+            out += keep ? 1 : 0;
+            rest += keep ? 0 : 1;
+        }
+    } catch (...) {
+        std::memcpy(out, buf,
+                    static_cast<std::size_t>(rest - buf) * sizeof(Tp));
+        alloc.deallocate(buf, n);
+        throw;
+    }
+    std::memcpy(out, buf, static_cast<std::size_t>(rest - buf) * sizeof(Tp));
+    alloc.deallocate(buf, n);
+    return out;
+}
+
+template <class BidirectionalIter, class Predicate>
+BidirectionalIter stable_partition(BidirectionalIter first,
+                                   BidirectionalIter last, Predicate pred) {
+    return easystl::niter_wrap(
+        first, stable_partition_dispatch(easystl::niter_base(first),
+                                         easystl::niter_base(last), pred));
+}
+
+/*
+ * lower_bound / upper_bound / equal_range / binary_search
+ * 在已排序的 [first, last) 中二分查找：
+ * (1)前向迭代器每次比较后分支，移动一半的距离
+ * (2)随机访问迭代器使用无分支的版本：区间长度只依赖于元素个数，每次比较的结果
+ *    只决定起点是否前移，编译器生成条件传送而不是跳转，没有分支预测失败
+ * (3)连续存储且超过 EASYSTL_SEARCH_PREFETCH_THRESHOLD 个元素时，每一步预取下
+ *    一步可能访问的两个位置，把缓存缺失的延迟重叠起来
+ * */
+#ifndef EASYSTL_SEARCH_PREFETCH_THRESHOLD
+#define EASYSTL_SEARCH_PREFETCH_THRESHOLD (std::size_t(1) << 14)
+#endif
+
+template <class Tp> inline void search_prefetch(const Tp *p) noexcept {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+// 返回第一个令 pred 为 false 的位置，要求 pred 在区间上先真后假
+template <class ForwardIter, class Predicate>
+ForwardIter partition_point_dispatch(ForwardIter first, ForwardIter last,
+                                     Predicate pred, forward_iterator_tag) {
+    auto len = easystl::distance(first, last);
+    while (len > 0) {
+        const auto half = len / 2;
+        ForwardIter mid = first;
+        easystl::advance(mid, half);
+        if (pred(*mid)) {
+            first = ++mid;
+            len -= half + 1;
+        } else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+template <class RandomIter, class Predicate>
+RandomIter partition_point_dispatch(RandomIter first, RandomIter last,
+                                    Predicate pred,
+                                    random_access_iterator_tag) {
+    auto len = last - first;
+    if (len == 0) {
+        return first;
+    }
+    while (len > 1) {
+        const auto half = len / 2;
+        first = pred(first[half]) ? first + half : first;
+        len -= half;
+    }
+    return first + (pred(*first) ? 1 : 0);
+}
+
+template <class Tp, class Predicate>
+Tp *partition_point_dispatch(Tp *first, Tp *last, Predicate pred,
+                             random_access_iterator_tag) {
+    std::size_t len = static_cast<std::size_t>(last - first);
+    if (len == 0) {
+        return first;
+    }
+    if (len >= EASYSTL_SEARCH_PREFETCH_THRESHOLD) {
+        while (len > 1) {
+            const std::size_t half = len / 2;
+            // 下一步的区间长度为 len - half，中点只有两种可能
+            const std::size_t next = (len - half) / 2;
+            search_prefetch(first + next);
+            search_prefetch(first + half + next);
+            first = pred(first[half]) ? first + half : first;
+            len -= half;
+        }
+    } else {
+        while (len > 1) {
+            const std::size_t half = len / 2;
+            first = pred(first[half]) ? first + half : first;
+            len -= half;
+        }
+    }
+    return first + (pred(*first) ? 1 : 0);
+}
+
+template <class ForwardIter, class Predicate>
+ForwardIter partition_point(ForwardIter first, ForwardIter last,
+                            Predicate pred) {
+    return easystl::niter_wrap(
+        first, partition_point_dispatch(easystl::niter_base(first),
+                                        easystl::niter_base(last), pred,
+                                        iterator_category(first)));
+}
+
+template <class T, class Compared> struct lower_bound_pred {
+    const T &value;
+    Compared comp;
+    template <class U> bool operator()(const U &x) const {
+        return comp(x, value);
+    }
+};
+
+template <class T, class Compared> struct upper_bound_pred {
+    const T &value;
+    Compared comp;
+    template <class U> bool operator()(const U &x) const {
+        return !comp(value, x);
+    }
+};
+
+// 返回第一个不小于 value 的位置
+template <class ForwardIter, class T, class Compared>
+ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T &value,
+                        Compared comp) {
+    return easystl::partition_point(first, last,
+                                    lower_bound_pred<T, Compared>{value, comp});
+}
+
+template <class ForwardIter, class T>
+ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T &value) {
+    return easystl::lower_bound(first, last, value, search_less());
+}
+
+// 返回第一个大于 value 的位置
+template <class ForwardIter, class T, class Compared>
+ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T &value,
+                        Compared comp) {
+    return easystl::partition_point(first, last,
+                                    upper_bound_pred<T, Compared>{value, comp});
+}
+
+template <class ForwardIter, class T>
+ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T &value) {
+    return easystl::upper_bound(first, last, value, search_less());
+}
+
+// 返回等于 value 的元素构成的区间
+template <class ForwardIter, class T, class Compared>
+pair<ForwardIter, ForwardIter> equal_range(ForwardIter first, ForwardIter last,
+                                           const T &value, Compared comp) {
+    ForwardIter lo = easystl::lower_bound(first, last, value, comp);
+    return pair<ForwardIter, ForwardIter>(
+        lo, easystl::upper_bound(lo, last, value, comp));
+}
+
+template <class ForwardIter, class T>
+pair<ForwardIter, ForwardIter> equal_range(ForwardIter first, ForwardIter last,
+                                           const T &value) {
+    return easystl::equal_range(first, last, value, search_less());
+}
+
+// 查找区间中是否有等于 value 的元素
+template <class ForwardIter, class T, class Compared>
+bool binary_search(ForwardIter first, ForwardIter last, const T &value,
+                   Compared comp) {
+    first = easystl::lower_bound(first, last, value, comp);
+    return first != last && !comp(value, *first);
+}
+
+template <class ForwardIter, class T>
+bool binary_search(ForwardIter first, ForwardIter last, const T &value) {
+    return easystl::binary_search(first, last, value, search_less());
+}
+
+/*
+ * sort
+ * pattern-defeating quicksort（Orson Peters, pdqsort）：
+ * (1)小于 24 个元素时使用插入排序
+ * (2)枢轴取三数中值，超过 128 个元素时取九数中值
+ * (3)算术类型配合 less/greater 时使用 BlockQuicksort 的无分支分区，比较结果
+ *    写入偏移数组而不是跳转
+ * (4)分区结果严重失衡时打乱部分元素，失衡次数超过 log2(n) 时改用堆排序，
+ *    保证 O(n log n)
+ * (5)分区前已经有序的部分用有限次的插入排序直接完成，已排序与逆序的输入为 O(n)
+ * */
+enum {
+    pdq_insertion_sort_threshold = 24,
+    pdq_ninther_threshold = 128,
+    pdq_partial_insertion_sort_limit = 8,
+    pdq_block_size = 64,
+    pdq_cacheline_size = 64
+};
+
+// 使用无分支分区的条件
+template <class Compare, class T>
+struct is_default_compare
+    : m_bool_constant<std::is_arithmetic<T>::value &&
+                      (std::is_same<Compare, easystl::less<T>>::value ||
+                       std::is_same<Compare, easystl::greater<T>>::value)> {};
+
+template <class RandomIter, class Compare>
+void unchecked_insertion_sort(RandomIter first, RandomIter last,
+                              Compare comp) {
+    if (first == last) {
+        return;
+    }
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter sift = cur;
+        RandomIter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            auto tmp = easystl::move(*sift);
+            // 调用 comp 时 *sift 是空位，抛出异常时把 tmp 放回，不丢失元素
+            try {
+                do {
+                    *sift-- = easystl::move(*sift_1);
+                } while (sift != first && comp(tmp, *--sift_1));
+            } catch (...) {
+                *sift = easystl::move(tmp);
+                throw;
+            }
+            *sift = easystl::move(tmp);
+        }
+    }
+}
+
+// 调用者保证 first 之前存在不大于 [first, last) 中任何元素的元素，省去边界检查
+template <class RandomIter, class Compare>
+void unguarded_insertion_sort(RandomIter first, RandomIter last,
+                              Compare comp) {
+    if (first == last) {
+        return;
+    }
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter sift = cur;
+        RandomIter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            auto tmp = easystl::move(*sift);
+            do {
+                *sift-- = easystl::move(*sift_1);
+            } while (comp(tmp, *--sift_1));
+            *sift = easystl::move(tmp);
+        }
+    }
+}
+
+// 插入排序，但移动的元素超过 pdq_partial_insertion_sort_limit 个时放弃；
+// 返回是否完成了排序
+template <class RandomIter, class Compare>
+bool pdq_partial_insertion_sort(RandomIter first, RandomIter last,
+                                Compare comp) {
+    if (first == last) {
+        return true;
+    }
+    std::size_t limit = 0;
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter sift = cur;
+        RandomIter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            auto tmp = easystl::move(*sift);
+            do {
+                *sift-- = easystl::move(*sift_1);
+            } while (sift != first && comp(tmp, *--sift_1));
+            *sift = easystl::move(tmp);
+            limit += static_cast<std::size_t>(cur - sift);
+        }
+        if (limit > pdq_partial_insertion_sort_limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class RandomIter, class Compare>
+void pdq_sort2(RandomIter a, RandomIter b, Compare comp) {
+    if (comp(*b, *a)) {
+        easystl::iter_swap(a, b);
+    }
+}
+
+template <class RandomIter, class Compare>
+void pdq_sort3(RandomIter a, RandomIter b, RandomIter c, Compare comp) {
+    pdq_sort2(a, b, comp);
+    pdq_sort2(b, c, comp);
+    pdq_sort2(a, b, comp);
+}
+
+inline unsigned char *pdq_align_cacheline(unsigned char *p) {
+    std::uintptr_t ip = reinterpret_cast<std::uintptr_t>(p);
+    ip = (ip + pdq_cacheline_size - 1) &
+         ~static_cast<std::uintptr_t>(pdq_cacheline_size - 1);
+    return reinterpret_cast<unsigned char *>(ip);
+}
+
+// 交换 first + offsets_l[i] 与 last - offsets_r[i]。两侧个数相同时必须逐对
+// 交换，否则降序输入会退化；其余情况用一个临时变量轮转，减少一半的移动
+template <class RandomIter>
+void pdq_swap_offsets(RandomIter first, RandomIter last,
+                      const unsigned char *offsets_l,
+                      const unsigned char *offsets_r, std::size_t num,
+                      bool use_swaps) {
+    if (use_swaps) {
+        for (std::size_t i = 0; i < num; ++i) {
+            easystl::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+    } else if (num > 0) {
+        RandomIter l = first + offsets_l[0];
+        RandomIter r = last - offsets_r[0];
+        auto tmp = easystl::move(*l);
+        *l = easystl::move(*r);
+        for (std::size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = easystl::move(*l);
+            r = last - offsets_r[i];
+            *l = easystl::move(*r);
+        }
+        *r = easystl::move(tmp);
+    }
+}
+
+// 以 *first 为枢轴分区，小于枢轴的放左侧。返回枢轴的最终位置，以及分区前
+// 是否已经满足分区条件
+template <class RandomIter, class Compare>
+pair<RandomIter, bool> pdq_partition_right(RandomIter begin, RandomIter end,
+                                           Compare comp) {
+    auto pivot = easystl::move(*begin);
+    RandomIter first = begin;
+    RandomIter last = end;
+
+    // 三数中值保证右侧存在不小于枢轴的元素
+    while (comp(*++first, pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {
+        }
+    } else {
+        while (!comp(*--last, pivot)) {
+        }
+    }
+
+    const bool already_partitioned = first >= last;
+    while (first < last) {
+        easystl::iter_swap(first, last);
+        while (comp(*++first, pivot)) {
+        }
+        while (!comp(*--last, pivot)) {
+        }
+    }
+
+    RandomIter pivot_pos = first - 1;
+    *begin = easystl::move(*pivot_pos);
+    *pivot_pos = easystl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 与 pdq_partition_right 相同，但每个块先把放错一侧的元素的偏移量记录下来，
+// 比较结果只用于累加计数，不产生分支
+template <class RandomIter, class Compare>
+pair<RandomIter, bool>
+pdq_partition_right_branchless(RandomIter begin, RandomIter end,
+                               Compare comp) {
+    auto pivot = easystl::move(*begin);
+    RandomIter first = begin;
+    RandomIter last = end;
+
+    while (comp(*++first, pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {
+        }
+    } else {
+        while (!comp(*--last, pivot)) {
+        }
+    }
+
+    const bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+        easystl::iter_swap(first, last);
+        ++first;
+
+        unsigned char offsets_l_storage[pdq_block_size + pdq_cacheline_size];
+        unsigned char offsets_r_storage[pdq_block_size + pdq_cacheline_size];
+        unsigned char *offsets_l = pdq_align_cacheline(offsets_l_storage);
+        unsigned char *offsets_r = pdq_align_cacheline(offsets_r_storage);
+
+        RandomIter offsets_l_base = first;
+        RandomIter offsets_r_base = last;
+        std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // 本轮两侧各检查多少个元素
+            const std::size_t num_unknown =
+                static_cast<std::size_t>(last - first);
+            const std::size_t left_split =
+                num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            const std::size_t right_split =
+                num_r == 0 ? (num_unknown - left_split) : 0;
+
+            if (left_split >= pdq_block_size) {
+                for (std::size_t i = 0; i < pdq_block_size;) {
+                    for (int k = 0; k < 8; ++k) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+                }
+            } else {
+                for (std::size_t i = 0; i < left_split;) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i++);
+                    num_l += !comp(*first, pivot);
+                    ++first;
+                }
+            }
+
+            if (right_split >= pdq_block_size) {
+                for (std::size_t i = 0; i < pdq_block_size;) {
+                    for (int k = 0; k < 8; ++k) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                    }
+                }
+            } else {
+                for (std::size_t i = 0; i < right_split;) {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i);
+                    num_r += comp(*--last, pivot);
+                }
+            }
+
+            const std::size_t num = num_l < num_r ? num_l : num_r;
+            pdq_swap_offsets(offsets_l_base, offsets_r_base,
+                             offsets_l + start_l, offsets_r + start_r, num,
+                             num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // 剩余一侧的错位元素逐个交换到中间
+        if (num_l) {
+            offsets_l += start_l;
+            while (num_l--) {
+                easystl::iter_swap(offsets_l_base + offsets_l[num_l], --last);
+            }
+            first = last;
+        }
+        if (num_r) {
+            offsets_r += start_r;
+            while (num_r--) {
+                easystl::iter_swap(offsets_r_base - offsets_r[num_r], first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    RandomIter pivot_pos = first - 1;
+    *begin = easystl::move(*pivot_pos);
+    *pivot_pos = easystl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 与枢轴相等的元素放左侧。begin 之前的元素与枢轴相等时使用，一次把所有等于
+// 枢轴的元素排除在后续递归之外，大量重复键时为 O(n)
+template <class RandomIter, class Compare>
+RandomIter pdq_partition_left(RandomIter begin, RandomIter end, Compare comp) {
+    auto pivot = easystl::move(*begin);
+    RandomIter first = begin;
+    RandomIter last = end;
+
+    while (comp(pivot, *--last)) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {
+        }
+    } else {
+        while (!comp(pivot, *++first)) {
+        }
+    }
+
+    while (first < last) {
+        easystl::iter_swap(first, last);
+        while (comp(pivot, *--last)) {
+        }
+        while (!comp(pivot, *++first)) {
+        }
+    }
+
+    RandomIter pivot_pos = last;
+    *begin = easystl::move(*pivot_pos);
+    *pivot_pos = easystl::move(pivot);
+    return pivot_pos;
+}
+
+template <bool Branchless, class RandomIter, class Compare>
+void pdq_sort_loop(RandomIter begin, RandomIter end, Compare comp,
+                   int bad_allowed, bool leftmost) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    while (true) {
+        const Distance size = end - begin;
+        if (size < pdq_insertion_sort_threshold) {
+            if (leftmost) {
+                unchecked_insertion_sort(begin, end, comp);
+            } else {
+                unguarded_insertion_sort(begin, end, comp);
+            }
+            return;
+        }
+
+        // 枢轴放到 *begin
+        const Distance s2 = size / 2;
+        if (size > pdq_ninther_threshold) {
+            pdq_sort3(begin, begin + s2, end - 1, comp);
+            pdq_sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            pdq_sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            easystl::iter_swap(begin, begin + s2);
+        } else {
+            pdq_sort3(begin + s2, begin, end - 1, comp);
+        }
+
+        // 左侧相邻的元素（上一次的枢轴）不小于本次枢轴，说明它们相等
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = pdq_partition_left(begin, end, comp) + 1;
+            continue;
+        }
+
+        const pair<RandomIter, bool> part =
+            Branchless ? pdq_partition_right_branchless(begin, end, comp)
+                       : pdq_partition_right(begin, end, comp);
+        const RandomIter pivot_pos = part.first;
+        const bool already_partitioned = part.second;
+
+        const Distance l_size = pivot_pos - begin;
+        const Distance r_size = end - (pivot_pos + 1);
+        const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            if (--bad_allowed == 0) {
+                easystl::make_heap(begin, end, comp);
+                easystl::sort_heap(begin, end, comp);
+                return;
+            }
+            // 打乱两侧的部分元素，破坏导致失衡的模式
+            if (l_size >= pdq_insertion_sort_threshold) {
+                easystl::iter_swap(begin, begin + l_size / 4);
+                easystl::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > pdq_ninther_threshold) {
+                    easystl::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                    easystl::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                    easystl::iter_swap(pivot_pos - 2,
+                                       pivot_pos - (l_size / 4 + 1));
+                    easystl::iter_swap(pivot_pos - 3,
+                                       pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= pdq_insertion_sort_threshold) {
+                easystl::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                easystl::iter_swap(end - 1, end - r_size / 4);
+                if (r_size > pdq_ninther_threshold) {
+                    easystl::iter_swap(pivot_pos + 2,
+                                       pivot_pos + (2 + r_size / 4));
+                    easystl::iter_swap(pivot_pos + 3,
+                                       pivot_pos + (3 + r_size / 4));
+                    easystl::iter_swap(end - 2, end - (1 + r_size / 4));
+                    easystl::iter_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned &&
+                   pdq_partial_insertion_sort(begin, pivot_pos, comp) &&
+                   pdq_partial_insertion_sort(pivot_pos + 1, end, comp)) {
+            return;
+        }
+
+        // 递归处理左侧，循环处理右侧
+        pdq_sort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed,
+                                  leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template <class RandomIter, class Compare>
+void sort(RandomIter first, RandomIter last, Compare comp) {
+    static_assert(is_random_access_iter<RandomIter>::value,
+                  "sort requires random access iterators");
+    auto begin = easystl::niter_base(first);
+    auto end = easystl::niter_base(last);
+    if (end - begin < 2) {
+        return;
+    }
+    typedef typename iterator_traits<RandomIter>::value_type T;
+    int bad_allowed = 0;
+    for (auto n = end - begin; n > 1; n >>= 1) {
+        ++bad_allowed;
+    }
+    pdq_sort_loop<is_default_compare<Compare, T>::value>(begin, end, comp,
+                                                         bad_allowed, true);
+}
+
+template <class RandomIter> void sort(RandomIter first, RandomIter last) {
+    easystl::sort(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/*
+ * partial_sort
+ * 把 [first, last) 中最小的 middle - first 个元素按顺序放到 [first, middle)：
+ * 在 [first, middle) 上维护一个大根堆，其余元素比堆顶小时替换堆顶
+ * */
+template <class RandomIter, class Compare>
+void partial_sort(RandomIter first, RandomIter middle, RandomIter last,
+                  Compare comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    easystl::make_heap(first, middle, comp);
+    const Distance len = middle - first;
+    for (RandomIter i = middle; i < last; ++i) {
+        if (comp(*i, *first)) {
+            auto value = easystl::move(*i);
+            *i = easystl::move(*first);
+            easystl::adjust_heap(first, Distance(0), len, easystl::move(value),
+                                 comp);
+        }
+    }
+    easystl::sort_heap(first, middle, comp);
+}
+
+template <class RandomIter>
+void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
+    easystl::partial_sort(
+        first, middle, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/*
+ * stable_sort
+ * 自底向上的归并排序：先对每 32 个元素做插入排序，再成倍合并。合并时把较短
+ * 的一半移到缓冲区，缓冲区只需要 n / 2 个元素
+ * */
+enum { stable_sort_chunk = 32 };
+
+// [first, middle) 移入缓冲区，从前往后合并；相等时先取左侧，保证稳定
+template <class RandomIter, class Tp, class Compare>
+void merge_forward_with_buffer(RandomIter first, RandomIter middle,
+                               RandomIter last, Tp *buf, Compare comp) {
+    Tp *bend = buf;
+    Tp *b = buf;
+    RandomIter r = first;
+    RandomIter out = first;
+    // [out, r) 中的元素已经移走，个数等于 bend - b。comp 或移动抛出异常时
+    // 把缓冲区中剩余的元素移回这些位置，不丢失元素
+    try {
+        for (; r != middle; ++r, ++bend) {
+            easystl::construct(bend, easystl::move(*r));
+        }
+        while (b != bend && r != last) {
+            if (comp(*r, *b)) {
+                *out++ = easystl::move(*r++);
+            } else {
+                *out++ = easystl::move(*b++);
+            }
+        }
+        for (; b != bend; ++b, ++out) {
+            *out = easystl::move(*b);
+        }
+    } catch (...) {
+        easystl::move(b, bend, out);
+        easystl::destroy(buf, bend);
+        throw;
+    }
+    easystl::destroy(buf, bend);
+}
+
+// [middle, last) 移入缓冲区，从后往前合并；相等时先取右侧，保证稳定
+template <class RandomIter, class Tp, class Compare>
+void merge_backward_with_buffer(RandomIter first, RandomIter middle,
+                                RandomIter last, Tp *buf, Compare comp) {
+    Tp *bend = buf;
+    Tp *b = buf;
+    RandomIter l = middle;
+    RandomIter out = middle;
+    // [l, out) 中的元素已经移走，个数等于 b - buf。抛出异常时处理方式与
+    // merge_forward_with_buffer 相同
+    try {
+        for (; out != last; ++out) {
+            easystl::construct(bend, easystl::move(*out));
+            b = ++bend;
+        }
+        while (b != buf && l != first) {
+            if (comp(*(b - 1), *(l - 1))) {
+                *--out = easystl::move(*--l);
+            } else {
+                *--out = easystl::move(*--b);
+            }
+        }
+        while (b != buf) {
+            *--out = easystl::move(*--b);
+        }
+    } catch (...) {
+        easystl::move(buf, b, l);
+        easystl::destroy(buf, bend);
+        throw;
+    }
+    easystl::destroy(buf, bend);
+}
+
+template <class RandomIter, class Compare>
+void stable_sort(RandomIter first, RandomIter last, Compare comp) {
+    static_assert(is_random_access_iter<RandomIter>::value,
+                  "stable_sort requires random access iterators");
+    typedef typename iterator_traits<RandomIter>::value_type T;
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    auto begin = easystl::niter_base(first);
+    auto end = easystl::niter_base(last);
+    const Distance n = end - begin;
+    for (Distance i = 0; i < n; i += stable_sort_chunk) {
+        const Distance j =
+            n - i < stable_sort_chunk ? n : i + stable_sort_chunk;
+        unchecked_insertion_sort(begin + i, begin + j, comp);
+    }
+    if (n <= stable_sort_chunk) {
+        return;
+    }
+
+    easystl::allocator<T> alloc;
+    const auto buf_len = static_cast<std::size_t>(n / 2 + 1);
+    T *buf = alloc.allocate(buf_len);
+    // 合并函数抛出异常前已经把元素移回原区间并析构了缓冲区中的对象
+    try {
+        for (Distance width = stable_sort_chunk; width < n; width *= 2) {
+            for (Distance lo = 0; lo + width < n; lo += 2 * width) {
+                const auto first1 = begin + lo;
+                const auto middle = first1 + width;
+                const auto last1 = n - lo > 2 * width ? middle + width : end;
+                // 两段之间已经有序
+                if (!comp(*middle, *(middle - 1))) {
+                    continue;
+                }
+                if (middle - first1 <= last1 - middle) {
+                    merge_forward_with_buffer(first1, middle, last1, buf,
+                                              comp);
+                } else {
+                    merge_backward_with_buffer(first1, middle, last1, buf,
+                                               comp);
+                }
+            }
+        }
+    } catch (...) {
+        alloc.deallocate(buf, buf_len);
+        throw;
+    }
+    alloc.deallocate(buf, buf_len);
+}
+
+template <class RandomIter>
+void stable_sort(RandomIter first, RandomIter last) {
+    easystl::stable_sort(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
 }
 } // namespace easystl
 
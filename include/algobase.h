@@ -2,22 +2,54 @@
 #define EASYSTL_ALGOBASE_H
 
 // 基本算法
+//
+// C++20 起以下算法均为 constexpr，常量求值时 memmove 等快速路径改为逐个元素处理
 #include "iterator.h"
+#include "type_traits.h"
 #include "utility.h"
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <type_traits>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define EASYSTL_ALGOBASE_SSE2 1
+#endif
+
+// 超过此字节数的填充使用非临时存储，绕过缓存直接写入内存，避免把缓存中的
+// 其他数据挤出去
+#ifndef EASYSTL_FILL_NONTEMPORAL_THRESHOLD
+#define EASYSTL_FILL_NONTEMPORAL_THRESHOLD (std::size_t(4) << 20)
+#endif
+
 namespace easystl {
 
+template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20 OutputIter copy(InputIter first, InputIter last,
+                                    OutputIter result);
+template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20 BidirectionalIter2 copy_backward(BidirectionalIter1 first,
+                                                     BidirectionalIter1 last,
+                                                     BidirectionalIter2 result);
+template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20 OutputIter move(InputIter first, InputIter last,
+                                    OutputIter result);
+template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20 BidirectionalIter2 move_backward(BidirectionalIter1 first,
+                                                     BidirectionalIter1 last,
+                                                     BidirectionalIter2 result);
+
 /*
  * max
  * */
-template <class T> const T &max(const T &lhs, const T &rhs) {
+template <class T>
+EASYSTL_CONSTEXPR20 const T &max(const T &lhs, const T &rhs) {
     return lhs < rhs ? rhs : lhs;
 }
 
 template <class T, class Compare>
+EASYSTL_CONSTEXPR20
 const T &max(const T &lhs, const T &rhs, Compare comp) {
     return comp(lhs, rhs) ? rhs : lhs;
 }
@@ -25,11 +57,13 @@ const T &max(const T &lhs, const T &rhs, Compare comp) {
 /*
  * min
  * */
-template <class T> const T &min(const T &lhs, const T &rhs) {
+template <class T>
+EASYSTL_CONSTEXPR20 const T &min(const T &lhs, const T &rhs) {
     return rhs < lhs ? rhs : lhs;
 }
 
 template <class T, class Compare>
+EASYSTL_CONSTEXPR20
 const T &min(const T &lhs, const T &rhs, Compare comp) {
     return comp(rhs, lhs) ? rhs : lhs;
 }
@@ -37,7 +71,8 @@ const T &min(const T &lhs, const T &rhs, Compare comp) {
 /*
  * iter_swap
  * */
-template <class FIter1, class FIter2> void iter_swap(FIter1 lhs, FIter2 rhs) {
+template <class FIter1, class FIter2>
+EASYSTL_CONSTEXPR20 void iter_swap(FIter1 lhs, FIter2 rhs) {
     swap(*lhs, *rhs);
 }
 
@@ -48,6 +83,7 @@ template <class FIter1, class FIter2> void iter_swap(FIter1 lhs, FIter2 rhs) {
 
 // input_iterator_tag version
 template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_copy_cat(InputIter first, InputIter last,
                               OutputIter result, input_iterator_tag) {
     for (; first != last; ++first, ++result) {
@@ -58,6 +94,7 @@ OutputIter unchecked_copy_cat(InputIter first, InputIter last,
 
 // random_access_iterator_tag version
 template <class RandomIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_copy_cat(RandomIter first, RandomIter last,
                               OutputIter result, random_access_iterator_tag) {
     for (auto n = last - first; n > 0; --n, ++first, ++result) {
@@ -67,17 +104,23 @@ OutputIter unchecked_copy_cat(RandomIter first, RandomIter last,
 }
 
 template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
     return unchecked_copy_cat(first, last, result, iterator_category(first));
 }
 
 // 为 trivially_copy_assignable 类型提供特化版本
 template <class Tp, class Up>
+EASYSTL_CONSTEXPR20
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_copy_assignable<Up>::value,
     Up *>::type
 unchecked_copy(Tp *first, Tp *last, Up *result) {
+    if (easystl::is_constant_evaluated()) {
+        return unchecked_copy_cat(first, last, result,
+                                  random_access_iterator_tag());
+    }
     const auto n = static_cast<size_t>(last - first);
     if (n != 0) {
         std::memmove(result, first, n * sizeof(Up));
@@ -85,9 +128,24 @@ unchecked_copy(Tp *first, Tp *last, Up *result) {
     return result + n;
 }
 
+// 反向迭代器的区间对应原区间从后往前复制，改用 copy_backward，使内层的迭代器
+// 仍然可以还原成指针
+template <class Iter1, class Iter2>
+EASYSTL_CONSTEXPR20 reverse_iterator<Iter2>
+unchecked_copy(reverse_iterator<Iter1> first, reverse_iterator<Iter1> last,
+               reverse_iterator<Iter2> result) {
+    return reverse_iterator<Iter2>(
+        easystl::copy_backward(last.base(), first.base(), result.base()));
+}
+
+// 连续迭代器先还原成指针，以便匹配上面的 memmove 版本
 template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter copy(InputIter first, InputIter last, OutputIter result) {
-    return unchecked_copy(first, last, result);
+    return easystl::niter_wrap(
+        result, unchecked_copy(easystl::niter_base(first),
+                               easystl::niter_base(last),
+                               easystl::niter_base(result)));
 }
 
 /*
@@ -97,6 +155,7 @@ OutputIter copy(InputIter first, InputIter last, OutputIter result) {
 
 // bidirectional_iterator_tag version
 template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20
 BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
                                                BidirectionalIter1 last,
                                                BidirectionalIter2 result,
@@ -109,6 +168,7 @@ BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
 
 // random_access_iterator_tag version
 template <class RandomIter, class BidirectionalIter>
+EASYSTL_CONSTEXPR20
 BidirectionalIter unchecked_copy_backward_cat(RandomIter first, RandomIter last,
                                               BidirectionalIter result,
                                               random_access_iterator_tag) {
@@ -119,6 +179,7 @@ BidirectionalIter unchecked_copy_backward_cat(RandomIter first, RandomIter last,
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20
 BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first,
                                            BidirectionalIter1 last,
                                            BidirectionalIter2 result) {
@@ -128,11 +189,16 @@ BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first,
 
 // 为 trivially_copy_assignable 类型提供特化版本
 template <class Tp, class Up>
+EASYSTL_CONSTEXPR20
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_copy_assignable<Up>::value,
     Up *>::type
 unchecked_copy_backward(Tp *first, Tp *last, Up *result) {
+    if (easystl::is_constant_evaluated()) {
+        return unchecked_copy_backward_cat(first, last, result,
+                                           random_access_iterator_tag());
+    }
     const auto n = static_cast<size_t>(last - first);
     if (n != 0) {
         result -= n;
@@ -141,11 +207,24 @@ unchecked_copy_backward(Tp *first, Tp *last, Up *result) {
     return result;
 }
 
+template <class Iter1, class Iter2>
+EASYSTL_CONSTEXPR20 reverse_iterator<Iter2>
+unchecked_copy_backward(reverse_iterator<Iter1> first,
+                        reverse_iterator<Iter1> last,
+                        reverse_iterator<Iter2> result) {
+    return reverse_iterator<Iter2>(
+        easystl::copy(last.base(), first.base(), result.base()));
+}
+
 template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20
 BidirectionalIter2 copy_backward(BidirectionalIter1 first,
                                  BidirectionalIter1 last,
                                  BidirectionalIter2 result) {
-    return unchecked_copy_backward(first, last, result);
+    return easystl::niter_wrap(
+        result, unchecked_copy_backward(easystl::niter_base(first),
+                                        easystl::niter_base(last),
+                                        easystl::niter_base(result)));
 }
 
 /*
@@ -153,6 +232,7 @@ BidirectionalIter2 copy_backward(BidirectionalIter1 first,
  * 将 [first, first + n) 区间的元素拷贝到 [result, result + n)
  * */
 template <class InputIter, class Size, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_copy_n(InputIter first, Size n, OutputIter result,
                             easystl::input_iterator_tag) {
     for (; n > 0; --n, ++first, ++result) {
@@ -162,6 +242,7 @@ OutputIter unchecked_copy_n(InputIter first, Size n, OutputIter result,
 }
 
 template <class RandomIter, class Size, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_copy_n(RandomIter first, Size n, OutputIter result,
                             easystl::random_access_iterator_tag) {
     auto last = first + n;
@@ -169,6 +250,7 @@ OutputIter unchecked_copy_n(RandomIter first, Size n, OutputIter result,
 }
 
 template <class InputIter, class Size, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter copy_n(InputIter first, Size n, OutputIter result) {
     return unchecked_copy_n(first, n, result, iterator_category(first));
 }
@@ -179,36 +261,44 @@ OutputIter copy_n(InputIter first, Size n, OutputIter result) {
  * */
 // input_iterator_tag version
 template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_move_cat(InputIter first, InputIter last,
                               OutputIter result, input_iterator_tag) {
     for (; first != last; ++first, ++result) {
-        *result = move(*first);
+        *result = easystl::move(*first);
     }
     return result;
 }
 
 // random_access_iterator_tag version
 template <class RandomIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_move_cat(RandomIter first, RandomIter last,
                               OutputIter result, random_access_iterator_tag) {
     for (auto n = last - first; n > 0; --n, ++first, ++result) {
-        *result = move(*first);
+        *result = easystl::move(*first);
     }
     return result;
 }
 
 template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
     return unchecked_move_cat(first, last, result, iterator_category(first));
 }
 
 // 为 trivially_move_assignable 类型提供特化版本
 template <class Tp, class Up>
+EASYSTL_CONSTEXPR20
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_move_assignable<Up>::value,
     Up *>::type
 unchecked_move(Tp *first, Tp *last, Up *result) {
+    if (easystl::is_constant_evaluated()) {
+        return unchecked_move_cat(first, last, result,
+                                  random_access_iterator_tag());
+    }
     const auto n = static_cast<size_t>(last - first);
     if (n != 0) {
         std::memmove(result, first, n * sizeof(Up));
@@ -216,9 +306,24 @@ unchecked_move(Tp *first, Tp *last, Up *result) {
     return result + n;
 }
 
+// 反向迭代器的区间对应原区间从后往前移动，改用 move_backward，使内层的迭代器
+// 仍然可以还原成指针
+template <class Iter1, class Iter2>
+EASYSTL_CONSTEXPR20 reverse_iterator<Iter2>
+unchecked_move(reverse_iterator<Iter1> first, reverse_iterator<Iter1> last,
+               reverse_iterator<Iter2> result) {
+    return reverse_iterator<Iter2>(
+        easystl::move_backward(last.base(), first.base(), result.base()));
+}
+
+// 连续迭代器先还原成指针，以便匹配上面的 memmove 版本
 template <class InputIter, class OutputIter>
+EASYSTL_CONSTEXPR20
 OutputIter move(InputIter first, InputIter last, OutputIter result) {
-    return unchecked_move(first, last, result);
+    return easystl::niter_wrap(
+        result, unchecked_move(easystl::niter_base(first),
+                               easystl::niter_base(last),
+                               easystl::niter_base(result)));
 }
 
 /*
@@ -228,28 +333,31 @@ OutputIter move(InputIter first, InputIter last, OutputIter result) {
 
 // bidirectional_iterator_tag version
 template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20
 BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first,
                                                BidirectionalIter1 last,
                                                BidirectionalIter2 result,
                                                bidirectional_iterator_tag) {
     while (first != last) {
-        *--result = move(*--last);
+        *--result = easystl::move(*--last);
     }
     return result;
 }
 
 // random_access_iterator_tag version
 template <class RandomIter, class BidirectionalIter>
+EASYSTL_CONSTEXPR20
 BidirectionalIter unchecked_move_backward_cat(RandomIter first, RandomIter last,
                                               BidirectionalIter result,
                                               random_access_iterator_tag) {
     for (auto n = last - first; n > 0; --n) {
-        *--result = move(*--last);
+        *--result = easystl::move(*--last);
     }
     return result;
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20
 BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first,
                                            BidirectionalIter1 last,
                                            BidirectionalIter2 result) {
@@ -259,11 +367,16 @@ BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first,
 
 // 为 trivially_move_assignable 类型提供特化版本
 template <class Tp, class Up>
+EASYSTL_CONSTEXPR20
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_move_assignable<Up>::value,
     Up *>::type
 unchecked_move_backward(Tp *first, Tp *last, Up *result) {
+    if (easystl::is_constant_evaluated()) {
+        return unchecked_move_backward_cat(first, last, result,
+                                           random_access_iterator_tag());
+    }
     const auto n = static_cast<size_t>(last - first);
     if (n != 0) {
         result -= n;
@@ -272,11 +385,84 @@ unchecked_move_backward(Tp *first, Tp *last, Up *result) {
     return result;
 }
 
+template <class Iter1, class Iter2>
+EASYSTL_CONSTEXPR20 reverse_iterator<Iter2>
+unchecked_move_backward(reverse_iterator<Iter1> first,
+                        reverse_iterator<Iter1> last,
+                        reverse_iterator<Iter2> result) {
+    return reverse_iterator<Iter2>(
+        easystl::move(last.base(), first.base(), result.base()));
+}
+
 template <class BidirectionalIter1, class BidirectionalIter2>
+EASYSTL_CONSTEXPR20
 BidirectionalIter2 move_backward(BidirectionalIter1 first,
                                  BidirectionalIter1 last,
                                  BidirectionalIter2 result) {
-    return unchecked_move_backward(first, last, result);
+    return easystl::niter_wrap(
+        result, unchecked_move_backward(easystl::niter_base(first),
+                                        easystl::niter_base(last),
+                                        easystl::niter_base(result)));
+}
+
+/*
+ * is_bitwise_comparable
+ * 两个对象相等当且仅当它们的对象表示相同：整数、枚举与指针。浮点数不满足
+ * （+0.0 == -0.0，NaN != NaN），带填充字节的类也不满足
+ * */
+template <class Tp>
+struct is_bitwise_comparable
+    : m_bool_constant<std::is_integral<Tp>::value || std::is_enum<Tp>::value ||
+                      std::is_pointer<Tp>::value> {};
+
+/*
+ * unchecked_mismatch_bytes
+ * 返回 [first1, first1 + n) 与 [first2, first2 + n) 第一个不同字节的下标，
+ * 全部相同时返回 n。SSE2 下每次比较 32 个字节
+ * */
+inline std::size_t unchecked_mismatch_bytes(const unsigned char *first1,
+                                            const unsigned char *first2,
+                                            std::size_t n) noexcept {
+    std::size_t i = 0;
+#ifdef EASYSTL_ALGOBASE_SSE2
+    for (; i + 32 <= n; i += 32) {
+        const __m128i a0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(first1 + i));
+        const __m128i b0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2 + i));
+        const __m128i a1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(first1 + i + 16));
+        const __m128i b1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2 + i + 16));
+        const unsigned eq0 =
+            static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a0, b0)));
+        const unsigned eq1 =
+            static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a1, b1)));
+        const unsigned diff = ~(eq0 | (eq1 << 16));
+        if (diff) {
+            return i + static_cast<std::size_t>(__builtin_ctz(diff));
+        }
+    }
+    if (i + 16 <= n) {
+        const __m128i a =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(first1 + i));
+        const __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2 + i));
+        const unsigned diff =
+            static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) ^
+            0xFFFFu;
+        if (diff) {
+            return i + static_cast<std::size_t>(__builtin_ctz(diff));
+        }
+        i += 16;
+    }
+#endif
+    for (; i < n; ++i) {
+        if (first1[i] != first2[i]) {
+            break;
+        }
+    }
+    return i;
 }
 
 /*
@@ -284,7 +470,8 @@ BidirectionalIter2 move_backward(BidirectionalIter1 first,
  * 比较第一序列在 [first, last) 区间上的元素值是否和第二序列相等
  * */
 template <class InputIter1, class InputIter2>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+EASYSTL_CONSTEXPR20 bool unchecked_equal(InputIter1 first1, InputIter1 last1,
+                                         InputIter2 first2) {
     for (; first1 != last1; ++first1, ++first2) {
         if (*first1 != *first2)
             return false;
@@ -292,8 +479,36 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
     return true;
 }
 
+// 为 bitwise comparable 类型提供特化版本，整段交给 memcmp
+template <class Tp, class Up>
+EASYSTL_CONSTEXPR20 typename std::enable_if<
+    std::is_same<typename std::remove_const<Tp>::type,
+                 typename std::remove_const<Up>::type>::value &&
+        is_bitwise_comparable<typename std::remove_const<Tp>::type>::value,
+    bool>::type
+unchecked_equal(Tp *first1, Tp *last1, Up *first2) {
+    if (easystl::is_constant_evaluated()) {
+        for (; first1 != last1; ++first1, ++first2) {
+            if (*first1 != *first2)
+                return false;
+        }
+        return true;
+    }
+    const auto n = static_cast<size_t>(last1 - first1);
+    return n == 0 || std::memcmp(first1, first2, n * sizeof(Tp)) == 0;
+}
+
+template <class InputIter1, class InputIter2>
+EASYSTL_CONSTEXPR20
+bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    return unchecked_equal(easystl::niter_base(first1),
+                           easystl::niter_base(last1),
+                           easystl::niter_base(first2));
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compared>
+EASYSTL_CONSTEXPR20
 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2,
            Compared comp) {
     for (; first1 != last1; ++first1, ++first2) {
@@ -308,6 +523,7 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2,
  * 从 first 位置开始填充 n 个元素
  * */
 template <class OutputIter, class Size, class T>
+EASYSTL_CONSTEXPR20
 OutputIter unchecked_fill_n(OutputIter first, Size n, const T &value) {
     for (; n > 0; --n, ++first) {
         *first = value;
@@ -315,22 +531,117 @@ OutputIter unchecked_fill_n(OutputIter first, Size n, const T &value) {
     return first;
 }
 
-// 为 one-byte 类型进行特化
+/*
+ * unchecked_fill_pattern
+ * 把 size 字节的 pattern 重复写入 first 开始的 n 个位置：
+ * (1)全零的 pattern 交给 memset
+ * (2)size 为 2、4、8、16 时用 SSE2 把 pattern 广播到 16 字节后整块写入，
+ *    超过 EASYSTL_FILL_NONTEMPORAL_THRESHOLD 字节时改用非临时存储
+ * (3)其余大小先写入一个元素，再成倍复制已写好的部分
+ * 调用者保证 size * n >= 32
+ * */
+inline void unchecked_fill_pattern(unsigned char *first,
+                                   const unsigned char *pattern,
+                                   std::size_t size, std::size_t n) noexcept {
+    const std::size_t bytes = size * n;
+    bool zero = true;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (pattern[i] != 0) {
+            zero = false;
+            break;
+        }
+    }
+    if (zero || size == 1) {
+        std::memset(first, pattern[0], bytes);
+        return;
+    }
+#ifdef EASYSTL_ALGOBASE_SSE2
+    if (16 % size == 0) {
+        // 两份 16 字节的 pattern，从下标 k 处读取即得到相位为 k 的 16 个字节
+        unsigned char block[32];
+        for (std::size_t i = 0; i < 32; ++i) {
+            block[i] = pattern[i % size];
+        }
+        unsigned char *p = first;
+        unsigned char *const end = first + bytes;
+        if (bytes >= EASYSTL_FILL_NONTEMPORAL_THRESHOLD) {
+            // 开头先做一次非对齐写入，之后从 16 字节对齐的位置开始 stream
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p),
+                             _mm_loadu_si128(
+                                 reinterpret_cast<const __m128i *>(block)));
+            p = reinterpret_cast<unsigned char *>(
+                (reinterpret_cast<std::uintptr_t>(p) + 16) &
+                ~static_cast<std::uintptr_t>(15));
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                block + static_cast<std::size_t>(p - first) % size));
+            for (; p + 16 <= end; p += 16) {
+                _mm_stream_si128(reinterpret_cast<__m128i *>(p), v);
+            }
+            _mm_sfence();
+        } else {
+            const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+            for (; p + 32 <= end; p += 32) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(p + 16), v);
+            }
+            if (p + 16 <= end) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+                p += 16;
+            }
+        }
+        // 不足 16 字节的尾部：以 end 为结尾再写一次，与前面的写入重叠
+        if (p != end) {
+            const std::size_t phase =
+                static_cast<std::size_t>(end - 16 - first) % size;
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(end - 16),
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(block + phase)));
+        }
+        return;
+    }
+#endif
+    std::memcpy(first, pattern, size);
+    for (std::size_t done = size; done < bytes;) {
+        const std::size_t chunk = done < bytes - done ? done : bytes - done;
+        std::memcpy(first + done, first, chunk);
+        done += chunk;
+    }
+}
+
+// 为 trivially_copyable 类型提供特化版本：把 value 转换成 Tp 后按字节重复
+// 写入。value 与 Tp 类型不同时只接受标量，保证赋值等价于复制转换后的对象
 template <class Tp, class Size, class Up>
-typename std::enable_if<std::is_integral<Tp>::value && sizeof(Tp) == 1 &&
-                            !std::is_same<Tp, bool>::value &&
-                            std::is_integral<Up>::value && sizeof(Up) == 1,
-                        Tp *>::type
-unchecked_fill_n(Tp *first, Size n, Up value) {
-    if (n > 0) {
-        std::memset(first, (unsigned char)value, (size_t)(n));
+EASYSTL_CONSTEXPR20 typename std::enable_if<
+    std::is_trivially_copyable<Tp>::value &&
+        std::is_trivially_copy_assignable<Tp>::value &&
+        (std::is_same<Tp, Up>::value ||
+         (std::is_scalar<Tp>::value && std::is_convertible<Up, Tp>::value)),
+    Tp *>::type
+unchecked_fill_n(Tp *first, Size n, const Up &value) {
+    if (!(n > 0)) {
+        return first;
+    }
+    const Tp v = value;
+    const auto count = static_cast<size_t>(n);
+    if (easystl::is_constant_evaluated() || count * sizeof(Tp) < 64) {
+        for (size_t i = 0; i < count; ++i) {
+            first[i] = v;
+        }
+    } else {
+        unchecked_fill_pattern(reinterpret_cast<unsigned char *>(first),
+                               reinterpret_cast<const unsigned char *>(&v),
+                               sizeof(Tp), count);
     }
-    return first + n;
+    return first + count;
 }
 
 template <class OutputIter, class Size, class T>
+EASYSTL_CONSTEXPR20
 OutputIter fill_n(OutputIter first, Size n, const T &value) {
-    return unchecked_fill_n(first, n, value);
+    return easystl::niter_wrap(
+        first, unchecked_fill_n(easystl::niter_base(first), n, value));
 }
 
 /*
@@ -338,6 +649,7 @@ OutputIter fill_n(OutputIter first, Size n, const T &value) {
  * 为 [first, last) 区间内的元素填充值
  * */
 template <class ForwardIter, class T>
+EASYSTL_CONSTEXPR20
 void fill_cat(ForwardIter first, ForwardIter last, const T &value,
               forward_iterator_tag) {
     for (; first != last; ++first) {
@@ -346,14 +658,17 @@ void fill_cat(ForwardIter first, ForwardIter last, const T &value,
 }
 
 template <class RandomIter, class T>
+EASYSTL_CONSTEXPR20
 void fill_cat(RandomIter first, RandomIter last, const T &value,
               random_access_iterator_tag) {
     fill_n(first, last - first, value);
 }
 
 template <class ForwardIter, class T>
+EASYSTL_CONSTEXPR20
 void fill(ForwardIter first, ForwardIter last, const T &value) {
-    fill_cat(first, last, value, iterator_category(first));
+    fill_cat(easystl::niter_base(first), easystl::niter_base(last), value,
+             iterator_category(first));
 }
 
 /*
@@ -365,8 +680,9 @@ void fill(ForwardIter first, ForwardIter last, const T &value) {
  * (4)如果同时到达 last1 和 last2 返回 false
  * */
 template <class InputIter1, class InputIter2>
-bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
-                             InputIter2 first2, InputIter2 last2) {
+EASYSTL_CONSTEXPR20
+bool unchecked_lexicographical_compare(InputIter1 first1, InputIter1 last1,
+                                       InputIter2 first2, InputIter2 last2) {
     for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
         if (*first1 < *first2)
             return true;
@@ -378,6 +694,7 @@ bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compred>
+EASYSTL_CONSTEXPR20
 bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
                              InputIter2 first2, InputIter2 last2,
                              Compred comp) {
@@ -390,11 +707,48 @@ bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
     return first1 == last1 && first2 != last2;
 }
 
+// 为整数类型提供特化版本：先按字节找到第一个不同的元素，再比较这一个元素，
+// 因此对有符号数和多字节的整数同样正确
+template <class Tp, class Up>
+EASYSTL_CONSTEXPR20 typename std::enable_if<
+    std::is_same<typename std::remove_const<Tp>::type,
+                 typename std::remove_const<Up>::type>::value &&
+        std::is_integral<typename std::remove_const<Tp>::type>::value,
+    bool>::type
+unchecked_lexicographical_compare(Tp *first1, Tp *last1, Up *first2,
+                                  Up *last2) {
+    const auto len1 = static_cast<size_t>(last1 - first1);
+    const auto len2 = static_cast<size_t>(last2 - first2);
+    const auto n = len1 < len2 ? len1 : len2;
+    size_t i = 0;
+    if (easystl::is_constant_evaluated()) {
+        while (i < n && first1[i] == first2[i]) {
+            ++i;
+        }
+    } else {
+        i = unchecked_mismatch_bytes(
+                reinterpret_cast<const unsigned char *>(first1),
+                reinterpret_cast<const unsigned char *>(first2),
+                n * sizeof(Tp)) /
+            sizeof(Tp);
+    }
+    return i < n ? first1[i] < first2[i] : len1 < len2;
+}
+
 // 针对 const unsigned char* 的特化版本
-bool lexicographical_compare(const unsigned char *first1,
-                             const unsigned char *last1,
-                             const unsigned char *first2,
-                             const unsigned char *last2) {
+EASYSTL_CONSTEXPR20
+inline bool unchecked_lexicographical_compare(const unsigned char *first1,
+                                              const unsigned char *last1,
+                                              const unsigned char *first2,
+                                              const unsigned char *last2) {
+    if (easystl::is_constant_evaluated()) {
+        for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+            if (*first1 != *first2) {
+                return *first1 < *first2;
+            }
+        }
+        return first1 == last1 && first2 != last2;
+    }
     const auto len1 = last1 - first1;
     const auto len2 = last2 - first2;
     // 先比较相同长度的部分
@@ -403,6 +757,16 @@ bool lexicographical_compare(const unsigned char *first1,
     return result != 0 ? result < 0 : len1 < len2;
 }
 
+// 连续存储的迭代器先还原为指针，与指针一样使用上面的特化版本
+template <class InputIter1, class InputIter2>
+EASYSTL_CONSTEXPR20
+bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
+                             InputIter2 first2, InputIter2 last2) {
+    return unchecked_lexicographical_compare(
+        easystl::niter_base(first1), easystl::niter_base(last1),
+        easystl::niter_base(first2), easystl::niter_base(last2));
+}
+
 } // namespace easystl
 
 #endif // !EASYSTL_ALGOBASE_H
@@ -5,6 +5,10 @@
 #include "type_traits.h"
 #include "utility.h"
 
+#ifdef EASYSTL_HAS_CONSTEXPR20
+#include <memory>
+#endif
+
 namespace easystl {
 struct allocator_traits_base {
     template <typename Tp, typename Up, typename = void>
@@ -141,7 +145,7 @@ template <typename Alloc> struct allocator_traits : allocator_traits_base {
     using has_construct = typename construct_helper<Tp, Args...>::type;
 
     template <typename Tp, typename... Args>
-    static std::_Require<has_construct<Tp, Args...>>
+    static EASYSTL_CONSTEXPR20 std::_Require<has_construct<Tp, Args...>>
     S_construct(Alloc &a, Tp *p, Args &&...args) noexcept(
         noexcept(a.construct(p, std::forward<Args>(args)...))) {
         a.construct(p, std::forward<Args>(args)...);
@@ -149,22 +153,29 @@ template <typename Alloc> struct allocator_traits : allocator_traits_base {
 
     // 不支持 cunstruct 操作，但是 constructible
     template <typename Tp, typename... Args>
-    static std::_Require<std::__and_<std::__not_<has_construct<Tp, Args...>>,
-                                     std::is_constructible<Tp, Args...>>>
+    static EASYSTL_CONSTEXPR20 std::_Require<
+        std::__and_<std::__not_<has_construct<Tp, Args...>>,
+                    std::is_constructible<Tp, Args...>>>
     S_construct(Alloc &, Tp *p, Args &&...args) noexcept(
         std::is_nothrow_constructible<Tp, Args...>::value) {
+#ifdef EASYSTL_HAS_CONSTEXPR20
+        if (easystl::is_constant_evaluated()) {
+            std::construct_at(p, std::forward<Args>(args)...);
+            return;
+        }
+#endif
         ::new ((void *)p) Tp(std::forward<Args>(args)...);
     }
 
     template <typename Alloc2, typename Tp>
-    static auto
+    static EASYSTL_CONSTEXPR20 auto
     S_destroy(Alloc2 &a, Tp *p,
               int) noexcept(noexcept(a.destroy(p))) -> decltype(a.destroy(p)) {
         a.destroy(p);
     }
 
     template <typename Alloc2, typename Tp>
-    static void
+    static EASYSTL_CONSTEXPR20 void
     S_destroy(Alloc2 &, Tp *p,
               ...) noexcept(std::is_nothrow_destructible<Tp>::value) {
         std::_Destroy(p);
@@ -193,33 +204,39 @@ template <typename Alloc> struct allocator_traits : allocator_traits_base {
     }
 
   public:
-    static pointer allocate(Alloc &a, size_type n) { return a.allocate(n); }
-    static pointer allocate(Alloc &a, size_type n, const_void_pointer hint) {
+    static EASYSTL_CONSTEXPR20 pointer allocate(Alloc &a, size_type n) {
+        return a.allocate(n);
+    }
+    static EASYSTL_CONSTEXPR20 pointer allocate(Alloc &a, size_type n,
+                                                const_void_pointer hint) {
         return S_allocate(a, n, hint, 0);
     }
 
-    static void deallocate(Alloc &a, pointer p, size_type n) {
+    static EASYSTL_CONSTEXPR20 void deallocate(Alloc &a, pointer p,
+                                               size_type n) {
         a.deallocate(p, n);
     }
 
     template <typename Tp, typename... Args>
-    static auto construct(Alloc &a, Tp *p, Args &&...args) noexcept(
+    static EASYSTL_CONSTEXPR20 auto
+    construct(Alloc &a, Tp *p, Args &&...args) noexcept(
         noexcept(S_construct(a, p, std::forward<Args>(args)...)))
         -> decltype(S_construct(a, p, std::forward<Args>(args)...)) {
         S_construct(a, p, std::forward<Args>(args)...);
     }
 
     template <typename Tp>
-    static void destroy(Alloc &a,
-                        Tp *p) noexcept(noexcept(S_destroy(a, p, 0))) {
+    static EASYSTL_CONSTEXPR20 void
+    destroy(Alloc &a, Tp *p) noexcept(noexcept(S_destroy(a, p, 0))) {
         S_destroy(a, p, 0);
     }
 
-    static size_type max_size(const Alloc &a) noexcept {
+    static constexpr size_type max_size(const Alloc &a) noexcept {
         return S_max_size(a, 0);
     }
 
-    static Alloc select_on_container_copy_construction(const Alloc &rhs) {
+    static constexpr Alloc
+    select_on_container_copy_construction(const Alloc &rhs) {
         return S_select(rhs, 0);
     }
 };
@@ -266,38 +283,40 @@ template <typename Tp> struct allocator_traits<allocator<Tp>> {
     template <typename Up>
     using rebind_traits = allocator_traits<allocator<Up>>;
 
-    inline static pointer allocate(allocator_type &a, size_type n) {
+    EASYSTL_CONSTEXPR20 static pointer allocate(allocator_type &a,
+                                                size_type n) {
         return a.allocate(n);
     }
 
-    inline static pointer allocate(allocator_type &a, size_type n,
-                                   const_void_pointer hint) {
+    EASYSTL_CONSTEXPR20 static pointer
+    allocate(allocator_type &a, size_type n, const_void_pointer hint) {
         return a.allocate(n, hint);
     };
 
-    inline static void deallocate(allocator_type &a, pointer p, size_type n) {
+    EASYSTL_CONSTEXPR20 static void deallocate(allocator_type &a, pointer p,
+                                               size_type n) {
         a.deallocate(p, n);
     }
 
     template <typename Up, typename... Args>
-    inline static void
+    EASYSTL_CONSTEXPR20 static void
     construct(allocator_type &a, Up *p, Args &&...args) noexcept(
         std::is_nothrow_constructible<Up, Args...>::value) {
         a.construct(p, std::forward<Args>(args)...);
     }
 
     template <typename Up>
-    inline static void
+    EASYSTL_CONSTEXPR20 static void
     destroy(allocator_type &a,
             Up *p) noexcept(std::is_nothrow_destructible<Up>::value) {
         a.destroy(p);
     }
 
-    inline static size_type max_size(const allocator_type &a) noexcept {
+    constexpr static size_type max_size(const allocator_type &a) noexcept {
         return a.max_size();
     }
 
-    inline static allocator_type
+    constexpr static allocator_type
     select_on_container_copy_construction(const allocator_type &rhs) {
         return rhs;
     }
@@ -375,10 +394,10 @@ template <> struct allocator_traits<allocator<void>> {
     }
 };
 
-template <typename T> T *to_address(T *p) noexcept { return p; }
+template <typename T> constexpr T *to_address(T *p) noexcept { return p; }
 
 template <typename Ptr>
-auto to_address(const Ptr &p) noexcept -> decltype(p.operator->()) {
+constexpr auto to_address(const Ptr &p) noexcept -> decltype(p.operator->()) {
     return p.operator->();
 }
 
@@ -414,7 +433,8 @@ struct alloc_traits : easystl::allocator_traits<Alloc> {
   public:
     // overload construct for non-standard pointer types
     template <typename Ptr, typename... Args>
-    static typename std::enable_if<is_custom_pointer<Ptr>::value>::value
+    static EASYSTL_CONSTEXPR20
+    typename std::enable_if<is_custom_pointer<Ptr>::value>::value
     construct(Alloc &a, Ptr p, Args &&...args) noexcept(
         noexcept(base_type::construct(a, easystl::to_address(p),
                                       easystl::forward<Args>(args)...))) {
@@ -424,7 +444,8 @@ struct alloc_traits : easystl::allocator_traits<Alloc> {
 
     // overload destroy for non-standard pointer types
     template <typename Ptr>
-    static typename std::enable_if<is_custom_pointer<Ptr>::value>::value
+    static EASYSTL_CONSTEXPR20
+    typename std::enable_if<is_custom_pointer<Ptr>::value>::value
     destroy(Alloc &a, Ptr p) noexcept(
         noexcept(base_type::destroy(a, easystl::to_address(p)))) {
         base_type::destroy(a, easystl::to_address(p));
@@ -434,7 +455,9 @@ struct alloc_traits : easystl::allocator_traits<Alloc> {
         return base_type::select_on_container_copy_construction(a);
     }
 
-    static void S_on_swap(Alloc &a, Alloc &b) { std::__alloc_on_swap(a, b); }
+    static EASYSTL_CONSTEXPR20 void S_on_swap(Alloc &a, Alloc &b) {
+        std::__alloc_on_swap(a, b);
+    }
 
     static constexpr bool S_propagate_on_copy_assign() {
         return base_type::propagate_on_container_copy_assignment::value;
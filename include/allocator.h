@@ -1,12 +1,17 @@
 #ifndef EASYSTL_ALLOCATOR_H
 #define EASYSTL_ALLOCATOR_H
 
+#include "type_traits.h"
 #include "utility.h"
 #include <cstddef>
 #include <memory.h>
 #include <stdexcept>
 #include <type_traits>
 
+#ifdef EASYSTL_HAS_CONSTEXPR20
+#include <memory>
+#endif
+
 namespace easystl {
 template <typename Tp> class allocator_base {
 
@@ -26,20 +31,27 @@ template <typename Tp> class allocator_base {
 
     typedef std::true_type propagate_on_container_move_assignment;
 
-    inline allocator_base() noexcept {}
-    inline allocator_base(const allocator_base &) noexcept {}
+    constexpr allocator_base() noexcept {}
+    constexpr allocator_base(const allocator_base &) noexcept {}
     template <typename Tp1>
-    allocator_base(const allocator_base<Tp1> &) noexcept {}
+    constexpr allocator_base(const allocator_base<Tp1> &) noexcept {}
     allocator_base &operator=(const allocator_base &) = default;
-    ~allocator_base() noexcept {}
+    EASYSTL_CONSTEXPR20 ~allocator_base() noexcept {}
 
     pointer address(reference x) const noexcept { return std::__addressof(x); }
     const_pointer address(const_reference x) const noexcept {
         return std::__addressof(x);
     }
 
-    Tp *allocate(size_type n, const void * = static_cast<const void *>(0)) {
+    EASYSTL_CONSTEXPR20 Tp *
+    allocate(size_type n, const void * = static_cast<const void *>(0)) {
         static_assert(sizeof(Tp) != 0, "cannot allocate incomplete types");
+#ifdef EASYSTL_HAS_CONSTEXPR20
+        // 常量求值中只能使用 std::allocator 申请内存，且必须在求值结束前释放
+        if (easystl::is_constant_evaluated()) {
+            return std::allocator<Tp>().allocate(n);
+        }
+#endif
 
         if (n > this->M_max_size()) {
             if (n > (std::size_t(-1) / sizeof(Tp))) {
@@ -51,23 +63,36 @@ template <typename Tp> class allocator_base {
         return static_cast<Tp *>(::operator new(n * sizeof(Tp)));
     }
 
-    void deallocate(Tp *p, size_type) {
+    EASYSTL_CONSTEXPR20 void deallocate(Tp *p, size_type n) {
         if (p == nullptr) {
             return;
         }
+#ifdef EASYSTL_HAS_CONSTEXPR20
+        if (easystl::is_constant_evaluated()) {
+            std::allocator<Tp>().deallocate(p, n);
+            return;
+        }
+#endif
+        (void)n;
         ::operator delete(p);
     }
 
-    inline size_type max_size() const noexcept { return M_max_size(); }
+    constexpr size_type max_size() const noexcept { return M_max_size(); }
 
     template <class Up, class... Args>
-    void construct(Up *p, Args &&...args) noexcept(
+    EASYSTL_CONSTEXPR20 void construct(Up *p, Args &&...args) noexcept(
         std::is_nothrow_constructible<Up, Args...>::value) {
+#ifdef EASYSTL_HAS_CONSTEXPR20
+        if (easystl::is_constant_evaluated()) {
+            std::construct_at(p, easystl::forward<Args>(args)...);
+            return;
+        }
+#endif
         ::new ((void *)p) Up(easystl::forward<Args>(args)...);
     }
 
     template <typename Up>
-    inline void
+    EASYSTL_CONSTEXPR20 void
     destroy(Up *p) noexcept(std::is_nothrow_destructible<Up>::value) {
         p->~Up();
     }
@@ -84,7 +109,7 @@ template <typename Tp> class allocator_base {
     }
 
   private:
-    size_type M_max_size() const noexcept {
+    constexpr size_type M_max_size() const noexcept {
 #if __PTRDIFF_MAX__ < __SIZE_MAX__
         return std::size_t(__PTRDIFF_MAX__) / sizeof(Tp);
 #else
@@ -117,13 +142,14 @@ template <class Tp> class allocator : public allocator_base<Tp> {
         "std::allocator_traits::is_always_equal") = std::true_type;
 
   public:
-    inline allocator() noexcept {}
-    allocator(const allocator &a) noexcept : allocator_base<Tp>(a) {}
+    constexpr allocator() noexcept {}
+    constexpr allocator(const allocator &a) noexcept : allocator_base<Tp>(a) {}
 
     allocator &operator=(const allocator &) = default;
 
-    template <typename Tp1> allocator(const allocator<Tp1> &) noexcept {}
-    inline ~allocator() noexcept {}
+    template <typename Tp1>
+    constexpr allocator(const allocator<Tp1> &) noexcept {}
+    EASYSTL_CONSTEXPR20 ~allocator() noexcept {}
 
     friend inline bool operator==(const allocator &,
                                   const allocator &) noexcept {
@@ -4,8 +4,13 @@
 #include "algobase.h"
 #include "alloc_traits.h"
 #include "char_traits.h"
+#include "charconv.h"
+#include "functional.h"
 #include "iterator.h"
+#include "string_view.h"
 #include "utility.h"
+#include <climits>
+#include <istream>
 #include <limits>
 
 namespace easystl {
@@ -43,7 +48,8 @@ struct basic_string {
 
     static constexpr size_type npos = static_cast<size_type>(-1);
 
-    static_assert(std::is_pod<CharType>::value,
+    static_assert(std::is_trivial<CharType>::value &&
+                      std::is_standard_layout<CharType>::value,
                   "Character type of basic_string must be a POD");
 
   private:
@@ -53,15 +59,18 @@ struct basic_string {
      *  @param  n  需要分配的内存的大小
      *  @return  指向新分配的内存的指针
      */
+    EASYSTL_CONSTEXPR20
     static pointer S_allocate(char_alloc_type &a, size_type n) {
         pointer p = alloc_traits::allocate(a, n);
         return p;
     }
 
     struct alloc_hider : allocator_type {
+        EASYSTL_CONSTEXPR20
         alloc_hider(pointer data, const Allocator &alloc)
             : allocator_type(alloc), M_ptr(data) {}
 
+        EASYSTL_CONSTEXPR20
         alloc_hider(pointer data, Allocator &&alloc = Allocator())
             : allocator_type(easystl::move(alloc)), M_ptr(data) {}
 
@@ -85,11 +94,13 @@ struct basic_string {
      *  @brief  更新数据指针
      *  @param  ptr  新数据指针
      */
+    EASYSTL_CONSTEXPR20
     void M_data(pointer ptr) { M_dataplus.M_ptr = ptr; }
 
     /**
      *  @brief  获取数据指针
      */
+    EASYSTL_CONSTEXPR20
     pointer M_data() const { return M_dataplus.M_ptr; }
 
     /**
@@ -97,11 +108,13 @@ struct basic_string {
      *
      *  @param len 新的长度
      */
+    EASYSTL_CONSTEXPR20
     void M_length(size_type len) { M_string_length = len; }
 
     /**
      *  @brief 获取小字符串的数据指针
      */
+    EASYSTL_CONSTEXPR20
     pointer M_local_data() {
         return pointer(M_local_buf);
         // return std::pointer_traits<const_pointer>::pointer_to(*local_buf);
@@ -110,6 +123,7 @@ struct basic_string {
     /**
      *  @brief 获取常量形式的小字符串数据指针
      */
+    EASYSTL_CONSTEXPR20
     const_pointer M_local_data() const {
         return const_pointer(M_local_buf);
         // return std::pointer_traits<const_pointer>::pointer_to(*local_buf);
@@ -119,6 +133,7 @@ struct basic_string {
      *  @brief  更新容量
      *  @param  cap  新容量
      */
+    EASYSTL_CONSTEXPR20
     void M_capacity(size_type cap) { M_allocated_capacity = cap; }
 
     /**
@@ -126,6 +141,7 @@ struct basic_string {
      *
      *  @param len 新长度
      */
+    EASYSTL_CONSTEXPR20
     void M_set_length(size_type n) {
         M_length(n);
         traits_type::assign(M_data()[n], CharType());
@@ -135,6 +151,7 @@ struct basic_string {
      *  @brief  判断当前字符串是否为小字符串
      *  @return  bool
      */
+    EASYSTL_CONSTEXPR20
     bool M_is_local() const { return M_data() == M_local_data(); }
 
     /**
@@ -148,11 +165,13 @@ struct basic_string {
      *  那么 @a capacity 将被置为两倍的 @a old_capacity，但不会大于最大长度。
      *  最终分配的 容量将是 @a capacity + 1（存放空字符）
      */
+    EASYSTL_CONSTEXPR20
     pointer M_create(size_type &, size_type);
 
     /**
      *  @brief  释放已分配的内存
      */
+    EASYSTL_CONSTEXPR20
     void M_dispose() {
         if (!M_is_local()) {
             M_destroy(M_allocated_capacity);
@@ -162,31 +181,48 @@ struct basic_string {
     /**
      *  @brief  释放已分配的内存
      */
+    EASYSTL_CONSTEXPR20
     void M_destroy(size_type size) noexcept {
         alloc_traits::deallocate(M_get_allocator(), M_data(), size + 1);
     }
 
     template <typename InputIter>
+    EASYSTL_CONSTEXPR20
     void M_construct(InputIter first, InputIter end,
                      easystl::input_iterator_tag);
 
     template <typename ForwardIter>
+    EASYSTL_CONSTEXPR20
     void M_construct(ForwardIter first, ForwardIter end,
                      easystl::forward_iterator_tag);
 
+    EASYSTL_CONSTEXPR20
     void M_construct(size_type req, CharType c);
 
+    EASYSTL_CONSTEXPR20
     allocator_type &M_get_allocator() { return M_dataplus; }
 
+    EASYSTL_CONSTEXPR20
     const allocator_type &M_get_allocator() const { return M_dataplus; }
 
-    // FIX: it seems no use if lower than c++20
-    void M_init_local_buf() noexcept {}
+    // 常量求值时 union 中只有被写入过的成员才能读取，需要先激活 M_local_buf
+    EASYSTL_CONSTEXPR20
+    void M_init_local_buf() noexcept {
+        if (easystl::is_constant_evaluated()) {
+            for (size_type i = 0; i <= S_local_capacity; ++i) {
+                M_local_buf[i] = CharType();
+            }
+        }
+    }
 
     /**
      *  @brief  Get pointer of @a M_local_data.
      */
-    pointer M_use_local_data() noexcept { return M_local_data(); }
+    EASYSTL_CONSTEXPR20
+    pointer M_use_local_data() noexcept {
+        M_init_local_buf();
+        return M_local_data();
+    }
 
   private:
     /**
@@ -197,11 +233,13 @@ struct basic_string {
      *
      *  @throw  Throw std::out_of_range if @a pos is larger than size()
      */
+    EASYSTL_CONSTEXPR20
     size_type M_check(size_type pos, const char *s) const {
         THROW_OUT_OF_RANGE_IF(pos > this->size(), s);
         return pos;
     }
 
+    EASYSTL_CONSTEXPR20
     void M_check_length(size_type n1, size_type n2, const char *s) {
         THROW_LENGTH_ERROR_IF(this->max_size() - (this->size() - n1) < n2, s);
     }
@@ -212,13 +250,24 @@ struct basic_string {
      *  @param  off  偏移量
      *  @return  @a off 和 size() - pos 二者的较小值
      */
+    EASYSTL_CONSTEXPR20
     size_type M_limit(size_type pos, size_type off) const noexcept {
         const bool testoff = off < this->size() - pos;
         return testoff ? off : this->size() - pos;
     }
 
     // check pointer s and data do not overlap
+    EASYSTL_CONSTEXPR20
     bool M_disjunct(const CharType *s) const noexcept {
+        if (easystl::is_constant_evaluated()) {
+            // 常量求值中无关指针不能比较大小，逐个位置判断是否相等
+            for (size_type i = 0; i <= this->size(); ++i) {
+                if (s == M_data() + i) {
+                    return false;
+                }
+            }
+            return true;
+        }
         return (std::less<const CharType *>()(s, M_data()) ||
                 std::less<const CharType *>()(M_data() + this->size(), s));
     }
@@ -229,6 +278,7 @@ struct basic_string {
      *  @param  s  pointer to source
      *  @param  n  size of characters to copy
      */
+    EASYSTL_CONSTEXPR20
     static void S_copy(CharType *d, const CharType *s, size_type n) {
         if (n == 1)
             traits_type::assign(*d, *s);
@@ -236,6 +286,7 @@ struct basic_string {
             traits_type::copy(d, s, n);
     }
 
+    EASYSTL_CONSTEXPR20
     static void S_move(CharType *d, const CharType *s, size_type n) {
         if (n == 1)
             traits_type::assign(*d, *s);
@@ -249,6 +300,7 @@ struct basic_string {
      *  @param  n  Number of characters.
      *  @param  s  Source.
      */
+    EASYSTL_CONSTEXPR20
     static void S_assign(CharType *d, size_type n, CharType c) {
         if (n == 1)
             traits_type::assign(*d, c);
@@ -263,6 +315,7 @@ struct basic_string {
      *  @param  end  end iterator
      */
     template <typename Iter>
+    EASYSTL_CONSTEXPR20
     static void S_copy_chars(CharType *p, Iter first, Iter end) {
         for (; first != end; (void)++p, ++first) {
             traits_type::assign(*p, *first);
@@ -275,6 +328,7 @@ struct basic_string {
      *  @param  first  starting iterator
      *  @param  end  end iterator
      */
+    EASYSTL_CONSTEXPR20
     static void S_copy_chars(CharType *p, iterator first,
                              iterator end) noexcept {
         S_copy_chars(p, first.base(), end.base());
@@ -286,6 +340,7 @@ struct basic_string {
      *  @param  first  starting iterator
      *  @param  end  end iterator
      */
+    EASYSTL_CONSTEXPR20
     static void S_copy_chars(CharType *p, const_iterator first,
                              const_iterator end) noexcept {
         S_copy_chars(p, first.base(), end.base());
@@ -297,6 +352,7 @@ struct basic_string {
      *  @param  first  starting pointer
      *  @param  end  end pointer
      */
+    EASYSTL_CONSTEXPR20
     static void S_copy_chars(CharType *p, CharType *first,
                              CharType *end) noexcept {
         S_copy(p, first, end - first);
@@ -308,11 +364,13 @@ struct basic_string {
      *  @param  first  const starting pointer
      *  @param  end  const end pointer
      */
+    EASYSTL_CONSTEXPR20
     static void S_copy_chars(CharType *p, const CharType *first,
                              const CharType *end) noexcept {
         S_copy(p, first, end - first);
     }
 
+    EASYSTL_CONSTEXPR20
     static int S_compare(size_type n1, size_type n2) noexcept {
         const difference_type d = difference_type(n1 - n2);
         if (d > std::numeric_limits<int>::max()) {
@@ -324,6 +382,7 @@ struct basic_string {
         }
     }
 
+    EASYSTL_CONSTEXPR20
     void M_assign(const basic_string &);
 
     /**
@@ -333,6 +392,7 @@ struct basic_string {
      *  @param  s  插入的字符串的指针
      *  @param  len2  插入的字符的数量
      */
+    EASYSTL_CONSTEXPR20
     void M_mutate(size_type pos, size_type len1, const CharType *s,
                   size_type len2);
 
@@ -341,12 +401,14 @@ struct basic_string {
      *  @param  pos  待删除的第一个字符的索引
      *  @param  n  待删除的字符数量
      */
+    EASYSTL_CONSTEXPR20
     void M_erase(size_type pos, size_type n);
 
   public:
     /**
      *  @brief  Default constructor creates an empty string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string() noexcept(
         std::is_nothrow_default_constructible<Allocator>::value)
         : M_dataplus(M_local_data()) {
@@ -357,6 +419,7 @@ struct basic_string {
     /**
      *  @brief  Construct an empty string using allocator @a a.
      */
+    EASYSTL_CONSTEXPR20
     basic_string(const Allocator &a) noexcept : M_dataplus(M_local_data(), a) {
         M_init_local_buf();
         M_set_length(0);
@@ -366,6 +429,7 @@ struct basic_string {
      *  @brief  Construct string with copy of value of @a str.
      *  @param  str  Source string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string(const basic_string &str) : M_dataplus(M_local_data()) {
         M_construct(str.M_data(), str.M_data() + str.length(),
                     easystl::forward_iterator_tag());
@@ -377,6 +441,7 @@ struct basic_string {
      *  @param  pos  Index of first character to copy from.
      *  @param  a  Allocator to use.
      */
+    EASYSTL_CONSTEXPR20
     basic_string(const basic_string &str, size_type pos,
                  const Allocator &a = Allocator())
         : M_dataplus(M_local_data(), a) {
@@ -393,6 +458,7 @@ struct basic_string {
      *  @param  pos  Index of first character to copy from.
      *  @param  n  Number of characters to copy.
      */
+    EASYSTL_CONSTEXPR20
     basic_string(const basic_string &str, size_type pos, size_type n)
         : M_dataplus(M_local_data()) {
         const CharType *start =
@@ -409,6 +475,7 @@ struct basic_string {
      *  @param  n  Number of characters to copy.
      *  @param  a  Allocator to use.
      */
+    EASYSTL_CONSTEXPR20
     basic_string(const basic_string &str, size_type pos, size_type n,
                  const Allocator &a)
         : M_dataplus(M_local_data(), a) {
@@ -425,6 +492,7 @@ struct basic_string {
      *  @param  n  Number of characters to copy.
      *  @param  a  Allocator to use (default is default allocator).
      */
+    EASYSTL_CONSTEXPR20
     basic_string(const CharType *s, size_type n,
                  const Allocator &a = Allocator())
         : M_dataplus(M_local_data(), a) {
@@ -440,6 +508,7 @@ struct basic_string {
      *  @param  s  Source C string.
      *  @param  a  Allocator to use (default is default allocator).
      */
+    EASYSTL_CONSTEXPR20
     basic_string(const CharType *s, const Allocator &a = Allocator())
         : M_dataplus(M_local_data(), a) {
         // NB: Not required, but considered best practice.
@@ -456,6 +525,7 @@ struct basic_string {
      *  @param  c  Character to use.
      *  @param  a  Allocator to use (default is default allocator).
      */
+    EASYSTL_CONSTEXPR20
     basic_string(size_type n, CharType c, const Allocator &a = Allocator())
         : M_dataplus(M_local_data(), a) {
         M_construct(n, c);
@@ -468,6 +538,7 @@ struct basic_string {
      *  The newly-created string contains the exact contents of @a str.
      *  @a str is a valid, but unspecified string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string(basic_string &&str) noexcept
         : M_dataplus(M_local_data(), std::move(str.M_get_allocator())) {
         if (str.M_is_local()) {
@@ -488,17 +559,32 @@ struct basic_string {
      *  @param  l  std::initializer_list of characters.
      *  @param  a  Allocator to use (default is default allocator).
      */
+    EASYSTL_CONSTEXPR20
     basic_string(std::initializer_list<CharType> l,
                  const Allocator &a = Allocator())
         : M_dataplus(M_local_data(), a) {
         M_construct(l.begin(), l.end(), easystl::forward_iterator_tag());
     }
 
+    /**
+     *  @brief  复制字符串视图引用的字符
+     *  @param  sv  字符串视图
+     *  @param  a  Allocator to use (default is default allocator).
+     */
+    EASYSTL_CONSTEXPR20
+    explicit basic_string(basic_string_view<CharType, CharTraits> sv,
+                          const Allocator &a = Allocator())
+        : M_dataplus(M_local_data(), a) {
+        M_construct(sv.data(), sv.data() + sv.size(),
+                    easystl::forward_iterator_tag());
+    }
+
     /**
      *  @brief  Copy constructor with allocator.
      *  @param  str  Source string.
      *  @param  a  Allocator to use (default is default allocator).
      */
+    EASYSTL_CONSTEXPR20
     basic_string(basic_string &str, const Allocator &a)
         : M_dataplus(M_local_data(), a) {
         M_construct(str.being(), str.end(), easystl::forward_iterator_tag());
@@ -512,6 +598,7 @@ struct basic_string {
      *  The newly-created string contains the exact contents of @a str.
      *  @a str is a valid, but unspecified string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string(basic_string &&str,
                  const Allocator &a) noexcept(alloc_traits::S_always_equal())
         : M_dataplus(M_local_data(), a) {
@@ -540,18 +627,21 @@ struct basic_string {
      */
     template <typename InputIterator,
               typename = easystl::RequireInputIter<InputIterator>>
+    EASYSTL_CONSTEXPR20
     basic_string(InputIterator beg, InputIterator end,
                  const Allocator &a = Allocator())
         : M_dataplus(M_local_data(), a), M_string_length(0) {
         M_construct(beg, end, easystl::iterator_category(beg));
     }
 
+    EASYSTL_CONSTEXPR20
     ~basic_string() { M_dispose(); }
 
     /**
      *  @brief  Assign the value of @a str to this string.
      *  @param  str  Source string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &operator=(const basic_string &str) {
         return this->assign(str);
     }
@@ -560,6 +650,7 @@ struct basic_string {
      *  @brief  Copy contents of @a s into this string.
      *  @param  s  Source null-terminated string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &operator=(const CharType *s) { return this->assign(s); }
 
     /**
@@ -569,6 +660,7 @@ struct basic_string {
      *  Assigning to a character makes this string length 1 and
      *  (*this)[0] == @a c.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &operator=(CharType c) {
         this->assign(1, c);
         return *this;
@@ -639,6 +731,7 @@ struct basic_string {
      *  @brief  Set value to string constructed from initializer %list.
      *  @param  l  std::initializer_list.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &operator=(std::initializer_list<CharType> l) {
         this->assign(l.begin(), l.size());
         return *this;
@@ -649,24 +742,28 @@ struct basic_string {
      *  Returns a read/write iterator that points to the first character in
      *  the %string.
      */
+    EASYSTL_CONSTEXPR20
     iterator begin() noexcept { return iterator(M_data()); }
 
     /**
      *  Returns a read-only (constant) iterator that points to the first
      *  character in the %string.
      */
+    EASYSTL_CONSTEXPR20
     const_iterator begin() const noexcept { return const_iterator(M_data()); }
 
     /**
      *  Returns a read/write iterator that points one past the last
      *  character in the %string.
      */
+    EASYSTL_CONSTEXPR20
     iterator end() noexcept { return iterator(M_data() + this->size()); }
 
     /**
      *  Returns a read-only (constant) iterator that points one past the
      *  last character in the %string.
      */
+    EASYSTL_CONSTEXPR20
     const_iterator end() const noexcept {
         return const_iterator(M_data() + this->size());
     }
@@ -676,6 +773,7 @@ struct basic_string {
      *  character in the %string.  Iteration is done in reverse element
      *  order.
      */
+    EASYSTL_CONSTEXPR20
     reverse_iterator rbegin() noexcept { return reverse_iterator(this->end()); }
 
     /**
@@ -683,6 +781,7 @@ struct basic_string {
      *  to the last character in the %string.  Iteration is done in
      *  reverse element order.
      */
+    EASYSTL_CONSTEXPR20
     const_reverse_iterator rbegin() const noexcept {
         return const_reverse_iterator(this->end());
     }
@@ -692,6 +791,7 @@ struct basic_string {
      *  first character in the %string.  Iteration is done in reverse
      *  element order.
      */
+    EASYSTL_CONSTEXPR20
     reverse_iterator rend() noexcept { return reverse_iterator(this->begin()); }
 
     /**
@@ -699,6 +799,7 @@ struct basic_string {
      *  to one before the first character in the %string.  Iteration
      *  is done in reverse element order.
      */
+    EASYSTL_CONSTEXPR20
     const_reverse_iterator rend() const noexcept {
         return const_reverse_iterator(this->begin());
     }
@@ -707,16 +808,18 @@ struct basic_string {
      *  Returns a read-only (constant) iterator that points to the first
      *  character in the %string.
      */
+    EASYSTL_CONSTEXPR20
     const_iterator cbegin() const noexcept {
-        return const_iterator(this->_M_data());
+        return const_iterator(this->M_data());
     }
 
     /**
      *  Returns a read-only (constant) iterator that points one past the
      *  last character in the %string.
      */
+    EASYSTL_CONSTEXPR20
     const_iterator cend() const noexcept {
-        return const_iterator(this->_M_data() + this->size());
+        return const_iterator(this->M_data() + this->size());
     }
 
     /**
@@ -724,6 +827,7 @@ struct basic_string {
      *  to the last character in the %string.  Iteration is done in
      *  reverse element order.
      */
+    EASYSTL_CONSTEXPR20
     const_reverse_iterator crbegin() const noexcept {
         return const_reverse_iterator(this->end());
     }
@@ -733,6 +837,7 @@ struct basic_string {
      *  to one before the first character in the %string.  Iteration
      *  is done in reverse element order.
      */
+    EASYSTL_CONSTEXPR20
     const_reverse_iterator crend() const noexcept {
         return const_reverse_iterator(this->begin());
     }
@@ -742,14 +847,17 @@ struct basic_string {
     /*  Returns the number of characters in the string, not including any
      *  null-termination.
      */
+    EASYSTL_CONSTEXPR20
     size_type size() const noexcept { return M_string_length; }
 
     /*  Returns the number of characters in the string, not including any
      *  null-termination.
      */
+    EASYSTL_CONSTEXPR20
     size_type length() const noexcept { return M_string_length; }
 
     ///  Returns the size() of the largest possible %string.
+    EASYSTL_CONSTEXPR20
     size_type max_size() const noexcept {
         return (alloc_traits::max_size(M_get_allocator()) - 1) / 2;
     }
@@ -764,6 +872,7 @@ struct basic_string {
      *  %string's current size the %string is truncated, otherwise
      *  the %string is extended and new elements are %set to @a __c.
      */
+    EASYSTL_CONSTEXPR20
     void resize(size_type n, CharType c);
 
     /**
@@ -776,14 +885,35 @@ struct basic_string {
      *  are default-constructed.  For basic types such as char, this means
      *  setting them to 0.
      */
+    EASYSTL_CONSTEXPR20
     void resize(size_type n) { this->resize(n, CharType()); }
 
+    /**
+     *  @brief  扩展容量后由 @a op 直接写入缓冲区，再设置字符串长度
+     *  @param  n  写入的字符数量的上限
+     *  @param  op  可调用对象，形如 size_type op(pointer p, size_type n)，
+     *              返回实际写入的长度，该长度不能超过 @a n
+     *
+     *  [0, size()) 的原有内容保持不变，[size(), n) 未初始化。与先 resize 再
+     *  写入相比，省去了一次填充。
+     */
+    template <typename Operation>
+    EASYSTL_CONSTEXPR20
+    void resize_and_overwrite(size_type n, Operation op) {
+        this->reserve(n);
+        const size_type len = op(M_data(), n);
+        EASYSTL_DEBUG(len <= n);
+        this->M_set_length(len);
+    }
+
+    EASYSTL_CONSTEXPR20
     void shrink_to_fit() noexcept { this->reserve(); }
 
     /**
      *  Returns the total number of characters that the %string can hold
      *  before needing to allocate more memory.
      */
+    EASYSTL_CONSTEXPR20
     size_type capacity() const noexcept {
         return M_is_local() ? size_type(S_local_capacity)
                             : M_allocated_capacity;
@@ -806,17 +936,20 @@ struct basic_string {
      *  prevent a possible reallocation of memory and copying of %string
      *  data.
      */
+    EASYSTL_CONSTEXPR20
     void reserve(size_type res_arg);
 
     /**
      *  Erases the string, making it empty.
      */
+    EASYSTL_CONSTEXPR20
     void clear() noexcept { M_set_length(0); }
 
     /**
      *  Returns true if the %string is empty.  Equivalent to
      *  <code>*this == ""</code>.
      */
+    EASYSTL_CONSTEXPR20
     bool empty() const noexcept { return this->size() == 0; }
 
     // Element access:
@@ -830,6 +963,7 @@ struct basic_string {
      *  out_of_range lookups are not defined. (For checked lookups
      *  see at().)
      */
+    EASYSTL_CONSTEXPR20
     const_reference operator[](size_type pos) const noexcept {
         EASYSTL_DEBUG(pos <= size());
         return M_data()[pos];
@@ -845,6 +979,7 @@ struct basic_string {
      *  out_of_range lookups are not defined. (For checked lookups
      *  see at().)
      */
+    EASYSTL_CONSTEXPR20
     reference operator[](size_type pos) {
         // Allow pos == size() both in C++98 mode, as v3 extension,
         // and in C++11 mode.
@@ -862,10 +997,12 @@ struct basic_string {
      *  first checked that it is in the range of the string.  The function
      *  throws out_of_range if the check fails.
      */
+    EASYSTL_CONSTEXPR20
     const_reference at(size_type n) const {
         THROW_OUT_OF_RANGE_IF(n >= this->size(), "basic_string::at()");
         return M_data()[n];
     }
+    EASYSTL_CONSTEXPR20
     reference at(size_type n) {
         THROW_OUT_OF_RANGE_IF(n >= this->size(), "basic_string::at()");
         return M_data()[n];
@@ -875,11 +1012,13 @@ struct basic_string {
      *  Returns a read/write reference to the data at the first
      *  element of the %string.
      */
+    EASYSTL_CONSTEXPR20
     reference front() noexcept {
         EASYSTL_DEBUG(!empty());
         return operator[](0);
     }
 
+    EASYSTL_CONSTEXPR20
     const_reference front() const noexcept {
         EASYSTL_DEBUG(!empty());
         return operator[](0);
@@ -889,11 +1028,13 @@ struct basic_string {
      *  Returns a read/write reference to the data at the last
      *  element of the %string.
      */
+    EASYSTL_CONSTEXPR20
     reference back() noexcept {
         EASYSTL_DEBUG(!empty());
         return operator[](this->size() - 1);
     }
 
+    EASYSTL_CONSTEXPR20
     const_reference back() const noexcept {
         EASYSTL_DEBUG(!empty());
         return operator[](this->size() - 1);
@@ -904,6 +1045,7 @@ struct basic_string {
      *  @param  str  待插入的字符串
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &append(const basic_string &str) {
         return this->append(str.M_data(), str.size());
     }
@@ -915,6 +1057,7 @@ struct basic_string {
      *  @param  n  待插入的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &append(const basic_string &str, size_type pos,
                          size_type n = npos) {
         return this->append(str.M_data() +
@@ -928,6 +1071,7 @@ struct basic_string {
      *  @param  n  待插入的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &append(const CharType *s, size_type n) {
         M_requires_string_len(s, n);
         M_check_length(size_type(0), n, "basic_string::append");
@@ -939,6 +1083,7 @@ struct basic_string {
      *  @param  s  待插入的字符串指针
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &append(const CharType *s) {
         M_requires_string(s);
         size_type n = CharTraits::length(s);
@@ -952,10 +1097,12 @@ struct basic_string {
      *  @param  c  待追加的字符
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &append(size_type n, CharType c) {
         return M_replace_aux(this->size(), size_type(0), n, c);
     }
 
+    EASYSTL_CONSTEXPR20
     basic_string &append(std::initializer_list<CharType> l) {
         return this->append(l.begin(), l.end());
     }
@@ -968,6 +1115,7 @@ struct basic_string {
      */
     template <class InputIterator,
               typename = easystl::RequireInputIter<InputIterator>>
+    EASYSTL_CONSTEXPR20
     basic_string &append(InputIterator first, InputIterator last) {
         return this->replace(end(), end(), first, last);
     }
@@ -977,6 +1125,7 @@ struct basic_string {
      *  @param  c  待追加的字符
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     void push_back(CharType c) {
         const size_type size = this->size();
         if (size + 1 > this->capacity()) {
@@ -993,6 +1142,7 @@ struct basic_string {
      *  @param  __str  Source string to use.
      *  @return  Reference to this string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &assign(const basic_string &str) {
         if (alloc_traits::S_propagate_on_copy_assign()) {
             if (!alloc_traits::S_always_equal() && !M_is_local() &&
@@ -1029,6 +1179,7 @@ struct basic_string {
      *  This function sets this string to the exact contents of @a __str.
      *  @a __str is a valid, but unspecified string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &
     assign(basic_string &&str) noexcept(alloc_traits::S_nothrow_move()) {
         return *this = easystl::move(str);
@@ -1047,6 +1198,7 @@ struct basic_string {
      *  is larger than the number of available characters in @a
      *  __str, the remainder of @a __str is used.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &assign(const basic_string &str, size_type pos,
                          size_type n = npos) {
         return M_replace(size_type(0), this->size(),
@@ -1065,6 +1217,7 @@ struct basic_string {
      *  characters of @a __s.  If @a __n is is larger than the number of
      *  available characters in @a __s, the remainder of @a __s is used.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &assign(const CharType *s, size_type n) {
         // __glibcxx_requires_string_len(__s, __n);
         THROW_LOGIC_ERROR_IF(s == nullptr, "basic_string::assign");
@@ -1082,6 +1235,7 @@ struct basic_string {
      *  The data is copied, so there is no dependence on @a __s once the
      *  function returns.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &assign(const CharType *s) {
         // __glibcxx_requires_string(__s);
         THROW_LOGIC_ERROR_IF(s == nullptr, "basic_string::assign");
@@ -1097,6 +1251,7 @@ struct basic_string {
      *  This function sets the value of this string to @a __n copies of
      *  character @a __c.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &assign(size_type n, CharType c) {
         return M_replace_aux(size_type(0), this->size(), n, c);
     }
@@ -1110,6 +1265,7 @@ struct basic_string {
      *  Sets value of string to characters in the range [__first,__last).
      */
     template <class InputIterator, easystl::RequireInputIter<InputIterator>>
+    EASYSTL_CONSTEXPR20
     basic_string &assign(InputIterator first, InputIterator last) {
         if (std::__is_one_of<InputIterator, const_iterator, iterator,
                              const CharType *, CharType *>::value) {
@@ -1125,6 +1281,7 @@ struct basic_string {
      *  @param __l  The initializer_list of characters to assign.
      *  @return  Reference to this string.
      */
+    EASYSTL_CONSTEXPR20
     basic_string &assign(std::initializer_list<CharType> l) {
         // The initializer_list array cannot alias the characters in *this
         // so we don't need to use replace to that case.
@@ -1146,6 +1303,7 @@ struct basic_string {
      *  @param  c  插入的字符
      *  @return  此字符串的索引
      */
+    EASYSTL_CONSTEXPR20
     iterator insert(const_iterator p, size_type n, CharType c) {
         EASYSTL_DEBUG(p >= begin() && p <= end());
         const size_type pos = p - begin();
@@ -1162,6 +1320,7 @@ struct basic_string {
      */
     template <typename InputIterator,
               typename = easystl::RequireInputIter<InputIterator>>
+    EASYSTL_CONSTEXPR20
     iterator insert(const_iterator p, InputIterator first, InputIterator last) {
         EASYSTL_DEBUG(p >= begin() && p <= end());
         const size_type pos = p - begin();
@@ -1175,6 +1334,7 @@ struct basic_string {
      *  @param  l  插入的初始化列表
      *  @return  此字符串的索引
      */
+    EASYSTL_CONSTEXPR20
     iterator insert(const_iterator p, std::initializer_list<CharType> l) {
         return this->insert(p, l.begin(), l.end());
     }
@@ -1185,6 +1345,7 @@ struct basic_string {
      *  @param  str  插入的字符串
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &insert(size_type pos, const basic_string &str) {
         return this->replace(pos, size_type(0), str.M_data(), str.size());
     }
@@ -1197,6 +1358,7 @@ struct basic_string {
      *  @param  n  插入的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &insert(size_type pos1, const basic_string &str,
                          size_type pos2, size_type n = npos) {
         return this->replace(pos1, size_type(0),
@@ -1212,6 +1374,7 @@ struct basic_string {
      *  @param  n  插入的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &insert(size_type pos1, const CharType *s, size_type n) {
         return this->replace(pos1, size_type(0), s, n);
     }
@@ -1222,6 +1385,7 @@ struct basic_string {
      *  @param  s  插入的字符串
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &insert(size_type pos1, const CharType *s) {
         M_requires_string(s);
         return this->replace(pos1, size_type(0), s, traits_type::length(s));
@@ -1234,6 +1398,7 @@ struct basic_string {
      *  @param  c  插入字符
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &insert(size_type pos, size_type n, CharType c) {
         return M_replace_aux(M_check(pos, "basic_string::insert"), size_type(0),
                              n, c);
@@ -1245,6 +1410,7 @@ struct basic_string {
      *  @param  c  插入字符
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     iterator insert(const_iterator p, CharType c) {
         EASYSTL_DEBUG(p >= begin() && p <= end());
         const size_type pos = p - begin();
@@ -1258,6 +1424,7 @@ struct basic_string {
      *  @param  n  待删除的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &erase(size_type pos, size_type n = npos) {
         M_check(pos, "basic_string::erase");
         if (n == npos) {
@@ -1273,6 +1440,7 @@ struct basic_string {
      *  @param  it  待删除的字符的索引
      *  @return  指向删除后的相同位置的迭代器
      */
+    EASYSTL_CONSTEXPR20
     iterator erase(const_iterator it) {
         EASYSTL_DEBUG(it >= begin() && it < end());
         const size_type pos = it - begin();
@@ -1286,6 +1454,7 @@ struct basic_string {
      *  @param  last  范围结束位置迭代器
      *  @return  指向删除后的相同起始位置的迭代器
      */
+    EASYSTL_CONSTEXPR20
     iterator erase(const_iterator first, const_iterator last) {
         EASYSTL_DEBUG(first >= begin() && first <= last && last <= end());
         const size_type pos = first - begin();
@@ -1302,6 +1471,7 @@ struct basic_string {
      *
      *  字符串必须非空
      */
+    EASYSTL_CONSTEXPR20
     void pop_back() noexcept {
         EASYSTL_DEBUG(!empty());
         this->M_erase(size() - 1, size_type(1));
@@ -1314,6 +1484,7 @@ struct basic_string {
      *  @param  str  插入的字符串
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(size_type pos, size_type n, const basic_string &str) {
         return this->replace(pos, n, str.M_data(), str.size());
     }
@@ -1327,6 +1498,7 @@ struct basic_string {
      *  @param  n2  插入的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(size_type pos1, size_type n1, const basic_string &str,
                           size_type pos2, size_type n2 = npos) {
         return this->replace(
@@ -1342,6 +1514,7 @@ struct basic_string {
      *  @param  n2  插入的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(size_type pos, size_type n1, const CharType *s,
                           size_type n2) {
         THROW_LOGIC_ERROR_IF(s == nullptr, "basic_string::relpace");
@@ -1359,6 +1532,7 @@ struct basic_string {
      *  @param  s  C 风格字符串指针
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(size_type pos, size_type n1, const CharType *s) {
         THROW_LOGIC_ERROR_IF(s == nullptr, "basic_string::relpace");
         return this->replace(pos, n1, s, traits_type::length(s));
@@ -1372,6 +1546,7 @@ struct basic_string {
      *  @param  c  插入的字符
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(size_type pos, size_type n1, size_type n2,
                           CharType c) {
         return M_replace_aux(M_check(pos, "basic_string::replace"),
@@ -1385,6 +1560,7 @@ struct basic_string {
      *  @param  str  插入的字符串
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           const basic_string &str) {
         return this->replace(iter1, iter2, str.M_data(), str.size());
@@ -1398,6 +1574,7 @@ struct basic_string {
      *  @param  n  插入的字符的数量
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           const CharType *s, size_type n) {
         EASYSTL_DEBUG(iter1 >= begin() && iter1 <= iter2 && iter2 <= end());
@@ -1411,6 +1588,7 @@ struct basic_string {
      *  @param  s  C 风格字符串指针
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           const CharType *s) {
         return this->replace(iter1, iter2, s, traits_type::length(s));
@@ -1424,6 +1602,7 @@ struct basic_string {
      *  @param  c  插入的字符
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           size_type n, CharType c) {
         EASYSTL_DEBUG(iter1 >= begin() && iter1 <= iter2 && iter2 <= end());
@@ -1440,6 +1619,7 @@ struct basic_string {
      */
     template <typename InputIter,
               typename = easystl::RequireInputIter<InputIter>>
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           InputIter input_iter1, InputIter input_iter2) {
         EASYSTL_DEBUG(begin() <= iter1 && iter1 <= iter2 && iter2 <= end());
@@ -1448,18 +1628,21 @@ struct basic_string {
     }
 
     // 对常规指针与迭代器的特化。
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           CharType *p1, CharType *p2) {
         EASYSTL_DEBUG(begin() <= iter1 && iter1 <= iter2 && iter2 <= end());
         return this->replace(iter1 - begin(), iter2 - iter1, p1, p2 - p1);
     }
 
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           const CharType *p1, const CharType *p2) {
         EASYSTL_DEBUG(begin() <= iter1 && iter1 <= iter2 && iter2 <= end());
         return this->replace(iter1 - begin(), iter2 - iter1, p1, p2 - p1);
     }
 
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           iterator p1, iterator p2) {
         EASYSTL_DEBUG(begin() <= iter1 && iter1 <= iter2 && iter2 <= end());
@@ -1467,6 +1650,7 @@ struct basic_string {
                              p2 - p1);
     }
 
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           const_iterator p1, const_iterator p2) {
         EASYSTL_DEBUG(begin() <= iter1 && iter1 <= iter2 && iter2 <= end());
@@ -1481,19 +1665,56 @@ struct basic_string {
      *  @param  l  initializer_list
      *  @return  此字符串的引用
      */
+    EASYSTL_CONSTEXPR20
     basic_string &replace(const_iterator iter1, const_iterator iter2,
                           std::initializer_list<CharType> l) {
         return this->replace(iter1, iter2, l.begin(), l.end());
     }
 
+    /**
+     *  @brief  将所有互不重叠的 @a from 替换为 @a to
+     *  @param  from  被替换的字符串，为空时不做任何事
+     *  @param  to  替换后的字符串
+     *  @return  此字符串的引用
+     *
+     *  @a to 不长于 @a from 时原地一次完成；否则先统计匹配数量得到最终长度，
+     *  只分配一次内存，从前向后一次生成结果。
+     */
+    EASYSTL_CONSTEXPR20
+    basic_string &replace_all(basic_string_view<CharType, CharTraits> from,
+                              basic_string_view<CharType, CharTraits> to);
+
+    typedef easystl::pair<basic_string_view<CharType, CharTraits>,
+                          basic_string_view<CharType, CharTraits>>
+        replacement_type;
+
+    /**
+     *  @brief  同时进行多组替换
+     *  @param  pairs  (from, to) 数组，from 为空的项被忽略
+     *  @param  n  数组长度
+     *  @return  此字符串的引用
+     *
+     *  从左向右扫描，每个位置使用第一个匹配的 from，替换得到的字符不会再被匹
+     *  配。先统计最终长度，只分配一次内存。
+     */
+    EASYSTL_CONSTEXPR20
+    basic_string &replace_each(const replacement_type *pairs, size_type n);
+
+    EASYSTL_CONSTEXPR20
+    basic_string &replace_each(std::initializer_list<replacement_type> l) {
+        return this->replace_each(l.begin(), l.size());
+    }
+
   private:
     template <typename Integer>
+    EASYSTL_CONSTEXPR20
     basic_string &M_replace_dispatch(const_iterator iter1, const_iterator iter2,
                                      Integer n, Integer val, std::__true_type) {
         return M_replace_aux(iter1 - begin(), iter2 - iter1, n, val);
     }
 
     template <typename InputIterator>
+    EASYSTL_CONSTEXPR20
     basic_string &M_replace_dispatch(const_iterator iter1, const_iterator iter2,
                                      InputIterator input_iter1,
                                      InputIterator input_iter2,
@@ -1503,21 +1724,27 @@ struct basic_string {
         return M_replace(iter1 - begin(), n, s.M_data(), s.size());
     }
 
+    EASYSTL_CONSTEXPR20
     basic_string &M_replace(size_type pos, size_type len1, const CharType *s,
                             const size_type len2);
 
+    EASYSTL_CONSTEXPR20
     void M_replace_cold(pointer p, size_type len1, const CharType *s,
                         const size_type len2, const size_type how_much);
 
+    EASYSTL_CONSTEXPR20
     basic_string &M_replace_aux(size_type pos1, size_type n1, size_type n2,
                                 CharType c);
 
+    EASYSTL_CONSTEXPR20
     basic_string &M_append(const CharType *s, size_type n);
 
+    EASYSTL_CONSTEXPR20
     void M_requires_string_len(const CharType *s, size_type n) const {
         EASYSTL_DEBUG(s != nullptr || n == 0);
     }
 
+    EASYSTL_CONSTEXPR20
     void M_requires_string(const CharType *s) const {
         EASYSTL_DEBUG(s != nullptr);
     }
@@ -1531,18 +1758,32 @@ struct basic_string {
      *  @return  实际被复制的字符的数量
      *  @throw  std::out_of_range  如果 pos > size()
      */
+    EASYSTL_CONSTEXPR20
     size_type copy(CharType *s, size_type n, size_type pos = 0) const;
 
     /**
      *  @brief  与另一个字符串交换内容
      *  @param  s  另一个字符串
      */
+    EASYSTL_CONSTEXPR20
     void swap(basic_string &s) noexcept;
 
+    EASYSTL_CONSTEXPR20
     const CharType *c_str() const noexcept { return M_data(); }
+    EASYSTL_CONSTEXPR20
     const CharType *data() const noexcept { return M_data(); }
+
+    /**
+     *  @brief  返回引用此字符串全部字符的视图，修改字符串后视图可能失效
+     */
+    EASYSTL_CONSTEXPR20
+    operator basic_string_view<CharType, CharTraits>() const noexcept {
+        return basic_string_view<CharType, CharTraits>(M_data(), length());
+    }
+    EASYSTL_CONSTEXPR20
     CharType *data() noexcept { return M_data(); }
 
+    EASYSTL_CONSTEXPR20
     allocator_type get_allocator() const noexcept { return M_get_allocator(); }
 
     /**
@@ -1555,6 +1796,7 @@ struct basic_string {
      *  在此字符串中从 @a pos 开始查找前 @a n 个在 @a s
      * 中的字符，若找到则返回第一 个字符的索引，若找不到则返回 npos。
      */
+    EASYSTL_CONSTEXPR20
     size_type find(const CharType *s, size_type pos,
                    size_type n) const noexcept;
 
@@ -1564,6 +1806,7 @@ struct basic_string {
      *  @param  pos  查找开始位置
      *  @return  第一次出现字符串时的第一个字符的索引
      */
+    EASYSTL_CONSTEXPR20
     size_type find(const basic_string &str, size_type pos = 0) const noexcept {
         return this->find(str.data(), pos, str.length());
     }
@@ -1574,6 +1817,7 @@ struct basic_string {
      *  @param  pos  查找开始位置
      *  @return  第一次出现 C 字符串时的第一个字符的索引
      */
+    EASYSTL_CONSTEXPR20
     size_type find(const CharType *s, size_type pos = 0) const noexcept {
         M_requires_string(s);
         return this->find(s, pos, traits_type::length(s));
@@ -1585,6 +1829,7 @@ struct basic_string {
      *  @param  pos  查找开始位置
      *  @return  第一次出现字符的位置的索引
      */
+    EASYSTL_CONSTEXPR20
     size_type find(const CharType c, size_type pos = 0) const noexcept;
 
     /**
@@ -1597,6 +1842,7 @@ struct basic_string {
      *  在此字符串中从 @a pos 开始向前查找前 @a n 个在 @a s
      *  中的字符，若找到则返回第一个字符的索引，若找不到则返回 npos。
      */
+    EASYSTL_CONSTEXPR20
     size_type rfind(const CharType *s, size_type pos,
                     size_type n) const noexcept;
 
@@ -1606,6 +1852,7 @@ struct basic_string {
      *  @param  pos  查找开始位置
      *  @return  最后一次出现字符串时的第一个字符的索引
      */
+    EASYSTL_CONSTEXPR20
     size_type rfind(const basic_string &str,
                     size_type pos = npos) const noexcept {
         return this->rfind(str.M_data(), pos, str.size());
@@ -1617,6 +1864,7 @@ struct basic_string {
      *  @param  pos  查找开始位置
      *  @return  最后一次出现 C 字符串时的第一个字符的索引
      */
+    EASYSTL_CONSTEXPR20
     size_type rfind(const CharType *s, size_type pos = npos) const noexcept {
         M_requires_string(s);
         return this->rfind(s, pos, traits_type::length(s));
@@ -1628,6 +1876,7 @@ struct basic_string {
      *  @param  pos  查找开始位置
      *  @return  最后一次出现字符的索引
      */
+    EASYSTL_CONSTEXPR20
     size_type rfind(const CharType c, size_type pos = npos) const noexcept;
 
     /**
@@ -1637,20 +1886,24 @@ struct basic_string {
      *  @param  n  待查找的字符数量
      *  @return  第一次出现 C 字符串中字符的位置索引
      */
+    EASYSTL_CONSTEXPR20
     size_type find_first_of(const CharType *s, size_type pos,
                             size_type n) const noexcept;
 
+    EASYSTL_CONSTEXPR20
     size_type find_first_of(const basic_string &str,
                             size_type pos = 0) const noexcept {
         return this->find_first_of(str.data(), pos, str.length());
     }
 
+    EASYSTL_CONSTEXPR20
     size_type find_first_of(const CharType *s,
                             size_type pos = 0) const noexcept {
         M_requires_string(s);
         return this->find_first_of(s, pos, traits_type::length(s));
     }
 
+    EASYSTL_CONSTEXPR20
     size_type find_first_of(const CharType c,
                             size_type pos = 0) const noexcept {
         return this->find(c, pos);
@@ -1663,20 +1916,24 @@ struct basic_string {
      *  @param  n  待查找的字符数量
      *  @return  最后一次出现 C 字符串中字符的位置索引
      */
+    EASYSTL_CONSTEXPR20
     size_type find_last_of(const CharType *s, size_type pos,
                            size_type n) const noexcept;
 
+    EASYSTL_CONSTEXPR20
     size_type find_last_of(const basic_string &str,
                            size_type pos = 0) const noexcept {
         return this->find_last_of(str.data(), pos, str.length());
     }
 
+    EASYSTL_CONSTEXPR20
     size_type find_last_of(const CharType *s,
                            size_type pos = 0) const noexcept {
         M_requires_string(s);
         return this->find_last_of(s, pos, traits_type::length(s));
     }
 
+    EASYSTL_CONSTEXPR20
     size_type find_last_of(const CharType c, size_type pos = 0) const noexcept {
         return this->rfind(c, pos);
     }
@@ -1688,14 +1945,17 @@ struct basic_string {
      *  @param  n  待查找的字符数量
      *  @return  首个不等于给定字符序列中任何字符的字符索引
      */
+    EASYSTL_CONSTEXPR20
     size_type find_first_not_of(const CharType *s, size_type pos,
                                 size_type n) const noexcept;
 
+    EASYSTL_CONSTEXPR20
     size_type find_first_not_of(const basic_string &str,
                                 size_type pos = 0) const noexcept {
         return this->find_first_not_of(str.data(), pos, str.length());
     }
 
+    EASYSTL_CONSTEXPR20
     size_type find_first_not_of(const CharType *s,
                                 size_type pos = 0) const noexcept {
         M_requires_string(s);
@@ -1708,6 +1968,7 @@ struct basic_string {
      *  @param  pos  查找开始位置索引
      *  @return  首个不等于 @a c 的字符的索引
      */
+    EASYSTL_CONSTEXPR20
     size_type find_first_not_of(const CharType c,
                                 size_type pos = 0) const noexcept;
 
@@ -1718,22 +1979,27 @@ struct basic_string {
      *  @param  n  待查找的字符数量
      *  @return  最后一个不等于给定字符序列中任何字符的字符
      */
+    EASYSTL_CONSTEXPR20
     size_type find_last_not_of(const CharType *s, size_type pos,
                                size_type n) const noexcept;
 
+    EASYSTL_CONSTEXPR20
     size_type find_last_not_of(const basic_string &str,
                                size_type pos = npos) const noexcept {
         return this->find_last_not_of(str.data(), pos, str.size());
     }
 
+    EASYSTL_CONSTEXPR20
     size_type find_last_not_of(const CharType *s,
                                size_type pos = npos) const noexcept {
         M_requires_string(s);
         return this->find_last_not_of(s, pos, traits_type::length(s));
     }
 
+    EASYSTL_CONSTEXPR20
     size_type find_last_not_of(CharType c, size_type pos = npos) const noexcept;
 
+    EASYSTL_CONSTEXPR20
     basic_string substr(size_type pos = 0, size_type n = npos) const {
         return basic_string(*this, M_check(pos, "basic_string::substr"), n);
     }
@@ -1743,7 +2009,8 @@ struct basic_string {
      *  @param  str  待比较的字符串
      *  @return  return
      */
-    int compare(basic_string &str) const {
+    EASYSTL_CONSTEXPR20
+    int compare(const basic_string &str) const {
         const size_type tsize = this->size();
         const size_type osize = str.size();
         const size_type len = easystl::min(tsize, osize);
@@ -1760,7 +2027,8 @@ struct basic_string {
      *  @param  param  desc
      *  @return  return
      */
-    int compare(size_type pos, size_type n, basic_string &str) const {
+    EASYSTL_CONSTEXPR20
+    int compare(size_type pos, size_type n, const basic_string &str) const {
         M_check(pos, "basic_string::compare");
         n = M_limit(pos, n);
         const size_type osize = str.size();
@@ -1778,8 +2046,9 @@ struct basic_string {
      *  @param  param  desc
      *  @return  return
      */
-    int compare(size_type pos1, size_type n1, basic_string &str, size_type pos2,
-                size_type n2 = npos) const {
+    EASYSTL_CONSTEXPR20
+    int compare(size_type pos1, size_type n1, const basic_string &str,
+                size_type pos2, size_type n2 = npos) const {
         M_check(pos1, "basic_string::compare");
         str.M_check(pos2, "basic_string::compare");
         n1 = M_limit(pos1, n1);
@@ -1797,6 +2066,7 @@ struct basic_string {
      *  @param  param  desc
      *  @return  return
      */
+    EASYSTL_CONSTEXPR20
     int compare(const CharType *s) const noexcept {
         M_requires_string(s);
         const size_type tsize = this->size();
@@ -1814,6 +2084,7 @@ struct basic_string {
      *  @param  param  desc
      *  @return  return
      */
+    EASYSTL_CONSTEXPR20
     int compare(size_type pos, size_type n, const CharType *s) const {
         M_requires_string(s);
         M_check(pos, "basic_string::compare");
@@ -1832,6 +2103,7 @@ struct basic_string {
      *  @param  param  desc
      *  @return  return
      */
+    EASYSTL_CONSTEXPR20
     int compare(size_type pos, size_type n1, const CharType *s,
                 size_type n2) const {
         M_requires_string_len(s, n2);
@@ -1847,6 +2119,7 @@ struct basic_string {
 };
 
 template <typename Str>
+EASYSTL_CONSTEXPR20
 inline Str
 str_concat(typename Str::value_type const *lhs, typename Str::size_type lhs_len,
            typename Str::value_type const *rhs, typename Str::size_type rhs_len,
@@ -1868,6 +2141,7 @@ str_concat(typename Str::value_type const *lhs, typename Str::size_type lhs_len,
  *  @return  拼接后的新字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) {
@@ -1883,6 +2157,7 @@ operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @return  拼接后的新字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(const CharType *lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) {
@@ -1897,6 +2172,7 @@ operator+(const CharType *lhs,
  *  @return  拼接后的新字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(CharType lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) {
@@ -1912,6 +2188,7 @@ operator+(CharType lhs,
  *  @return  拼接后的新字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
           const CharType *rhs) {
@@ -1930,6 +2207,7 @@ operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @return  拼接后的新字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
           const CharType rhs) {
@@ -1941,6 +2219,7 @@ operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(basic_string<CharType, CharTraits, Allocator> &&lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) {
@@ -1948,6 +2227,7 @@ operator+(basic_string<CharType, CharTraits, Allocator> &&lhs,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
           basic_string<CharType, CharTraits, Allocator> &&rhs) {
@@ -1955,6 +2235,7 @@ operator+(const basic_string<CharType, CharTraits, Allocator> &lhs,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(basic_string<CharType, CharTraits, Allocator> &&lhs,
           basic_string<CharType, CharTraits, Allocator> &&rhs) {
@@ -1975,6 +2256,7 @@ operator+(basic_string<CharType, CharTraits, Allocator> &&lhs,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(const CharType *lhs,
           basic_string<CharType, CharTraits, Allocator> &&rhs) {
@@ -1982,12 +2264,14 @@ operator+(const CharType *lhs,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(CharType lhs, basic_string<CharType, CharTraits, Allocator> &&rhs) {
     return easystl::move(rhs.insert(0, 1, lhs));
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(basic_string<CharType, CharTraits, Allocator> &&lhs,
           const CharType *rhs) {
@@ -1995,6 +2279,7 @@ operator+(basic_string<CharType, CharTraits, Allocator> &&lhs,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline basic_string<CharType, CharTraits, Allocator>
 operator+(basic_string<CharType, CharTraits, Allocator> &&lhs, CharType rhs) {
     return easystl::move(lhs.append(1, rhs));
@@ -2006,6 +2291,7 @@ operator+(basic_string<CharType, CharTraits, Allocator> &&lhs, CharType rhs) {
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator==(const basic_string<CharType, CharTraits, Allocator> &lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2019,6 +2305,7 @@ operator==(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  C 字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool operator==(const basic_string<CharType, CharTraits, Allocator> &lhs,
                        const CharType *rhs) noexcept {
     return lhs.size() == CharTraits::length(rhs) &&
@@ -2031,6 +2318,7 @@ inline bool operator==(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator==(const CharType *lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2043,6 +2331,7 @@ operator==(const CharType *lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator!=(const basic_string<CharType, CharTraits, Allocator> &lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2055,6 +2344,7 @@ operator!=(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator!=(const CharType *lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2067,6 +2357,7 @@ operator!=(const CharType *lhs,
  *  @param  rhs  C 字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool operator!=(const basic_string<CharType, CharTraits, Allocator> &lhs,
                        const CharType *rhs) noexcept {
     return !(lhs == rhs);
@@ -2078,6 +2369,7 @@ inline bool operator!=(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator<(const basic_string<CharType, CharTraits, Allocator> &lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2090,6 +2382,7 @@ operator<(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  C 字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool operator<(const basic_string<CharType, CharTraits, Allocator> &lhs,
                       const CharType *rhs) noexcept {
     return lhs.compare(rhs) < 0;
@@ -2101,6 +2394,7 @@ inline bool operator<(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator<(const CharType *lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2113,6 +2407,7 @@ operator<(const CharType *lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>(const basic_string<CharType, CharTraits, Allocator> &lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2125,6 +2420,7 @@ operator>(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  C 字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool operator>(const basic_string<CharType, CharTraits, Allocator> &lhs,
                       const CharType *rhs) noexcept {
     return lhs.compare(rhs) > 0;
@@ -2136,6 +2432,7 @@ inline bool operator>(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>(const CharType *lhs,
           const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2148,6 +2445,7 @@ operator>(const CharType *lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator<=(const basic_string<CharType, CharTraits, Allocator> &lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2160,6 +2458,7 @@ operator<=(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  C 字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool operator<=(const basic_string<CharType, CharTraits, Allocator> &lhs,
                        const CharType *rhs) noexcept {
     return lhs.compare(rhs) <= 0;
@@ -2171,6 +2470,7 @@ inline bool operator<=(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator<=(const CharType *lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2183,6 +2483,7 @@ operator<=(const CharType *lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>=(const basic_string<CharType, CharTraits, Allocator> &lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2195,6 +2496,7 @@ operator>=(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  C 字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool operator>=(const basic_string<CharType, CharTraits, Allocator> &lhs,
                        const CharType *rhs) noexcept {
     return lhs.compare(rhs) >= 0;
@@ -2206,6 +2508,7 @@ inline bool operator>=(const basic_string<CharType, CharTraits, Allocator> &lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>=(const CharType *lhs,
            const basic_string<CharType, CharTraits, Allocator> &rhs) noexcept {
@@ -2218,13 +2521,122 @@ operator>=(const CharType *lhs,
  *  @param  rhs  字符串
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 inline void swap(const basic_string<CharType, CharTraits, Allocator> &lhs,
                  const basic_string<CharType, CharTraits, Allocator>
                      &rhs) noexcept(noexcept(lhs.swap(rhs))) {
     lhs.swap(rhs);
 }
 
-// TODO: operator>>
+/**
+ *  @brief  访问 basic_streambuf 的读取区
+ *
+ *  gptr、egptr、gbump 是受保护的成员，借助派生类取得它们的成员指针后，可以
+ *  作用于任意 basic_streambuf 对象，从而直接扫描已缓冲的字符。
+ */
+template <typename CharType>
+struct streambuf_get_area : std::basic_streambuf<CharType> {
+    typedef std::basic_streambuf<CharType> streambuf_type;
+
+    static CharType *begin(streambuf_type *sb) {
+        return (sb->*&streambuf_get_area::gptr)();
+    }
+    static CharType *end(streambuf_type *sb) {
+        return (sb->*&streambuf_get_area::egptr)();
+    }
+    static void bump(streambuf_type *sb, int n) {
+        (sb->*&streambuf_get_area::gbump)(n);
+    }
+};
+
+/**
+ *  @brief  流提取过程中发生异常时置 badbit，流要求时重新抛出该异常
+ */
+template <typename CharType>
+inline void stream_extract_failed(std::basic_istream<CharType> &is) {
+    try {
+        is.setstate(std::ios_base::badbit);
+    } catch (std::ios_base::failure &) {
+    }
+    if (is.exceptions() & std::ios_base::badbit) {
+        throw;
+    }
+}
+
+/**
+ *  @brief  从流中读取一个以空白分隔的单词
+ *  @param  is  输入流
+ *  @param  str  保存结果的字符串，原有内容被清除，容量保留
+ *  @return  输入流的引用
+ *
+ *  跳过前导空白后读取字符，直到遇到空白、文件尾或读满 is.width() 个字符。
+ *  已缓冲的字符整块交给 ctype::scan_is 查找空白，再一次性追加到 @a str。
+ */
+template <typename CharType, typename CharTraits, typename Allocator>
+std::basic_istream<CharType> &
+operator>>(std::basic_istream<CharType> &is,
+           basic_string<CharType, CharTraits, Allocator> &str) {
+    typedef std::basic_istream<CharType> istream_type;
+    typedef typename istream_type::traits_type stream_traits;
+    typedef typename istream_type::int_type int_type;
+    typedef streambuf_get_area<CharType> get_area;
+    typedef typename basic_string<CharType, CharTraits, Allocator>::size_type
+        size_type;
+
+    size_type extracted = 0;
+    std::ios_base::iostate err = std::ios_base::goodbit;
+    typename istream_type::sentry cerb(is, false);
+    if (cerb) {
+        try {
+            str.clear();
+            const std::streamsize w = is.width();
+            const size_type n = w > 0 ? static_cast<size_type>(w)
+                                      : str.max_size();
+            const std::ctype<CharType> &ct =
+                std::use_facet<std::ctype<CharType>>(is.getloc());
+            const int_type eof = stream_traits::eof();
+            std::basic_streambuf<CharType> *sb = is.rdbuf();
+            int_type c = sb->sgetc();
+
+            while (extracted < n && !stream_traits::eq_int_type(c, eof) &&
+                   !ct.is(std::ctype_base::space,
+                          stream_traits::to_char_type(c))) {
+                std::streamsize size = get_area::end(sb) - get_area::begin(sb);
+                if (static_cast<size_type>(size) > n - extracted) {
+                    size = static_cast<std::streamsize>(n - extracted);
+                }
+                if (size > 1) {
+                    const CharType *p = get_area::begin(sb);
+                    const CharType *e =
+                        ct.scan_is(std::ctype_base::space, p,
+                                   p + (size < INT_MAX ? size : INT_MAX));
+                    size = e - p;
+                    str.append(p, size);
+                    get_area::bump(sb, static_cast<int>(size));
+                    extracted += size;
+                    c = sb->sgetc();
+                } else {
+                    str.push_back(stream_traits::to_char_type(c));
+                    ++extracted;
+                    c = sb->snextc();
+                }
+            }
+            if (stream_traits::eq_int_type(c, eof)) {
+                err |= std::ios_base::eofbit;
+            }
+            is.width(0);
+        } catch (...) {
+            stream_extract_failed(is);
+        }
+    }
+    if (!extracted) {
+        err |= std::ios_base::failbit;
+    }
+    if (err) {
+        is.setstate(err);
+    }
+    return is;
+}
 
 /**
  *  @brief  将字符串写入到流中
@@ -2243,9 +2655,324 @@ operator<<(std::basic_ostream<CharType> &os,
     return std::__ostream_insert(os, str.data(), str.size());
 }
 
-// TODO: getline
+/**
+ *  @brief  从流中读取一行
+ *  @param  is  输入流
+ *  @param  str  保存结果的字符串，原有内容被清除，容量保留
+ *  @param  delim  行分隔符，被读取但不保存到 @a str
+ *  @return  输入流的引用
+ *
+ *  已缓冲的字符整块交给 traits::find（对 char 即 memchr）查找分隔符，再一次
+ *  性追加到 @a str，不逐个字符调用 sgetc。循环调用时 @a str 的容量可以复用。
+ */
+template <typename CharType, typename CharTraits, typename Allocator>
+std::basic_istream<CharType> &
+getline(std::basic_istream<CharType> &is,
+        basic_string<CharType, CharTraits, Allocator> &str, CharType delim) {
+    typedef std::basic_istream<CharType> istream_type;
+    typedef typename istream_type::traits_type stream_traits;
+    typedef typename istream_type::int_type int_type;
+    typedef streambuf_get_area<CharType> get_area;
+    typedef typename basic_string<CharType, CharTraits, Allocator>::size_type
+        size_type;
+
+    size_type extracted = 0;
+    const size_type n = str.max_size();
+    std::ios_base::iostate err = std::ios_base::goodbit;
+    typename istream_type::sentry cerb(is, true);
+    if (cerb) {
+        try {
+            str.clear();
+            const int_type idelim = stream_traits::to_int_type(delim);
+            const int_type eof = stream_traits::eof();
+            std::basic_streambuf<CharType> *sb = is.rdbuf();
+            int_type c = sb->sgetc();
+
+            while (extracted < n && !stream_traits::eq_int_type(c, eof) &&
+                   !stream_traits::eq_int_type(c, idelim)) {
+                std::streamsize size = get_area::end(sb) - get_area::begin(sb);
+                if (static_cast<size_type>(size) > n - extracted) {
+                    size = static_cast<std::streamsize>(n - extracted);
+                }
+                if (size > 1) {
+                    const CharType *p = get_area::begin(sb);
+                    if (size > INT_MAX) {
+                        size = INT_MAX;
+                    }
+                    const CharType *hit = stream_traits::find(
+                        p, static_cast<std::size_t>(size), delim);
+                    if (hit) {
+                        size = hit - p;
+                    }
+                    str.append(p, size);
+                    get_area::bump(sb, static_cast<int>(size));
+                    extracted += size;
+                    c = sb->sgetc();
+                } else {
+                    str.push_back(stream_traits::to_char_type(c));
+                    ++extracted;
+                    c = sb->snextc();
+                }
+            }
+            if (stream_traits::eq_int_type(c, eof)) {
+                err |= std::ios_base::eofbit;
+            } else if (stream_traits::eq_int_type(c, idelim)) {
+                ++extracted;
+                sb->sbumpc();
+            } else {
+                err |= std::ios_base::failbit;
+            }
+        } catch (...) {
+            stream_extract_failed(is);
+        }
+    }
+    if (!extracted) {
+        err |= std::ios_base::failbit;
+    }
+    if (err) {
+        is.setstate(err);
+    }
+    return is;
+}
+
+/**
+ *  @brief  从流中读取一行，以 is.widen('\n') 为分隔符
+ */
+template <typename CharType, typename CharTraits, typename Allocator>
+inline std::basic_istream<CharType> &
+getline(std::basic_istream<CharType> &is,
+        basic_string<CharType, CharTraits, Allocator> &str) {
+    return easystl::getline(is, str, is.widen('\n'));
+}
+
+/*
+ * 数值转换
+ * */
+
+/**
+ *  @brief  将数值的十进制表示追加到字符串末尾
+ *  @param  str  字符串
+ *  @param  value  整数或浮点数
+ *  @return  @a str 的引用
+ *
+ *  数字直接写入字符串的缓冲区，不经过临时缓冲区或 iostream。浮点数使用可往返
+ *  的最短表示，与 to_chars 相同。
+ */
+template <typename CharTraits, typename Allocator, typename Number>
+inline typename std::enable_if<
+    (std::is_integral<Number>::value && !std::is_same<Number, bool>::value) ||
+        std::is_same<Number, float>::value ||
+        std::is_same<Number, double>::value,
+    basic_string<char, CharTraits, Allocator> &>::type
+append_number(basic_string<char, CharTraits, Allocator> &str, Number value) {
+    typedef typename basic_string<char, CharTraits, Allocator>::size_type
+        size_type;
+    // 64 位整数最长 20 个字符，double 最长 24 个字符
+    const size_type old_size = str.size();
+    str.resize_and_overwrite(old_size + 32, [=](char *p, size_type n) {
+        return static_cast<size_type>(
+            easystl::to_chars(p + old_size, p + n, value).ptr - p);
+    });
+    return str;
+}
+
+/**
+ *  @brief  将数值转换为字符串
+ *
+ *  与 std::to_string 不同，浮点数不使用 "%f" 格式，而是输出可往返的最短表示，
+ *  例如 to_string(0.1) 为 "0.1"，to_string(1e300) 为 "1e+300"。
+ */
+template <typename Number>
+inline typename std::enable_if<
+    (std::is_integral<Number>::value && !std::is_same<Number, bool>::value) ||
+        std::is_same<Number, float>::value ||
+        std::is_same<Number, double>::value,
+    basic_string<char>>::type
+to_string(Number value) {
+    basic_string<char> str;
+    easystl::append_number(str, value);
+    return str;
+}
+
+inline bool sto_is_space(char c) noexcept {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ *  @brief  stoi 等函数的公共实现，语义与 strtol 相同
+ *  @param  str  字符串
+ *  @param  idx  若不为空，保存第一个未被解析的字符的索引
+ *  @param  base  进制，为 0 时根据前缀 "0x" 或 "0" 自动判断
+ *  @param  name  抛出异常时使用的函数名
+ *  @throw  std::invalid_argument  没有可以解析的数字
+ *  @throw  std::out_of_range  结果超出 Integer 的范围
+ *
+ *  接受前导空白和 '+'、'-' 符号。与 strtoul 相同，无符号类型也接受 '-'，结果
+ *  为对应的模 2^N 的值。
+ */
+template <typename Integer, typename CharTraits, typename Allocator>
+Integer sto_integer(const basic_string<char, CharTraits, Allocator> &str,
+                    std::size_t *idx, int base, const char *name) {
+    const char *const begin = str.data();
+    const char *const end = begin + str.size();
+    const char *p = begin;
+    while (p != end && sto_is_space(*p)) {
+        ++p;
+    }
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        ++p;
+    }
+    if ((base == 0 || base == 16) && end - p >= 3 && p[0] == '0' &&
+        (p[1] | 0x20) == 'x' &&
+        (static_cast<unsigned>(p[2] - '0') <= 9 ||
+         static_cast<unsigned>((p[2] | 0x20) - 'a') < 6)) {
+        p += 2;
+        base = 16;
+    } else if (base == 0) {
+        base = (p != end && *p == '0') ? 8 : 10;
+    }
+
+    unsigned long long magnitude = 0;
+    const from_chars_result res = easystl::from_chars(p, end, magnitude, base);
+    THROW_INVALID_ARGUMENT_IF(res.ec == std::errc::invalid_argument, name);
+    THROW_OUT_OF_RANGE_IF(res.ec == std::errc::result_out_of_range, name);
+
+    Integer result;
+    if (std::is_signed<Integer>::value) {
+        typedef typename std::make_unsigned<Integer>::type unsigned_type;
+        const unsigned long long max = static_cast<unsigned long long>(
+            std::numeric_limits<Integer>::max());
+        THROW_OUT_OF_RANGE_IF(magnitude > max + negative, name);
+        unsigned_type u = static_cast<unsigned_type>(magnitude);
+        result = static_cast<Integer>(negative ? unsigned_type(0) - u : u);
+    } else {
+        THROW_OUT_OF_RANGE_IF(
+            magnitude > static_cast<unsigned long long>(
+                            std::numeric_limits<Integer>::max()),
+            name);
+        result = static_cast<Integer>(magnitude);
+        if (negative) {
+            result = static_cast<Integer>(Integer(0) - result);
+        }
+    }
+    if (idx) {
+        *idx = static_cast<std::size_t>(res.ptr - begin);
+    }
+    return result;
+}
+
+/**
+ *  @brief  stof、stod 的公共实现，接受前导空白、'+' 符号、inf 与 nan
+ */
+template <typename Float, typename CharTraits, typename Allocator>
+Float sto_float(const basic_string<char, CharTraits, Allocator> &str,
+                std::size_t *idx, const char *name) {
+    const char *const begin = str.data();
+    const char *const end = begin + str.size();
+    const char *p = begin;
+    while (p != end && sto_is_space(*p)) {
+        ++p;
+    }
+    if (p != end && *p == '+') {
+        ++p;
+        THROW_INVALID_ARGUMENT_IF(p != end && *p == '-', name);
+    }
+    Float result = Float();
+    const from_chars_result res = easystl::from_chars(p, end, result);
+    THROW_INVALID_ARGUMENT_IF(res.ec == std::errc::invalid_argument, name);
+    THROW_OUT_OF_RANGE_IF(res.ec == std::errc::result_out_of_range, name);
+    if (idx) {
+        *idx = static_cast<std::size_t>(res.ptr - begin);
+    }
+    return result;
+}
+
+template <typename CharTraits, typename Allocator>
+inline int stoi(const basic_string<char, CharTraits, Allocator> &str,
+                std::size_t *idx = nullptr, int base = 10) {
+    return sto_integer<int>(str, idx, base, "stoi");
+}
+
+template <typename CharTraits, typename Allocator>
+inline long stol(const basic_string<char, CharTraits, Allocator> &str,
+                 std::size_t *idx = nullptr, int base = 10) {
+    return sto_integer<long>(str, idx, base, "stol");
+}
+
+template <typename CharTraits, typename Allocator>
+inline unsigned long stoul(const basic_string<char, CharTraits, Allocator> &str,
+                           std::size_t *idx = nullptr, int base = 10) {
+    return sto_integer<unsigned long>(str, idx, base, "stoul");
+}
+
+template <typename CharTraits, typename Allocator>
+inline long long stoll(const basic_string<char, CharTraits, Allocator> &str,
+                       std::size_t *idx = nullptr, int base = 10) {
+    return sto_integer<long long>(str, idx, base, "stoll");
+}
+
+template <typename CharTraits, typename Allocator>
+inline unsigned long long
+stoull(const basic_string<char, CharTraits, Allocator> &str,
+       std::size_t *idx = nullptr, int base = 10) {
+    return sto_integer<unsigned long long>(str, idx, base, "stoull");
+}
+
+template <typename CharTraits, typename Allocator>
+inline float stof(const basic_string<char, CharTraits, Allocator> &str,
+                  std::size_t *idx = nullptr) {
+    return sto_float<float>(str, idx, "stof");
+}
+
+template <typename CharTraits, typename Allocator>
+inline double stod(const basic_string<char, CharTraits, Allocator> &str,
+                   std::size_t *idx = nullptr) {
+    return sto_float<double>(str, idx, "stod");
+}
+
+/*
+ * 哈希
+ * */
+
+/**
+ *  @brief  basic_string 的哈希函数，对字符序列调用 traits_hash_bytes
+ *
+ *  CharTraits 认为相等的字符序列在同一平台上总是得到相同的值，与分配器无关。
+ */
+template <typename CharType, typename CharTraits, typename Allocator>
+struct hash<basic_string<CharType, CharTraits, Allocator>> {
+    std::size_t
+    operator()(const basic_string<CharType, CharTraits, Allocator> &str) const
+        noexcept {
+        return static_cast<std::size_t>(
+            easystl::traits_hash_bytes<CharTraits>(str.data(), str.size()));
+    }
+};
+
+/**
+ *  @brief  带种子的 basic_string 哈希函数
+ *
+ *  默认构造时使用进程内随机的 hash_seed()，键来自不可信的输入时应使用此版本。
+ */
+template <typename CharType, typename CharTraits, typename Allocator>
+struct seeded_hash<basic_string<CharType, CharTraits, Allocator>> {
+    std::uint64_t seed;
+
+    seeded_hash() : seed(easystl::hash_seed()) {}
+    explicit seeded_hash(std::uint64_t s) noexcept : seed(s) {}
+
+    std::size_t
+    operator()(const basic_string<CharType, CharTraits, Allocator> &str) const
+        noexcept {
+        return static_cast<std::size_t>(easystl::traits_hash_bytes<CharTraits>(
+            str.data(), str.size(), seed));
+    }
+};
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::pointer
 basic_string<CharType, CharTraits, Allocator>::M_create(
     size_type &capacity, size_type old_capacity) {
@@ -2262,6 +2989,7 @@ basic_string<CharType, CharTraits, Allocator>::M_create(
 
 template <typename CharType, typename CharTraits, typename Allocator>
 template <typename InputIter>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::M_construct(
     InputIter first, InputIter end, easystl::input_iterator_tag) {
     size_type len = 0;
@@ -2276,9 +3004,9 @@ void basic_string<CharType, CharTraits, Allocator>::M_construct(
 
     struct Guard {
         basic_string *guarded;
-        explicit Guard(basic_string *s) : guarded(s) {}
+        EASYSTL_CONSTEXPR20 explicit Guard(basic_string *s) : guarded(s) {}
 
-        ~Guard() {
+        EASYSTL_CONSTEXPR20 ~Guard() {
             if (guarded) {
                 guarded->M_dispose();
             }
@@ -2311,6 +3039,7 @@ void basic_string<CharType, CharTraits, Allocator>::M_construct(
  */
 template <typename CharType, typename CharTraits, typename Allocator>
 template <typename InputIter>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::M_construct(
     InputIter first, InputIter end, easystl::forward_iterator_tag) {
     size_type dnew = static_cast<size_type>(easystl::distance(first, end));
@@ -2324,9 +3053,9 @@ void basic_string<CharType, CharTraits, Allocator>::M_construct(
 
     struct Guard {
         basic_string *guarded;
-        explicit Guard(basic_string *s) : guarded(s) {}
+        EASYSTL_CONSTEXPR20 explicit Guard(basic_string *s) : guarded(s) {}
 
-        ~Guard() {
+        EASYSTL_CONSTEXPR20 ~Guard() {
             if (guarded) {
                 guarded->M_dispose();
             }
@@ -2347,6 +3076,7 @@ void basic_string<CharType, CharTraits, Allocator>::M_construct(
  *  @param  c  Character.
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::M_construct(size_type n,
                                                                 CharType c) {
     if (n > size_type(S_local_capacity)) {
@@ -2363,6 +3093,7 @@ void basic_string<CharType, CharTraits, Allocator>::M_construct(size_type n,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::M_assign(
     const basic_string &str) {
     if (this != easystl::address_of(str)) {
@@ -2386,6 +3117,7 @@ void basic_string<CharType, CharTraits, Allocator>::M_assign(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::M_mutate(size_type pos,
                                                              size_type len1,
                                                              const CharType *s,
@@ -2410,6 +3142,7 @@ void basic_string<CharType, CharTraits, Allocator>::M_mutate(size_type pos,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::M_erase(size_type pos,
                                                             size_type n) {
     const size_type how_much = length() - pos - n;
@@ -2421,6 +3154,7 @@ void basic_string<CharType, CharTraits, Allocator>::M_erase(size_type pos,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::resize(size_type n,
                                                            CharType c) {
     const size_type size = this->size();
@@ -2431,6 +3165,7 @@ void basic_string<CharType, CharTraits, Allocator>::resize(size_type n,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::reserve(size_type res) {
     const size_type current_capacity = capacity();
     // _GLIBCXX_RESOLVE_LIB_DEFECTS
@@ -2456,6 +3191,7 @@ void basic_string<CharType, CharTraits, Allocator>::reserve(size_type res) {
  *  @return  此字符串的引用
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 basic_string<CharType, CharTraits, Allocator> &
 basic_string<CharType, CharTraits, Allocator>::M_replace_aux(size_type pos1,
                                                              size_type n1,
@@ -2491,6 +3227,7 @@ basic_string<CharType, CharTraits, Allocator>::M_replace_aux(size_type pos1,
  *  @return  return
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::M_replace_cold(
     pointer p, size_type len1, const CharType *s, const size_type len2,
     const size_type how_much) {
@@ -2524,6 +3261,7 @@ void basic_string<CharType, CharTraits, Allocator>::M_replace_cold(
  *  @return  Reference of the original string
  */
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 basic_string<CharType, CharTraits, Allocator> &
 basic_string<CharType, CharTraits, Allocator>::M_replace(size_type pos,
                                                          size_type len1,
@@ -2555,6 +3293,170 @@ basic_string<CharType, CharTraits, Allocator>::M_replace(size_type pos,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
+basic_string<CharType, CharTraits, Allocator> &
+basic_string<CharType, CharTraits, Allocator>::replace_all(
+    basic_string_view<CharType, CharTraits> from,
+    basic_string_view<CharType, CharTraits> to) {
+    typedef basic_string_view<CharType, CharTraits> view_type;
+    const size_type old_size = this->size();
+    const size_type n1 = from.size();
+    const size_type n2 = to.size();
+    if (n1 == 0 || n1 > old_size) {
+        return *this;
+    }
+    if (!M_disjunct(from.data()) || !M_disjunct(to.data())) {
+        // 参数引用了此字符串的字符，写入时会被覆盖
+        const basic_string f(from, get_allocator());
+        const basic_string t(to, get_allocator());
+        return this->replace_all(view_type(f), view_type(t));
+    }
+    const view_type self(M_data(), old_size);
+
+    if (n2 <= n1) {
+        // 写入位置总在读取位置之前，原地前移
+        pointer p = M_data();
+        size_type w = 0;
+        size_type r = 0;
+        for (size_type pos = self.find(from); pos != view_type::npos;
+             pos = self.find(from, r)) {
+            if (w != r) {
+                this->S_move(p + w, p + r, pos - r);
+            }
+            w += pos - r;
+            if (n2) {
+                this->S_copy(p + w, to.data(), n2);
+            }
+            w += n2;
+            r = pos + n1;
+        }
+        if (w != r) {
+            this->S_move(p + w, p + r, old_size - r);
+            this->M_set_length(w + old_size - r);
+        }
+        return *this;
+    }
+
+    size_type count = 0;
+    for (size_type pos = self.find(from); pos != view_type::npos;
+         pos = self.find(from, pos + n1)) {
+        ++count;
+    }
+    if (count == 0) {
+        return *this;
+    }
+    THROW_LENGTH_ERROR_IF(count > (max_size() - old_size) / (n2 - n1),
+                          "basic_string::replace_all");
+    const size_type new_size = old_size + count * (n2 - n1);
+    size_type capacity = new_size;
+    pointer np = M_create(capacity, this->capacity());
+    const CharType *src = M_data();
+    size_type w = 0;
+    size_type r = 0;
+    for (size_type pos = self.find(from); pos != view_type::npos;
+         pos = self.find(from, r)) {
+        if (pos != r) {
+            this->S_copy(np + w, src + r, pos - r);
+        }
+        w += pos - r;
+        this->S_copy(np + w, to.data(), n2);
+        w += n2;
+        r = pos + n1;
+    }
+    if (r != old_size) {
+        this->S_copy(np + w, src + r, old_size - r);
+    }
+    M_dispose();
+    M_data(np);
+    M_capacity(capacity);
+    this->M_set_length(new_size);
+    return *this;
+}
+
+template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
+basic_string<CharType, CharTraits, Allocator> &
+basic_string<CharType, CharTraits, Allocator>::replace_each(
+    const replacement_type *pairs, size_type n) {
+    const size_type old_size = this->size();
+    const CharType *src = M_data();
+
+    // 所有 from 的首字符组成的过滤表；traits 的 eq 为逐值比较时才能使用
+    const bool use_filter =
+        std::is_same<CharTraits, easystl::char_traits<CharType>>::value;
+    std::uint32_t filter[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (size_type k = 0; k < n; ++k) {
+        if (!pairs[k].first.empty()) {
+            const unsigned c = static_cast<unsigned>(pairs[k].first[0]) & 255u;
+            filter[c >> 5] |= std::uint32_t(1) << (c & 31);
+        }
+    }
+    // 返回在 pos 处匹配的第一组的下标，没有匹配时返回 n
+    auto match = [&](size_type pos) -> size_type {
+        if (use_filter) {
+            const unsigned c = static_cast<unsigned>(src[pos]) & 255u;
+            if (!((filter[c >> 5] >> (c & 31)) & 1)) {
+                return n;
+            }
+        }
+        for (size_type k = 0; k < n; ++k) {
+            const size_type len = pairs[k].first.size();
+            if (len != 0 && len <= old_size - pos &&
+                traits_type::compare(src + pos, pairs[k].first.data(), len) ==
+                    0) {
+                return k;
+            }
+        }
+        return n;
+    };
+
+    size_type new_size = 0;
+    bool changed = false;
+    for (size_type pos = 0; pos < old_size;) {
+        const size_type k = match(pos);
+        if (k == n) {
+            ++new_size;
+            ++pos;
+        } else {
+            THROW_LENGTH_ERROR_IF(max_size() - new_size <
+                                      pairs[k].second.size(),
+                                  "basic_string::replace_each");
+            new_size += pairs[k].second.size();
+            pos += pairs[k].first.size();
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return *this;
+    }
+
+    size_type capacity = new_size;
+    pointer np = M_create(capacity, this->capacity());
+    size_type w = 0;
+    size_type run = 0; // 未被替换的连续字符的起点
+    for (size_type pos = 0; pos < old_size;) {
+        const size_type k = match(pos);
+        if (k == n) {
+            ++pos;
+            continue;
+        }
+        this->S_copy(np + w, src + run, pos - run);
+        w += pos - run;
+        this->S_copy(np + w, pairs[k].second.data(), pairs[k].second.size());
+        w += pairs[k].second.size();
+        pos += pairs[k].first.size();
+        run = pos;
+    }
+    this->S_copy(np + w, src + run, old_size - run);
+    M_dispose();
+    M_data(np);
+    M_capacity(capacity);
+    this->M_set_length(new_size);
+    return *this;
+}
+
+template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 basic_string<CharType, CharTraits, Allocator> &
 basic_string<CharType, CharTraits, Allocator>::M_append(const CharType *s,
                                                         size_type n) {
@@ -2573,6 +3475,7 @@ basic_string<CharType, CharTraits, Allocator>::M_append(const CharType *s,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 basic_string<CharType, CharTraits, Allocator>::copy(CharType *s, size_type n,
                                                     size_type pos) const {
@@ -2588,6 +3491,7 @@ basic_string<CharType, CharTraits, Allocator>::copy(CharType *s, size_type n,
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 void basic_string<CharType, CharTraits, Allocator>::swap(
     basic_string &s) noexcept {
     if (this == easystl::address_of(s)) {
@@ -2648,6 +3552,7 @@ void basic_string<CharType, CharTraits, Allocator>::swap(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find(
     const CharType *s, size_type pos, size_type n) const noexcept {
@@ -2681,6 +3586,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::find(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find(
     const CharType c, size_type pos) const noexcept {
@@ -2698,6 +3604,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::find(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::rfind(
     const CharType *s, size_type pos, size_type n) const noexcept {
@@ -2717,6 +3624,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::rfind(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::rfind(
     const CharType c, size_type pos) const noexcept {
@@ -2736,6 +3644,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::rfind(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find_first_of(
     const CharType *s, size_type pos, size_type n) const noexcept {
@@ -2752,6 +3661,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::find_first_of(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find_last_of(
     const CharType *s, size_type pos, size_type n) const noexcept {
@@ -2773,6 +3683,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::find_last_of(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find_first_not_of(
     const CharType *s, size_type pos, size_type n) const noexcept {
@@ -2788,6 +3699,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::find_first_not_of(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find_first_not_of(
     CharType c, size_type pos) const noexcept {
@@ -2801,6 +3713,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::find_first_not_of(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find_last_not_of(
     const CharType *s, size_type pos, size_type n) const noexcept {
@@ -2822,6 +3735,7 @@ easystl::basic_string<CharType, CharTraits, Allocator>::find_last_not_of(
 }
 
 template <typename CharType, typename CharTraits, typename Allocator>
+EASYSTL_CONSTEXPR20
 typename basic_string<CharType, CharTraits, Allocator>::size_type
 easystl::basic_string<CharType, CharTraits, Allocator>::find_last_not_of(
     CharType c, size_type pos) const noexcept {
@@ -2,12 +2,18 @@
 #define EASYSTL_CHAR_TRAITS_H
 
 #include "exceptdef.h"
+#include "type_traits.h"
 #include <cstddef>
 #include <cstring>
 #include <cwchar>
 #include <memory.h>
 #include <type_traits>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define EASYSTL_CHAR_TRAITS_SSE2 1
+#endif
+
 namespace easystl {
 
 template <typename CharType> struct CharTypes {
@@ -18,39 +24,52 @@ template <class CharType> struct char_traits {
     typedef CharType char_type;
     typedef typename CharTypes<CharType>::int_type int_type;
 
-    static void assign(char_type &c1, char_type &c2) { c1 = c2; }
+    EASYSTL_CONSTEXPR20
+    static void assign(char_type &c1, const char_type &c2) { c1 = c2; }
 
+    EASYSTL_CONSTEXPR20
     static bool eq(const char_type &c1, const char_type &c2) {
         return c1 == c2;
     }
 
+    EASYSTL_CONSTEXPR20
     static bool lt(const char_type &c1, const char_type &c2) { return c1 < c2; }
 
+    EASYSTL_CONSTEXPR20
     static int compare(const char_type *str1, const char_type *str2, size_t n);
 
+    EASYSTL_CONSTEXPR20
     static size_t length(const char_type *str);
 
+    EASYSTL_CONSTEXPR20
     static const char_type *find(const char_type *s, std::size_t n,
                                  const char_type &c);
 
+    EASYSTL_CONSTEXPR20
     static char_type *move(char_type *dest, const char_type *src, size_t n);
 
+    EASYSTL_CONSTEXPR20
     static char_type *copy(char_type *dest, const char_type *src, size_t n);
 
-    static char_type *assign(char_type *s, std::size_t n, char_type &c);
+    EASYSTL_CONSTEXPR20
+    static char_type *assign(char_type *s, std::size_t n, const char_type &c);
 
+    EASYSTL_CONSTEXPR20
     static char_type to_char_type(const int_type &c) {
         return static_cast<char_type>(c);
     }
 
+    EASYSTL_CONSTEXPR20
     static char_type to_int_type(const char_type &c) {
         return static_cast<int_type>(c);
     }
 
+    EASYSTL_CONSTEXPR20
     static bool eq_int_type(const int_type &c1, const int_type &c2) {
         return c1 == c2;
     }
 
+    EASYSTL_CONSTEXPR20
     static char_type *fill(char_type *dest, char_type ch, size_t count) {
         char_type *r = dest;
         for (; count > 0; --count, ++dest)
@@ -60,6 +79,7 @@ template <class CharType> struct char_traits {
 };
 
 template <typename CharType>
+EASYSTL_CONSTEXPR20
 int char_traits<CharType>::compare(const char_type *str1, const char_type *str2,
                                    size_t n) {
     for (std::size_t i = 0; i < n; ++i) {
@@ -73,6 +93,7 @@ int char_traits<CharType>::compare(const char_type *str1, const char_type *str2,
 }
 
 template <typename CharType>
+EASYSTL_CONSTEXPR20
 std::size_t char_traits<CharType>::length(const char_type *str) {
     size_t len = 0;
     while (!eq(str[len], char_type())) {
@@ -82,6 +103,7 @@ std::size_t char_traits<CharType>::length(const char_type *str) {
 }
 
 template <typename CharType>
+EASYSTL_CONSTEXPR20
 const typename char_traits<CharType>::char_type *
 char_traits<CharType>::find(const char_type *s, std::size_t n,
                             const char_type &c) {
@@ -93,6 +115,7 @@ char_traits<CharType>::find(const char_type *s, std::size_t n,
     return 0;
 }
 template <typename CharType>
+EASYSTL_CONSTEXPR20
 typename char_traits<CharType>::char_type *
 char_traits<CharType>::move(char_type *dest, const char_type *src, size_t n) {
     char_type *r = dest;
@@ -108,9 +131,11 @@ char_traits<CharType>::move(char_type *dest, const char_type *src, size_t n) {
     return r;
 }
 template <typename CharType>
+EASYSTL_CONSTEXPR20
 typename char_traits<CharType>::char_type *
 char_traits<CharType>::copy(char_type *dest, const char_type *src, size_t n) {
-    EASYSTL_DEBUG(src + n <= dest || dest + n <= src);
+    EASYSTL_DEBUG(easystl::is_constant_evaluated() || src + n <= dest ||
+                  dest + n <= src);
     char_type *r = dest;
     for (; n != 0; --n, dest++, src++) {
         *dest = *src;
@@ -119,8 +144,9 @@ char_traits<CharType>::copy(char_type *dest, const char_type *src, size_t n) {
 }
 
 template <typename CharType>
+EASYSTL_CONSTEXPR20
 typename char_traits<CharType>::char_type *
-char_traits<CharType>::assign(char_type *s, std::size_t n, char_type &c) {
+char_traits<CharType>::assign(char_type *s, std::size_t n, const char_type &c) {
     for (std::size_t i = 0; i < n; ++i) {
         s[i] = c;
     }
@@ -128,84 +154,260 @@ char_traits<CharType>::assign(char_type *s, std::size_t n, char_type &c) {
 }
 
 // partitialize char_traits<char>
+// 常量求值时不能调用 memcmp 等库函数，改为逐个字符处理
 template <> struct char_traits<char> {
     typedef char char_type;
     typedef int int_type;
 
+    EASYSTL_CONSTEXPR20
     static void assign(char_type &c1, const char_type &c2) noexcept { c1 = c2; }
 
-    static bool eq(const char_type &c1, const char_type &c2) noexcept {
+    static constexpr bool eq(const char_type &c1,
+                             const char_type &c2) noexcept {
         return c1 == c2;
     }
 
-    static bool lt(const char_type &c1, const char_type &c2) noexcept {
+    static constexpr bool lt(const char_type &c1,
+                             const char_type &c2) noexcept {
         return (static_cast<unsigned char>(c1) <
                 static_cast<unsigned char>(c2));
     }
 
+    EASYSTL_CONSTEXPR20
     static int compare(const char_type *str1, const char_type *str2, size_t n) {
         if (n == 0) {
             return 0;
         }
+        if (easystl::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (lt(str1[i], str2[i])) {
+                    return -1;
+                } else if (lt(str2[i], str1[i])) {
+                    return 1;
+                }
+            }
+            return 0;
+        }
         return std::memcmp(str1, str2, n);
     }
 
+    EASYSTL_CONSTEXPR20
     static size_t length(const char_type *str) noexcept {
+        if (easystl::is_constant_evaluated()) {
+            size_t len = 0;
+            while (str[len] != char_type()) {
+                ++len;
+            }
+            return len;
+        }
         return std::strlen(str);
     }
 
+    EASYSTL_CONSTEXPR20
     static const char_type *find(const char_type *s, std::size_t n,
                                  const char_type &c) {
 
         if (n == 0) {
             return 0;
         }
+        if (easystl::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (s[i] == c) {
+                    return s + i;
+                }
+            }
+            return 0;
+        }
         return static_cast<const char_type *>(std::memchr(s, c, n));
     }
 
+    EASYSTL_CONSTEXPR20
     static char_type *move(char_type *dest, const char_type *src, size_t n) {
         if (n == 0) {
             return dest;
         }
+        if (easystl::is_constant_evaluated()) {
+            // 常量求值中不能比较无关指针的大小，只能用 == 判断 dest 是否落在
+            // (src, src + n) 内，此时需要从后往前复制
+            bool backward = false;
+            for (size_t i = 1; i < n; ++i) {
+                if (dest == src + i) {
+                    backward = true;
+                    break;
+                }
+            }
+            if (backward) {
+                for (size_t i = n; i > 0; --i) {
+                    dest[i - 1] = src[i - 1];
+                }
+            } else {
+                for (size_t i = 0; i < n; ++i) {
+                    dest[i] = src[i];
+                }
+            }
+            return dest;
+        }
         return static_cast<char_type *>(std::memmove(dest, src, n));
     }
 
+    EASYSTL_CONSTEXPR20
     static char_type *copy(char_type *dest, const char_type *src,
                            size_t n) noexcept {
         if (n == 0) {
             return dest;
         }
+        if (easystl::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                dest[i] = src[i];
+            }
+            return dest;
+        }
         // EASYSTL_DEBUG(src + n <= dest || dest + n <= src);
         return static_cast<char_type *>(std::memcpy(dest, src, n));
     }
 
+    EASYSTL_CONSTEXPR20
     static char_type *assign(char_type *dest, std::size_t n,
                              char_type c) noexcept {
 
         if (n == 0) {
             return dest;
         }
+        if (easystl::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                dest[i] = c;
+            }
+            return dest;
+        }
         return static_cast<char_type *>(std::memset(dest, c, n));
     }
 
-    static char_type to_char_type(const int_type &c) noexcept {
+    static constexpr char_type to_char_type(const int_type &c) noexcept {
         return static_cast<char_type>(c);
     }
 
-    static char_type to_int_type(const char_type &c) noexcept {
+    static constexpr char_type to_int_type(const char_type &c) noexcept {
         return static_cast<int_type>(c);
     }
 
-    static bool eq_int_type(const int_type &c1, const int_type &c2) {
+    static constexpr bool eq_int_type(const int_type &c1, const int_type &c2) {
         return c1 == c2;
     }
 
+    EASYSTL_CONSTEXPR20
     static char_type *fill(char_type *dest, char_type ch,
                            size_t count) noexcept {
-        return static_cast<char_type *>(std::memset(dest, ch, count));
+        return assign(dest, count, ch);
+    }
+};
+
+/*
+ * ascii_ci_traits
+ * 只对 ASCII 字母不区分大小写的 char_traits，用于 HTTP 头部名称等协议字段，
+ * 与 locale 无关。compare 与 find 每次处理 16 个字节，在寄存器中完成大小写折
+ * 叠，不需要先复制一份小写的字符串。
+ * */
+struct ascii_ci_traits : char_traits<char> {
+    /**
+     *  @brief  将 'A' ~ 'Z' 转换为小写，其他字符不变
+     */
+    EASYSTL_CONSTEXPR20
+    static char_type fold(char_type c) noexcept {
+        const unsigned char u = static_cast<unsigned char>(c);
+        return static_cast<char_type>(
+            u | (static_cast<unsigned>(u - 'A') < 26u ? 0x20 : 0));
+    }
+
+    EASYSTL_CONSTEXPR20
+    static bool eq(const char_type &c1, const char_type &c2) noexcept {
+        return fold(c1) == fold(c2);
+    }
+
+    EASYSTL_CONSTEXPR20
+    static bool lt(const char_type &c1, const char_type &c2) noexcept {
+        return static_cast<unsigned char>(fold(c1)) <
+               static_cast<unsigned char>(fold(c2));
     }
+
+    EASYSTL_CONSTEXPR20
+    static int compare(const char_type *str1, const char_type *str2,
+                       std::size_t n) noexcept {
+        std::size_t i = 0;
+#ifdef EASYSTL_CHAR_TRAITS_SSE2
+        for (; !easystl::is_constant_evaluated() && i + 16 <= n; i += 16) {
+            const __m128i a = fold16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(str1 + i)));
+            const __m128i b = fold16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(str2 + i)));
+            const unsigned diff =
+                static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) ^
+                0xFFFFu;
+            if (diff) {
+                i += static_cast<std::size_t>(__builtin_ctz(diff));
+                return lt(str1[i], str2[i]) ? -1 : 1;
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            if (!eq(str1[i], str2[i])) {
+                return lt(str1[i], str2[i]) ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    EASYSTL_CONSTEXPR20
+    static const char_type *find(const char_type *s, std::size_t n,
+                                 const char_type &c) noexcept {
+        const char_type lower = fold(c);
+        const char_type upper =
+            (lower >= 'a' && lower <= 'z') ? static_cast<char_type>(lower - 0x20)
+                                           : lower;
+        if (lower == upper) {
+            return char_traits<char>::find(s, n, c);
+        }
+        std::size_t i = 0;
+#ifdef EASYSTL_CHAR_TRAITS_SSE2
+        if (!easystl::is_constant_evaluated()) {
+            const __m128i vl = _mm_set1_epi8(lower);
+            const __m128i vu = _mm_set1_epi8(upper);
+            for (; i + 16 <= n; i += 16) {
+                const __m128i v =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                const int mask = _mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, vl), _mm_cmpeq_epi8(v, vu)));
+                if (mask) {
+                    return s + i + __builtin_ctz(static_cast<unsigned>(mask));
+                }
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            if (s[i] == lower || s[i] == upper) {
+                return s + i;
+            }
+        }
+        return 0;
+    }
+
+  private:
+#ifdef EASYSTL_CHAR_TRAITS_SSE2
+    // 16 个字节同时折叠：'A' ~ 'Z' 平移到有符号数的最小端后比较，再加上 0x20
+    static __m128i fold16(__m128i v) noexcept {
+        const __m128i shifted =
+            _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - 'A')));
+        const __m128i is_upper =
+            _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+        return _mm_add_epi8(v, _mm_and_si128(is_upper, _mm_set1_epi8(0x20)));
+    }
+#endif
 };
 
+// 不区分大小写的 char_traits，目前只提供 char 的版本
+template <class CharType> struct ci_char_traits;
+
+template <> struct ci_char_traits<char> : ascii_ci_traits {};
+
 // partitialize char_traits<wchar_t>
 // template <> struct char_traits<wchar_t> {
 //     typedef wchar_t char_type;
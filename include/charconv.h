@@ -0,0 +1,1163 @@
+#ifndef EASYSTL_CHARCONV_H
+#define EASYSTL_CHARCONV_H
+
+// 数值与字符序列之间的转换
+//
+// to_chars / from_chars 的语义与 C++17 <charconv> 相同：不分配内存、不依赖
+// locale、不抛出异常。
+//   - 整数格式化使用两位一组的查表法，从末尾向前写入
+//   - 浮点数格式化使用 Ryu 算法，输出可往返的最短十进制表示
+//   - 十进制整数解析使用 SWAR，一次判断并转换 8 个数字
+//   - 浮点数解析的慢速路径使用栈上定长的十进制大数，逐次乘除 2 的幂，
+//     结果正确舍入
+
+#include "ryu_tables.h"
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace easystl {
+
+struct to_chars_result {
+    char *ptr;
+    std::errc ec;
+};
+
+struct from_chars_result {
+    const char *ptr;
+    std::errc ec;
+};
+
+/*
+ * 整数格式化的辅助函数
+ * */
+
+template <class Tp = void> struct charconv_digits {
+    // "00" "01" ... "99"
+    static const char pairs[201];
+};
+
+template <class Tp>
+const char charconv_digits<Tp>::pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// 计算十进制位数
+template <class Unsigned> unsigned to_chars_len_10(Unsigned value) noexcept {
+    unsigned n = 1;
+    for (;;) {
+        if (value < 10u)
+            return n;
+        if (value < 100u)
+            return n + 1;
+        if (value < 1000u)
+            return n + 2;
+        if (value < 10000u)
+            return n + 3;
+        value /= 10000u;
+        n += 4;
+    }
+}
+
+// 将 value 的 len 位十进制数字写入 [first, first + len)
+template <class Unsigned>
+void to_chars_10_impl(char *first, unsigned len, Unsigned value) noexcept {
+    const char *digits = charconv_digits<>::pairs;
+    unsigned pos = len - 1;
+    while (value >= 100u) {
+        const unsigned num = static_cast<unsigned>(value % 100u) * 2;
+        value /= 100u;
+        first[pos] = digits[num + 1];
+        first[pos - 1] = digits[num];
+        pos -= 2;
+    }
+    if (value >= 10u) {
+        const unsigned num = static_cast<unsigned>(value) * 2;
+        first[1] = digits[num + 1];
+        first[0] = digits[num];
+    } else {
+        first[0] = static_cast<char>('0' + value);
+    }
+}
+
+template <class Unsigned>
+to_chars_result to_chars_10(char *first, char *last, Unsigned value) noexcept {
+    const unsigned len = to_chars_len_10(value);
+    if (last - first < static_cast<std::ptrdiff_t>(len)) {
+        return {last, std::errc::value_too_large};
+    }
+    // 32 位除法比 64 位除法快得多
+    if (value <= 0xFFFFFFFFu) {
+        to_chars_10_impl(first, len, static_cast<std::uint32_t>(value));
+    } else {
+        to_chars_10_impl(first, len, value);
+    }
+    return {first + len, std::errc()};
+}
+
+template <class Unsigned>
+to_chars_result to_chars_base(char *first, char *last, Unsigned value,
+                              unsigned base) noexcept {
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    unsigned len = 1;
+    for (Unsigned v = value; v >= base; v /= base) {
+        ++len;
+    }
+    if (last - first < static_cast<std::ptrdiff_t>(len)) {
+        return {last, std::errc::value_too_large};
+    }
+    for (unsigned pos = len; pos > 0; --pos) {
+        first[pos - 1] = digits[value % base];
+        value /= base;
+    }
+    return {first + len, std::errc()};
+}
+
+/**
+ *  @brief  将整数转换为字符序列
+ *  @param  first  输出区间的起点
+ *  @param  last  输出区间的终点
+ *  @param  value  待转换的整数
+ *  @param  base  进制，取值范围为 [2, 36]
+ *  @return  {写入的末尾, std::errc()}；空间不足时返回 {last, value_too_large}
+ */
+template <class Integer>
+typename std::enable_if<std::is_integral<Integer>::value &&
+                            !std::is_same<Integer, bool>::value,
+                        to_chars_result>::type
+to_chars(char *first, char *last, Integer value, int base = 10) noexcept {
+    typedef typename std::make_unsigned<Integer>::type unsigned_type;
+    typedef typename std::conditional<(sizeof(unsigned_type) < sizeof(unsigned)),
+                                      unsigned, unsigned_type>::type work_type;
+    work_type uvalue = static_cast<unsigned_type>(value);
+    if (value < 0) {
+        if (first == last) {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '-';
+        uvalue = static_cast<unsigned_type>(unsigned_type(0) - uvalue);
+    }
+    if (base == 10) {
+        return to_chars_10(first, last, uvalue);
+    }
+    return to_chars_base(first, last, uvalue, static_cast<unsigned>(base));
+}
+
+/*
+ * Ryu 最短往返浮点数格式化
+ * 参见 Ulf Adams, "Ryū: fast float-to-string conversion", PLDI 2018
+ * */
+
+struct ryu_decimal {
+    std::uint64_t mantissa;
+    std::int32_t exponent;
+};
+
+// 5^e 的二进制位数，0 <= e <= 3528
+inline std::int32_t ryu_pow5bits(std::int32_t e) noexcept {
+    return static_cast<std::int32_t>(
+        ((static_cast<std::uint32_t>(e) * 1217359u) >> 19) + 1);
+}
+
+// floor(log10(2^e))，0 <= e <= 1650
+inline std::uint32_t ryu_log10_pow2(std::int32_t e) noexcept {
+    return (static_cast<std::uint32_t>(e) * 78913u) >> 18;
+}
+
+// floor(log10(5^e))，0 <= e <= 2620
+inline std::uint32_t ryu_log10_pow5(std::int32_t e) noexcept {
+    return (static_cast<std::uint32_t>(e) * 732923u) >> 20;
+}
+
+inline std::uint32_t ryu_pow5_factor(std::uint64_t value) noexcept {
+    std::uint32_t count = 0;
+    while (value % 5 == 0) {
+        value /= 5;
+        ++count;
+    }
+    return count;
+}
+
+inline bool ryu_multiple_of_pow5(std::uint64_t value, std::uint32_t p) noexcept {
+    return ryu_pow5_factor(value) >= p;
+}
+
+inline bool ryu_multiple_of_pow2(std::uint64_t value, std::uint32_t p) noexcept {
+    return (value & ((std::uint64_t(1) << p) - 1)) == 0;
+}
+
+// (m * mul) >> j，mul 为 128 位数，j >= 64
+inline std::uint64_t ryu_mul_shift(std::uint64_t m, const std::uint64_t *mul,
+                                   std::int32_t j) noexcept {
+#ifdef __SIZEOF_INT128__
+    typedef unsigned __int128 uint128;
+    const uint128 b0 = static_cast<uint128>(m) * mul[0];
+    const uint128 b2 = static_cast<uint128>(m) * mul[1];
+    return static_cast<std::uint64_t>(((b0 >> 64) + b2) >> (j - 64));
+#else
+    // 拆成 32 位计算 128 位乘积
+    struct mul64 {
+        static std::uint64_t full(std::uint64_t a, std::uint64_t b,
+                                  std::uint64_t *hi) {
+            const std::uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+            const std::uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+            const std::uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi;
+            const std::uint64_t p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+            const std::uint64_t mid =
+                (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+            *hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+            return (mid << 32) | (p0 & 0xFFFFFFFFu);
+        }
+    };
+    std::uint64_t high1 = 0;
+    const std::uint64_t low1 = mul64::full(m, mul[1], &high1);
+    std::uint64_t high0 = 0;
+    mul64::full(m, mul[0], &high0);
+    const std::uint64_t sum = high0 + low1;
+    if (sum < high0) {
+        ++high1;
+    }
+    const std::int32_t dist = j - 64;
+    if (dist == 0) {
+        return sum;
+    }
+    return (high1 << (64 - dist)) | (sum >> dist);
+#endif
+}
+
+/**
+ *  @brief  Ryu 算法核心，计算 m2 * 2^e2 的最短十进制表示
+ *  @param  m2  二进制尾数（已含隐含位）
+ *  @param  e2  二进制指数（已减去 2，为区间两端留出位置）
+ *  @param  mm_shift  下边界是否与上边界对称
+ *
+ *  float 与 double 共用此实现，double 的表精度对 float 同样足够。
+ */
+inline ryu_decimal ryu_shortest(std::uint64_t m2, std::int32_t e2,
+                                std::uint32_t mm_shift) noexcept {
+    const bool accept_bounds = (m2 & 1) == 0;
+    const std::uint64_t mv = 4 * m2;
+
+    std::uint64_t vr, vp, vm;
+    std::int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+
+    if (e2 >= 0) {
+        const std::uint32_t q = ryu_log10_pow2(e2) - (e2 > 3);
+        e10 = static_cast<std::int32_t>(q);
+        const std::int32_t k =
+            125 + ryu_pow5bits(static_cast<std::int32_t>(q)) - 1;
+        const std::int32_t i = -e2 + static_cast<std::int32_t>(q) + k;
+        const std::uint64_t *mul = ryu_tables<>::pow5_inv_split[q];
+        vr = ryu_mul_shift(4 * m2, mul, i);
+        vp = ryu_mul_shift(4 * m2 + 2, mul, i);
+        vm = ryu_mul_shift(4 * m2 - 1 - mm_shift, mul, i);
+        if (q <= 21) {
+            // 只有 q 较小时 mv 才可能被 5^q 整除
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = ryu_multiple_of_pow5(mv, q);
+            } else if (accept_bounds) {
+                vm_trailing_zeros = ryu_multiple_of_pow5(mv - 1 - mm_shift, q);
+            } else {
+                vp -= ryu_multiple_of_pow5(mv + 2, q);
+            }
+        }
+    } else {
+        const std::uint32_t q = ryu_log10_pow5(-e2) - (-e2 > 1);
+        e10 = static_cast<std::int32_t>(q) + e2;
+        const std::int32_t i = -e2 - static_cast<std::int32_t>(q);
+        const std::int32_t k = ryu_pow5bits(i) - 125;
+        const std::int32_t j = static_cast<std::int32_t>(q) - k;
+        const std::uint64_t *mul = ryu_tables<>::pow5_split[i];
+        vr = ryu_mul_shift(4 * m2, mul, j);
+        vp = ryu_mul_shift(4 * m2 + 2, mul, j);
+        vm = ryu_mul_shift(4 * m2 - 1 - mm_shift, mul, j);
+        if (q <= 1) {
+            // mv 至少有 q 个尾随零
+            vr_trailing_zeros = true;
+            if (accept_bounds) {
+                vm_trailing_zeros = mm_shift == 1;
+            } else {
+                --vp;
+            }
+        } else if (q < 63) {
+            vr_trailing_zeros = ryu_multiple_of_pow2(mv, q);
+        }
+    }
+
+    std::int32_t removed = 0;
+    std::uint32_t last_removed_digit = 0;
+    std::uint64_t output;
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        // 少见的情况，需要精确处理尾随零
+        for (;;) {
+            const std::uint64_t vp_div10 = vp / 10;
+            const std::uint64_t vm_div10 = vm / 10;
+            if (vp_div10 <= vm_div10) {
+                break;
+            }
+            const std::uint32_t vm_mod10 =
+                static_cast<std::uint32_t>(vm - 10 * vm_div10);
+            const std::uint64_t vr_div10 = vr / 10;
+            const std::uint32_t vr_mod10 =
+                static_cast<std::uint32_t>(vr - 10 * vr_div10);
+            vm_trailing_zeros &= vm_mod10 == 0;
+            vr_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = vr_mod10;
+            vr = vr_div10;
+            vp = vp_div10;
+            vm = vm_div10;
+            ++removed;
+        }
+        if (vm_trailing_zeros) {
+            for (;;) {
+                const std::uint64_t vm_div10 = vm / 10;
+                const std::uint32_t vm_mod10 =
+                    static_cast<std::uint32_t>(vm - 10 * vm_div10);
+                if (vm_mod10 != 0) {
+                    break;
+                }
+                const std::uint64_t vp_div10 = vp / 10;
+                const std::uint64_t vr_div10 = vr / 10;
+                const std::uint32_t vr_mod10 =
+                    static_cast<std::uint32_t>(vr - 10 * vr_div10);
+                vr_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = vr_mod10;
+                vr = vr_div10;
+                vp = vp_div10;
+                vm = vm_div10;
+                ++removed;
+            }
+        }
+        if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+            // 恰好位于中点时向偶数舍入
+            last_removed_digit = 4;
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) ||
+                       last_removed_digit >= 5);
+    } else {
+        // 常见情况
+        bool round_up = false;
+        const std::uint64_t vp_div100 = vp / 100;
+        const std::uint64_t vm_div100 = vm / 100;
+        if (vp_div100 > vm_div100) {
+            const std::uint64_t vr_div100 = vr / 100;
+            const std::uint32_t vr_mod100 =
+                static_cast<std::uint32_t>(vr - 100 * vr_div100);
+            round_up = vr_mod100 >= 50;
+            vr = vr_div100;
+            vp = vp_div100;
+            vm = vm_div100;
+            removed += 2;
+        }
+        for (;;) {
+            const std::uint64_t vp_div10 = vp / 10;
+            const std::uint64_t vm_div10 = vm / 10;
+            if (vp_div10 <= vm_div10) {
+                break;
+            }
+            const std::uint64_t vr_div10 = vr / 10;
+            const std::uint32_t vr_mod10 =
+                static_cast<std::uint32_t>(vr - 10 * vr_div10);
+            round_up = vr_mod10 >= 5;
+            vr = vr_div10;
+            vp = vp_div10;
+            vm = vm_div10;
+            ++removed;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+    ryu_decimal result;
+    result.mantissa = output;
+    result.exponent = e10 + removed;
+    return result;
+}
+
+/**
+ *  @brief  将整数 m2 * 2^e2 的精确十进制表示写入 buf
+ *  @return  写入的长度
+ *
+ *  要求 m2 * 2^e2 为小于 2^96 的整数，buf 至少有 40 个字符。
+ */
+inline std::int32_t ryu_exact_integer(char *buf, std::uint64_t m2,
+                                      std::int32_t e2) noexcept {
+    if (e2 < 0) {
+        m2 >>= -e2;
+        e2 = 0;
+    }
+    // 以 32 位为一组保存 m2 << e2
+    std::uint32_t limb[5] = {0, 0, 0, 0, 0};
+    const std::int32_t word = e2 / 32;
+    const std::int32_t bit = e2 % 32;
+    const std::uint64_t lo = (m2 & 0xFFFFFFFFu) << bit;
+    const std::uint64_t hi = ((m2 >> 32) << bit) + (lo >> 32);
+    limb[word] = static_cast<std::uint32_t>(lo);
+    limb[word + 1] = static_cast<std::uint32_t>(hi);
+    limb[word + 2] = static_cast<std::uint32_t>(hi >> 32);
+
+    // 每次除以 10^9，从低位向高位得到 9 位一组的数字
+    char tmp[48];
+    char *p = tmp + sizeof(tmp);
+    for (;;) {
+        std::uint64_t rem = 0;
+        bool zero = true;
+        for (int i = 4; i >= 0; --i) {
+            const std::uint64_t cur = (rem << 32) | limb[i];
+            limb[i] = static_cast<std::uint32_t>(cur / 1000000000u);
+            rem = cur % 1000000000u;
+            zero = zero && limb[i] == 0;
+        }
+        const std::uint32_t group = static_cast<std::uint32_t>(rem);
+        if (zero) {
+            const unsigned len = to_chars_len_10(group);
+            p -= len;
+            to_chars_10_impl(p, len, group);
+            break;
+        }
+        p -= 9;
+        std::uint32_t v = group;
+        for (int i = 8; i >= 0; --i) {
+            p[i] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        }
+    }
+    const std::int32_t len = static_cast<std::int32_t>(tmp + sizeof(tmp) - p);
+    std::memcpy(buf, p, len);
+    return len;
+}
+
+/**
+ *  @brief  把十进制表示 digits * 10^exp 写成定点或科学计数法中较短的一种
+ *  @param  m2  原值的二进制尾数
+ *  @param  e2  原值的二进制指数，原值等于 m2 * 2^e2
+ *
+ *  与 std::to_chars(first, last, value) 的输出一致，长度相同时使用定点表示。
+ *  定点表示需要在有效数字后补零时，原值必然是整数。标准要求在同样长度的表示
+ *  中选择与原值之差最小的一个，即原值的精确整数表示。
+ */
+inline to_chars_result ryu_format(char *first, char *last, bool negative,
+                                  ryu_decimal d, std::uint64_t m2,
+                                  std::int32_t e2) noexcept {
+    const std::int32_t olength =
+        static_cast<std::int32_t>(to_chars_len_10(d.mantissa));
+    const std::int32_t exp = d.exponent;
+    const std::int32_t sci_exp = exp + olength - 1;
+    const std::int32_t abs_sci_exp = sci_exp < 0 ? -sci_exp : sci_exp;
+
+    std::int32_t fixed_len;
+    if (exp >= 0) {
+        fixed_len = olength + exp;
+    } else if (-exp < olength) {
+        fixed_len = olength + 1;
+    } else {
+        fixed_len = 2 - exp;
+    }
+    const std::int32_t sci_len =
+        olength + (olength > 1) + 2 + (abs_sci_exp >= 100 ? 3 : 2);
+    char exact[40];
+    if (exp > 0 && fixed_len <= sci_len) {
+        fixed_len = ryu_exact_integer(exact, m2, e2);
+    }
+    const bool use_fixed = fixed_len <= sci_len;
+    const std::int32_t total =
+        (use_fixed ? fixed_len : sci_len) + (negative ? 1 : 0);
+    if (last - first < total) {
+        return {last, std::errc::value_too_large};
+    }
+
+    char *p = first;
+    if (negative) {
+        *p++ = '-';
+    }
+    if (use_fixed) {
+        if (exp > 0) {
+            std::memcpy(p, exact, fixed_len);
+            p += fixed_len;
+        } else if (exp == 0) {
+            to_chars_10_impl(p, olength, d.mantissa);
+            p += olength;
+        } else if (-exp < olength) {
+            // 小数点落在数字中间：先写在后移一位的位置，再把整数部分前移
+            const std::int32_t int_len = olength + exp;
+            to_chars_10_impl(p + 1, olength, d.mantissa);
+            std::memmove(p, p + 1, int_len);
+            p[int_len] = '.';
+            p += olength + 1;
+        } else {
+            const std::int32_t zeros = -exp - olength;
+            *p++ = '0';
+            *p++ = '.';
+            std::memset(p, '0', zeros);
+            p += zeros;
+            to_chars_10_impl(p, olength, d.mantissa);
+            p += olength;
+        }
+    } else {
+        to_chars_10_impl(p + 1, olength, d.mantissa);
+        p[0] = p[1];
+        if (olength > 1) {
+            p[1] = '.';
+            p += olength + 1;
+        } else {
+            p += 1;
+        }
+        *p++ = 'e';
+        *p++ = sci_exp < 0 ? '-' : '+';
+        if (abs_sci_exp >= 100) {
+            *p++ = static_cast<char>('0' + abs_sci_exp / 100);
+        }
+        const char *digits = charconv_digits<>::pairs + (abs_sci_exp % 100) * 2;
+        *p++ = digits[0];
+        *p++ = digits[1];
+    }
+    return {p, std::errc()};
+}
+
+// 浮点类型的位布局
+template <class Float> struct float_layout;
+
+template <> struct float_layout<float> {
+    typedef std::uint32_t bits_type;
+    enum { mantissa_bits = 23, exponent_bits = 8, bias = 127 };
+};
+
+template <> struct float_layout<double> {
+    typedef std::uint64_t bits_type;
+    enum { mantissa_bits = 52, exponent_bits = 11, bias = 1023 };
+};
+
+template <class Float>
+to_chars_result to_chars_shortest(char *first, char *last,
+                                  Float value) noexcept {
+    typedef float_layout<Float> layout;
+    typedef typename layout::bits_type bits_type;
+    bits_type bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const bool negative =
+        ((bits >> (layout::mantissa_bits + layout::exponent_bits)) & 1) != 0;
+    const std::uint64_t mantissa =
+        bits & ((bits_type(1) << layout::mantissa_bits) - 1);
+    const std::uint32_t exponent = static_cast<std::uint32_t>(
+        (bits >> layout::mantissa_bits) &
+        ((1u << layout::exponent_bits) - 1));
+
+    if (exponent == (1u << layout::exponent_bits) - 1 ||
+        (exponent == 0 && mantissa == 0)) {
+        const char *text =
+            exponent == 0 ? "0" : (mantissa != 0 ? "nan" : "inf");
+        const std::size_t len = std::strlen(text);
+        if (static_cast<std::size_t>(last - first) < len + negative) {
+            return {last, std::errc::value_too_large};
+        }
+        if (negative) {
+            *first++ = '-';
+        }
+        std::memcpy(first, text, len);
+        return {first + len, std::errc()};
+    }
+
+    std::uint64_t m2;
+    std::int32_t e2;
+    if (exponent == 0) {
+        m2 = mantissa;
+        e2 = 1 - layout::bias - layout::mantissa_bits - 2;
+    } else {
+        m2 = (std::uint64_t(1) << layout::mantissa_bits) | mantissa;
+        e2 = static_cast<std::int32_t>(exponent) - layout::bias -
+             layout::mantissa_bits - 2;
+    }
+    const std::uint32_t mm_shift = mantissa != 0 || exponent <= 1;
+    return ryu_format(first, last, negative, ryu_shortest(m2, e2, mm_shift),
+                      m2, e2 + 2);
+}
+
+/**
+ *  @brief  将浮点数转换为可往返的最短字符序列
+ *
+ *  输出与 std::to_chars(first, last, value) 相同：在定点与科学计数法中选择较
+ *  短的一种，且按 from_chars 解析后得到原值。
+ */
+inline to_chars_result to_chars(char *first, char *last, double value) noexcept {
+    return to_chars_shortest(first, last, value);
+}
+
+inline to_chars_result to_chars(char *first, char *last, float value) noexcept {
+    return to_chars_shortest(first, last, value);
+}
+
+/*
+ * 整数解析
+ * */
+
+// 8 个字节是否全为 '0' ~ '9'
+inline bool swar_is_eight_digits(std::uint64_t v) noexcept {
+    return (((v & 0xF0F0F0F0F0F0F0F0u) |
+             (((v + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) ==
+            0x3333333333333333u);
+}
+
+// 将小端序读入的 8 个数字字符转换为整数
+inline std::uint32_t swar_parse_eight_digits(std::uint64_t v) noexcept {
+    const std::uint64_t mask = 0x000000FF000000FFu;
+    const std::uint64_t mul1 = 0x000F424000000064u; // 100 + (1000000 << 32)
+    const std::uint64_t mul2 = 0x0000271000000001u; // 1 + (10000 << 32)
+    v -= 0x3030303030303030u;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<std::uint32_t>(v);
+}
+
+inline bool swar_little_endian() noexcept {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+    return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#else
+    return false;
+#endif
+}
+
+/**
+ *  @brief  解析十进制数字，溢出时继续消耗数字并置位 overflow
+ *  @return  第一个非数字字符的位置
+ */
+inline const char *parse_digits_10(const char *first, const char *last,
+                                   std::uint64_t &acc,
+                                   bool &overflow) noexcept {
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    if (swar_little_endian()) {
+        while (last - first >= 8) {
+            std::uint64_t v;
+            std::memcpy(&v, first, 8);
+            if (!swar_is_eight_digits(v)) {
+                break;
+            }
+            const std::uint64_t chunk = swar_parse_eight_digits(v);
+            if (acc > (max - chunk) / 100000000u) {
+                overflow = true;
+            } else {
+                acc = acc * 100000000u + chunk;
+            }
+            first += 8;
+        }
+    }
+    for (; first != last; ++first) {
+        const unsigned d = static_cast<unsigned char>(*first) - '0';
+        if (d > 9) {
+            break;
+        }
+        if (acc > (max - d) / 10) {
+            overflow = true;
+        } else {
+            acc = acc * 10 + d;
+        }
+    }
+    return first;
+}
+
+inline const char *parse_digits_base(const char *first, const char *last,
+                                     std::uint64_t &acc, bool &overflow,
+                                     unsigned base) noexcept {
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    for (; first != last; ++first) {
+        const unsigned char c = static_cast<unsigned char>(*first);
+        unsigned d;
+        if (c >= '0' && c <= '9') {
+            d = c - '0';
+        } else if (c >= 'a' && c <= 'z') {
+            d = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'Z') {
+            d = c - 'A' + 10;
+        } else {
+            break;
+        }
+        if (d >= base) {
+            break;
+        }
+        if (acc > (max - d) / base) {
+            overflow = true;
+        } else {
+            acc = acc * base + d;
+        }
+    }
+    return first;
+}
+
+/**
+ *  @brief  从字符序列解析整数
+ *  @param  first  输入区间的起点
+ *  @param  last  输入区间的终点
+ *  @param  value  解析结果，失败时不被修改
+ *  @param  base  进制，取值范围为 [2, 36]
+ *  @return  ptr 指向第一个未被解析的字符。没有匹配的数字时 ec 为
+ *           invalid_argument 且 ptr == first；超出 Integer 的范围时 ec 为
+ *           result_out_of_range
+ *
+ *  只有有符号类型接受前导 '-'，不接受 '+' 或空白。
+ */
+template <class Integer>
+typename std::enable_if<std::is_integral<Integer>::value &&
+                            !std::is_same<Integer, bool>::value,
+                        from_chars_result>::type
+from_chars(const char *first, const char *last, Integer &value,
+           int base = 10) noexcept {
+    const char *p = first;
+    bool negative = false;
+    if (std::is_signed<Integer>::value && p != last && *p == '-') {
+        negative = true;
+        ++p;
+    }
+
+    std::uint64_t acc = 0;
+    bool overflow = false;
+    const char *digits_end =
+        base == 10 ? parse_digits_10(p, last, acc, overflow)
+                   : parse_digits_base(p, last, acc, overflow,
+                                       static_cast<unsigned>(base));
+    if (digits_end == p) {
+        return {first, std::errc::invalid_argument};
+    }
+
+    typedef typename std::make_unsigned<Integer>::type unsigned_type;
+    const std::uint64_t max = static_cast<std::uint64_t>(
+        static_cast<unsigned_type>(std::numeric_limits<Integer>::max()));
+    const std::uint64_t limit = negative ? max + 1 : max;
+    if (overflow || acc > limit) {
+        return {digits_end, std::errc::result_out_of_range};
+    }
+    unsigned_type magnitude = static_cast<unsigned_type>(acc);
+    if (negative) {
+        magnitude = static_cast<unsigned_type>(unsigned_type(0) - magnitude);
+    }
+    value = static_cast<Integer>(magnitude);
+    return {digits_end, std::errc()};
+}
+
+/*
+ * 浮点数解析
+ * */
+
+inline bool charconv_match_ci(const char *first, const char *last,
+                              const char *word) noexcept {
+    for (; *word; ++word, ++first) {
+        if (first == last || (*first | 0x20) != *word) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Float> struct float_parse_traits;
+
+template <> struct float_parse_traits<float> {
+    // 可以精确表示的最大尾数与 10 的幂
+    static constexpr std::uint64_t max_exact_mantissa = std::uint64_t(1) << 24;
+    static constexpr int max_exact_pow10 = 10;
+    static float pow10(int e) noexcept {
+        static const float table[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                      1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        return table[e];
+    }
+};
+
+template <> struct float_parse_traits<double> {
+    static constexpr std::uint64_t max_exact_mantissa = std::uint64_t(1) << 53;
+    static constexpr int max_exact_pow10 = 22;
+    static double pow10(int e) noexcept {
+        static const double table[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        return table[e];
+    }
+};
+
+/*
+ * charconv_decimal
+ * 浮点数解析的慢速路径：十进制大数 0.d[0]d[1]...d[nd-1] * 10^dp，每位保存
+ * 0 到 9。反复乘除 2 的幂把值移到 [0.5, 1)，记下移动的位数作为二进制指数，
+ * 再取出尾数并按“四舍六入五成双”舍入（Go strconv 的 decimal 算法）。
+ * 正确舍入最多需要 767 位有效数字，超出 S_max_digits 的非零数字只记为 trunc
+ * */
+struct charconv_decimal {
+    enum { S_max_digits = 800, S_max_shift = 60 };
+
+    unsigned char d[S_max_digits];
+    int nd;
+    int dp;
+    bool trunc;
+
+    charconv_decimal() noexcept : nd(0), dp(0), trunc(false) {}
+
+    /**
+     *  @brief  读入 [first, last) 中的数字与至多一个小数点
+     */
+    void assign(const char *first, const char *last) noexcept {
+        bool saw_dot = false;
+        for (; first != last; ++first) {
+            if (*first == '.') {
+                saw_dot = true;
+                dp = nd;
+                continue;
+            }
+            const unsigned char c = static_cast<unsigned char>(*first - '0');
+            if (c == 0 && nd == 0) {
+                --dp; // 前导零
+                continue;
+            }
+            if (nd < S_max_digits) {
+                d[nd++] = c;
+            } else if (c != 0) {
+                trunc = true;
+            }
+        }
+        if (!saw_dot) {
+            dp = nd;
+        }
+    }
+
+    void trim() noexcept {
+        while (nd > 0 && d[nd - 1] == 0) {
+            --nd;
+        }
+        if (nd == 0) {
+            dp = 0;
+        }
+    }
+
+    // 乘以 2^k，k <= S_max_shift。从低位向高位写入临时缓冲区，再复制回来
+    void left_shift(unsigned k) noexcept {
+        unsigned char tmp[S_max_digits + 20];
+        int w = nd + 20;
+        const int end = w;
+        std::uint64_t n = 0;
+        for (int r = nd - 1; r >= 0; --r) {
+            n += static_cast<std::uint64_t>(d[r]) << k;
+            tmp[--w] = static_cast<unsigned char>(n % 10);
+            n /= 10;
+        }
+        for (; n > 0; n /= 10) {
+            tmp[--w] = static_cast<unsigned char>(n % 10);
+        }
+        const int count = end - w;
+        const int kept = count < S_max_digits ? count : S_max_digits;
+        for (int i = kept; i < count; ++i) {
+            if (tmp[w + i] != 0) {
+                trunc = true;
+            }
+        }
+        std::memcpy(d, tmp + w, static_cast<std::size_t>(kept));
+        dp += count - nd;
+        nd = kept;
+        trim();
+    }
+
+    // 除以 2^k，k <= S_max_shift
+    void right_shift(unsigned k) noexcept {
+        int r = 0;
+        int w = 0;
+        std::uint64_t n = 0;
+        // 读入足够的高位，使第一次相除的商不为零
+        for (; (n >> k) == 0; ++r) {
+            if (r >= nd) {
+                if (n == 0) {
+                    nd = 0;
+                    return;
+                }
+                while ((n >> k) == 0) {
+                    n *= 10;
+                    ++r;
+                }
+                break;
+            }
+            n = n * 10 + d[r];
+        }
+        dp -= r - 1;
+        const std::uint64_t mask = (std::uint64_t(1) << k) - 1;
+        for (; r < nd; ++r) {
+            d[w++] = static_cast<unsigned char>(n >> k);
+            n = (n & mask) * 10 + d[r];
+        }
+        for (; n > 0; n = (n & mask) * 10) {
+            const unsigned char dig = static_cast<unsigned char>(n >> k);
+            if (w < S_max_digits) {
+                d[w++] = dig;
+            } else if (dig > 0) {
+                trunc = true;
+            }
+        }
+        nd = w;
+        trim();
+    }
+
+    // 乘以 2^k，k 为负数时除以 2^-k
+    void shift(int k) noexcept {
+        if (nd == 0) {
+            return;
+        }
+        for (; k > S_max_shift; k -= S_max_shift) {
+            left_shift(S_max_shift);
+        }
+        for (; k < -S_max_shift; k += S_max_shift) {
+            right_shift(S_max_shift);
+        }
+        if (k > 0) {
+            left_shift(static_cast<unsigned>(k));
+        } else if (k < 0) {
+            right_shift(static_cast<unsigned>(-k));
+        }
+    }
+
+    // 整数部分，按小数部分舍入到最近，恰好一半时取偶数
+    std::uint64_t rounded_integer() const noexcept {
+        std::uint64_t n = 0;
+        int i = 0;
+        for (; i < dp && i < nd; ++i) {
+            n = n * 10 + d[i];
+        }
+        for (; i < dp; ++i) {
+            n *= 10;
+        }
+        if (dp >= 0 && dp < nd) {
+            bool up = d[dp] >= 5;
+            if (d[dp] == 5 && dp + 1 == nd && !trunc) {
+                up = dp > 0 && d[dp - 1] % 2 == 1;
+            }
+            n += up ? 1 : 0;
+        }
+        return n;
+    }
+
+    /**
+     *  @brief  转换为 Float 的位表示
+     *  @return  超出 Float 的范围（上溢或非零值下溢为 0）时返回 false
+     */
+    template <class Float>
+    bool to_bits(typename float_layout<Float>::bits_type &bits) noexcept {
+        typedef float_layout<Float> layout;
+        typedef typename layout::bits_type bits_type;
+        const int max_biased = (1 << layout::exponent_bits) - 1;
+        if (nd == 0) {
+            bits = 0;
+            return true;
+        }
+        // 明显的上溢与下溢，界限对 double 也足够宽
+        if (dp > 310) {
+            return false;
+        }
+        if (dp < -330) {
+            return false;
+        }
+        // 移到 [0.5, 1)，每次移动的位数由十进制指数估计
+        static const int pow_tab[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+        const int tab_size = static_cast<int>(sizeof(pow_tab) / sizeof(int));
+        int exp = 0;
+        while (dp > 0) {
+            const int n = dp >= tab_size ? 27 : pow_tab[dp];
+            shift(-n);
+            exp += n;
+        }
+        while (dp < 0 || (dp == 0 && d[0] < 5)) {
+            const int n = -dp >= tab_size ? 27 : pow_tab[-dp];
+            shift(n);
+            exp -= n;
+        }
+        // [0.5, 1) 转为 [1, 2)
+        --exp;
+        // 低于最小的规格化指数时按非规格化数处理
+        if (exp < 1 - layout::bias) {
+            shift(-(1 - layout::bias - exp));
+            exp = 1 - layout::bias;
+        }
+        if (exp + layout::bias >= max_biased) {
+            return false;
+        }
+        shift(1 + layout::mantissa_bits);
+        std::uint64_t mant = rounded_integer();
+        // 舍入进位多出一位
+        if (mant == std::uint64_t(2) << layout::mantissa_bits) {
+            mant >>= 1;
+            ++exp;
+            if (exp + layout::bias >= max_biased) {
+                return false;
+            }
+        }
+        int biased = exp + layout::bias;
+        if ((mant & (std::uint64_t(1) << layout::mantissa_bits)) == 0) {
+            biased = 0;
+            if (mant == 0) {
+                return false;
+            }
+        }
+        bits = static_cast<bits_type>(
+            (mant & ((std::uint64_t(1) << layout::mantissa_bits) - 1)) |
+            (static_cast<std::uint64_t>(biased) << layout::mantissa_bits));
+        return true;
+    }
+};
+
+/**
+ *  @brief  解析十进制浮点数
+ *
+ *  尾数不超过 2^53 且十进制指数绝对值不超过 22 时（绝大多数度量数据属于这种
+ *  情况）可以用一次精确的乘除法得到正确舍入的结果；其余情况使用
+ *  charconv_decimal，不分配内存，也不受 locale 影响。
+ */
+template <class Float>
+from_chars_result from_chars_float(const char *first, const char *last,
+                                   Float &value) noexcept {
+    typedef float_parse_traits<Float> traits;
+    const char *p = first;
+    const bool negative = p != last && *p == '-';
+    if (negative) {
+        ++p;
+    }
+
+    // inf / infinity / nan / nan(n-char-sequence)
+    if (p != last && ((*p | 0x20) == 'i' || (*p | 0x20) == 'n')) {
+        if (charconv_match_ci(p, last, "inf")) {
+            p += charconv_match_ci(p, last, "infinity") ? 8 : 3;
+            value = negative ? -std::numeric_limits<Float>::infinity()
+                             : std::numeric_limits<Float>::infinity();
+            return {p, std::errc()};
+        }
+        if (charconv_match_ci(p, last, "nan")) {
+            p += 3;
+            if (p != last && *p == '(') {
+                const char *q = p + 1;
+                while (q != last &&
+                       (*q == '_' || (*q >= '0' && *q <= '9') ||
+                        ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z'))) {
+                    ++q;
+                }
+                if (q != last && *q == ')') {
+                    p = q + 1;
+                }
+            }
+            value = negative ? -std::numeric_limits<Float>::quiet_NaN()
+                             : std::numeric_limits<Float>::quiet_NaN();
+            return {p, std::errc()};
+        }
+        return {first, std::errc::invalid_argument};
+    }
+
+    // 尾数最多保留 19 位有效数字
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exp10 = 0;
+    bool truncated = false;
+    const char *int_begin = p;
+    while (p != last && *p == '0') {
+        ++p;
+    }
+    const char *sig_begin = p;
+    bool overflow = false;
+    p = parse_digits_10(p, last, mantissa, overflow);
+    digits = static_cast<int>(p - sig_begin);
+    bool any_digits = p != int_begin;
+    if (p != last && *p == '.') {
+        ++p;
+        const char *frac_begin = p;
+        if (digits == 0) {
+            // 跳过小数点后的前导零
+            while (p != last && *p == '0') {
+                ++p;
+            }
+            exp10 -= static_cast<int>(p - frac_begin);
+        }
+        const char *frac_sig = p;
+        std::uint64_t frac_acc = mantissa;
+        p = parse_digits_10(p, last, frac_acc, overflow);
+        const int frac_digits = static_cast<int>(p - frac_sig);
+        if (!overflow) {
+            mantissa = frac_acc;
+        }
+        digits += frac_digits;
+        exp10 -= frac_digits;
+        any_digits = any_digits || p != frac_begin;
+    }
+    if (!any_digits) {
+        return {first, std::errc::invalid_argument};
+    }
+    truncated = overflow || digits > 19;
+    const char *mantissa_end = p;
+    int exp_value = 0;
+
+    if (p != last && (*p | 0x20) == 'e') {
+        const char *q = p + 1;
+        bool exp_negative = false;
+        if (q != last && (*q == '+' || *q == '-')) {
+            exp_negative = *q == '-';
+            ++q;
+        }
+        if (q != last && static_cast<unsigned>(*q - '0') <= 9) {
+            int e = 0;
+            for (; q != last && static_cast<unsigned>(*q - '0') <= 9; ++q) {
+                if (e < 100000) {
+                    e = e * 10 + (*q - '0');
+                }
+            }
+            exp_value = exp_negative ? -e : e;
+            exp10 += exp_value;
+            p = q;
+        }
+    }
+
+    if (!truncated) {
+        if (mantissa == 0) {
+            value = negative ? -Float(0) : Float(0);
+            return {p, std::errc()};
+        }
+        if (mantissa <= traits::max_exact_mantissa &&
+            exp10 >= -traits::max_exact_pow10 &&
+            exp10 <= traits::max_exact_pow10) {
+            Float result = static_cast<Float>(mantissa);
+            if (exp10 < 0) {
+                result /= traits::pow10(-exp10);
+            } else {
+                result *= traits::pow10(exp10);
+            }
+            value = negative ? -result : result;
+            return {p, std::errc()};
+        }
+    }
+
+    // 慢速路径
+    charconv_decimal dec;
+    dec.assign(int_begin, mantissa_end);
+    dec.dp += exp_value;
+    typename float_layout<Float>::bits_type bits = 0;
+    if (!dec.to_bits<Float>(bits)) {
+        return {p, std::errc::result_out_of_range};
+    }
+    Float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    value = negative ? -result : result;
+    return {p, std::errc()};
+}
+
+/**
+ *  @brief  从字符序列解析浮点数，接受定点与科学计数法
+ *  @return  与整数版本相同；结果超出类型的范围时 ec 为 result_out_of_range
+ */
+inline from_chars_result from_chars(const char *first, const char *last,
+                                    double &value) noexcept {
+    return from_chars_float(first, last, value);
+}
+
+inline from_chars_result from_chars(const char *first, const char *last,
+                                    float &value) noexcept {
+    return from_chars_float(first, last, value);
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_CHARCONV_H
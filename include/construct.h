@@ -15,7 +15,7 @@ template <class Ty1, class Ty2> void construct(Ty1 *ptr, const Ty2 &value) {
 }
 
 template <class Ty, class... Args> void construct(Ty *ptr, Args &&...args) {
-    ::new ((void *)ptr) Ty(forward<Args>(args)...);
+    ::new ((void *)ptr) Ty(easystl::forward<Args>(args)...);
 }
 
 template <class Ty> void destroy_one(Ty *, std::true_type) {};
@@ -26,6 +26,10 @@ template <class Ty> void destroy_one(Ty *pointer, std::false_type) {
     }
 }
 
+template <class Ty> void destroy(Ty *pointer) {
+    destroy_one(pointer, std::is_trivially_destructible<Ty>{});
+}
+
 template <class ForwardIter>
 void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
 
@@ -35,10 +39,6 @@ void destroy_cat(ForwardIter first, ForwardIter last, std::false_type) {
         destroy(&*first);
 }
 
-template <class Ty> void destroy(Ty *pointer) {
-    destroy_one(pointer, std::is_trivially_destructible<Ty>{});
-}
-
 template <class ForwardIter> void destroy(ForwardIter first, ForwardIter last) {
     destroy_cat(first, last,
                 std::is_trivially_destructible<
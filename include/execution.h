@@ -0,0 +1,82 @@
+#ifndef EASYSTL_EXECUTION_H
+#define EASYSTL_EXECUTION_H
+
+// 执行策略
+//
+// 作为 parallel_algo.h 中算法的第一个参数：
+//     easystl::sort(easystl::execution::par, first, last);
+// seq 在调用线程中顺序执行；par 与 par_unseq 把区间分块交给调度器，元素个数
+// 少于粒度（grain）时同样顺序执行。粒度与调度器可以按调用指定：
+//     easystl::fill(easystl::execution::par.with_grain(1 << 20).on(pool),
+//                   first, last, 0);
+
+#include "type_traits.h"
+#include <cstddef>
+#include <type_traits>
+
+// 并行算法默认的粒度：每一块至少包含的元素个数
+#ifndef EASYSTL_PARALLEL_GRAIN
+#define EASYSTL_PARALLEL_GRAIN (std::size_t(1) << 14)
+#endif
+
+namespace easystl {
+
+class scheduler;
+typedef scheduler thread_pool;
+
+namespace execution {
+
+struct sequenced_policy {};
+
+struct parallel_policy {
+    std::size_t grain;
+    // 为 nullptr 时使用 scheduler::instance()
+    scheduler *pool;
+
+    constexpr parallel_policy() noexcept
+        : grain(EASYSTL_PARALLEL_GRAIN), pool(nullptr) {}
+    constexpr parallel_policy(std::size_t g, scheduler *p) noexcept
+        : grain(g == 0 ? 1 : g), pool(p) {}
+
+    constexpr parallel_policy with_grain(std::size_t g) const noexcept {
+        return parallel_policy(g, pool);
+    }
+    constexpr parallel_policy on(scheduler &p) const noexcept {
+        return parallel_policy(grain, &p);
+    }
+};
+
+// 每一块内部的循环交给编译器向量化，分块方式与 par 相同
+struct parallel_unsequenced_policy : parallel_policy {
+    constexpr parallel_unsequenced_policy() noexcept : parallel_policy() {}
+    constexpr parallel_unsequenced_policy(std::size_t g,
+                                          scheduler *p) noexcept
+        : parallel_policy(g, p) {}
+
+    constexpr parallel_unsequenced_policy
+    with_grain(std::size_t g) const noexcept {
+        return parallel_unsequenced_policy(g, pool);
+    }
+    constexpr parallel_unsequenced_policy on(scheduler &p) const noexcept {
+        return parallel_unsequenced_policy(grain, &p);
+    }
+};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{};
+constexpr parallel_unsequenced_policy par_unseq{};
+
+} // namespace execution
+
+template <class T> struct is_execution_policy : m_false_type {};
+template <>
+struct is_execution_policy<execution::sequenced_policy> : m_true_type {};
+template <>
+struct is_execution_policy<execution::parallel_policy> : m_true_type {};
+template <>
+struct is_execution_policy<execution::parallel_unsequenced_policy>
+    : m_true_type {};
+
+} // namespace easystl
+
+#endif // !EASYSTL_EXECUTION_H
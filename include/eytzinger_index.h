@@ -0,0 +1,206 @@
+#ifndef EASYSTL_EYTZINGER_INDEX_H
+#define EASYSTL_EYTZINGER_INDEX_H
+
+// Eytzinger 布局的只读查找表
+//
+// 把有序序列按照二叉堆的顺序存放：下标 k 的两个孩子位于 2k 与 2k + 1。查找时
+// 从根开始每一步只依赖一次比较的结果，访问的位置在数组中是连续向后的，每个缓
+// 存行包含的若干层后代可以提前预取。元素很多、不能放入缓存时比在有序数组上
+// 二分查找快数倍（Khuong 与 Morin, "Array Layouts for Comparison-Based
+// Searching"）。
+//
+// 构造后不能修改，适合读多写少的查找表：
+//     easystl::eytzinger_index<int> index(sorted_keys);
+//     std::size_t i = index.lower_bound(key);  // 在 sorted_keys 中的下标
+
+#include "functional.h"
+#include "utility.h"
+#include "vector.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace easystl {
+
+template <class T, class Compare = easystl::less<T>> class eytzinger_index {
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef Compare value_compare;
+    typedef const T &const_reference;
+
+  private:
+    // 下标从 1 开始，M_tree[0] 不使用
+    vector<T> M_tree;
+    Compare M_comp;
+
+  public:
+    eytzinger_index() : M_tree(), M_comp() {}
+
+    /**
+     *  @brief  由已按 @a comp 排序的 [first, last) 构造
+     */
+    template <class RandomIter>
+    eytzinger_index(RandomIter first, RandomIter last,
+                    const Compare &comp = Compare())
+        : M_tree(), M_comp(comp) {
+        M_build(first, static_cast<size_type>(last - first));
+    }
+
+    explicit eytzinger_index(const vector<T> &sorted,
+                             const Compare &comp = Compare())
+        : M_tree(), M_comp(comp) {
+        M_build(sorted.begin(), sorted.size());
+    }
+
+    size_type size() const noexcept {
+        return M_tree.empty() ? 0 : M_tree.size() - 1;
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     *  @brief  第一个不小于 @a value 的元素在原有序序列中的下标
+     *  @return  所有元素都小于 value 时返回 size()
+     */
+    size_type lower_bound(const T &value) const {
+        const size_type k = M_search(value);
+        return k == 0 ? size() : M_rank(k);
+    }
+
+    /**
+     *  @brief  第一个不小于 @a value 的元素
+     *  @return  所有元素都小于 value 时返回 nullptr
+     */
+    const T *find_lower_bound(const T &value) const {
+        const size_type k = M_search(value);
+        return k == 0 ? nullptr : &M_tree[k];
+    }
+
+    bool contains(const T &value) const {
+        const size_type k = M_search(value);
+        return k != 0 && !M_comp(value, M_tree[k]);
+    }
+
+    // 按照原有序序列的下标访问元素
+    const_reference operator[](size_type i) const {
+        return M_tree[M_position(i)];
+    }
+
+  private:
+    template <class RandomIter> void M_build(RandomIter first, size_type n) {
+        if (n == 0) {
+            return;
+        }
+        M_tree.assign(n + 1, *first);
+        M_fill(first, 0, 1);
+    }
+
+    // 按中序遍历依次填入第 i 个有序元素，返回下一个要填入的下标
+    template <class RandomIter>
+    size_type M_fill(RandomIter first, size_type i, size_type k) {
+        if (k < M_tree.size()) {
+            i = M_fill(first, i, 2 * k);
+            M_tree[k] = first[static_cast<std::ptrdiff_t>(i++)];
+            i = M_fill(first, i, 2 * k + 1);
+        }
+        return i;
+    }
+
+    // 返回第一个不小于 value 的元素在 M_tree 中的下标，不存在时返回 0
+    size_type M_search(const T &value) const {
+        const size_type n = size();
+        const T *tree = M_tree.data();
+        // 一个缓存行中的元素个数；预取 log2(B) 层以后的后代所在的缓存行
+        const size_type block = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+        size_type k = 1;
+        while (k <= n) {
+#if defined(__GNUC__)
+            __builtin_prefetch(reinterpret_cast<const void *>(
+                reinterpret_cast<std::uintptr_t>(tree) +
+                k * block * sizeof(T)));
+#endif
+            k = 2 * k + (M_comp(tree[k], value) ? 1 : 0);
+        }
+        // 最后一次向左走的位置即为答案：去掉末尾连续的 1 以及其上的一个 0
+        k >>= M_trailing_ones(k) + 1;
+        return k;
+    }
+
+    static unsigned M_trailing_ones(size_type k) noexcept {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(
+            __builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+        unsigned n = 0;
+        for (; k & 1; k >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    // 结点 k 的深度，要求 k > 0
+    static unsigned M_depth(size_type k) noexcept {
+#if defined(__GNUC__)
+        return 63u - static_cast<unsigned>(
+                         __builtin_clzll(static_cast<unsigned long long>(k)));
+#else
+        unsigned d = 0;
+        for (; k > 1; k >>= 1) {
+            ++d;
+        }
+        return d;
+#endif
+    }
+
+    // 以 k 为根的子树的结点个数：除最后一层外都是满的
+    size_type M_subtree_size(size_type k) const noexcept {
+        const size_type n = size();
+        if (k > n) {
+            return 0;
+        }
+        const unsigned h = M_depth(n) - M_depth(k);
+        const size_type width = size_type(1) << h;
+        const size_type first = k << h;
+        size_type count = width - 1;
+        if (first <= n) {
+            count += n - first + 1 < width ? n - first + 1 : width;
+        }
+        return count;
+    }
+
+    // M_tree[k] 在原有序序列中的下标，只做算术运算，不再访问内存。
+    // 先按补满最后一层的完全二叉树计算中序下标，再减去排在 k 之前、最后一层
+    // 中实际不存在的结点个数
+    size_type M_rank(size_type k) const noexcept {
+        const size_type n = size();
+        const unsigned last = M_depth(n);
+        const unsigned d = M_depth(k);
+        const size_type w = size_type(1) << (last - d);
+        const size_type offset = k - (size_type(1) << d);
+        const size_type rank = (2 * offset + 1) * w - 1;
+        // 最后一层中排在 k 之前的结点个数，以及最后一层实际存在的结点个数
+        const size_type before = offset * w + (w >> 1);
+        const size_type present = n - (size_type(1) << last) + 1;
+        return rank - (before > present ? before - present : 0);
+    }
+
+    // 原有序序列中第 i 个元素在 M_tree 中的下标
+    size_type M_position(size_type i) const noexcept {
+        size_type k = 1;
+        while (true) {
+            const size_type left = M_subtree_size(2 * k);
+            if (i < left) {
+                k = 2 * k;
+            } else if (i == left) {
+                return k;
+            } else {
+                i -= left + 1;
+                k = 2 * k + 1;
+            }
+        }
+    }
+};
+
+} // namespace easystl
+
+#endif // !EASYSTL_EYTZINGER_INDEX_H
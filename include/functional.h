@@ -0,0 +1,236 @@
+#ifndef EASYSTL_FUNCTIONAL_H
+#define EASYSTL_FUNCTIONAL_H
+
+// 函数对象与哈希函数
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace easystl {
+
+/*
+ * 比较用的函数对象
+ * */
+template <class T> struct less {
+    constexpr bool operator()(const T &x, const T &y) const { return x < y; }
+};
+
+template <class T> struct greater {
+    constexpr bool operator()(const T &x, const T &y) const { return x > y; }
+};
+
+template <class T> struct equal_to {
+    constexpr bool operator()(const T &x, const T &y) const { return x == y; }
+};
+
+/*
+ * 算术运算的函数对象
+ * */
+template <class T> struct plus {
+    constexpr T operator()(const T &x, const T &y) const { return x + y; }
+};
+
+/*
+ * 字节序列的哈希
+ * 使用 wyhash（https://github.com/wangyi-fudan/wyhash）的算法：每 16 个字节
+ * 做一次 64x64 -> 128 位乘法混合，长输入时三路乘法互不依赖，可以并行执行。
+ * */
+
+// 64x64 -> 128 位乘法，*a 保存低 64 位，*b 保存高 64 位
+inline void hash_mum(std::uint64_t *a, std::uint64_t *b) noexcept {
+#ifdef __SIZEOF_INT128__
+    typedef unsigned __int128 uint128;
+    const uint128 r = static_cast<uint128>(*a) * *b;
+    *a = static_cast<std::uint64_t>(r);
+    *b = static_cast<std::uint64_t>(r >> 64);
+#else
+    const std::uint64_t ha = *a >> 32, hb = *b >> 32;
+    const std::uint64_t la = *a & 0xFFFFFFFFu, lb = *b & 0xFFFFFFFFu;
+    const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la;
+    const std::uint64_t rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t c = t < rl;
+    const std::uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept {
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+inline std::uint64_t hash_read8(const unsigned char *p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline std::uint64_t hash_read4(const unsigned char *p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+// 1 到 3 个字节
+inline std::uint64_t hash_read3(const unsigned char *p,
+                                std::size_t k) noexcept {
+    return (static_cast<std::uint64_t>(p[0]) << 16) |
+           (static_cast<std::uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+template <class Tp = void> struct hash_secret {
+    static const std::uint64_t value[4];
+};
+
+template <class Tp>
+const std::uint64_t hash_secret<Tp>::value[4] = {
+    0x2d358dccaa6c78a5u, 0x8bb84b93962eacc9u, 0x4b33a62ed433d4a3u,
+    0x4d5a2da51de1aa47u};
+
+/**
+ *  @brief  计算字节序列的 64 位哈希值
+ *  @param  data  字节序列的起点
+ *  @param  len  字节数
+ *  @param  seed  种子，不同的种子得到互不相关的哈希函数
+ */
+inline std::uint64_t hash_bytes(const void *data, std::size_t len,
+                                std::uint64_t seed = 0) noexcept {
+    const std::uint64_t *secret = hash_secret<>::value;
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    seed ^= hash_mix(seed ^ secret[0], secret[1]);
+    std::uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            const std::size_t mid = (len >> 3) << 2;
+            a = (hash_read4(p) << 32) | hash_read4(p + mid);
+            b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = hash_read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = len;
+        if (i > 48) {
+            std::uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = hash_mix(hash_read8(p) ^ secret[1],
+                                hash_read8(p + 8) ^ seed);
+                see1 = hash_mix(hash_read8(p + 16) ^ secret[2],
+                                hash_read8(p + 24) ^ see1);
+                see2 = hash_mix(hash_read8(p + 32) ^ secret[3],
+                                hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = hash_mix(hash_read8(p) ^ secret[1],
+                            hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = hash_read8(p + i - 16);
+        b = hash_read8(p + i - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+    hash_mum(&a, &b);
+    return hash_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+/**
+ *  @brief  进程内固定的随机种子
+ *
+ *  第一次调用时由 random_device 与时钟生成。以它为种子的哈希函数，外部无法预
+ *  先构造大量冲突的键，可以抵御哈希洪泛攻击。
+ */
+inline std::uint64_t hash_seed() {
+    static const std::uint64_t seed = [] {
+        std::random_device rd;
+        const std::uint64_t r =
+            (static_cast<std::uint64_t>(rd()) << 32) ^ rd() ^
+            static_cast<std::uint64_t>(
+                std::chrono::high_resolution_clock::now()
+                    .time_since_epoch()
+                    .count());
+        return hash_mix(r, hash_secret<>::value[2]);
+    }();
+    return seed;
+}
+
+/*
+ * hash
+ * 对于大部分类型，hash 不做任何事情，需要为其提供特化版本
+ * */
+
+template <class Key> struct hash {};
+
+// 针对指针的偏特化版本
+template <class Tp> struct hash<Tp *> {
+    std::size_t operator()(Tp *p) const noexcept {
+        return reinterpret_cast<std::size_t>(p);
+    }
+};
+
+// 对于整型类型，只是返回原值
+#define EASYSTL_TRIVIAL_HASH_FCN(Type)                                         \
+    template <> struct hash<Type> {                                            \
+        std::size_t operator()(Type val) const noexcept {                      \
+            return static_cast<std::size_t>(val);                              \
+        }                                                                      \
+    };
+
+EASYSTL_TRIVIAL_HASH_FCN(bool)
+EASYSTL_TRIVIAL_HASH_FCN(char)
+EASYSTL_TRIVIAL_HASH_FCN(signed char)
+EASYSTL_TRIVIAL_HASH_FCN(unsigned char)
+EASYSTL_TRIVIAL_HASH_FCN(wchar_t)
+EASYSTL_TRIVIAL_HASH_FCN(char16_t)
+EASYSTL_TRIVIAL_HASH_FCN(char32_t)
+EASYSTL_TRIVIAL_HASH_FCN(short)
+EASYSTL_TRIVIAL_HASH_FCN(unsigned short)
+EASYSTL_TRIVIAL_HASH_FCN(int)
+EASYSTL_TRIVIAL_HASH_FCN(unsigned int)
+EASYSTL_TRIVIAL_HASH_FCN(long)
+EASYSTL_TRIVIAL_HASH_FCN(unsigned long)
+EASYSTL_TRIVIAL_HASH_FCN(long long)
+EASYSTL_TRIVIAL_HASH_FCN(unsigned long long)
+
+#undef EASYSTL_TRIVIAL_HASH_FCN
+
+// 对于浮点数，逐位哈希，+0.0 与 -0.0 得到相同的值
+template <> struct hash<float> {
+    std::size_t operator()(float val) const noexcept {
+        return val == 0.0f ? 0
+                           : static_cast<std::size_t>(
+                                 easystl::hash_bytes(&val, sizeof(float)));
+    }
+};
+
+template <> struct hash<double> {
+    std::size_t operator()(double val) const noexcept {
+        return val == 0.0 ? 0
+                          : static_cast<std::size_t>(
+                                easystl::hash_bytes(&val, sizeof(double)));
+    }
+};
+
+/*
+ * seeded_hash
+ * 带种子的哈希函数，默认使用 hash_seed()，需要为键类型提供特化版本
+ * */
+
+template <class Key> struct seeded_hash {};
+
+} // namespace easystl
+
+#endif // !EASYSTL_FUNCTIONAL_H
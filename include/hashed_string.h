@@ -0,0 +1,152 @@
+#ifndef EASYSTL_HASHED_STRING_H
+#define EASYSTL_HASHED_STRING_H
+
+// 缓存哈希值的不可变字符串
+//
+// 反复作为哈希表的键使用的字符串，每次查找都要重新遍历全部字符计算哈希值。
+// basic_hashed_string 在构造时计算一次哈希值并保存下来，之后 hash() 只是读取
+// 成员；比较相等时也先比较哈希值，不同的键通常不需要比较字符。
+//
+// 构造时使用的哈希函数对象也保存下来，release() 之后用它重新计算。带状态的
+// 哈希函数（例如不同种子的 seeded_hash）对相同内容可能得到不同的哈希值，
+// 此时 operator== 只比较内容。
+//
+// 哈希值没有放进 basic_string 本身：basic_string 的每个修改操作都必须让缓存
+// 失效，这会给所有字符串增加一个成员和一次写入。这里的字符串不允许修改，缓存
+// 永远有效。
+
+#include "basic_string.h"
+#include "functional.h"
+#include "utility.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace easystl {
+
+template <
+    class CharType, class CharTraits = easystl::char_traits<CharType>,
+    class Allocator = easystl::allocator<CharType>,
+    class Hash = easystl::hash<basic_string<CharType, CharTraits, Allocator>>>
+class basic_hashed_string {
+  public:
+    typedef basic_string<CharType, CharTraits, Allocator> string_type;
+    typedef typename string_type::size_type size_type;
+    typedef typename string_type::const_iterator const_iterator;
+    typedef Hash hasher;
+
+  private:
+    string_type M_str;
+    Hash M_hasher;
+    std::size_t M_hash;
+
+  public:
+    basic_hashed_string() : M_str(), M_hasher(), M_hash(M_hasher(M_str)) {}
+
+    basic_hashed_string(const CharType *s)
+        : M_str(s), M_hasher(), M_hash(M_hasher(M_str)) {}
+
+    basic_hashed_string(const CharType *s, size_type n)
+        : M_str(s, n), M_hasher(), M_hash(M_hasher(M_str)) {}
+
+    basic_hashed_string(const string_type &str)
+        : M_str(str), M_hasher(), M_hash(M_hasher(M_str)) {}
+
+    basic_hashed_string(string_type &&str)
+        : M_str(easystl::move(str)), M_hasher(), M_hash(M_hasher(M_str)) {}
+
+    /**
+     *  @brief  使用指定的哈希函数对象，例如带种子的 seeded_hash
+     */
+    basic_hashed_string(const string_type &str, const Hash &h)
+        : M_str(str), M_hasher(h), M_hash(M_hasher(M_str)) {}
+
+    basic_hashed_string(const basic_hashed_string &) = default;
+    basic_hashed_string(basic_hashed_string &&) = default;
+    basic_hashed_string &operator=(const basic_hashed_string &) = default;
+    basic_hashed_string &operator=(basic_hashed_string &&) = default;
+
+  public:
+    /**
+     *  @brief  构造时计算好的哈希值
+     */
+    std::size_t hash() const noexcept { return M_hash; }
+
+    hasher hash_function() const { return M_hasher; }
+
+    const string_type &str() const noexcept { return M_str; }
+    const CharType *c_str() const noexcept { return M_str.c_str(); }
+    const CharType *data() const noexcept { return M_str.data(); }
+    size_type size() const noexcept { return M_str.size(); }
+    size_type length() const noexcept { return M_str.size(); }
+    bool empty() const noexcept { return M_str.empty(); }
+    const_iterator begin() const noexcept { return M_str.begin(); }
+    const_iterator end() const noexcept { return M_str.end(); }
+    const CharType &operator[](size_type n) const noexcept { return M_str[n]; }
+
+    /**
+     *  @brief  取出内部的字符串，之后此对象为空字符串
+     */
+    string_type release() {
+        string_type result(easystl::move(M_str));
+        M_str.clear();
+        M_hash = M_hasher(M_str);
+        return result;
+    }
+
+    void swap(basic_hashed_string &rhs) noexcept {
+        M_str.swap(rhs.M_str);
+        easystl::swap(M_hasher, rhs.M_hasher);
+        easystl::swap(M_hash, rhs.M_hash);
+    }
+};
+
+template <class CharType, class CharTraits, class Allocator, class Hash>
+inline bool operator==(
+    const basic_hashed_string<CharType, CharTraits, Allocator, Hash> &lhs,
+    const basic_hashed_string<CharType, CharTraits, Allocator, Hash> &rhs) {
+    // 无状态的哈希函数对相同内容总是得到相同的哈希值，可以先比较哈希值；
+    // 带状态的哈希函数两侧可能不同，只能比较内容
+    if (std::is_empty<Hash>::value && lhs.hash() != rhs.hash()) {
+        return false;
+    }
+    return lhs.size() == rhs.size() &&
+           CharTraits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <class CharType, class CharTraits, class Allocator, class Hash>
+inline bool operator!=(
+    const basic_hashed_string<CharType, CharTraits, Allocator, Hash> &lhs,
+    const basic_hashed_string<CharType, CharTraits, Allocator, Hash> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <class CharType, class CharTraits, class Allocator, class Hash>
+inline bool operator<(
+    const basic_hashed_string<CharType, CharTraits, Allocator, Hash> &lhs,
+    const basic_hashed_string<CharType, CharTraits, Allocator, Hash> &rhs) {
+    return lhs.str() < rhs.str();
+}
+
+template <class CharType, class CharTraits, class Allocator, class Hash>
+inline void
+swap(basic_hashed_string<CharType, CharTraits, Allocator, Hash> &lhs,
+     basic_hashed_string<CharType, CharTraits, Allocator, Hash> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// 直接返回缓存的哈希值
+template <class CharType, class CharTraits, class Allocator, class Hash>
+struct hash<basic_hashed_string<CharType, CharTraits, Allocator, Hash>> {
+    std::size_t operator()(
+        const basic_hashed_string<CharType, CharTraits, Allocator, Hash> &str)
+        const noexcept {
+        return str.hash();
+    }
+};
+
+using hashed_string = basic_hashed_string<char>;
+using whashed_string = basic_hashed_string<wchar_t>;
+
+} // namespace easystl
+
+#endif // !EASYSTL_HASHED_STRING_H
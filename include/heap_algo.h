@@ -0,0 +1,279 @@
+#ifndef EASYSTL_HEAP_ALGO_H
+#define EASYSTL_HEAP_ALGO_H
+
+// 堆算法：push_heap, pop_heap, sort_heap, make_heap
+//
+// [first, last) 按二叉堆组织，下标 i 的子节点为 2i + 1 与 2i + 2，comp 为真
+// 表示左侧的元素排在右侧之后，默认 less 时为大根堆。
+//
+// 以分叉数 Arity 为第一个模板参数的版本按 d 叉堆组织，例如
+// easystl::push_heap<4>(first, last)：下标 i 的子节点为 Arity * i + 1 到
+// Arity * i + Arity。
+
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include <cstddef>
+
+namespace easystl {
+
+/*
+ * push_heap
+ * 新元素已经放在容器尾部，把它上浮到合适的位置
+ * */
+template <class RandomIter, class Distance, class T, class Compare>
+void push_heap_aux(RandomIter first, Distance hole, Distance top, T value,
+                   Compare comp) {
+    Distance parent = (hole - 1) / 2;
+    while (hole > top && comp(*(first + parent), value)) {
+        *(first + hole) = easystl::move(*(first + parent));
+        hole = parent;
+        parent = (hole - 1) / 2;
+    }
+    *(first + hole) = easystl::move(value);
+}
+
+template <class RandomIter, class Compare>
+void push_heap(RandomIter first, RandomIter last, Compare comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    const Distance len = last - first;
+    if (len > 1) {
+        auto value = easystl::move(*(last - 1));
+        push_heap_aux(first, len - 1, Distance(0), easystl::move(value), comp);
+    }
+}
+
+template <class RandomIter> void push_heap(RandomIter first, RandomIter last) {
+    easystl::push_heap(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/*
+ * adjust_heap
+ * 在 hole 处放入 value 并保持堆的性质：先沿较大的子节点把空洞下移到叶子，
+ * 再让 value 从叶子上浮，比逐层同时比较两个子节点与 value 少一半比较
+ * */
+template <class RandomIter, class Distance, class T, class Compare>
+void adjust_heap(RandomIter first, Distance hole, Distance len, T value,
+                 Compare comp) {
+    const Distance top = hole;
+    Distance child = 2 * hole + 2;
+    while (child < len) {
+        if (comp(*(first + child), *(first + (child - 1)))) {
+            --child;
+        }
+        *(first + hole) = easystl::move(*(first + child));
+        hole = child;
+        child = 2 * child + 2;
+    }
+    if (child == len) {
+        // 只有左子节点
+        *(first + hole) = easystl::move(*(first + (child - 1)));
+        hole = child - 1;
+    }
+    push_heap_aux(first, hole, top, easystl::move(value), comp);
+}
+
+/*
+ * pop_heap
+ * 把堆顶元素移到尾部，[first, last - 1) 重新调整为堆
+ * */
+template <class RandomIter, class Compare>
+void pop_heap(RandomIter first, RandomIter last, Compare comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    if (last - first > 1) {
+        --last;
+        auto value = easystl::move(*last);
+        *last = easystl::move(*first);
+        adjust_heap(first, Distance(0), Distance(last - first),
+                    easystl::move(value), comp);
+    }
+}
+
+template <class RandomIter> void pop_heap(RandomIter first, RandomIter last) {
+    easystl::pop_heap(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/*
+ * sort_heap
+ * 不断执行 pop_heap，得到按 comp 升序排列的序列
+ * */
+template <class RandomIter, class Compare>
+void sort_heap(RandomIter first, RandomIter last, Compare comp) {
+    while (last - first > 1) {
+        easystl::pop_heap(first, last--, comp);
+    }
+}
+
+template <class RandomIter> void sort_heap(RandomIter first, RandomIter last) {
+    easystl::sort_heap(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/*
+ * make_heap
+ * 从最后一个非叶子节点开始向前逐个调整，O(n)
+ * */
+template <class RandomIter, class Compare>
+void make_heap(RandomIter first, RandomIter last, Compare comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    const Distance len = last - first;
+    if (len < 2) {
+        return;
+    }
+    for (Distance hole = (len - 2) / 2;; --hole) {
+        auto value = easystl::move(*(first + hole));
+        adjust_heap(first, hole, len, easystl::move(value), comp);
+        if (hole == 0) {
+            return;
+        }
+    }
+}
+
+template <class RandomIter> void make_heap(RandomIter first, RandomIter last) {
+    easystl::make_heap(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/*
+ * d 叉堆
+ * 树高是二叉堆的 1 / log2(Arity)，下沉时每层在 Arity 个相邻的子节点中选出
+ * 最大的一个。元素很多、堆不能放入缓存时，每层的子节点在同一个或相邻的缓存行
+ * 中，缓存缺失的次数随树高减少；每层多出的比较只访问已经载入的缓存行。
+ * push 只做上浮，比较次数随树高减少；pop 每层要做 Arity - 1 次比较，
+ * 4 叉堆的总比较次数与二叉堆相当，8 叉堆更多，只在元素较大、复制与缓存缺失
+ * 占主要开销时才划算
+ * */
+template <std::size_t Arity, class RandomIter, class Distance, class T,
+          class Compare>
+void dary_push_heap_aux(RandomIter first, Distance hole, Distance top,
+                        T value, Compare &comp) {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+    while (hole > top) {
+        const Distance parent = (hole - 1) / static_cast<Distance>(Arity);
+        if (!comp(*(first + parent), value)) {
+            break;
+        }
+        *(first + hole) = easystl::move(*(first + parent));
+        hole = parent;
+    }
+    *(first + hole) = easystl::move(value);
+}
+
+// [first + child, first + child + n) 中按 comp 排在最后的元素，即最大的子节点
+template <class RandomIter, class Distance, class Compare>
+Distance dary_max_child(RandomIter first, Distance child, Distance n,
+                        Compare &comp) {
+    Distance best = child;
+    for (Distance i = child + 1; i < child + n; ++i) {
+        if (comp(*(first + best), *(first + i))) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// 与 adjust_heap 相同：空洞沿最大的子节点下移到叶子，再让 value 上浮
+template <std::size_t Arity, class RandomIter, class Distance, class T,
+          class Compare>
+void dary_adjust_heap(RandomIter first, Distance hole, Distance len, T value,
+                      Compare &comp) {
+    const Distance arity = static_cast<Distance>(Arity);
+    const Distance top = hole;
+    Distance child = arity * hole + 1;
+    while (child <= len - arity) {
+        const Distance best = dary_max_child(first, child, arity, comp);
+        *(first + hole) = easystl::move(*(first + best));
+        hole = best;
+        child = arity * hole + 1;
+    }
+    if (child < len) {
+        const Distance best = dary_max_child(first, child, len - child, comp);
+        *(first + hole) = easystl::move(*(first + best));
+        hole = best;
+    }
+    dary_push_heap_aux<Arity>(first, hole, top, easystl::move(value), comp);
+}
+
+template <std::size_t Arity, class RandomIter, class Compare>
+void push_heap(RandomIter first, RandomIter last, Compare comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    const Distance len = last - first;
+    if (len > 1) {
+        auto value = easystl::move(*(last - 1));
+        dary_push_heap_aux<Arity>(first, len - 1, Distance(0),
+                                  easystl::move(value), comp);
+    }
+}
+
+template <std::size_t Arity, class RandomIter>
+void push_heap(RandomIter first, RandomIter last) {
+    easystl::push_heap<Arity>(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+template <std::size_t Arity, class RandomIter, class Compare>
+void pop_heap(RandomIter first, RandomIter last, Compare comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    if (last - first > 1) {
+        --last;
+        auto value = easystl::move(*last);
+        *last = easystl::move(*first);
+        dary_adjust_heap<Arity>(first, Distance(0), Distance(last - first),
+                                easystl::move(value), comp);
+    }
+}
+
+template <std::size_t Arity, class RandomIter>
+void pop_heap(RandomIter first, RandomIter last) {
+    easystl::pop_heap<Arity>(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+template <std::size_t Arity, class RandomIter, class Compare>
+void sort_heap(RandomIter first, RandomIter last, Compare comp) {
+    while (last - first > 1) {
+        easystl::pop_heap<Arity>(first, last--, comp);
+    }
+}
+
+template <std::size_t Arity, class RandomIter>
+void sort_heap(RandomIter first, RandomIter last) {
+    easystl::sort_heap<Arity>(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+template <std::size_t Arity, class RandomIter, class Compare>
+void make_heap(RandomIter first, RandomIter last, Compare comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    const Distance len = last - first;
+    if (len < 2) {
+        return;
+    }
+    for (Distance hole = (len - 2) / static_cast<Distance>(Arity);; --hole) {
+        auto value = easystl::move(*(first + hole));
+        dary_adjust_heap<Arity>(first, hole, len, easystl::move(value), comp);
+        if (hole == 0) {
+            return;
+        }
+    }
+}
+
+template <std::size_t Arity, class RandomIter>
+void make_heap(RandomIter first, RandomIter last) {
+    easystl::make_heap<Arity>(
+        first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_HEAP_ALGO_H
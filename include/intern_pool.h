@@ -0,0 +1,373 @@
+#ifndef EASYSTL_INTERN_POOL_H
+#define EASYSTL_INTERN_POOL_H
+
+// 字符串驻留池
+//
+// basic_intern_pool 为每个不同的字符串内容分配一个 32 位句柄，内容只在池中保存
+// 一份。比较两个驻留字符串只需比较句柄，哈希值在驻留时计算一次并保存。
+//
+// 字符保存在由分配器申请的大块内存（arena）中，直到池被销毁都不会移动或释放，
+// view() 返回的视图在池的生命周期内一直有效。
+//
+// 并发：字符串到句柄的查找按哈希值分为 kShards 个分片，每个分片由各自的互斥锁
+// 保护，不同分片互不阻塞；句柄到视图、哈希值的查找不加锁，只读取一次原子指针。
+
+#include "alloc_traits.h"
+#include "basic_string.h"
+#include "char_traits.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "string_view.h"
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace easystl {
+
+template <class CharType, class CharTraits = easystl::char_traits<CharType>,
+          class Allocator = easystl::allocator<CharType>>
+class basic_intern_pool {
+  public:
+    typedef CharTraits traits_type;
+    typedef CharType value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef std::uint32_t handle;
+    typedef basic_string_view<CharType, CharTraits> view_type;
+
+    // find() 没有找到时返回的句柄
+    static constexpr handle npos = static_cast<handle>(-1);
+
+  private:
+    // 每个驻留字符串的记录，按句柄保存在分段数组中
+    struct entry {
+        const CharType *data;
+        size_type size;
+        std::size_t hash;
+    };
+
+    // 哈希表的槽位，保存哈希值的低 32 位，先比较它再比较字符
+    struct slot {
+        handle id;
+        std::uint32_t hash_lo;
+    };
+
+    // arena 的一块内存，字符紧跟在头部之后
+    struct block {
+        block *next;
+        size_type units;
+    };
+
+    // 按缓存行对齐，相邻分片的互斥锁不共享缓存行
+    struct alignas(64) shard {
+        std::mutex mutex;
+        slot *slots;
+        size_type mask; // 槽位数量减一，槽位数量为 0 或 2 的幂
+        size_type count;
+        block *blocks;
+        CharType *cur; // 当前块中未使用部分的起点
+        size_type left;
+    };
+
+    typedef easystl_cxx::alloc_traits<Allocator> char_alloc_traits;
+    typedef typename char_alloc_traits::template rebind<entry>::other
+        entry_alloc_type;
+    typedef typename char_alloc_traits::template rebind<slot>::other
+        slot_alloc_type;
+    typedef typename char_alloc_traits::template rebind<block>::other
+        block_alloc_type;
+    typedef easystl_cxx::alloc_traits<entry_alloc_type> entry_alloc_traits;
+    typedef easystl_cxx::alloc_traits<slot_alloc_type> slot_alloc_traits;
+    typedef easystl_cxx::alloc_traits<block_alloc_type> block_alloc_traits;
+
+    static const size_type kShards = 16;
+    // 第 k 段保存 kFirstSegment << k 个记录
+    static const size_type kFirstSegmentBits = 8;
+    static const size_type kFirstSegment = size_type(1) << kFirstSegmentBits;
+    static const size_type kSegments = 33 - kFirstSegmentBits;
+    // arena 每块的字节数，超过其四分之一的字符串单独分配
+    static const size_type kBlockBytes = 16384;
+
+    Allocator M_alloc;
+    mutable shard M_shards[kShards];
+    std::atomic<entry *> M_segments[kSegments];
+    std::atomic<std::uint32_t> M_next;
+
+  public:
+    explicit basic_intern_pool(const Allocator &a = Allocator()) : M_alloc(a) {
+        for (size_type i = 0; i < kShards; ++i) {
+            shard &s = M_shards[i];
+            s.slots = nullptr;
+            s.mask = 0;
+            s.count = 0;
+            s.blocks = nullptr;
+            s.cur = nullptr;
+            s.left = 0;
+        }
+        for (size_type i = 0; i < kSegments; ++i) {
+            M_segments[i].store(nullptr, std::memory_order_relaxed);
+        }
+        M_next.store(0, std::memory_order_relaxed);
+    }
+
+    basic_intern_pool(const basic_intern_pool &) = delete;
+    basic_intern_pool &operator=(const basic_intern_pool &) = delete;
+
+    ~basic_intern_pool() {
+        for (size_type i = 0; i < kShards; ++i) {
+            M_free_shard(M_shards[i]);
+        }
+        entry_alloc_type ealloc(M_alloc);
+        for (size_type k = 0; k < kSegments; ++k) {
+            entry *seg = M_segments[k].load(std::memory_order_relaxed);
+            if (seg) {
+                entry_alloc_traits::deallocate(ealloc, seg, kFirstSegment << k);
+            }
+        }
+    }
+
+  public:
+    /**
+     *  @brief  驻留字符串，返回其句柄
+     *  @param  sv  字符串内容，const CharType* 与 basic_string 可隐式转换
+     *  @return  相同内容总是得到相同的句柄
+     *  @throw  std::length_error  句柄已用尽
+     */
+    handle intern(view_type sv) {
+        const std::size_t h = S_hash(sv);
+        shard &s = M_shards[S_shard_of(h)];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        slot *found = M_lookup(s, sv, h);
+        if (found && found->id != npos) {
+            return found->id;
+        }
+        if ((s.count + 1) * 2 > s.mask + 1) {
+            M_rehash(s);
+            found = M_lookup(s, sv, h);
+        }
+        const CharType *data = M_store(s, sv);
+        // 先分配记录所在的段再占用句柄，占用之后不再抛出异常，分配失败时
+        // size() 不变，也不会留下没有内容的句柄。句柄用尽后 M_next 停在
+        // npos，不会回绕到 0 而重复分配句柄
+        handle id = M_next.load(std::memory_order_relaxed);
+        entry *e;
+        do {
+            THROW_LENGTH_ERROR_IF(id == npos, "basic_intern_pool::intern");
+            e = &M_entry_slot(id);
+        } while (!M_next.compare_exchange_weak(id, id + 1,
+                                               std::memory_order_relaxed));
+        e->data = data;
+        e->size = sv.size();
+        e->hash = h;
+        found->id = id;
+        found->hash_lo = static_cast<std::uint32_t>(h);
+        ++s.count;
+        return id;
+    }
+
+    /**
+     *  @brief  查找已驻留的字符串，不存在时返回 npos，不会插入
+     */
+    handle find(view_type sv) const {
+        const std::size_t h = S_hash(sv);
+        shard &s = M_shards[S_shard_of(h)];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        const slot *found = M_lookup(s, sv, h);
+        return found ? found->id : npos;
+    }
+
+    /**
+     *  @brief  句柄对应的字符串，以空字符结尾，在池的生命周期内有效
+     *
+     *  @a id 必须是此池返回的句柄。
+     */
+    view_type view(handle id) const noexcept {
+        const entry &e = M_entry(id);
+        return view_type(e.data, e.size);
+    }
+
+    const CharType *c_str(handle id) const noexcept { return M_entry(id).data; }
+
+    /**
+     *  @brief  驻留时计算的哈希值，与 hash<basic_string> 的结果相同
+     */
+    std::size_t hash(handle id) const noexcept { return M_entry(id).hash; }
+
+    /**
+     *  @brief  已驻留的不同字符串数量
+     */
+    size_type size() const noexcept {
+        return M_next.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    allocator_type get_allocator() const noexcept { return M_alloc; }
+
+  private:
+    static std::size_t S_hash(view_type sv) noexcept {
+        return easystl::hash<view_type>()(sv);
+    }
+
+    // 分片使用哈希值的高位，表内位置使用低位，两者互不相关
+    static size_type S_shard_of(std::size_t h) noexcept {
+        return static_cast<size_type>(h >> (sizeof(std::size_t) * CHAR_BIT - 4)) &
+               (kShards - 1);
+    }
+
+    static size_type S_segment_of(handle id) noexcept {
+        const std::uint64_t n = (static_cast<std::uint64_t>(id) >>
+                                 kFirstSegmentBits) + 1;
+        return static_cast<size_type>(63 - __builtin_clzll(n));
+    }
+
+    const entry &M_entry(handle id) const noexcept {
+        const size_type k = S_segment_of(id);
+        const entry *seg = M_segments[k].load(std::memory_order_acquire);
+        EASYSTL_DEBUG(seg != nullptr);
+        return seg[id + kFirstSegment - (kFirstSegment << k)];
+    }
+
+    // 取得句柄对应的记录，所在的段不存在时分配，多个线程竞争时只保留一个
+    entry &M_entry_slot(handle id) {
+        const size_type k = S_segment_of(id);
+        entry *seg = M_segments[k].load(std::memory_order_acquire);
+        if (!seg) {
+            entry_alloc_type ealloc(M_alloc);
+            entry *fresh =
+                entry_alloc_traits::allocate(ealloc, kFirstSegment << k);
+            if (M_segments[k].compare_exchange_strong(
+                    seg, fresh, std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+                seg = fresh;
+            } else {
+                entry_alloc_traits::deallocate(ealloc, fresh,
+                                               kFirstSegment << k);
+            }
+        }
+        return seg[id + kFirstSegment - (kFirstSegment << k)];
+    }
+
+    /**
+     *  @brief  线性探测查找，返回匹配的槽位或应当插入的空槽位
+     *  @return  表为空时返回 nullptr
+     */
+    slot *M_lookup(shard &s, view_type sv, std::size_t h) const noexcept {
+        if (!s.slots) {
+            return nullptr;
+        }
+        const std::uint32_t lo = static_cast<std::uint32_t>(h);
+        for (size_type i = h & s.mask;; i = (i + 1) & s.mask) {
+            slot &sl = s.slots[i];
+            if (sl.id == npos) {
+                return &sl;
+            }
+            if (sl.hash_lo == lo) {
+                const entry &e = M_entry(sl.id);
+                if (e.size == sv.size() &&
+                    (e.size == 0 ||
+                     traits_type::compare(e.data, sv.data(), e.size) == 0)) {
+                    return &sl;
+                }
+            }
+        }
+    }
+
+    void M_rehash(shard &s) {
+        const size_type n = s.slots ? (s.mask + 1) * 2 : 16;
+        slot_alloc_type salloc(M_alloc);
+        slot *slots = slot_alloc_traits::allocate(salloc, n);
+        for (size_type i = 0; i < n; ++i) {
+            slots[i].id = npos;
+            slots[i].hash_lo = 0;
+        }
+        for (size_type i = 0; s.slots && i <= s.mask; ++i) {
+            if (s.slots[i].id == npos) {
+                continue;
+            }
+            size_type j = M_entry(s.slots[i].id).hash & (n - 1);
+            while (slots[j].id != npos) {
+                j = (j + 1) & (n - 1);
+            }
+            slots[j] = s.slots[i];
+        }
+        if (s.slots) {
+            slot_alloc_traits::deallocate(salloc, s.slots, s.mask + 1);
+        }
+        s.slots = slots;
+        s.mask = n - 1;
+    }
+
+    static CharType *S_chars(block *b) noexcept {
+        return reinterpret_cast<CharType *>(b + 1);
+    }
+
+    block *M_new_block(size_type chars) {
+        const size_type units =
+            1 + (chars * sizeof(CharType) + sizeof(block) - 1) / sizeof(block);
+        block_alloc_type balloc(M_alloc);
+        block *b = block_alloc_traits::allocate(balloc, units);
+        b->next = nullptr;
+        b->units = units;
+        return b;
+    }
+
+    // 把字符复制到分片的 arena 中，末尾添加空字符
+    const CharType *M_store(shard &s, view_type sv) {
+        const size_type need = sv.size() + 1;
+        const size_type block_chars = kBlockBytes / sizeof(CharType);
+        CharType *dst;
+        if (need > block_chars / 4) {
+            // 单独分配，挂在当前块之后，当前块的剩余空间继续使用
+            block *b = M_new_block(need);
+            if (s.blocks) {
+                b->next = s.blocks->next;
+                s.blocks->next = b;
+            } else {
+                s.blocks = b;
+            }
+            dst = S_chars(b);
+        } else {
+            if (s.left < need) {
+                block *b = M_new_block(block_chars);
+                b->next = s.blocks;
+                s.blocks = b;
+                s.cur = S_chars(b);
+                s.left = block_chars;
+            }
+            dst = s.cur;
+            s.cur += need;
+            s.left -= need;
+        }
+        traits_type::copy(dst, sv.data(), sv.size());
+        traits_type::assign(dst[sv.size()], CharType());
+        return dst;
+    }
+
+    void M_free_shard(shard &s) noexcept {
+        if (s.slots) {
+            slot_alloc_type salloc(M_alloc);
+            slot_alloc_traits::deallocate(salloc, s.slots, s.mask + 1);
+        }
+        block_alloc_type balloc(M_alloc);
+        for (block *b = s.blocks; b;) {
+            block *next = b->next;
+            block_alloc_traits::deallocate(balloc, b, b->units);
+            b = next;
+        }
+    }
+};
+
+template <class CharType, class CharTraits, class Allocator>
+constexpr typename basic_intern_pool<CharType, CharTraits, Allocator>::handle
+    basic_intern_pool<CharType, CharTraits, Allocator>::npos;
+
+using intern_pool = basic_intern_pool<char>;
+using wintern_pool = basic_intern_pool<wchar_t>;
+
+} // namespace easystl
+
+#endif // !EASYSTL_INTERN_POOL_H
@@ -102,6 +102,7 @@ template <class T> struct iterator_traits<const T *> {
 
 // 萃取某个迭代器的 category
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 typename iterator_traits<Iterator>::iterator_category
 iterator_category(const Iterator &) {
     typedef typename iterator_traits<Iterator>::iterator_category Category;
@@ -115,6 +116,15 @@ template <typename InIter>
 using RequireInputIter = typename std::enable_if<std::is_convertible<
     easystl::iter_category_t<InIter>, input_iterator_tag>::value>::type;
 
+// 迭代器类别可以转换为 input_iterator_tag 时为 true，不是迭代器时为 false
+template <typename Iter, typename = std::__void_t<>>
+struct is_input_iterator : m_false_type {};
+
+template <typename Iter>
+struct is_input_iterator<Iter, std::__void_t<iter_category_t<Iter>>>
+    : m_bool_constant<std::is_convertible<iter_category_t<Iter>,
+                                          input_iterator_tag>::value> {};
+
 template <typename Iter, typename Cat = iter_category_t<Iter>>
 struct is_random_access_iter
     : std::is_base_of<random_access_iterator_tag, Cat> {
@@ -158,6 +168,7 @@ struct is_random_access_iter
 
 // 萃取某个迭代器的 distance_type
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 typename iterator_traits<Iterator>::difference_type *
 distance_type(const Iterator &) {
     return static_cast<typename iterator_traits<Iterator>::difference_type *>(
@@ -166,6 +177,7 @@ distance_type(const Iterator &) {
 
 // 萃取某个迭代器的 value_type
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 typename iterator_traits<Iterator>::value_type *value_type(const Iterator &) {
     return static_cast<typename iterator_traits<Iterator>::value_type *>(0);
 }
@@ -174,6 +186,7 @@ typename iterator_traits<Iterator>::value_type *value_type(const Iterator &) {
 
 // distance 的 input_iterator_tag 的版本
 template <class InputIterator>
+EASYSTL_CONSTEXPR20
 inline typename iterator_traits<InputIterator>::difference_type
 distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag) {
     typename iterator_traits<InputIterator>::difference_type n = 0;
@@ -186,6 +199,7 @@ distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag) {
 
 // distance 的 random_access_iterator_tag 的版本
 template <class RandomIter>
+EASYSTL_CONSTEXPR20
 typename iterator_traits<RandomIter>::difference_type
 distance_dispatch(RandomIter first, RandomIter last,
                   random_access_iterator_tag) {
@@ -193,6 +207,7 @@ distance_dispatch(RandomIter first, RandomIter last,
 }
 
 template <class InputIterator>
+EASYSTL_CONSTEXPR20
 typename iterator_traits<InputIterator>::difference_type
 distance(InputIterator first, InputIterator last) {
     return distance_dispatch(first, last, iterator_category(first));
@@ -202,6 +217,7 @@ distance(InputIterator first, InputIterator last) {
 
 // advance 的 input_iterator_tag 的版本
 template <class InputIterator, class Distance>
+EASYSTL_CONSTEXPR20
 void advance_dispatch(InputIterator &i, Distance n, input_iterator_tag) {
     EASYSTL_DEBUG(n >= 0);
     while (n--)
@@ -210,6 +226,7 @@ void advance_dispatch(InputIterator &i, Distance n, input_iterator_tag) {
 
 // advance 的 bidirectional_iterator_tag 的版本
 template <class BidirectionalIterator, class Distance>
+EASYSTL_CONSTEXPR20
 void advance_dispatch(BidirectionalIterator &i, Distance n,
                       bidirectional_iterator_tag) {
     if (n > 0)
@@ -222,17 +239,20 @@ void advance_dispatch(BidirectionalIterator &i, Distance n,
 
 // advance 的 random_access_iterator_tag 的版本
 template <class RandomIter, class Distance>
+EASYSTL_CONSTEXPR20
 void advance_dispatch(RandomIter &i, Distance n, random_access_iterator_tag) {
     i += n;
 }
 
 template <class InputIterator, class Distance>
+EASYSTL_CONSTEXPR20
 void advance(InputIterator &i, Distance n) {
     typename iterator_traits<InputIterator>::difference_type d = n;
     advance_dispatch(i, d, iterator_category(i));
 }
 
 template <typename InputIterator>
+EASYSTL_CONSTEXPR20
 inline InputIterator
 next(InputIterator x,
      typename iterator_traits<InputIterator>::difference_type n = 1) {
@@ -241,6 +261,7 @@ next(InputIterator x,
 }
 
 template <typename BidirectionIterator>
+EASYSTL_CONSTEXPR20
 inline BidirectionIterator
 prev(BidirectionIterator x,
      typename iterator_traits<BidirectionIterator>::difference_type n = 1) {
@@ -269,11 +290,14 @@ template <class Iterator> class reverse_iterator {
 
   public:
     // 构造函数
+    EASYSTL_CONSTEXPR20
     reverse_iterator() noexcept(noexcept(Iterator())) : current() {}
 
+    EASYSTL_CONSTEXPR20
     explicit reverse_iterator(iterator_type i) noexcept(noexcept(Iterator()))
         : current(i) {}
 
+    EASYSTL_CONSTEXPR20
     reverse_iterator(const reverse_iterator &x) noexcept(
         noexcept(Iterator(x.current)))
         : current(x.current) {}
@@ -281,11 +305,13 @@ template <class Iterator> class reverse_iterator {
     reverse_iterator &operator=(const reverse_iterator &) = default;
 
     template <typename Iter>
+    EASYSTL_CONSTEXPR20
     reverse_iterator(const reverse_iterator<Iter> &x) noexcept(
         noexcept(Iterator(x.current)))
         : current(x.current) {}
 
     template <typename Iter>
+    EASYSTL_CONSTEXPR20
     reverse_iterator &operator=(const reverse_iterator<Iter> &x) noexcept(
         noexcept(current = x.current)) {
         current = x.current;
@@ -294,15 +320,18 @@ template <class Iterator> class reverse_iterator {
 
   public:
     // 取出对应的正向迭代器
+    EASYSTL_CONSTEXPR20
     iterator_type base() const noexcept(noexcept(Iterator(current))) {
         return current;
     }
 
     // 重载操作符
+    EASYSTL_CONSTEXPR20
     reference operator*() const { // 实际对应正向迭代器的前一个位置
         auto tmp = current;
         return *--tmp;
     }
+    EASYSTL_CONSTEXPR20
     pointer operator->() const {
         auto tmp = current;
         --tmp;
@@ -310,125 +339,150 @@ template <class Iterator> class reverse_iterator {
     }
 
     // 前进(++)变为后退(--)
+    EASYSTL_CONSTEXPR20
     reverse_iterator &operator++() {
         --current;
         return *this;
     }
+    EASYSTL_CONSTEXPR20
     reverse_iterator operator++(int) {
         auto tmp = *this;
         --current;
         return tmp;
     }
     // 后退(--)变为前进(++)
+    EASYSTL_CONSTEXPR20
     reverse_iterator &operator--() {
         ++current;
         return *this;
     }
+    EASYSTL_CONSTEXPR20
     reverse_iterator operator--(int) {
         auto tmp = *this;
         ++current;
         return tmp;
     }
 
+    EASYSTL_CONSTEXPR20
     reverse_iterator &operator+=(difference_type n) {
         current -= n;
         return *this;
     }
+    EASYSTL_CONSTEXPR20
     reverse_iterator operator+(difference_type n) const {
         return reverse_iterator(current - n);
     }
+    EASYSTL_CONSTEXPR20
     reverse_iterator &operator-=(difference_type n) {
         current += n;
         return *this;
     }
+    EASYSTL_CONSTEXPR20
     reverse_iterator operator-(difference_type n) const {
         return reverse_iterator(current + n);
     }
 
+    EASYSTL_CONSTEXPR20
     reference operator[](difference_type n) const { return *(*this + n); }
 
   private:
-    template <typename Tp> static Tp *S_to_pointer(Tp *p) { return p; }
+    template <typename Tp> static EASYSTL_CONSTEXPR20 Tp *S_to_pointer(Tp *p) {
+        return p;
+    }
 
-    template <typename Tp> static pointer S_to_pointer(Tp t) {
+    template <typename Tp>
+    static EASYSTL_CONSTEXPR20 pointer S_to_pointer(Tp t) {
         return t.operator->();
     }
 };
 
 // 重载比较操作符
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 bool operator==(const reverse_iterator<Iterator> &lhs,
                 const reverse_iterator<Iterator> &rhs) {
     return lhs.base() == rhs.base();
 }
 
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 bool operator<(const reverse_iterator<Iterator> &lhs,
                const reverse_iterator<Iterator> &rhs) {
     return rhs.base() < lhs.base();
 }
 
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 bool operator!=(const reverse_iterator<Iterator> &lhs,
                 const reverse_iterator<Iterator> &rhs) {
     return !(lhs == rhs);
 }
 
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 bool operator>(const reverse_iterator<Iterator> &lhs,
                const reverse_iterator<Iterator> &rhs) {
     return rhs < lhs;
 }
 
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 bool operator<=(const reverse_iterator<Iterator> &lhs,
                 const reverse_iterator<Iterator> &rhs) {
     return !(rhs < lhs);
 }
 
 template <class Iterator>
+EASYSTL_CONSTEXPR20
 bool operator>=(const reverse_iterator<Iterator> &lhs,
                 const reverse_iterator<Iterator> &rhs) {
     return !(lhs < rhs);
 }
 
 template <typename IteratorL, typename IteratorR>
+EASYSTL_CONSTEXPR20
 inline bool operator==(const reverse_iterator<IteratorL> &lhs,
                        const reverse_iterator<IteratorR> &rhs) {
     return lhs.base() == rhs.base();
 }
 
 template <typename IteratorL, typename IteratorR>
+EASYSTL_CONSTEXPR20
 inline bool operator<(const reverse_iterator<IteratorL> &lhs,
                       const reverse_iterator<IteratorR> &rhs) {
     return lhs.base() > rhs.base();
 }
 
 template <typename IteratorL, typename IteratorR>
+EASYSTL_CONSTEXPR20
 inline bool operator!=(const reverse_iterator<IteratorL> &lhs,
                        const reverse_iterator<IteratorR> &rhs) {
     return lhs.base() != rhs.base();
 }
 
 template <typename IteratorL, typename IteratorR>
+EASYSTL_CONSTEXPR20
 inline bool operator>(const reverse_iterator<IteratorL> &lhs,
                       const reverse_iterator<IteratorR> &rhs) {
     return lhs.base() < rhs.base();
 }
 
 template <typename IteratorL, typename IteratorR>
+EASYSTL_CONSTEXPR20
 inline bool operator<=(const reverse_iterator<IteratorL> &lhs,
                        const reverse_iterator<IteratorR> &rhs) {
     return lhs.base() >= rhs.base();
 }
 
 template <typename IteratorL, typename IteratorR>
+EASYSTL_CONSTEXPR20
 inline bool operator>=(const reverse_iterator<IteratorL> &lhs,
                        const reverse_iterator<IteratorR> &rhs) {
     return lhs.base() <= rhs.base();
 }
 
 template <typename IteratorL, typename IteratorR>
+EASYSTL_CONSTEXPR20
 inline auto operator-(const reverse_iterator<IteratorL> &lhs,
                       const reverse_iterator<IteratorR> &rhs)
     -> decltype(rhs.base() - lhs.base()) {
@@ -436,6 +490,7 @@ inline auto operator-(const reverse_iterator<IteratorL> &lhs,
 }
 
 template <typename Iterator>
+EASYSTL_CONSTEXPR20
 inline reverse_iterator<Iterator>
 operator+(typename reverse_iterator<Iterator>::difference_type n,
           const reverse_iterator<Iterator> &x) {
@@ -470,65 +525,80 @@ template <typename Iterator, typename Container> class normal_iterator {
 
     constexpr normal_iterator() noexcept : M_current(Iterator()) {}
 
+    EASYSTL_CONSTEXPR20
     explicit normal_iterator(const Iterator &i) noexcept : M_current(i) {}
 
     // Allow iterator to const_iterator conversion
     template <typename Iter, typename = convertible_from<Iter>>
+    EASYSTL_CONSTEXPR20
     normal_iterator(const normal_iterator<Iter, Container> &i) noexcept
         : M_current(i.base()) {}
 
     // Forward iterator requirements
+    EASYSTL_CONSTEXPR20
     reference operator*() const noexcept { return *M_current; }
 
+    EASYSTL_CONSTEXPR20
     pointer operator->() const noexcept { return M_current; }
 
+    EASYSTL_CONSTEXPR20
     normal_iterator &operator++() noexcept {
         ++M_current;
         return *this;
     }
 
+    EASYSTL_CONSTEXPR20
     normal_iterator operator++(int) noexcept {
         return normal_iterator(M_current++);
     }
 
     // Bidirectional iterator requirements
+    EASYSTL_CONSTEXPR20
     normal_iterator &operator--() noexcept {
         --M_current;
         return *this;
     }
 
+    EASYSTL_CONSTEXPR20
     normal_iterator operator--(int) noexcept {
         return normal_iterator(M_current--);
     }
 
     // Random access iterator requirements
+    EASYSTL_CONSTEXPR20
     reference operator[](difference_type n) const noexcept {
         return M_current[n];
     }
 
+    EASYSTL_CONSTEXPR20
     normal_iterator &operator+=(difference_type n) noexcept {
         M_current += n;
         return *this;
     }
 
+    EASYSTL_CONSTEXPR20
     normal_iterator operator+(difference_type n) const noexcept {
         return normal_iterator(M_current + n);
     }
 
+    EASYSTL_CONSTEXPR20
     normal_iterator &operator-=(difference_type n) noexcept {
         M_current -= n;
         return *this;
     }
 
+    EASYSTL_CONSTEXPR20
     normal_iterator operator-(difference_type n) const _GLIBCXX_NOEXCEPT {
         return normal_iterator(M_current - n);
     }
 
+    EASYSTL_CONSTEXPR20
     const Iterator &base() const noexcept { return M_current; }
 };
 
 // Forward iterator requirements
 template <typename IteratorL, typename IteratorR, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator==(const normal_iterator<IteratorL, Container> &lhs,
            const normal_iterator<IteratorR, Container> &rhs) noexcept {
@@ -536,6 +606,7 @@ operator==(const normal_iterator<IteratorL, Container> &lhs,
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator==(const normal_iterator<Iterator, Container> &lhs,
            const normal_iterator<Iterator, Container> &rhs) noexcept {
@@ -543,6 +614,7 @@ operator==(const normal_iterator<Iterator, Container> &lhs,
 }
 
 template <typename IteratorL, typename IteratorR, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator!=(const normal_iterator<IteratorL, Container> &lhs,
            const normal_iterator<IteratorR, Container> &rhs) noexcept {
@@ -550,6 +622,7 @@ operator!=(const normal_iterator<IteratorL, Container> &lhs,
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator!=(const normal_iterator<Iterator, Container> &lhs,
            const normal_iterator<Iterator, Container> &rhs) _GLIBCXX_NOEXCEPT {
@@ -558,13 +631,14 @@ operator!=(const normal_iterator<Iterator, Container> &lhs,
 
 // Random access iterator requirements
 template <typename IteratorL, typename IteratorR, typename Container>
-_GLIBCXX_NODISCARD inline bool
+_GLIBCXX_NODISCARD EASYSTL_CONSTEXPR20 inline bool
 operator<(const normal_iterator<IteratorL, Container> &lhs,
           const normal_iterator<IteratorR, Container> &rhs) _GLIBCXX_NOEXCEPT {
     return lhs.base() < rhs.base();
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator<(const normal_iterator<Iterator, Container> &lhs,
           const normal_iterator<Iterator, Container> &rhs) noexcept {
@@ -572,6 +646,7 @@ operator<(const normal_iterator<Iterator, Container> &lhs,
 }
 
 template <typename IteratorL, typename IteratorR, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>(const normal_iterator<IteratorL, Container> &lhs,
           const normal_iterator<IteratorR, Container> &rhs) noexcept {
@@ -579,6 +654,7 @@ operator>(const normal_iterator<IteratorL, Container> &lhs,
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>(const normal_iterator<Iterator, Container> &lhs,
           const normal_iterator<Iterator, Container> &rhs) noexcept {
@@ -586,6 +662,7 @@ operator>(const normal_iterator<Iterator, Container> &lhs,
 }
 
 template <typename IteratorL, typename IteratorR, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator<=(const normal_iterator<IteratorL, Container> &lhs,
            const normal_iterator<IteratorR, Container> &rhs) noexcept {
@@ -593,6 +670,7 @@ operator<=(const normal_iterator<IteratorL, Container> &lhs,
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator<=(const normal_iterator<Iterator, Container> &lhs,
            const normal_iterator<Iterator, Container> &rhs) noexcept {
@@ -600,6 +678,7 @@ operator<=(const normal_iterator<Iterator, Container> &lhs,
 }
 
 template <typename IteratorL, typename IteratorR, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>=(const normal_iterator<IteratorL, Container> &lhs,
            const normal_iterator<IteratorR, Container> &rhs) noexcept {
@@ -607,6 +686,7 @@ operator>=(const normal_iterator<IteratorL, Container> &lhs,
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline bool
 operator>=(const normal_iterator<Iterator, Container> &lhs,
            const normal_iterator<Iterator, Container> &rhs) noexcept {
@@ -614,6 +694,7 @@ operator>=(const normal_iterator<Iterator, Container> &lhs,
 }
 
 template <typename IteratorL, typename IteratorR, typename Container>
+EASYSTL_CONSTEXPR20
 inline auto operator-(const normal_iterator<IteratorL, Container> &lhs,
                       const normal_iterator<IteratorR, Container> &rhs) noexcept
     -> decltype(lhs.base() - rhs.base()) {
@@ -621,6 +702,7 @@ inline auto operator-(const normal_iterator<IteratorL, Container> &lhs,
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline typename normal_iterator<Iterator, Container>::difference_type
 operator-(const normal_iterator<Iterator, Container> &lhs,
           const normal_iterator<Iterator, Container> &rhs) noexcept {
@@ -628,6 +710,7 @@ operator-(const normal_iterator<Iterator, Container> &lhs,
 }
 
 template <typename Iterator, typename Container>
+EASYSTL_CONSTEXPR20
 inline normal_iterator<Iterator, Container>
 operator+(typename normal_iterator<Iterator, Container>::difference_type n,
           const normal_iterator<Iterator, Container> &i) noexcept {
@@ -643,4 +726,51 @@ to_address(const easystl_cxx::normal_iterator<Iterator, Container> &it) noexcept
 
 } // namespace easystl_cxx
 
+namespace easystl {
+
+/*
+ * is_contiguous_iterator
+ * 元素在内存中连续存放的迭代器。algobase 中的算法先用 niter_base 把这类迭代器
+ * 还原成指针，从而使用 memmove、memset、memcmp 等快速路径。自定义的连续迭代器
+ * 可以特化此模板，但需要提供返回元素指针的 operator->
+ * */
+template <class Iter> struct is_contiguous_iterator : m_false_type {};
+
+template <class Tp> struct is_contiguous_iterator<Tp *> : m_true_type {};
+
+template <class Iter, class Container>
+struct is_contiguous_iterator<easystl_cxx::normal_iterator<Iter, Container>>
+    : is_contiguous_iterator<Iter> {};
+
+// 非连续迭代器原样返回
+template <class Iter>
+EASYSTL_CONSTEXPR20 typename std::enable_if<
+    !is_contiguous_iterator<Iter>::value || std::is_pointer<Iter>::value,
+    Iter>::type
+niter_base(Iter it) {
+    return it;
+}
+
+// 连续迭代器还原为指向同一元素的指针
+template <class Iter>
+EASYSTL_CONSTEXPR20 typename std::enable_if<
+    is_contiguous_iterator<Iter>::value && !std::is_pointer<Iter>::value,
+    decltype(easystl::to_address(std::declval<const Iter &>()))>::type
+niter_base(const Iter &it) {
+    return easystl::to_address(it);
+}
+
+// 把 niter_base 后的算法结果 res 转换回 from 的迭代器类型
+template <class Iter>
+EASYSTL_CONSTEXPR20 Iter niter_wrap(const Iter &, Iter res) {
+    return res;
+}
+
+template <class From, class To>
+EASYSTL_CONSTEXPR20 From niter_wrap(From from, To res) {
+    return from + (res - easystl::niter_base(from));
+}
+
+} // namespace easystl
+
 #endif // !EASYSTL_ITERATOR_H
@@ -0,0 +1,221 @@
+#ifndef EASYSTL_NUMERIC_H
+#define EASYSTL_NUMERIC_H
+
+// 数值算法
+
+#include "functional.h"
+#include "iterator.h"
+#include "simd.h"
+#include "utility.h"
+#include <type_traits>
+
+namespace easystl {
+
+/*
+ * accumulate
+ * 版本1：以初值 init 对每个元素进行累加
+ * 版本2：以初值 init 对每个元素进行二元操作
+ * 按从左到右的顺序计算。版本1 在连续存储的整数上、init 与元素类型相同时交给
+ * simd::sum：整数加法按位宽回绕，改变顺序不影响结果
+ * */
+template <class InputIter, class T>
+T accumulate_dispatch(InputIter first, InputIter last, T init) {
+    for (; first != last; ++first) {
+        init = easystl::move(init) + *first;
+    }
+    return init;
+}
+
+template <class Tp, class Up>
+typename std::enable_if<
+    simd::is_vectorizable<Tp>::value && std::is_integral<Tp>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+    Up>::type
+accumulate_dispatch(Tp *first, Tp *last, Up init) {
+    return simd::wrapping_add(init, simd::sum<Up>(first, last));
+}
+
+template <class InputIter, class T>
+T accumulate(InputIter first, InputIter last, T init) {
+    return accumulate_dispatch(easystl::niter_base(first),
+                               easystl::niter_base(last),
+                               easystl::move(init));
+}
+
+template <class InputIter, class T, class BinaryOp>
+T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+    for (; first != last; ++first) {
+        init = binary_op(easystl::move(init), *first);
+    }
+    return init;
+}
+
+/*
+ * reduce
+ * 与 accumulate 相同，但不规定计算顺序，binary_op 需要满足结合律与交换律
+ * 使用 plus、在连续存储的算术类型上、init 与元素类型相同时交给 simd::sum，
+ * 浮点数按多个通道分别累加，结果可能与逐个累加有舍入上的差别
+ * */
+template <class InputIter, class T, class BinaryOp>
+T reduce_dispatch(InputIter first, InputIter last, T init,
+                  BinaryOp binary_op) {
+    for (; first != last; ++first) {
+        init = binary_op(easystl::move(init), *first);
+    }
+    return init;
+}
+
+template <class Tp, class Up>
+typename std::enable_if<
+    simd::is_vectorizable<Tp>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+    Up>::type
+reduce_dispatch(Tp *first, Tp *last, Up init, easystl::plus<Up>) {
+    return simd::wrapping_add(init, simd::sum<Up>(first, last));
+}
+
+template <class InputIter, class T, class BinaryOp>
+T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+    return reduce_dispatch(easystl::niter_base(first),
+                           easystl::niter_base(last), easystl::move(init),
+                           binary_op);
+}
+
+template <class InputIter, class T>
+T reduce(InputIter first, InputIter last, T init) {
+    return easystl::reduce(first, last, easystl::move(init),
+                           easystl::plus<T>());
+}
+
+template <class InputIter>
+typename iterator_traits<InputIter>::value_type reduce(InputIter first,
+                                                       InputIter last) {
+    typedef typename iterator_traits<InputIter>::value_type T;
+    return easystl::reduce(first, last, T(), easystl::plus<T>());
+}
+
+/*
+ * inclusive_scan
+ * 版本1：result[i] 为 first[0] + ... + first[i]
+ * 版本2：以二元操作 binary_op 代替加法
+ * 版本3：以初值 init 开始，result[i] 为 init 与 first[0..i] 依次做二元操作
+ * binary_op 需要满足结合律。每个元素先读后写，result 可以等于 first。使用
+ * plus、在连续存储的 4 字节整数、float 与 double 上、输入与输出类型相同时
+ * 交给 simd::scan，浮点数的结果可能与逐个累加有舍入上的差别
+ * */
+template <class InputIter, class OutputIter, class BinaryOp, class T>
+OutputIter inclusive_scan_dispatch(InputIter first, InputIter last,
+                                   OutputIter result, BinaryOp binary_op,
+                                   T init) {
+    for (; first != last; ++first, ++result) {
+        init = binary_op(easystl::move(init), *first);
+        *result = init;
+    }
+    return result;
+}
+
+template <class Tp, class Up>
+typename std::enable_if<
+    simd::is_scannable<Tp>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+    Up *>::type
+inclusive_scan_dispatch(Tp *first, Tp *last, Up *result, easystl::plus<Up>,
+                        Up init) {
+    return simd::scan<false>(first, last, result, init);
+}
+
+template <class InputIter, class OutputIter, class BinaryOp, class T>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          BinaryOp binary_op, T init) {
+    return easystl::niter_wrap(
+        result, inclusive_scan_dispatch(
+                    easystl::niter_base(first), easystl::niter_base(last),
+                    easystl::niter_base(result), binary_op,
+                    easystl::move(init)));
+}
+
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          BinaryOp binary_op) {
+    if (first == last) {
+        return result;
+    }
+    typename iterator_traits<InputIter>::value_type init = *first;
+    *result = init;
+    return easystl::inclusive_scan(++first, last, ++result, binary_op,
+                                   easystl::move(init));
+}
+
+template <class InputIter, class OutputIter>
+OutputIter inclusive_scan(InputIter first, InputIter last,
+                          OutputIter result) {
+    typedef typename iterator_traits<InputIter>::value_type T;
+    return easystl::inclusive_scan(first, last, result, easystl::plus<T>());
+}
+
+/*
+ * exclusive_scan
+ * 版本1：以初值 init 开始，result[i] 为 init + first[0] + ... + first[i - 1]
+ * 版本2：以二元操作 binary_op 代替加法
+ * 与 inclusive_scan 相同，result 可以等于 first，满足条件时交给 simd::scan
+ * */
+template <class InputIter, class OutputIter, class T, class BinaryOp>
+OutputIter exclusive_scan_dispatch(InputIter first, InputIter last,
+                                   OutputIter result, T init,
+                                   BinaryOp binary_op) {
+    for (; first != last; ++first, ++result) {
+        T next = binary_op(init, *first);
+        *result = easystl::move(init);
+        init = easystl::move(next);
+    }
+    return result;
+}
+
+template <class Tp, class Up>
+typename std::enable_if<
+    simd::is_scannable<Tp>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value,
+    Up *>::type
+exclusive_scan_dispatch(Tp *first, Tp *last, Up *result, Up init,
+                        easystl::plus<Up>) {
+    return simd::scan<true>(first, last, result, init);
+}
+
+template <class InputIter, class OutputIter, class T, class BinaryOp>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          T init, BinaryOp binary_op) {
+    return easystl::niter_wrap(
+        result, exclusive_scan_dispatch(
+                    easystl::niter_base(first), easystl::niter_base(last),
+                    easystl::niter_base(result), easystl::move(init),
+                    binary_op));
+}
+
+template <class InputIter, class OutputIter, class T>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          T init) {
+    return easystl::exclusive_scan(first, last, result, easystl::move(init),
+                                   easystl::plus<T>());
+}
+
+/*
+ * transform_exclusive_scan
+ * 先对每个元素做一元操作 unary_op，再以 init 与 binary_op 做 exclusive_scan，
+ * 例如由各行的长度直接求出 CSR 的行偏移。result 可以等于 first
+ * */
+template <class InputIter, class OutputIter, class T, class BinaryOp,
+          class UnaryOp>
+OutputIter transform_exclusive_scan(InputIter first, InputIter last,
+                                    OutputIter result, T init,
+                                    BinaryOp binary_op, UnaryOp unary_op) {
+    for (; first != last; ++first, ++result) {
+        T next = binary_op(init, unary_op(*first));
+        *result = easystl::move(init);
+        init = easystl::move(next);
+    }
+    return result;
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_NUMERIC_H
@@ -0,0 +1,775 @@
+#ifndef EASYSTL_PARALLEL_ALGO_H
+#define EASYSTL_PARALLEL_ALGO_H
+
+// 带执行策略的算法：copy, fill, transform, reduce, inclusive_scan,
+// exclusive_scan, transform_exclusive_scan, sort, find, find_if, count,
+// count_if
+//
+// 第一个参数为 execution.h 中的执行策略。par 与 par_unseq 要求随机访问迭代器，
+// 把区间分为不超过 4 * (线程数 + 1) 块交给调度器，每块至少包含 grain 个元素；
+// 迭代器不支持随机访问或者元素太少时退化为顺序版本。
+//
+// 与标准库相同，并行执行时元素访问函数抛出异常会调用 std::terminate。
+
+#include "algo.h"
+#include "algobase.h"
+#include "allocator.h"
+#include "construct.h"
+#include "execution.h"
+#include "functional.h"
+#include "iterator.h"
+#include "numeric.h"
+#include "scheduler.h"
+#include "utility.h"
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace easystl {
+
+template <class... Iters> struct all_random_access_iter : m_true_type {};
+
+template <class Iter, class... Rest>
+struct all_random_access_iter<Iter, Rest...>
+    : m_bool_constant<is_random_access_iter<Iter>::value &&
+                      all_random_access_iter<Rest...>::value> {};
+
+// 策略为 par 或 par_unseq 且所有迭代器都支持随机访问时为 true
+template <class ExecutionPolicy, class... Iters>
+struct use_parallel
+    : m_bool_constant<
+          std::is_base_of<execution::parallel_policy,
+                          typename std::decay<ExecutionPolicy>::type>::value &&
+          all_random_access_iter<Iters...>::value> {};
+
+template <class ExecutionPolicy, class R>
+struct enable_if_execution_policy
+    : std::enable_if<
+          is_execution_policy<
+              typename std::decay<ExecutionPolicy>::type>::value,
+          R> {};
+
+/*
+ * parallel_blocks
+ * 把 [0, n) 均分为 count 块，第 i 块为 [begin(i), begin(i + 1))
+ * */
+struct parallel_blocks {
+    scheduler *pool;
+    std::size_t n;
+    std::size_t count;
+
+    // 等于 n * i / count，避免乘法溢出
+    std::size_t begin(std::size_t i) const noexcept {
+        return n / count * i + n % count * i / count;
+    }
+};
+
+inline parallel_blocks
+make_parallel_blocks(const execution::parallel_policy &policy,
+                     std::size_t n) {
+    parallel_blocks blocks;
+    blocks.pool = policy.pool ? policy.pool : &scheduler::instance();
+    blocks.n = n;
+    const std::size_t limit = (blocks.pool->size() + 1) * 4;
+    blocks.count = n / policy.grain;
+    if (blocks.count > limit) {
+        blocks.count = limit;
+    }
+    if (blocks.count == 0) {
+        blocks.count = 1;
+    }
+    return blocks;
+}
+
+// 对每一块调用 fn(i, begin, end)；异常在 noexcept 边界处终止程序
+template <class Fn>
+void run_parallel_blocks(const parallel_blocks &blocks, Fn fn) noexcept {
+    if (blocks.count == 1) {
+        fn(std::size_t(0), std::size_t(0), blocks.n);
+        return;
+    }
+    blocks.pool->run_chunks(blocks.count, [&blocks, &fn](std::size_t i) {
+        fn(i, blocks.begin(i), blocks.begin(i + 1));
+    });
+}
+
+/*
+ * copy
+ * */
+template <class ExecutionPolicy, class InputIter, class OutputIter>
+OutputIter copy_policy(m_false_type, ExecutionPolicy &&, InputIter first,
+                       InputIter last, OutputIter result) {
+    return easystl::copy(first, last, result);
+}
+
+template <class RandomIter1, class RandomIter2>
+RandomIter2 copy_policy(m_true_type, const execution::parallel_policy &policy,
+                        RandomIter1 first, RandomIter1 last,
+                        RandomIter2 result) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    run_parallel_blocks(make_parallel_blocks(policy, n),
+                        [&](std::size_t, std::size_t b, std::size_t e) {
+                            easystl::copy(first + b, first + e, result + b);
+                        });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+copy(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last,
+     ForwardIter2 result) {
+    return copy_policy(use_parallel<ExecutionPolicy, ForwardIter1,
+                                    ForwardIter2>(),
+                       policy, first, last, result);
+}
+
+/*
+ * fill
+ * */
+template <class ExecutionPolicy, class ForwardIter, class T>
+void fill_policy(m_false_type, ExecutionPolicy &&, ForwardIter first,
+                 ForwardIter last, const T &value) {
+    easystl::fill(first, last, value);
+}
+
+template <class RandomIter, class T>
+void fill_policy(m_true_type, const execution::parallel_policy &policy,
+                 RandomIter first, RandomIter last, const T &value) {
+    run_parallel_blocks(
+        make_parallel_blocks(policy, static_cast<std::size_t>(last - first)),
+        [&](std::size_t, std::size_t b, std::size_t e) {
+            easystl::fill(first + b, first + e, value);
+        });
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+typename enable_if_execution_policy<ExecutionPolicy, void>::type
+fill(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last,
+     const T &value) {
+    fill_policy(use_parallel<ExecutionPolicy, ForwardIter>(), policy, first,
+                last, value);
+}
+
+/*
+ * transform
+ * */
+template <class ExecutionPolicy, class InputIter, class OutputIter,
+          class UnaryOperation>
+OutputIter transform_policy(m_false_type, ExecutionPolicy &&, InputIter first,
+                            InputIter last, OutputIter result,
+                            UnaryOperation unary_op) {
+    return easystl::transform(first, last, result, unary_op);
+}
+
+template <class RandomIter1, class RandomIter2, class UnaryOperation>
+RandomIter2 transform_policy(m_true_type,
+                             const execution::parallel_policy &policy,
+                             RandomIter1 first, RandomIter1 last,
+                             RandomIter2 result, UnaryOperation unary_op) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    run_parallel_blocks(make_parallel_blocks(policy, n),
+                        [&](std::size_t, std::size_t b, std::size_t e) {
+                            easystl::transform(first + b, first + e,
+                                               result + b, unary_op);
+                        });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class InputIter1, class InputIter2,
+          class OutputIter, class BinaryOperation>
+OutputIter transform_policy(m_false_type, ExecutionPolicy &&,
+                            InputIter1 first1, InputIter1 last1,
+                            InputIter2 first2, OutputIter result,
+                            BinaryOperation binary_op) {
+    return easystl::transform(first1, last1, first2, result, binary_op);
+}
+
+template <class RandomIter1, class RandomIter2, class RandomIter3,
+          class BinaryOperation>
+RandomIter3 transform_policy(m_true_type,
+                             const execution::parallel_policy &policy,
+                             RandomIter1 first1, RandomIter1 last1,
+                             RandomIter2 first2, RandomIter3 result,
+                             BinaryOperation binary_op) {
+    const std::size_t n = static_cast<std::size_t>(last1 - first1);
+    run_parallel_blocks(make_parallel_blocks(policy, n),
+                        [&](std::size_t, std::size_t b, std::size_t e) {
+                            easystl::transform(first1 + b, first1 + e,
+                                               first2 + b, result + b,
+                                               binary_op);
+                        });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2,
+          class UnaryOperation>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+transform(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last,
+          ForwardIter2 result, UnaryOperation unary_op) {
+    return transform_policy(
+        use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>(), policy,
+        first, last, result, unary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2,
+          class ForwardIter3, class BinaryOperation>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter3>::type
+transform(ExecutionPolicy &&policy, ForwardIter1 first1, ForwardIter1 last1,
+          ForwardIter2 first2, ForwardIter3 result,
+          BinaryOperation binary_op) {
+    return transform_policy(use_parallel<ExecutionPolicy, ForwardIter1,
+                                         ForwardIter2, ForwardIter3>(),
+                            policy, first1, last1, first2, result, binary_op);
+}
+
+/*
+ * reduce
+ * 每一块从第一个元素开始归约，再按块的顺序与 init 合并
+ * */
+template <class ExecutionPolicy, class InputIter, class T, class BinaryOp>
+T reduce_policy(m_false_type, ExecutionPolicy &&, InputIter first,
+                InputIter last, T init, BinaryOp binary_op) {
+    return easystl::reduce(first, last, easystl::move(init), binary_op);
+}
+
+template <class RandomIter, class T, class BinaryOp>
+T reduce_policy(m_true_type, const execution::parallel_policy &policy,
+                RandomIter first, RandomIter last, T init,
+                BinaryOp binary_op) {
+    const parallel_blocks blocks =
+        make_parallel_blocks(policy, static_cast<std::size_t>(last - first));
+    if (blocks.count == 1) {
+        return easystl::reduce(first, last, easystl::move(init), binary_op);
+    }
+    easystl::allocator<T> alloc;
+    T *partial = alloc.allocate(blocks.count);
+    run_parallel_blocks(blocks,
+                        [&](std::size_t i, std::size_t b, std::size_t e) {
+                            easystl::construct(
+                                partial + i,
+                                easystl::reduce(first + (b + 1), first + e,
+                                                T(*(first + b)), binary_op));
+                        });
+    for (std::size_t i = 0; i < blocks.count; ++i) {
+        init = binary_op(easystl::move(init), easystl::move(partial[i]));
+    }
+    easystl::destroy(partial, partial + blocks.count);
+    alloc.deallocate(partial, blocks.count);
+    return init;
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T, class BinaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init,
+       BinaryOp binary_op) {
+    return reduce_policy(use_parallel<ExecutionPolicy, ForwardIter>(), policy,
+                         first, last, easystl::move(init), binary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last,
+       T init) {
+    return easystl::reduce(policy, first, last, easystl::move(init),
+                           easystl::plus<T>());
+}
+
+template <class ExecutionPolicy, class ForwardIter>
+typename enable_if_execution_policy<
+    ExecutionPolicy, typename iterator_traits<ForwardIter>::value_type>::type
+reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last) {
+    typedef typename iterator_traits<ForwardIter>::value_type T;
+    return easystl::reduce(policy, first, last, T(), easystl::plus<T>());
+}
+
+/*
+ * inclusive_scan, exclusive_scan, transform_exclusive_scan
+ * 两遍的分块前缀和：
+ * (1)各块并行求和
+ * (2)按块的顺序对各块的和做 exclusive_scan，得到每块的初值
+ * (3)各块以自己的初值并行做顺序版本的前缀和
+ * 输入要读两遍，元素很多时才比顺序版本快。各块只读写自己的区间，result 可以
+ * 等于 first
+ * */
+
+// block_sum(b, e) 返回 [b, e) 的和，block_scan(b, e, init) 处理 [b, e)
+template <class T, class BinaryOp, class BlockSum, class BlockScan>
+void parallel_scan(const parallel_blocks &blocks, T init, BinaryOp &binary_op,
+                   BlockSum block_sum, BlockScan block_scan) {
+    const std::size_t count = blocks.count;
+    easystl::allocator<T> alloc;
+    T *offset = alloc.allocate(count);
+    // 最后一块的和用不到
+    run_parallel_blocks(blocks,
+                        [&](std::size_t i, std::size_t b, std::size_t e) {
+                            if (i + 1 != count) {
+                                easystl::construct(offset + i,
+                                                   block_sum(b, e));
+                            }
+                        });
+    for (std::size_t i = 0; i + 1 < count; ++i) {
+        T next = binary_op(init, offset[i]);
+        offset[i] = easystl::move(init);
+        init = easystl::move(next);
+    }
+    easystl::construct(offset + (count - 1), easystl::move(init));
+    run_parallel_blocks(blocks,
+                        [&](std::size_t i, std::size_t b, std::size_t e) {
+                            block_scan(b, e, offset[i]);
+                        });
+    easystl::destroy(offset, offset + count);
+    alloc.deallocate(offset, count);
+}
+
+template <class ExecutionPolicy, class InputIter, class OutputIter,
+          class BinaryOp, class T>
+OutputIter inclusive_scan_policy(m_false_type, ExecutionPolicy &&,
+                                 InputIter first, InputIter last,
+                                 OutputIter result, BinaryOp binary_op,
+                                 T init) {
+    return easystl::inclusive_scan(first, last, result, binary_op,
+                                   easystl::move(init));
+}
+
+template <class RandomIter1, class RandomIter2, class BinaryOp, class T>
+RandomIter2 inclusive_scan_policy(m_true_type,
+                                  const execution::parallel_policy &policy,
+                                  RandomIter1 first, RandomIter1 last,
+                                  RandomIter2 result, BinaryOp binary_op,
+                                  T init) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const parallel_blocks blocks = make_parallel_blocks(policy, n);
+    if (blocks.count == 1) {
+        return easystl::inclusive_scan(first, last, result, binary_op,
+                                       easystl::move(init));
+    }
+    parallel_scan(
+        blocks, easystl::move(init), binary_op,
+        [&](std::size_t b, std::size_t e) {
+            return easystl::reduce(first + (b + 1), first + e,
+                                   T(*(first + b)), binary_op);
+        },
+        [&](std::size_t b, std::size_t e, T &block_init) {
+            easystl::inclusive_scan(first + b, first + e, result + b,
+                                    binary_op, easystl::move(block_init));
+        });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2,
+          class BinaryOp, class T>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first,
+               ForwardIter1 last, ForwardIter2 result, BinaryOp binary_op,
+               T init) {
+    return inclusive_scan_policy(
+        use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>(), policy,
+        first, last, result, binary_op, easystl::move(init));
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2,
+          class BinaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first,
+               ForwardIter1 last, ForwardIter2 result, BinaryOp binary_op) {
+    if (first == last) {
+        return result;
+    }
+    typename iterator_traits<ForwardIter1>::value_type init = *first;
+    *result = init;
+    return easystl::inclusive_scan(policy, ++first, last, ++result,
+                                   binary_op, easystl::move(init));
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first,
+               ForwardIter1 last, ForwardIter2 result) {
+    typedef typename iterator_traits<ForwardIter1>::value_type T;
+    return easystl::inclusive_scan(policy, first, last, result,
+                                   easystl::plus<T>());
+}
+
+template <class ExecutionPolicy, class InputIter, class OutputIter, class T,
+          class BinaryOp>
+OutputIter exclusive_scan_policy(m_false_type, ExecutionPolicy &&,
+                                 InputIter first, InputIter last,
+                                 OutputIter result, T init,
+                                 BinaryOp binary_op) {
+    return easystl::exclusive_scan(first, last, result, easystl::move(init),
+                                   binary_op);
+}
+
+template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+RandomIter2 exclusive_scan_policy(m_true_type,
+                                  const execution::parallel_policy &policy,
+                                  RandomIter1 first, RandomIter1 last,
+                                  RandomIter2 result, T init,
+                                  BinaryOp binary_op) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const parallel_blocks blocks = make_parallel_blocks(policy, n);
+    if (blocks.count == 1) {
+        return easystl::exclusive_scan(first, last, result,
+                                       easystl::move(init), binary_op);
+    }
+    parallel_scan(
+        blocks, easystl::move(init), binary_op,
+        [&](std::size_t b, std::size_t e) {
+            return easystl::reduce(first + (b + 1), first + e,
+                                   T(*(first + b)), binary_op);
+        },
+        [&](std::size_t b, std::size_t e, T &block_init) {
+            easystl::exclusive_scan(first + b, first + e, result + b,
+                                    easystl::move(block_init), binary_op);
+        });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2,
+          class T, class BinaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+exclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first,
+               ForwardIter1 last, ForwardIter2 result, T init,
+               BinaryOp binary_op) {
+    return exclusive_scan_policy(
+        use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>(), policy,
+        first, last, result, easystl::move(init), binary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2,
+          class T>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+exclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first,
+               ForwardIter1 last, ForwardIter2 result, T init) {
+    return easystl::exclusive_scan(policy, first, last, result,
+                                   easystl::move(init), easystl::plus<T>());
+}
+
+template <class ExecutionPolicy, class InputIter, class OutputIter, class T,
+          class BinaryOp, class UnaryOp>
+OutputIter transform_exclusive_scan_policy(m_false_type, ExecutionPolicy &&,
+                                           InputIter first, InputIter last,
+                                           OutputIter result, T init,
+                                           BinaryOp binary_op,
+                                           UnaryOp unary_op) {
+    return easystl::transform_exclusive_scan(
+        first, last, result, easystl::move(init), binary_op, unary_op);
+}
+
+template <class RandomIter1, class RandomIter2, class T, class BinaryOp,
+          class UnaryOp>
+RandomIter2 transform_exclusive_scan_policy(
+    m_true_type, const execution::parallel_policy &policy, RandomIter1 first,
+    RandomIter1 last, RandomIter2 result, T init, BinaryOp binary_op,
+    UnaryOp unary_op) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const parallel_blocks blocks = make_parallel_blocks(policy, n);
+    if (blocks.count == 1) {
+        return easystl::transform_exclusive_scan(
+            first, last, result, easystl::move(init), binary_op, unary_op);
+    }
+    parallel_scan(
+        blocks, easystl::move(init), binary_op,
+        [&](std::size_t b, std::size_t e) {
+            T sum = unary_op(*(first + b));
+            for (std::size_t i = b + 1; i < e; ++i) {
+                sum = binary_op(easystl::move(sum), unary_op(*(first + i)));
+            }
+            return sum;
+        },
+        [&](std::size_t b, std::size_t e, T &block_init) {
+            easystl::transform_exclusive_scan(first + b, first + e,
+                                              result + b,
+                                              easystl::move(block_init),
+                                              binary_op, unary_op);
+        });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2,
+          class T, class BinaryOp, class UnaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+transform_exclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first,
+                         ForwardIter1 last, ForwardIter2 result, T init,
+                         BinaryOp binary_op, UnaryOp unary_op) {
+    return transform_exclusive_scan_policy(
+        use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>(), policy,
+        first, last, result, easystl::move(init), binary_op, unary_op);
+}
+
+/*
+ * find_if
+ * 各块以 1024 个元素为单位查找，已经在更靠前的位置找到时提前结束
+ * */
+template <class ExecutionPolicy, class InputIter, class UnaryPredicate>
+InputIter find_if_policy(m_false_type, ExecutionPolicy &&, InputIter first,
+                         InputIter last, UnaryPredicate pred) {
+    return easystl::find_if(first, last, pred);
+}
+
+template <class RandomIter, class UnaryPredicate>
+RandomIter find_if_policy(m_true_type,
+                          const execution::parallel_policy &policy,
+                          RandomIter first, RandomIter last,
+                          UnaryPredicate pred) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    std::atomic<std::size_t> found(n);
+    run_parallel_blocks(
+        make_parallel_blocks(policy, n),
+        [&](std::size_t, std::size_t b, std::size_t e) {
+            for (std::size_t s = b; s < e; s += 1024) {
+                if (found.load(std::memory_order_relaxed) <= s) {
+                    return;
+                }
+                const std::size_t t = e - s < 1024 ? e : s + 1024;
+                const RandomIter it =
+                    easystl::find_if(first + s, first + t, pred);
+                if (it != first + t) {
+                    const std::size_t pos = static_cast<std::size_t>(
+                        it - first);
+                    std::size_t cur = found.load(std::memory_order_relaxed);
+                    while (pos < cur && !found.compare_exchange_weak(
+                                            cur, pos,
+                                            std::memory_order_relaxed)) {
+                    }
+                    return;
+                }
+            }
+        });
+    return first + found.load(std::memory_order_relaxed);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+find_if(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last,
+        UnaryPredicate pred) {
+    return find_if_policy(use_parallel<ExecutionPolicy, ForwardIter>(),
+                          policy, first, last, pred);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+find(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last,
+     const T &value) {
+    typedef typename iterator_traits<ForwardIter>::value_type V;
+    return easystl::find_if(policy, first, last,
+                            [&value](const V &x) { return x == value; });
+}
+
+/*
+ * count_if
+ * */
+template <class ExecutionPolicy, class InputIter, class UnaryPredicate>
+typename iterator_traits<InputIter>::difference_type
+count_if_policy(m_false_type, ExecutionPolicy &&, InputIter first,
+                InputIter last, UnaryPredicate pred) {
+    return easystl::count_if(first, last, pred);
+}
+
+template <class RandomIter, class UnaryPredicate>
+typename iterator_traits<RandomIter>::difference_type
+count_if_policy(m_true_type, const execution::parallel_policy &policy,
+                RandomIter first, RandomIter last, UnaryPredicate pred) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    std::atomic<Distance> total(0);
+    run_parallel_blocks(
+        make_parallel_blocks(policy, static_cast<std::size_t>(last - first)),
+        [&](std::size_t, std::size_t b, std::size_t e) {
+            total.fetch_add(easystl::count_if(first + b, first + e, pred),
+                            std::memory_order_relaxed);
+        });
+    return total.load(std::memory_order_relaxed);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+typename enable_if_execution_policy<
+    ExecutionPolicy,
+    typename iterator_traits<ForwardIter>::difference_type>::type
+count_if(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last,
+         UnaryPredicate pred) {
+    return count_if_policy(use_parallel<ExecutionPolicy, ForwardIter>(),
+                           policy, first, last, pred);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+typename enable_if_execution_policy<
+    ExecutionPolicy,
+    typename iterator_traits<ForwardIter>::difference_type>::type
+count(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last,
+      const T &value) {
+    typedef typename iterator_traits<ForwardIter>::value_type V;
+    return easystl::count_if(policy, first, last,
+                             [&value](const V &x) { return x == value; });
+}
+
+/*
+ * sort
+ * 并行归并排序：
+ * (1)区间分为 2^k 块，每块移入临时缓冲区后用 sort 排序
+ * (2)每一轮把相邻的两段合并为一段，数据在缓冲区与原区间之间来回搬移；每次
+ *    合并按 merge path 再切分为多个互不相交的子合并，使每一轮都能用满所有线程
+ * */
+
+// 在 A、B 的归并结果中，前 diag 个元素有多少个来自 A；相等时 A 在前
+template <class Iter1, class Iter2, class Compare>
+std::size_t merge_path_split(Iter1 a, std::size_t na, Iter2 b,
+                             std::size_t nb, std::size_t diag,
+                             Compare &comp) {
+    std::size_t lo = diag > nb ? diag - nb : 0;
+    std::size_t hi = diag < na ? diag : na;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (comp(*(b + (diag - mid - 1)), *(a + mid))) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+template <class Iter1, class Iter2, class OutputIter, class Compare>
+void merge_move(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2,
+                OutputIter result, Compare &comp) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first2, *first1)) {
+            *result = easystl::move(*first2);
+            ++first2;
+        } else {
+            *result = easystl::move(*first1);
+            ++first1;
+        }
+        ++result;
+    }
+    result = easystl::move(first1, last1, result);
+    easystl::move(first2, last2, result);
+}
+
+// 把 src 中以 bounds 划分、各自有序的 runs 段两两合并到 dst
+template <class Iter1, class Iter2, class Compare>
+void parallel_merge_round(const parallel_blocks &blocks, Iter1 src,
+                          Iter2 dst, const std::size_t *bounds,
+                          std::size_t runs, Compare &comp) {
+    // 每一对合并切分为 pieces 个子合并。切分点要在任何元素被移走之前求出
+    const std::size_t pairs = runs / 2;
+    const std::size_t pieces = blocks.count / pairs;
+    easystl::allocator<std::size_t> alloc;
+    const std::size_t nsplits = pairs * (pieces + 1);
+    std::size_t *splits = alloc.allocate(nsplits);
+    for (std::size_t p = 0; p < pairs; ++p) {
+        const std::size_t lo = bounds[2 * p];
+        const std::size_t mid = bounds[2 * p + 1];
+        const std::size_t hi = bounds[2 * p + 2];
+        for (std::size_t k = 0; k <= pieces; ++k) {
+            splits[p * (pieces + 1) + k] = merge_path_split(
+                src + lo, mid - lo, src + mid, hi - mid,
+                (hi - lo) * k / pieces, comp);
+        }
+    }
+    parallel_blocks tasks = blocks;
+    tasks.count = pairs * pieces;
+    run_parallel_blocks(tasks, [&](std::size_t t, std::size_t,
+                                   std::size_t) {
+        const std::size_t p = t / pieces;
+        const std::size_t k = t % pieces;
+        const std::size_t lo = bounds[2 * p];
+        const std::size_t mid = bounds[2 * p + 1];
+        const std::size_t hi = bounds[2 * p + 2];
+        const std::size_t d0 = (hi - lo) * k / pieces;
+        const std::size_t d1 = (hi - lo) * (k + 1) / pieces;
+        const std::size_t i0 = splits[p * (pieces + 1) + k];
+        const std::size_t i1 = splits[p * (pieces + 1) + k + 1];
+        merge_move(src + (lo + i0), src + (lo + i1),
+                   src + (mid + (d0 - i0)), src + (mid + (d1 - i1)),
+                   dst + (lo + d0), comp);
+    });
+    alloc.deallocate(splits, nsplits);
+}
+
+template <class ExecutionPolicy, class RandomIter, class Compare>
+void sort_policy(m_false_type, ExecutionPolicy &&, RandomIter first,
+                 RandomIter last, Compare comp) {
+    easystl::sort(first, last, comp);
+}
+
+template <class RandomIter, class Compare>
+void sort_policy(m_true_type, const execution::parallel_policy &policy,
+                 RandomIter first, RandomIter last, Compare comp) {
+    typedef typename iterator_traits<RandomIter>::value_type T;
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    parallel_blocks blocks = make_parallel_blocks(policy, n);
+    // 块数取不超过线程数的 2 的幂
+    std::size_t runs = 1;
+    while (runs * 2 <= blocks.count && runs * 2 <= blocks.pool->size() + 1) {
+        runs *= 2;
+    }
+    if (runs == 1) {
+        easystl::sort(first, last, comp);
+        return;
+    }
+    blocks.count = runs;
+
+    easystl::allocator<T> alloc;
+    T *buf = alloc.allocate(n);
+    std::size_t bounds[129];
+    std::size_t *bound = runs < 128 ? bounds : nullptr;
+    easystl::allocator<std::size_t> bound_alloc;
+    if (bound == nullptr) {
+        bound = bound_alloc.allocate(runs + 1);
+    }
+    for (std::size_t i = 0; i <= runs; ++i) {
+        bound[i] = blocks.begin(i);
+    }
+    run_parallel_blocks(blocks,
+                        [&](std::size_t, std::size_t b, std::size_t e) {
+                            for (std::size_t i = b; i < e; ++i) {
+                                easystl::construct(
+                                    buf + i, easystl::move(*(first + i)));
+                            }
+                            easystl::sort(buf + b, buf + e, comp);
+                        });
+
+    bool in_buf = true;
+    for (; runs > 1; runs /= 2) {
+        if (in_buf) {
+            parallel_merge_round(blocks, buf, first, bound, runs, comp);
+        } else {
+            parallel_merge_round(blocks, first, buf, bound, runs, comp);
+        }
+        in_buf = !in_buf;
+        for (std::size_t i = 0; i <= runs / 2; ++i) {
+            bound[i] = bound[2 * i];
+        }
+    }
+    if (in_buf) {
+        run_parallel_blocks(blocks,
+                            [&](std::size_t, std::size_t b, std::size_t e) {
+                                easystl::move(buf + b, buf + e, first + b);
+                            });
+    }
+    easystl::destroy(buf, buf + n);
+    alloc.deallocate(buf, n);
+    if (bound != bounds) {
+        bound_alloc.deallocate(bound, blocks.count + 1);
+    }
+}
+
+template <class ExecutionPolicy, class RandomIter, class Compare>
+typename enable_if_execution_policy<ExecutionPolicy, void>::type
+sort(ExecutionPolicy &&policy, RandomIter first, RandomIter last,
+     Compare comp) {
+    sort_policy(use_parallel<ExecutionPolicy, RandomIter>(), policy,
+                easystl::niter_base(first), easystl::niter_base(last), comp);
+}
+
+template <class ExecutionPolicy, class RandomIter>
+typename enable_if_execution_policy<ExecutionPolicy, void>::type
+sort(ExecutionPolicy &&policy, RandomIter first, RandomIter last) {
+    easystl::sort(
+        policy, first, last,
+        easystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_PARALLEL_ALGO_H
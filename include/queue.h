@@ -0,0 +1,346 @@
+#ifndef EASYSTL_QUEUE_H
+#define EASYSTL_QUEUE_H
+
+// 优先队列：priority_queue, indexed_priority_queue
+//
+// 两者都按 heap_algo.h 中的 d 叉堆组织，分叉数 Arity 默认为 4，Arity 为 2 时
+// 就是普通的二叉堆。不同分叉数的开销见 heap_algo.h 中的说明，可以用
+// bench/queue_bench.cpp 在实际的元素类型上比较。
+//
+// indexed_priority_queue 在 push 时为每个元素分配一个句柄，之后可以按句柄
+// 修改元素的优先级（decrease_key / increase_key / update）或删除任意元素，
+// 适合定时器、Dijkstra 等需要调整优先级的场合：
+//     easystl::indexed_priority_queue<long> timers;  // 默认为小根堆
+//     auto h = timers.push(deadline);
+//     timers.decrease_key(h, earlier_deadline);
+
+#include "exceptdef.h"
+#include "functional.h"
+#include "heap_algo.h"
+#include "utility.h"
+#include "vector.h"
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+namespace easystl {
+
+/*
+ * priority_queue
+ * 容器适配器，默认以 easystl::vector 为底层容器，comp 为 less 时为大根堆，
+ * top() 返回最大的元素
+ * */
+template <class T, class Container = vector<T>,
+          class Compare = easystl::less<typename Container::value_type>,
+          std::size_t Arity = 4>
+class priority_queue {
+  public:
+    typedef Container container_type;
+    typedef Compare value_compare;
+    typedef typename Container::value_type value_type;
+    typedef typename Container::size_type size_type;
+    typedef typename Container::reference reference;
+    typedef typename Container::const_reference const_reference;
+
+  protected:
+    Container c;
+    Compare comp;
+
+  public:
+    priority_queue() : c(), comp() {}
+
+    explicit priority_queue(const Compare &compare) : c(), comp(compare) {}
+
+    priority_queue(const Compare &compare, const Container &cont)
+        : c(cont), comp(compare) {
+        easystl::make_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    priority_queue(const Compare &compare, Container &&cont)
+        : c(easystl::move(cont)), comp(compare) {
+        easystl::make_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    template <class InputIter>
+    priority_queue(InputIter first, InputIter last,
+                   const Compare &compare = Compare())
+        : c(first, last), comp(compare) {
+        easystl::make_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    priority_queue(std::initializer_list<value_type> ilist,
+                   const Compare &compare = Compare())
+        : c(ilist), comp(compare) {
+        easystl::make_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    bool empty() const { return c.empty(); }
+    size_type size() const { return c.size(); }
+
+    const_reference top() const {
+        EASYSTL_DEBUG(!empty());
+        return c.front();
+    }
+
+    void push(const value_type &value) {
+        c.push_back(value);
+        easystl::push_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    void push(value_type &&value) {
+        c.push_back(easystl::move(value));
+        easystl::push_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    template <class... Args> void emplace(Args &&...args) {
+        c.emplace_back(easystl::forward<Args>(args)...);
+        easystl::push_heap<Arity>(c.begin(), c.end(), comp);
+    }
+
+    void pop() {
+        EASYSTL_DEBUG(!empty());
+        easystl::pop_heap<Arity>(c.begin(), c.end(), comp);
+        c.pop_back();
+    }
+
+    void swap(priority_queue &rhs) noexcept(
+        noexcept(easystl::swap(std::declval<Container &>(),
+                               std::declval<Container &>())) &&
+        noexcept(easystl::swap(std::declval<Compare &>(),
+                               std::declval<Compare &>()))) {
+        easystl::swap(c, rhs.c);
+        easystl::swap(comp, rhs.comp);
+    }
+};
+
+template <class T, class Container, class Compare, std::size_t Arity>
+void swap(priority_queue<T, Container, Compare, Arity> &lhs,
+          priority_queue<T, Container, Compare, Arity> &rhs) noexcept(
+    noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+/*
+ * indexed_priority_queue
+ * 可以按句柄修改与删除元素的 d 叉堆。堆中的每个节点保存元素与它的句柄，
+ * M_pos 记录每个句柄当前在堆中的下标，节点每次移动时同步更新。
+ * 元素出队或被删除后，它的句柄会被之后的 push 复用。
+ * 与 priority_queue 不同，默认的 comp 为 greater，是小根堆，top() 返回最小
+ * 的元素，decrease_key 与 increase_key 的名称与值的变化方向一致
+ * */
+template <class T, class Compare = easystl::greater<T>, std::size_t Arity = 4>
+class indexed_priority_queue {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+  public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef std::size_t size_type;
+    typedef std::size_t handle_type;
+    typedef const T &const_reference;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+  private:
+    struct node {
+        T value;
+        handle_type handle;
+    };
+
+    vector<node> M_heap;
+    // 句柄 -> 在 M_heap 中的下标，不在队列中时为 npos
+    vector<size_type> M_pos;
+    // 可以复用的句柄
+    vector<handle_type> M_free;
+    Compare M_comp;
+
+  public:
+    indexed_priority_queue() : M_heap(), M_pos(), M_free(), M_comp() {}
+
+    explicit indexed_priority_queue(const Compare &comp)
+        : M_heap(), M_pos(), M_free(), M_comp(comp) {}
+
+    bool empty() const noexcept { return M_heap.empty(); }
+    size_type size() const noexcept { return M_heap.size(); }
+
+    void reserve(size_type n) {
+        M_heap.reserve(n);
+        M_pos.reserve(n);
+    }
+
+    void clear() {
+        M_heap.clear();
+        M_pos.clear();
+        M_free.clear();
+    }
+
+    const_reference top() const {
+        EASYSTL_DEBUG(!empty());
+        return M_heap.front().value;
+    }
+
+    handle_type top_handle() const {
+        EASYSTL_DEBUG(!empty());
+        return M_heap.front().handle;
+    }
+
+    bool contains(handle_type h) const noexcept {
+        return h < M_pos.size() && M_pos[h] != npos;
+    }
+
+    // 句柄 h 对应的元素
+    const_reference operator[](handle_type h) const {
+        EASYSTL_DEBUG(contains(h));
+        return M_heap[M_pos[h]].value;
+    }
+
+    /**
+     *  @brief  放入 @a value
+     *  @return  元素的句柄，元素离开队列之前一直有效
+     */
+    handle_type push(const T &value) { return M_push(T(value)); }
+    handle_type push(T &&value) { return M_push(easystl::move(value)); }
+
+    void pop() {
+        EASYSTL_DEBUG(!empty());
+        M_erase_at(0);
+    }
+
+    // 删除句柄 h 对应的元素
+    void erase(handle_type h) {
+        EASYSTL_DEBUG(contains(h));
+        M_erase_at(M_pos[h]);
+    }
+
+    /**
+     *  @brief  把句柄 @a h 对应的元素改为 @a value，新值按 comp 不排在旧值
+     *          之前，元素只会向堆顶移动。
+     *  默认的 greater 下即新值不大于旧值；自定义 comp 时按优先级变高理解
+     */
+    void decrease_key(handle_type h, T value) {
+        EASYSTL_DEBUG(contains(h));
+        EASYSTL_DEBUG(!M_comp(value, M_heap[M_pos[h]].value));
+        M_sift_up(M_pos[h], node{easystl::move(value), h});
+    }
+
+    // 与 decrease_key 相反：新值不排在旧值之后，元素只会向叶子移动
+    void increase_key(handle_type h, T value) {
+        EASYSTL_DEBUG(contains(h));
+        EASYSTL_DEBUG(!M_comp(M_heap[M_pos[h]].value, value));
+        M_sift_down(M_pos[h], node{easystl::move(value), h});
+    }
+
+    // 把句柄 h 对应的元素改为 value，不要求新旧值的大小关系
+    void update(handle_type h, T value) {
+        EASYSTL_DEBUG(contains(h));
+        M_fix(M_pos[h], node{easystl::move(value), h});
+    }
+
+    void swap(indexed_priority_queue &rhs) noexcept(noexcept(
+        easystl::swap(std::declval<Compare &>(), std::declval<Compare &>()))) {
+        easystl::swap(M_heap, rhs.M_heap);
+        easystl::swap(M_pos, rhs.M_pos);
+        easystl::swap(M_free, rhs.M_free);
+        easystl::swap(M_comp, rhs.M_comp);
+    }
+
+  private:
+    // 先放入节点再分配句柄：M_pos 扩容失败时撤销节点，句柄不会泄漏
+    handle_type M_push(T &&value) {
+        M_heap.push_back(node{easystl::move(value), handle_type()});
+        handle_type h;
+        if (M_free.empty()) {
+            h = M_pos.size();
+            try {
+                M_pos.push_back(npos);
+            } catch (...) {
+                M_heap.pop_back();
+                throw;
+            }
+        } else {
+            h = M_free.back();
+            M_free.pop_back();
+        }
+        M_heap.back().handle = h;
+        node n = easystl::move(M_heap.back());
+        M_sift_up(M_heap.size() - 1, easystl::move(n));
+        return h;
+    }
+
+    void M_erase_at(size_type i) {
+        // push_back 可能抛出异常，放在修改任何状态之前
+        const handle_type h = M_heap[i].handle;
+        M_free.push_back(h);
+        M_pos[h] = npos;
+        node last = easystl::move(M_heap.back());
+        M_heap.pop_back();
+        if (i < M_heap.size()) {
+            M_fix(i, easystl::move(last));
+        }
+    }
+
+    void M_move_to(size_type i, node &&n) {
+        M_pos[n.handle] = i;
+        M_heap[i] = easystl::move(n);
+    }
+
+    // 下标 hole 处的节点已经失效，把 n 放到从 hole 上浮后的位置
+    void M_sift_up(size_type hole, node &&n) {
+        while (hole > 0) {
+            const size_type parent = (hole - 1) / Arity;
+            if (!M_comp(M_heap[parent].value, n.value)) {
+                break;
+            }
+            M_move_to(hole, easystl::move(M_heap[parent]));
+            hole = parent;
+        }
+        M_move_to(hole, easystl::move(n));
+    }
+
+    // 把 n 放到从 hole 下沉后的位置，每层与最大的子节点比较
+    void M_sift_down(size_type hole, node &&n) {
+        const size_type len = M_heap.size();
+        while (true) {
+            const size_type child = Arity * hole + 1;
+            if (child >= len) {
+                break;
+            }
+            const size_type end = len - child < Arity ? len : child + Arity;
+            size_type best = child;
+            for (size_type i = child + 1; i < end; ++i) {
+                if (M_comp(M_heap[best].value, M_heap[i].value)) {
+                    best = i;
+                }
+            }
+            if (!M_comp(n.value, M_heap[best].value)) {
+                break;
+            }
+            M_move_to(hole, easystl::move(M_heap[best]));
+            hole = best;
+        }
+        M_move_to(hole, easystl::move(n));
+    }
+
+    void M_fix(size_type hole, node &&n) {
+        if (hole > 0 && M_comp(M_heap[(hole - 1) / Arity].value, n.value)) {
+            M_sift_up(hole, easystl::move(n));
+        } else {
+            M_sift_down(hole, easystl::move(n));
+        }
+    }
+};
+
+template <class T, class Compare, std::size_t Arity>
+const typename indexed_priority_queue<T, Compare, Arity>::size_type
+    indexed_priority_queue<T, Compare, Arity>::npos;
+
+template <class T, class Compare, std::size_t Arity>
+void swap(indexed_priority_queue<T, Compare, Arity> &lhs,
+          indexed_priority_queue<T, Compare, Arity> &rhs) noexcept(
+    noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_QUEUE_H
@@ -0,0 +1,317 @@
+#ifndef EASYSTL_RADIX_SORT_H
+#define EASYSTL_RADIX_SORT_H
+
+// 基数排序：radix_sort
+//
+// 整数与浮点数键使用 LSD 基数排序，每一趟按一个字节分配，一次遍历统计所有
+// 字节的直方图，所有元素在某个字节上相同时跳过这一趟。元素在原区间与分配器
+// 申请的临时缓冲区之间来回搬移，结果是稳定的。
+//
+// basic_string 使用 MSD 基数排序（American flag sort）：按当前位置的字符原地
+// 分桶，再对每个桶处理下一个字符，已经结束的字符串排在最前面。顺序与
+// char_traits<char>::compare 相同，即按无符号字节比较。
+//
+//     easystl::radix_sort(keys, keys + n);
+//     easystl::radix_sort(recs, recs + n, [](const rec &r) { return r.id; });
+
+#include "algo.h"
+#include "allocator.h"
+#include "basic_string.h"
+#include "construct.h"
+#include "iterator.h"
+#include "utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace easystl {
+
+// 元素少于这个值时使用插入排序
+enum { radix_sort_threshold = 64, radix_string_sort_threshold = 32 };
+
+/**
+ *  @brief  把键转换为无符号整数，转换后的大小顺序与键的顺序一致
+ *
+ *  有符号整数翻转符号位；浮点数为非负时置符号位，为负时所有位取反，
+ *  因此 -0.0 排在 0.0 之前，NaN 按符号位排在两端。
+ */
+template <class Key, class = void> struct radix_key_traits;
+
+template <class Key>
+struct radix_key_traits<
+    Key, typename std::enable_if<std::is_integral<Key>::value &&
+                                 !std::is_same<Key, bool>::value>::type> {
+    typedef typename std::make_unsigned<Key>::type unsigned_type;
+
+    static unsigned_type encode(Key key) noexcept {
+        return static_cast<unsigned_type>(key) ^
+               (std::is_signed<Key>::value
+                    ? static_cast<unsigned_type>(
+                          unsigned_type(1)
+                          << (std::numeric_limits<unsigned_type>::digits - 1))
+                    : unsigned_type(0));
+    }
+};
+
+template <class Key>
+struct radix_key_traits<
+    Key,
+    typename std::enable_if<std::is_floating_point<Key>::value &&
+                            std::numeric_limits<Key>::is_iec559 &&
+                            (sizeof(Key) == 4 || sizeof(Key) == 8)>::type> {
+    typedef typename std::conditional<sizeof(Key) == 4, std::uint32_t,
+                                      std::uint64_t>::type unsigned_type;
+
+    static unsigned_type encode(Key key) noexcept {
+        unsigned_type bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        const unsigned_type sign = unsigned_type(1) << (sizeof(Key) * 8 - 1);
+        return (bits & sign) ? static_cast<unsigned_type>(~bits)
+                             : static_cast<unsigned_type>(bits | sign);
+    }
+};
+
+// 返回元素本身的键提取函数
+struct radix_identity {
+    template <class T> const T &operator()(const T &x) const noexcept {
+        return x;
+    }
+};
+
+/*
+ * LSD 基数排序
+ * */
+
+// 按第 shift 位开始的字节把 [first, last) 分配到 out
+template <class InputIter, class OutputIter, class KeyFn>
+void radix_scatter(InputIter first, InputIter last, OutputIter out,
+                   std::size_t *offsets, unsigned shift, KeyFn &key) {
+    typedef decltype(key(*first)) key_ref;
+    typedef typename std::decay<key_ref>::type Key;
+    for (; first != last; ++first) {
+        const std::size_t digit = static_cast<std::size_t>(
+            (radix_key_traits<Key>::encode(key(*first)) >> shift) & 0xff);
+        *(out + offsets[digit]++) = easystl::move(*first);
+    }
+}
+
+// 第一趟分配时缓冲区中还没有对象，逐个构造
+template <class RandomIter, class Tp, class KeyFn>
+void radix_scatter_construct(RandomIter first, RandomIter last, Tp *out,
+                             std::size_t *offsets, unsigned shift,
+                             KeyFn &key) {
+    typedef decltype(key(*first)) key_ref;
+    typedef typename std::decay<key_ref>::type Key;
+    for (; first != last; ++first) {
+        const std::size_t digit = static_cast<std::size_t>(
+            (radix_key_traits<Key>::encode(key(*first)) >> shift) & 0xff);
+        easystl::construct(out + offsets[digit]++, easystl::move(*first));
+    }
+}
+
+template <class RandomIter, class KeyFn>
+void radix_sort_lsd(RandomIter first, RandomIter last, KeyFn key) {
+    typedef typename iterator_traits<RandomIter>::value_type T;
+    typedef decltype(key(*first)) key_ref;
+    typedef typename std::decay<key_ref>::type Key;
+    typedef typename radix_key_traits<Key>::unsigned_type U;
+    const unsigned kPasses = sizeof(U);
+
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    if (n < radix_sort_threshold) {
+        unchecked_insertion_sort(first, last, [&key](const T &a, const T &b) {
+            return radix_key_traits<Key>::encode(key(a)) <
+                   radix_key_traits<Key>::encode(key(b));
+        });
+        return;
+    }
+
+    // 一次遍历统计每个字节的直方图
+    std::size_t counts[sizeof(U)][256] = {};
+    for (RandomIter i = first; i != last; ++i) {
+        U k = radix_key_traits<Key>::encode(key(*i));
+        for (unsigned p = 0; p < kPasses; ++p) {
+            ++counts[p][k & 0xff];
+            k = static_cast<U>(k >> 8);
+        }
+    }
+
+    easystl::allocator<T> alloc;
+    T *buf = alloc.allocate(n);
+    bool buf_constructed = false;
+    bool in_buf = false;
+    for (unsigned p = 0; p < kPasses; ++p) {
+        // 所有元素在这个字节上相同，这一趟不改变顺序
+        const std::size_t *count = counts[p];
+        bool trivial = false;
+        for (unsigned d = 0; d < 256; ++d) {
+            if (count[d] != 0) {
+                trivial = count[d] == n;
+                break;
+            }
+        }
+        if (trivial) {
+            continue;
+        }
+        std::size_t offsets[256];
+        std::size_t sum = 0;
+        for (unsigned d = 0; d < 256; ++d) {
+            offsets[d] = sum;
+            sum += count[d];
+        }
+        const unsigned shift = p * 8;
+        if (in_buf) {
+            radix_scatter(buf, buf + n, first, offsets, shift, key);
+        } else if (buf_constructed) {
+            radix_scatter(first, last, buf, offsets, shift, key);
+        } else {
+            radix_scatter_construct(first, last, buf, offsets, shift, key);
+            buf_constructed = true;
+        }
+        in_buf = !in_buf;
+    }
+    if (in_buf) {
+        easystl::move(buf, buf + n, first);
+    }
+    if (buf_constructed) {
+        easystl::destroy(buf, buf + n);
+    }
+    alloc.deallocate(buf, n);
+}
+
+/*
+ * MSD 基数排序（American flag sort）
+ * */
+
+// 从第 depth 个字符开始比较
+template <class CharType, class CharTraits, class Allocator>
+bool radix_string_less(const basic_string<CharType, CharTraits, Allocator> &a,
+                       const basic_string<CharType, CharTraits, Allocator> &b,
+                       std::size_t depth) noexcept {
+    const std::size_t na = a.size() - depth;
+    const std::size_t nb = b.size() - depth;
+    const int r = char_traits<char>::compare(
+        reinterpret_cast<const char *>(a.data()) + depth,
+        reinterpret_cast<const char *>(b.data()) + depth, na < nb ? na : nb);
+    return r != 0 ? r < 0 : na < nb;
+}
+
+// 已经结束的字符串放在桶 0，字符 c 放在桶 c + 1
+template <class CharType, class CharTraits, class Allocator>
+std::size_t
+radix_string_bucket(const basic_string<CharType, CharTraits, Allocator> &s,
+                    std::size_t depth) noexcept {
+    return depth < s.size()
+               ? static_cast<std::size_t>(
+                     static_cast<unsigned char>(s.data()[depth])) +
+                     1
+               : 0;
+}
+
+template <class RandomIter>
+void radix_sort_msd(RandomIter first, RandomIter last, std::size_t depth) {
+    typedef typename iterator_traits<RandomIter>::value_type Str;
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    while (true) {
+        const Distance n = last - first;
+        if (n < radix_string_sort_threshold) {
+            unchecked_insertion_sort(first, last,
+                                     [depth](const Str &a, const Str &b) {
+                                         return radix_string_less(a, b, depth);
+                                     });
+            return;
+        }
+
+        Distance count[257] = {};
+        for (RandomIter i = first; i != last; ++i) {
+            ++count[radix_string_bucket(*i, depth)];
+        }
+        // heads[b] 为桶 b 中下一个待放置的位置，tails[b] 为桶 b 的末尾
+        Distance heads[257];
+        Distance tails[257];
+        Distance sum = 0;
+        std::size_t largest = 0;
+        for (std::size_t b = 0; b < 257; ++b) {
+            heads[b] = sum;
+            sum += count[b];
+            tails[b] = sum;
+            if (count[b] > count[largest]) {
+                largest = b;
+            }
+        }
+
+        // 沿置换环把每个字符串交换到所属的桶
+        for (std::size_t b = 0; b < 257; ++b) {
+            while (heads[b] < tails[b]) {
+                Str &s = *(first + heads[b]);
+                std::size_t target = radix_string_bucket(s, depth);
+                while (target != b) {
+                    s.swap(*(first + heads[target]++));
+                    target = radix_string_bucket(s, depth);
+                }
+                ++heads[b];
+            }
+        }
+
+        // 桶 0 中的字符串相等。最大的桶留给循环处理，递归只处理其余的桶，
+        // 每一层递归的元素数至多为上一层的一半，递归深度不超过 log2(n)
+        for (std::size_t b = 1; b < 257; ++b) {
+            if (b != largest && count[b] > 1) {
+                radix_sort_msd(first + (tails[b] - count[b]),
+                               first + tails[b], depth + 1);
+            }
+        }
+        if (largest == 0 || count[largest] < 2) {
+            return;
+        }
+        last = first + tails[largest];
+        first = last - count[largest];
+        ++depth;
+    }
+}
+
+template <class RandomIter, class CharType, class CharTraits, class Allocator>
+void radix_sort_aux(RandomIter first, RandomIter last,
+                    basic_string<CharType, CharTraits, Allocator> *) {
+    static_assert(sizeof(CharType) == 1,
+                  "radix_sort supports strings of single-byte characters");
+    radix_sort_msd(first, last, 0);
+}
+
+template <class RandomIter, class T>
+void radix_sort_aux(RandomIter first, RandomIter last, T *) {
+    radix_sort_lsd(first, last, radix_identity());
+}
+
+/**
+ *  @brief  稳定地排序整数、浮点数或 basic_string
+ *  @param  first  起始随机访问迭代器
+ *  @param  last  结束随机访问迭代器
+ *
+ *  整数与浮点数需要 n 个元素的临时缓冲区；字符串原地排序。
+ */
+template <class RandomIter> void radix_sort(RandomIter first, RandomIter last) {
+    static_assert(is_random_access_iter<RandomIter>::value,
+                  "radix_sort requires random access iterators");
+    radix_sort_aux(easystl::niter_base(first), easystl::niter_base(last),
+                   value_type(first));
+}
+
+/**
+ *  @brief  按 key 返回的整数或浮点数稳定地排序
+ *  @param  first  起始随机访问迭代器
+ *  @param  last  结束随机访问迭代器
+ *  @param  key  键提取函数，对每个元素调用 O(sizeof(key)) 次
+ */
+template <class RandomIter, class KeyFn>
+void radix_sort(RandomIter first, RandomIter last, KeyFn key) {
+    static_assert(is_random_access_iter<RandomIter>::value,
+                  "radix_sort requires random access iterators");
+    radix_sort_lsd(easystl::niter_base(first), easystl::niter_base(last), key);
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_RADIX_SORT_H
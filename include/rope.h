@@ -0,0 +1,664 @@
+#ifndef EASYSTL_ROPE_H
+#define EASYSTL_ROPE_H
+
+// 持久化的 rope 字符串
+//
+// basic_rope 使用不可变的、引用计数共享的平衡二叉树（基于 join 的 AVL 树）
+// 存储字符串，叶子节点保存一段不超过 S_leaf_max 个字符的连续内容。
+// 拷贝为 O(1)，在任意位置插入、删除、截取子串均为 O(log n)，且不会修改已有
+// 节点：修改后的 rope 与原 rope 共享未改变的部分。
+
+#include "alloc_traits.h"
+#include "basic_string.h"
+#include "char_traits.h"
+#include "exceptdef.h"
+#include "utility.h"
+#include <atomic>
+#include <cstddef>
+
+namespace easystl {
+
+template <class CharType, class CharTraits = easystl::char_traits<CharType>,
+          class Allocator = easystl::allocator<CharType>>
+class basic_rope {
+  public:
+    typedef CharTraits traits_type;
+    typedef CharType value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef basic_string<CharType, CharTraits, Allocator> string_type;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+  private:
+    // 叶子节点 left == right == nullptr，字符存放在 chars 中
+    struct node {
+        std::atomic<size_type> refs;
+        size_type length;
+        unsigned height;
+        node *left;
+        node *right;
+        CharType *chars;
+    };
+
+    typedef easystl_cxx::alloc_traits<Allocator> char_alloc_traits;
+    typedef typename char_alloc_traits::template rebind<node>::other
+        node_alloc_type;
+    typedef easystl_cxx::alloc_traits<node_alloc_type> node_alloc_traits;
+
+    // 叶子节点的最大长度，两个相邻的小叶子合并后不超过该长度时会被合并
+    enum { S_leaf_max = 512 / sizeof(CharType) };
+
+    Allocator M_alloc;
+    node *M_root;
+
+  public:
+    /**
+     *  @brief  构造空 rope
+     */
+    basic_rope() noexcept : M_alloc(), M_root(nullptr) {}
+
+    explicit basic_rope(const Allocator &a) noexcept
+        : M_alloc(a), M_root(nullptr) {}
+
+    basic_rope(const CharType *s, size_type n,
+               const Allocator &a = Allocator())
+        : M_alloc(a), M_root(nullptr) {
+        easystl_require_string_len(s, n);
+        M_root = M_build(s, n);
+    }
+
+    basic_rope(const CharType *s, const Allocator &a = Allocator())
+        : M_alloc(a), M_root(nullptr) {
+        easystl_require_string(s);
+        M_root = M_build(s, traits_type::length(s));
+    }
+
+    template <class Alloc>
+    basic_rope(const basic_string<CharType, CharTraits, Alloc> &str,
+               const Allocator &a = Allocator())
+        : M_alloc(a), M_root(nullptr) {
+        M_root = M_build(str.data(), str.size());
+    }
+
+    /**
+     *  @brief  拷贝构造，只增加根节点的引用计数
+     */
+    basic_rope(const basic_rope &rhs) noexcept
+        : M_alloc(rhs.M_alloc), M_root(M_acquire(rhs.M_root)) {}
+
+    basic_rope(basic_rope &&rhs) noexcept
+        : M_alloc(easystl::move(rhs.M_alloc)), M_root(rhs.M_root) {
+        rhs.M_root = nullptr;
+    }
+
+    basic_rope &operator=(const basic_rope &rhs) noexcept {
+        node *root = M_acquire(rhs.M_root);
+        M_release(M_root);
+        M_root = root;
+        return *this;
+    }
+
+    basic_rope &operator=(basic_rope &&rhs) noexcept {
+        if (this != &rhs) {
+            M_release(M_root);
+            M_root = rhs.M_root;
+            rhs.M_root = nullptr;
+        }
+        return *this;
+    }
+
+    ~basic_rope() { M_release(M_root); }
+
+  public:
+    size_type size() const noexcept { return S_length(M_root); }
+    size_type length() const noexcept { return S_length(M_root); }
+    bool empty() const noexcept { return M_root == nullptr; }
+
+    /**
+     *  @brief  树的高度，叶子节点高度为 0
+     */
+    size_type height() const noexcept {
+        return M_root ? M_root->height : 0;
+    }
+
+    /**
+     *  @brief  获取第 @a pos 个字符，O(log n)
+     */
+    CharType operator[](size_type pos) const noexcept {
+        EASYSTL_DEBUG(pos < size());
+        const node *x = M_root;
+        while (x->left) {
+            if (pos < x->left->length) {
+                x = x->left;
+            } else {
+                pos -= x->left->length;
+                x = x->right;
+            }
+        }
+        return x->chars[pos];
+    }
+
+    CharType at(size_type pos) const {
+        THROW_OUT_OF_RANGE_IF(pos >= size(), "basic_rope::at");
+        return (*this)[pos];
+    }
+
+    /**
+     *  @brief  在末尾追加字符
+     */
+    basic_rope &append(const CharType *s, size_type n) {
+        easystl_require_string_len(s, n);
+        node *tail = M_build(s, n);
+        M_reset(M_join(M_acquire(M_root), tail));
+        return *this;
+    }
+
+    basic_rope &append(const CharType *s) {
+        easystl_require_string(s);
+        return append(s, traits_type::length(s));
+    }
+
+    basic_rope &append(const basic_rope &r) {
+        M_reset(M_join(M_acquire(M_root), M_acquire(r.M_root)));
+        return *this;
+    }
+
+    /**
+     *  @brief  在 @a pos 处插入 C 字符串的前 @a n 个字符，O(log n + n)
+     */
+    basic_rope &insert(size_type pos, const CharType *s, size_type n) {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "basic_rope::insert");
+        easystl_require_string_len(s, n);
+        M_reset(M_insert(pos, M_build(s, n)));
+        return *this;
+    }
+
+    basic_rope &insert(size_type pos, const CharType *s) {
+        easystl_require_string(s);
+        return insert(pos, s, traits_type::length(s));
+    }
+
+    /**
+     *  @brief  在 @a pos 处插入另一个 rope，O(log n)，不复制字符
+     */
+    basic_rope &insert(size_type pos, const basic_rope &r) {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "basic_rope::insert");
+        M_reset(M_insert(pos, M_acquire(r.M_root)));
+        return *this;
+    }
+
+    /**
+     *  @brief  删除从 @a pos 开始的 @a n 个字符，O(log n)
+     */
+    basic_rope &erase(size_type pos, size_type n = npos) {
+        const size_type len = size();
+        THROW_OUT_OF_RANGE_IF(pos > len, "basic_rope::erase");
+        if (n > len - pos) {
+            n = len - pos;
+        }
+        node *left = nullptr;
+        node *rest = nullptr;
+        node *mid = nullptr;
+        node *right = nullptr;
+        M_split(M_acquire(M_root), pos, left, rest);
+        try {
+            M_split(rest, n, mid, right);
+        } catch (...) {
+            M_release(left);
+            throw;
+        }
+        M_release(mid);
+        M_reset(M_join(left, right));
+        return *this;
+    }
+
+    /**
+     *  @brief  截取子串，O(log n)，与原 rope 共享节点
+     */
+    basic_rope substr(size_type pos, size_type n = npos) const {
+        const size_type len = size();
+        THROW_OUT_OF_RANGE_IF(pos > len, "basic_rope::substr");
+        if (n > len - pos) {
+            n = len - pos;
+        }
+        basic_rope r(M_alloc);
+        node *left = nullptr;
+        node *rest = nullptr;
+        node *mid = nullptr;
+        node *right = nullptr;
+        r.M_split(M_acquire(M_root), pos, left, rest);
+        r.M_release(left);
+        r.M_split(rest, n, mid, right);
+        r.M_release(right);
+        r.M_root = mid;
+        return r;
+    }
+
+    void clear() noexcept {
+        M_release(M_root);
+        M_root = nullptr;
+    }
+
+    /**
+     *  @brief  按顺序对每个叶子调用 fn(const CharType *data, size_type n)
+     */
+    template <class Function> void for_each_chunk(Function fn) const {
+        S_for_each(M_root, fn);
+    }
+
+    /**
+     *  @brief  将内容追加到 @a str 末尾
+     */
+    template <class Alloc>
+    void append_to(basic_string<CharType, CharTraits, Alloc> &str) const {
+        str.reserve(str.size() + size());
+        S_append_to(M_root, str);
+    }
+
+    /**
+     *  @brief  生成包含全部内容的字符串
+     */
+    string_type str() const {
+        string_type result(M_alloc);
+        append_to(result);
+        return result;
+    }
+
+    void swap(basic_rope &rhs) noexcept {
+        easystl::swap(M_alloc, rhs.M_alloc);
+        easystl::swap(M_root, rhs.M_root);
+    }
+
+  private:
+    // 修改操作在根的新引用上构建新树，成功后才替换 M_root，抛出异常时 rope
+    // 保持不变。以下接管引用的函数抛出异常时会释放接管的全部引用
+    void M_reset(node *root) noexcept {
+        node *old = M_root;
+        M_root = root;
+        M_release(old);
+    }
+
+    static size_type S_length(const node *x) noexcept {
+        return x ? x->length : 0;
+    }
+
+    static unsigned S_height(const node *x) noexcept {
+        return x ? x->height : 0;
+    }
+
+    static node *M_acquire(node *x) noexcept {
+        if (x) {
+            x->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    /**
+     *  @brief  减少引用计数，降为 0 时递归释放
+     */
+    void M_release(node *x) noexcept {
+        while (x && x->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            node *left = x->left;
+            node *right = x->right;
+            if (x->chars) {
+                char_alloc_traits::deallocate(M_alloc, x->chars, x->length);
+            }
+            node_alloc_type nalloc(M_alloc);
+            node_alloc_traits::deallocate(nalloc, x, 1);
+            M_release(left);
+            x = right;
+        }
+    }
+
+    node *M_new_node() {
+        node_alloc_type nalloc(M_alloc);
+        node *x = node_alloc_traits::allocate(nalloc, 1);
+        ::new (static_cast<void *>(&x->refs)) std::atomic<size_type>(1);
+        x->length = 0;
+        x->height = 0;
+        x->left = nullptr;
+        x->right = nullptr;
+        x->chars = nullptr;
+        return x;
+    }
+
+    /**
+     *  @brief  分配一个可容纳 @a n 个字符的叶子节点，字符未初始化
+     */
+    node *M_new_leaf(size_type n) {
+        node *x = M_new_node();
+        try {
+            x->chars = char_alloc_traits::allocate(M_alloc, n);
+        } catch (...) {
+            node_alloc_type nalloc(M_alloc);
+            node_alloc_traits::deallocate(nalloc, x, 1);
+            throw;
+        }
+        x->length = n;
+        return x;
+    }
+
+    node *M_make_leaf(const CharType *s, size_type n) {
+        node *x = M_new_leaf(n);
+        traits_type::copy(x->chars, s, n);
+        return x;
+    }
+
+    /**
+     *  @brief  由两个高度相差不超过 1 的子树创建内部节点，接管两者的引用
+     */
+    node *M_make_inner(node *left, node *right) {
+        node *x = nullptr;
+        try {
+            x = M_new_node();
+        } catch (...) {
+            M_release(left);
+            M_release(right);
+            throw;
+        }
+        x->left = left;
+        x->right = right;
+        x->length = left->length + right->length;
+        const unsigned hl = left->height;
+        const unsigned hr = right->height;
+        x->height = (hl > hr ? hl : hr) + 1;
+        return x;
+    }
+
+    /**
+     *  @brief  用 [s, s + n) 构建平衡的子树
+     */
+    node *M_build(const CharType *s, size_type n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n <= size_type(S_leaf_max)) {
+            return M_make_leaf(s, n);
+        }
+        // 按叶子数目对半分，保证两棵子树高度相差不超过 1
+        const size_type leaves = (n + S_leaf_max - 1) / S_leaf_max;
+        const size_type half = (leaves / 2) * S_leaf_max;
+        node *left = M_build(s, half);
+        node *right = nullptr;
+        try {
+            right = M_build(s + half, n - half);
+        } catch (...) {
+            M_release(left);
+            throw;
+        }
+        return M_make_inner(left, right);
+    }
+
+    // 以下旋转与 join 操作都接管参数的引用，并返回新树（旧节点不被修改）
+
+    /**
+     *  @brief  创建以 (a, b) 为子树的节点，必要时合并两个小叶子
+     */
+    node *M_node(node *a, node *b) {
+        if (!a->left && !b->left &&
+            a->length + b->length <= size_type(S_leaf_max)) {
+            node *x = nullptr;
+            try {
+                x = M_new_leaf(a->length + b->length);
+            } catch (...) {
+                M_release(a);
+                M_release(b);
+                throw;
+            }
+            traits_type::copy(x->chars, a->chars, a->length);
+            traits_type::copy(x->chars + a->length, b->chars, b->length);
+            M_release(a);
+            M_release(b);
+            return x;
+        }
+        return M_make_inner(a, b);
+    }
+
+    /**
+     *  @brief  拆开内部节点 @a x，以新引用返回它的两个子节点
+     */
+    void M_open(node *x, node *&left, node *&right) {
+        left = M_acquire(x->left);
+        right = M_acquire(x->right);
+        M_release(x);
+    }
+
+    node *M_rotate_left(node *x) {
+        node *a = nullptr;
+        node *y = nullptr;
+        M_open(x, a, y);
+        node *b = nullptr;
+        node *c = nullptr;
+        M_open(y, b, c);
+        node *ab = nullptr;
+        try {
+            ab = M_make_inner(a, b);
+        } catch (...) {
+            M_release(c);
+            throw;
+        }
+        return M_make_inner(ab, c);
+    }
+
+    node *M_rotate_right(node *x) {
+        node *y = nullptr;
+        node *c = nullptr;
+        M_open(x, y, c);
+        node *a = nullptr;
+        node *b = nullptr;
+        M_open(y, a, b);
+        node *bc = nullptr;
+        try {
+            bc = M_make_inner(b, c);
+        } catch (...) {
+            M_release(a);
+            throw;
+        }
+        return M_make_inner(a, bc);
+    }
+
+    node *M_join_right(node *tl, node *tr) {
+        node *l = nullptr;
+        node *r = nullptr;
+        M_open(tl, l, r);
+        node *t = nullptr;
+        bool rotate = false;
+        try {
+            if (S_height(r) <= S_height(tr) + 1) {
+                t = M_node(r, tr);
+                if (S_height(t) > S_height(l) + 1) {
+                    t = M_rotate_right(t);
+                    rotate = true;
+                }
+            } else {
+                t = M_join_right(r, tr);
+                rotate = S_height(t) > S_height(l) + 1;
+            }
+        } catch (...) {
+            M_release(l);
+            throw;
+        }
+        node *t2 = M_make_inner(l, t);
+        return rotate ? M_rotate_left(t2) : t2;
+    }
+
+    node *M_join_left(node *tl, node *tr) {
+        node *l = nullptr;
+        node *r = nullptr;
+        M_open(tr, l, r);
+        node *t = nullptr;
+        bool rotate = false;
+        try {
+            if (S_height(l) <= S_height(tl) + 1) {
+                t = M_node(tl, l);
+                if (S_height(t) > S_height(r) + 1) {
+                    t = M_rotate_left(t);
+                    rotate = true;
+                }
+            } else {
+                t = M_join_left(tl, l);
+                rotate = S_height(t) > S_height(r) + 1;
+            }
+        } catch (...) {
+            M_release(r);
+            throw;
+        }
+        node *t2 = M_make_inner(t, r);
+        return rotate ? M_rotate_right(t2) : t2;
+    }
+
+    /**
+     *  @brief  连接两棵树，O(|h(a) - h(b)| + 1)
+     */
+    node *M_join(node *a, node *b) {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        if (a->height > b->height + 1) {
+            return M_join_right(a, b);
+        }
+        if (b->height > a->height + 1) {
+            return M_join_left(a, b);
+        }
+        return M_node(a, b);
+    }
+
+    /**
+     *  @brief  把 @a mid 插入到根的新引用的 @a pos 处，返回新树，接管 @a mid
+     */
+    node *M_insert(size_type pos, node *mid) {
+        node *left = nullptr;
+        node *right = nullptr;
+        try {
+            M_split(M_acquire(M_root), pos, left, right);
+        } catch (...) {
+            M_release(mid);
+            throw;
+        }
+        node *lm = nullptr;
+        try {
+            lm = M_join(left, mid);
+        } catch (...) {
+            M_release(right);
+            throw;
+        }
+        return M_join(lm, right);
+    }
+
+    /**
+     *  @brief  将 @a x 在 @a pos 处拆分为 [0, pos) 与 [pos, size)，接管 @a x
+     */
+    void M_split(node *x, size_type pos, node *&left, node *&right) {
+        if (x == nullptr) {
+            left = right = nullptr;
+            return;
+        }
+        if (pos == 0) {
+            left = nullptr;
+            right = x;
+            return;
+        }
+        if (pos >= x->length) {
+            left = x;
+            right = nullptr;
+            return;
+        }
+        if (x->left == nullptr) {
+            node *l = nullptr;
+            try {
+                l = M_make_leaf(x->chars, pos);
+                right = M_make_leaf(x->chars + pos, x->length - pos);
+            } catch (...) {
+                M_release(l);
+                M_release(x);
+                throw;
+            }
+            left = l;
+            M_release(x);
+            return;
+        }
+        node *l = nullptr;
+        node *r = nullptr;
+        M_open(x, l, r);
+        if (pos < l->length) {
+            node *ll = nullptr;
+            node *lr = nullptr;
+            try {
+                M_split(l, pos, ll, lr);
+            } catch (...) {
+                M_release(r);
+                throw;
+            }
+            try {
+                right = M_join(lr, r);
+            } catch (...) {
+                M_release(ll);
+                throw;
+            }
+            left = ll;
+        } else if (pos == l->length) {
+            left = l;
+            right = r;
+        } else {
+            node *rl = nullptr;
+            node *rr = nullptr;
+            try {
+                M_split(r, pos - l->length, rl, rr);
+            } catch (...) {
+                M_release(l);
+                throw;
+            }
+            try {
+                left = M_join(l, rl);
+            } catch (...) {
+                M_release(rr);
+                throw;
+            }
+            right = rr;
+        }
+    }
+
+    template <class Function>
+    static void S_for_each(const node *x, Function &fn) {
+        while (x) {
+            if (x->left == nullptr) {
+                fn(static_cast<const CharType *>(x->chars), x->length);
+                return;
+            }
+            S_for_each(x->left, fn);
+            x = x->right;
+        }
+    }
+
+    template <class Str> static void S_append_to(const node *x, Str &str) {
+        while (x) {
+            if (x->left == nullptr) {
+                str.append(x->chars, x->length);
+                return;
+            }
+            S_append_to(x->left, str);
+            x = x->right;
+        }
+    }
+};
+
+template <class CharType, class CharTraits, class Allocator>
+constexpr typename basic_rope<CharType, CharTraits, Allocator>::size_type
+    basic_rope<CharType, CharTraits, Allocator>::npos;
+
+template <class CharType, class CharTraits, class Allocator>
+inline void swap(basic_rope<CharType, CharTraits, Allocator> &lhs,
+                 basic_rope<CharType, CharTraits, Allocator> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+using rope = basic_rope<char>;
+using wrope = basic_rope<wchar_t>;
+
+} // namespace easystl
+
+#endif // !EASYSTL_ROPE_H
@@ -0,0 +1,535 @@
+#ifndef EASYSTL_SCHEDULER_H
+#define EASYSTL_SCHEDULER_H
+
+// 工作窃取任务调度器
+//
+// 每个工作线程拥有一个 Chase-Lev 双端队列（work_stealing_deque）。工作线程
+// 产生的任务放入自己队列的底部，并优先从底部取回（后进先出，数据仍在缓存
+// 中）；自己的队列为空时随机选择其他线程，从队列顶部窃取最早的任务。不是
+// 工作线程的线程提交的任务进入一个加锁的注入队列。
+//
+// 空闲的工作线程先自旋若干轮，再让出 CPU 若干轮，仍然没有任务时在条件变量
+// 上休眠，不占用 CPU；有新任务时只在存在休眠线程的情况下才加锁唤醒。
+//
+// fork-join 使用 task_group：
+//     easystl::task_group g;
+//     g.spawn([&] { left = fib(n - 1); });
+//     right = fib(n - 2);
+//     g.sync();
+// sync 等待期间当前线程会执行队列中的任务，因此在任务中嵌套使用不会死锁。
+//
+// 任务对象由 easystl::allocator 分配，工作线程与扩容后的旧数组保存在
+// easystl::vector 中。
+
+#include "allocator.h"
+#include "construct.h"
+#include "utility.h"
+#include "vector.h"
+#include "work_stealing_deque.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#define EASYSTL_SCHEDULER_AFFINITY 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define EASYSTL_SCHEDULER_SSE2 1
+#endif
+
+namespace easystl {
+
+/**
+ *  @brief  scheduler 的构造参数
+ */
+struct scheduler_options {
+    // 工作线程数，默认为硬件线程数减一（等待任务的线程也参与执行）
+    std::size_t threads;
+    // 把第 i 个工作线程绑定到第 (i + 1) % 硬件线程数 个 CPU 上，只在 Linux
+    // 上有效
+    bool pin_threads;
+    // 空闲时自旋与让出 CPU 的轮数，之后进入休眠
+    unsigned spin_rounds;
+    unsigned yield_rounds;
+
+    scheduler_options()
+        : threads(default_threads()), pin_threads(false), spin_rounds(64),
+          yield_rounds(16) {}
+
+    static std::size_t default_threads() noexcept {
+        const unsigned n = std::thread::hardware_concurrency();
+        return n > 1 ? n - 1 : 0;
+    }
+};
+
+class scheduler {
+  public:
+    typedef std::size_t size_type;
+
+  private:
+    // 类型擦除后的任务：invoke 执行任务并释放它
+    struct task {
+        void (*invoke)(task *);
+        explicit task(void (*f)(task *)) noexcept : invoke(f) {}
+    };
+
+    template <class Fn> struct task_impl : task {
+        Fn fn;
+
+        template <class F>
+        explicit task_impl(F &&f)
+            : task(&S_invoke), fn(easystl::forward<F>(f)) {}
+
+        // 先把函数对象移出再释放任务，函数对象抛出异常时任务也已经释放
+        static void S_invoke(task *t) {
+            task_impl *self = static_cast<task_impl *>(t);
+            Fn f(easystl::move(self->fn));
+            easystl::destroy(self);
+            easystl::allocator<task_impl>().deallocate(self, 1);
+            f();
+        }
+    };
+
+    struct worker {
+        work_stealing_deque<task *> deque;
+        std::thread thread;
+        std::uint64_t rng;
+
+        explicit worker(std::uint64_t seed) : deque(256), thread(), rng(seed) {}
+    };
+
+    vector<worker *> M_workers;
+    scheduler_options M_options;
+
+    // 非工作线程提交的任务，[M_inject_head, M_inject.size()) 为待执行部分
+    std::mutex M_inject_mutex;
+    vector<task *> M_inject;
+    size_type M_inject_head;
+    std::atomic<size_type> M_inject_size;
+
+    std::mutex M_sleep_mutex;
+    std::condition_variable M_wake;
+    std::atomic<size_type> M_sleepers;
+    // 每次唤醒时递增，由 M_sleep_mutex 保护
+    std::uint64_t M_epoch;
+    std::atomic<bool> M_stop;
+
+  public:
+    explicit scheduler(const scheduler_options &options = scheduler_options())
+        : M_workers(), M_options(options), M_inject(), M_inject_head(0),
+          M_inject_size(0), M_sleepers(0), M_epoch(0), M_stop(false) {
+        M_start();
+    }
+
+    /**
+     *  @brief  创建 @a threads 个工作线程，其余参数取默认值
+     *
+     *  threads 为 0 时不创建线程，所有任务由调用 sync、run_chunks 或
+     *  try_run_one 的线程执行。
+     */
+    explicit scheduler(size_type threads)
+        : M_workers(), M_options(), M_inject(), M_inject_head(0),
+          M_inject_size(0), M_sleepers(0), M_epoch(0), M_stop(false) {
+        M_options.threads = threads;
+        M_start();
+    }
+
+    scheduler(const scheduler &) = delete;
+    scheduler &operator=(const scheduler &) = delete;
+
+    /**
+     *  @brief  执行完已提交的任务后结束所有工作线程
+     */
+    ~scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(M_sleep_mutex);
+            M_stop.store(true, std::memory_order_seq_cst);
+            ++M_epoch;
+        }
+        M_wake.notify_all();
+        for (worker *w : M_workers) {
+            w->thread.join();
+        }
+        while (try_run_one()) {
+        }
+        easystl::allocator<worker> alloc;
+        for (worker *w : M_workers) {
+            easystl::destroy(w);
+            alloc.deallocate(w, 1);
+        }
+    }
+
+    /**
+     *  @brief  进程内共享的调度器，使用默认参数
+     */
+    static scheduler &instance() {
+        static scheduler s;
+        return s;
+    }
+
+    static size_type default_size() noexcept {
+        return scheduler_options::default_threads();
+    }
+
+    // 工作线程数
+    size_type size() const noexcept { return M_workers.size(); }
+
+    /**
+     *  @brief  提交一个任务，不等待其完成
+     *
+     *  在工作线程中调用时放入该线程自己的队列，否则放入注入队列。任务抛出
+     *  的异常会调用 std::terminate，需要得到异常时使用 task_group。
+     */
+    template <class Fn> void submit(Fn &&fn) {
+        M_push(S_make_task(easystl::forward<Fn>(fn)));
+    }
+
+    /**
+     *  @brief  在调用线程中取出并执行一个任务
+     *  @return  是否执行了任务
+     */
+    bool try_run_one() {
+        task *t = nullptr;
+        const size_type self = M_current_worker();
+        if (!M_find(self, t)) {
+            return false;
+        }
+        t->invoke(t);
+        return true;
+    }
+
+    /**
+     *  @brief  以编号 0 到 count - 1 调用 fn，返回时所有调用均已完成
+     *  @param  count  任务个数
+     *  @param  fn  可以在多个线程中同时调用的函数对象，参数为任务编号
+     *
+     *  至多使用 min(count - 1, size()) 个工作线程，其余任务由调用线程执行。
+     *  某次调用抛出异常后不再开始新的任务，等待已开始的任务结束后重新抛出第
+     *  一个异常。
+     */
+    template <class Fn> void run_chunks(size_type count, Fn fn);
+
+  private:
+    friend class task_group;
+
+    template <class Fn> static task *S_make_task(Fn &&fn) {
+        typedef task_impl<typename std::decay<Fn>::type> impl;
+        easystl::allocator<impl> alloc;
+        impl *p = alloc.allocate(1);
+        try {
+            easystl::construct(p, easystl::forward<Fn>(fn));
+        } catch (...) {
+            alloc.deallocate(p, 1);
+            throw;
+        }
+        return p;
+    }
+
+    static scheduler *&S_current() noexcept {
+        static thread_local scheduler *s = nullptr;
+        return s;
+    }
+
+    static size_type &S_current_index() noexcept {
+        static thread_local size_type index = 0;
+        return index;
+    }
+
+    // 当前线程在本调度器中的编号，不是工作线程时为 size()
+    size_type M_current_worker() const noexcept {
+        return S_current() == this ? S_current_index() : size();
+    }
+
+    static void S_pause() noexcept {
+#ifdef EASYSTL_SCHEDULER_SSE2
+        _mm_pause();
+#endif
+    }
+
+    void M_start() {
+        M_workers.reserve(M_options.threads);
+        easystl::allocator<worker> alloc;
+        for (size_type i = 0; i < M_options.threads; ++i) {
+            worker *w = alloc.allocate(1);
+            easystl::construct(w, 0x9e3779b97f4a7c15ull * (i + 1));
+            M_workers.push_back(w);
+        }
+        // 所有队列都创建好之后再启动线程，线程之间可以互相窃取
+        for (size_type i = 0; i < M_workers.size(); ++i) {
+            M_workers[i]->thread = std::thread([this, i] { M_worker_loop(i); });
+            if (M_options.pin_threads) {
+                M_pin(M_workers[i]->thread, i);
+            }
+        }
+    }
+
+    static void M_pin(std::thread &t, size_type index) noexcept {
+#ifdef EASYSTL_SCHEDULER_AFFINITY
+        const unsigned n = std::thread::hardware_concurrency();
+        if (n == 0) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<int>((index + 1) % n), &set);
+        pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+        (void)t;
+        (void)index;
+#endif
+    }
+
+    void M_push(task *t) {
+        const size_type self = M_current_worker();
+        if (self < size()) {
+            M_workers[self]->deque.push(t);
+        } else {
+            std::lock_guard<std::mutex> lock(M_inject_mutex);
+            M_inject.push_back(t);
+            M_inject_size.fetch_add(1, std::memory_order_seq_cst);
+        }
+        // 与 M_sleep 中先登记再检查队列的顺序配对，两者至少有一方看到对方
+        if (M_sleepers.load(std::memory_order_seq_cst) != 0) {
+            {
+                std::lock_guard<std::mutex> lock(M_sleep_mutex);
+                ++M_epoch;
+            }
+            M_wake.notify_one();
+        }
+    }
+
+    bool M_take_injected(task *&t) {
+        if (M_inject_size.load(std::memory_order_seq_cst) == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(M_inject_mutex);
+        if (M_inject_head == M_inject.size()) {
+            return false;
+        }
+        t = M_inject[M_inject_head++];
+        if (M_inject_head == M_inject.size()) {
+            M_inject.clear();
+            M_inject_head = 0;
+        }
+        M_inject_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 随机选择起点，依次尝试从每个其他线程的队列窃取
+    bool M_steal(size_type self, task *&t) {
+        const size_type n = size();
+        if (n == 0) {
+            return false;
+        }
+        size_type start = 0;
+        if (self < n) {
+            std::uint64_t &x = M_workers[self]->rng;
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            start = static_cast<size_type>(x % n);
+        }
+        for (size_type k = 0; k < n; ++k) {
+            const size_type victim = (start + k) % n;
+            if (victim != self && M_workers[victim]->deque.steal(t)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool M_find(size_type self, task *&t) {
+        if (self < size() && M_workers[self]->deque.take(t)) {
+            return true;
+        }
+        return M_take_injected(t) || M_steal(self, t);
+    }
+
+    void M_worker_loop(size_type index) {
+        S_current() = this;
+        S_current_index() = index;
+        unsigned idle = 0;
+        task *t = nullptr;
+        while (true) {
+            if (M_find(index, t)) {
+                t->invoke(t);
+                idle = 0;
+                continue;
+            }
+            if (M_stop.load(std::memory_order_acquire)) {
+                return;
+            }
+            ++idle;
+            if (idle <= M_options.spin_rounds) {
+                S_pause();
+            } else if (idle <= M_options.spin_rounds + M_options.yield_rounds) {
+                std::this_thread::yield();
+            } else {
+                M_sleep(index);
+                idle = 0;
+            }
+        }
+    }
+
+    void M_sleep(size_type index) {
+        std::unique_lock<std::mutex> lock(M_sleep_mutex);
+        const std::uint64_t epoch = M_epoch;
+        M_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        // 登记之后再检查一次，避免与 M_push 交错时错过任务
+        task *t = nullptr;
+        if (!M_stop.load(std::memory_order_seq_cst) && !M_find(index, t)) {
+            M_wake.wait(lock, [this, epoch] {
+                return M_epoch != epoch ||
+                       M_stop.load(std::memory_order_relaxed);
+            });
+        }
+        M_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        lock.unlock();
+        if (t != nullptr) {
+            t->invoke(t);
+        }
+    }
+};
+
+/**
+ *  @brief  fork-join 的任务组
+ *
+ *  spawn 提交的任务全部完成之前 sync 不会返回；等待期间当前线程执行调度器
+ *  中的任务。析构时同样会等待，但不再抛出任务的异常。
+ */
+class task_group {
+  public:
+    typedef std::size_t size_type;
+
+  private:
+    friend class scheduler;
+
+    scheduler &M_sched;
+    std::atomic<size_type> M_pending;
+    std::mutex M_error_mutex;
+    std::exception_ptr M_error;
+
+  public:
+    explicit task_group(scheduler &s = scheduler::instance())
+        : M_sched(s), M_pending(0) {}
+
+    task_group(const task_group &) = delete;
+    task_group &operator=(const task_group &) = delete;
+
+    ~task_group() { M_wait(); }
+
+    /**
+     *  @brief  提交 @a fn 在调度器中执行
+     */
+    template <class Fn> void spawn(Fn &&fn) {
+        M_pending.fetch_add(1, std::memory_order_relaxed);
+        try {
+            M_sched.submit(spawned<typename std::decay<Fn>::type>(
+                this, easystl::forward<Fn>(fn)));
+        } catch (...) {
+            M_pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    /**
+     *  @brief  等待所有 spawn 的任务完成
+     *  @throw  第一个抛出异常的任务的异常
+     */
+    void sync() {
+        M_wait();
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(M_error_mutex);
+            e = M_error;
+            M_error = nullptr;
+        }
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+
+  private:
+    template <class Fn> struct spawned {
+        task_group *group;
+        Fn fn;
+
+        template <class F>
+        spawned(task_group *g, F &&f) : group(g), fn(easystl::forward<F>(f)) {}
+
+        void operator()() {
+            try {
+                fn();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(group->M_error_mutex);
+                if (!group->M_error) {
+                    group->M_error = std::current_exception();
+                }
+            }
+            group->M_pending.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    void M_wait() {
+        unsigned idle = 0;
+        while (M_pending.load(std::memory_order_acquire) != 0) {
+            if (M_sched.try_run_one()) {
+                idle = 0;
+            } else if (++idle < 64) {
+                scheduler::S_pause();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+template <class Fn> void scheduler::run_chunks(size_type count, Fn fn) {
+    if (count == 0) {
+        return;
+    }
+    const size_type helpers = count - 1 < size() ? count - 1 : size();
+    if (helpers == 0) {
+        for (size_type i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<size_type> next(0);
+    auto claim = [&next, &fn, count] {
+        size_type i;
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < count) {
+            try {
+                fn(i);
+            } catch (...) {
+                next.store(count, std::memory_order_relaxed);
+                throw;
+            }
+        }
+    };
+    task_group group(*this);
+    for (size_type h = 0; h < helpers; ++h) {
+        group.spawn(claim);
+    }
+    try {
+        claim();
+    } catch (...) {
+        group.M_wait();
+        throw;
+    }
+    group.sync();
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_SCHEDULER_H
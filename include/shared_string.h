@@ -0,0 +1,364 @@
+#ifndef EASYSTL_SHARED_STRING_H
+#define EASYSTL_SHARED_STRING_H
+
+// 共享缓冲区的不可变字符串
+//
+// basic_shared_string 的字符保存在一块带原子引用计数的堆内存中，内容创建后不
+// 再修改。复制只是增加引用计数，substr 返回共享同一块内存的切片，都不分配内存
+// 也不复制字符，适合在线程之间大量传递的配置值、标记等字符串。
+//
+// 与 std::shared_ptr 相同，不同对象之间的引用计数操作是线程安全的，同一个对
+// 象的并发读写则需要外部同步。
+
+#include "alloc_traits.h"
+#include "basic_string.h"
+#include "char_traits.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "utility.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace easystl {
+
+template <class CharType, class CharTraits = easystl::char_traits<CharType>,
+          class Allocator = easystl::allocator<CharType>>
+class basic_shared_string {
+  public:
+    typedef CharTraits traits_type;
+    typedef CharType value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const CharType &const_reference;
+    typedef const CharType *const_pointer;
+    typedef const CharType *const_iterator;
+    typedef basic_string<CharType, CharTraits, Allocator> string_type;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+  private:
+    // 缓冲区头部，字符紧跟在头部之后，以头部的大小为单位分配
+    struct rep {
+        std::atomic<std::size_t> refs;
+        size_type units;
+    };
+
+    typedef easystl_cxx::alloc_traits<Allocator> char_alloc_traits;
+    typedef typename char_alloc_traits::template rebind<rep>::other
+        rep_alloc_type;
+    typedef easystl_cxx::alloc_traits<rep_alloc_type> rep_alloc_traits;
+
+    Allocator M_alloc;
+    rep *M_rep;
+    const CharType *M_data;
+    size_type M_size;
+
+  public:
+    /**
+     *  @brief  构造空字符串，不分配内存
+     */
+    basic_shared_string() noexcept
+        : M_alloc(), M_rep(nullptr), M_data(S_empty()), M_size(0) {}
+
+    explicit basic_shared_string(const Allocator &a) noexcept
+        : M_alloc(a), M_rep(nullptr), M_data(S_empty()), M_size(0) {}
+
+    /**
+     *  @brief  复制 @a s 的前 @a n 个字符，分配一次内存
+     */
+    basic_shared_string(const CharType *s, size_type n,
+                        const Allocator &a = Allocator())
+        : M_alloc(a), M_rep(nullptr), M_data(S_empty()), M_size(0) {
+        easystl_require_string_len(s, n);
+        M_assign_new(s, n);
+    }
+
+    basic_shared_string(const CharType *s, const Allocator &a = Allocator())
+        : M_alloc(a), M_rep(nullptr), M_data(S_empty()), M_size(0) {
+        easystl_require_string(s);
+        M_assign_new(s, traits_type::length(s));
+    }
+
+    /**
+     *  @brief  从 basic_string 构造，分配一次内存
+     */
+    explicit basic_shared_string(const string_type &str)
+        : M_alloc(str.get_allocator()), M_rep(nullptr), M_data(S_empty()),
+          M_size(0) {
+        M_assign_new(str.data(), str.size());
+    }
+
+    /**
+     *  @brief  复制只增加引用计数
+     */
+    basic_shared_string(const basic_shared_string &rhs) noexcept
+        : M_alloc(rhs.M_alloc), M_rep(rhs.M_rep), M_data(rhs.M_data),
+          M_size(rhs.M_size) {
+        M_acquire(M_rep);
+    }
+
+    basic_shared_string(basic_shared_string &&rhs) noexcept
+        : M_alloc(easystl::move(rhs.M_alloc)), M_rep(rhs.M_rep),
+          M_data(rhs.M_data), M_size(rhs.M_size) {
+        rhs.M_rep = nullptr;
+        rhs.M_data = S_empty();
+        rhs.M_size = 0;
+    }
+
+    basic_shared_string &operator=(const basic_shared_string &rhs) noexcept {
+        basic_shared_string tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    basic_shared_string &operator=(basic_shared_string &&rhs) noexcept {
+        basic_shared_string tmp(easystl::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~basic_shared_string() { M_release(); }
+
+  public:
+    size_type size() const noexcept { return M_size; }
+    size_type length() const noexcept { return M_size; }
+    bool empty() const noexcept { return M_size == 0; }
+    const CharType *data() const noexcept { return M_data; }
+    allocator_type get_allocator() const noexcept { return M_alloc; }
+
+    const_iterator begin() const noexcept { return M_data; }
+    const_iterator end() const noexcept { return M_data + M_size; }
+    const_iterator cbegin() const noexcept { return M_data; }
+    const_iterator cend() const noexcept { return M_data + M_size; }
+
+    const_reference operator[](size_type n) const noexcept {
+        EASYSTL_DEBUG(n < M_size);
+        return M_data[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(n >= M_size, "basic_shared_string::at");
+        return M_data[n];
+    }
+
+    const_reference front() const noexcept { return M_data[0]; }
+    const_reference back() const noexcept { return M_data[M_size - 1]; }
+
+    /**
+     *  @brief  共享此缓冲区的对象数量，空字符串为 0
+     */
+    size_type use_count() const noexcept {
+        return M_rep ? M_rep->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     *  @brief  返回 [pos, pos + n) 的切片，与此对象共享缓冲区
+     *  @throw  std::out_of_range  pos > size()
+     */
+    basic_shared_string substr(size_type pos = 0, size_type n = npos) const {
+        THROW_OUT_OF_RANGE_IF(pos > M_size, "basic_shared_string::substr");
+        if (n > M_size - pos) {
+            n = M_size - pos;
+        }
+        basic_shared_string result(*this);
+        result.M_data += pos;
+        result.M_size = n;
+        return result;
+    }
+
+    /**
+     *  @brief  复制为 basic_string，分配一次内存
+     */
+    string_type str() const { return string_type(M_data, M_size, M_alloc); }
+
+    /**
+     *  @brief  追加到 @a str 的末尾
+     */
+    template <class Alloc>
+    void append_to(basic_string<CharType, CharTraits, Alloc> &str) const {
+        str.append(M_data, M_size);
+    }
+
+    int compare(const basic_shared_string &rhs) const noexcept {
+        return S_compare(M_data, M_size, rhs.M_data, rhs.M_size);
+    }
+
+    int compare(const CharType *s) const noexcept {
+        return S_compare(M_data, M_size, s, traits_type::length(s));
+    }
+
+    size_type find(CharType c, size_type pos = 0) const noexcept {
+        if (pos >= M_size) {
+            return npos;
+        }
+        const CharType *p = traits_type::find(M_data + pos, M_size - pos, c);
+        return p ? static_cast<size_type>(p - M_data) : npos;
+    }
+
+    size_type find(const CharType *s, size_type pos, size_type n) const
+        noexcept {
+        if (pos > M_size || n > M_size - pos) {
+            return npos;
+        }
+        if (n == 0) {
+            return pos;
+        }
+        for (; pos <= M_size - n; ++pos) {
+            const CharType *p =
+                traits_type::find(M_data + pos, M_size - pos - n + 1, s[0]);
+            if (!p) {
+                return npos;
+            }
+            pos = static_cast<size_type>(p - M_data);
+            if (traits_type::compare(p, s, n) == 0) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    size_type find(const CharType *s, size_type pos = 0) const noexcept {
+        return find(s, pos, traits_type::length(s));
+    }
+
+    void swap(basic_shared_string &rhs) noexcept {
+        easystl::swap(M_alloc, rhs.M_alloc);
+        easystl::swap(M_rep, rhs.M_rep);
+        easystl::swap(M_data, rhs.M_data);
+        easystl::swap(M_size, rhs.M_size);
+    }
+
+  private:
+    static const CharType *S_empty() noexcept {
+        static const CharType empty = CharType();
+        return &empty;
+    }
+
+    static int S_compare(const CharType *s1, size_type n1, const CharType *s2,
+                         size_type n2) noexcept {
+        const int r = traits_type::compare(s1, s2, n1 < n2 ? n1 : n2);
+        if (r != 0) {
+            return r;
+        }
+        return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+    }
+
+    static CharType *S_chars(rep *r) noexcept {
+        return reinterpret_cast<CharType *>(r + 1);
+    }
+
+    /**
+     *  @brief  分配新的缓冲区并复制字符，末尾添加空字符
+     */
+    void M_assign_new(const CharType *s, size_type n) {
+        if (n == 0) {
+            return;
+        }
+        const size_type units =
+            1 + ((n + 1) * sizeof(CharType) + sizeof(rep) - 1) / sizeof(rep);
+        rep_alloc_type ralloc(M_alloc);
+        rep *r = rep_alloc_traits::allocate(ralloc, units);
+        ::new (static_cast<void *>(r)) rep();
+        r->refs.store(1, std::memory_order_relaxed);
+        r->units = units;
+        CharType *chars = S_chars(r);
+        traits_type::copy(chars, s, n);
+        traits_type::assign(chars[n], CharType());
+        M_rep = r;
+        M_data = chars;
+        M_size = n;
+    }
+
+    static void M_acquire(rep *r) noexcept {
+        if (r) {
+            r->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void M_release() noexcept {
+        if (M_rep &&
+            M_rep->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            const size_type units = M_rep->units;
+            M_rep->~rep();
+            rep_alloc_type ralloc(M_alloc);
+            rep_alloc_traits::deallocate(ralloc, M_rep, units);
+        }
+        M_rep = nullptr;
+    }
+};
+
+template <class CharType, class CharTraits, class Allocator>
+constexpr typename basic_shared_string<CharType, CharTraits,
+                                       Allocator>::size_type
+    basic_shared_string<CharType, CharTraits, Allocator>::npos;
+
+template <class CharType, class CharTraits, class Allocator>
+inline bool
+operator==(const basic_shared_string<CharType, CharTraits, Allocator> &lhs,
+           const basic_shared_string<CharType, CharTraits, Allocator> &rhs) {
+    return lhs.size() == rhs.size() &&
+           (lhs.data() == rhs.data() ||
+            CharTraits::compare(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline bool
+operator==(const basic_shared_string<CharType, CharTraits, Allocator> &lhs,
+           const CharType *rhs) {
+    return lhs.compare(rhs) == 0;
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline bool
+operator!=(const basic_shared_string<CharType, CharTraits, Allocator> &lhs,
+           const basic_shared_string<CharType, CharTraits, Allocator> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline bool
+operator!=(const basic_shared_string<CharType, CharTraits, Allocator> &lhs,
+           const CharType *rhs) {
+    return !(lhs == rhs);
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline bool
+operator<(const basic_shared_string<CharType, CharTraits, Allocator> &lhs,
+          const basic_shared_string<CharType, CharTraits, Allocator> &rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline void
+swap(basic_shared_string<CharType, CharTraits, Allocator> &lhs,
+     basic_shared_string<CharType, CharTraits, Allocator> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline std::basic_ostream<CharType> &
+operator<<(std::basic_ostream<CharType> &os,
+           const basic_shared_string<CharType, CharTraits, Allocator> &str) {
+    return std::__ostream_insert(os, str.data(), str.size());
+}
+
+// 与内容相同的 basic_string 得到相同的哈希值
+template <class CharType, class CharTraits, class Allocator>
+struct hash<basic_shared_string<CharType, CharTraits, Allocator>> {
+    std::size_t operator()(
+        const basic_shared_string<CharType, CharTraits, Allocator> &str) const
+        noexcept {
+        return static_cast<std::size_t>(
+            easystl::traits_hash_bytes<CharTraits>(str.data(), str.size()));
+    }
+};
+
+using shared_string = basic_shared_string<char>;
+using shared_wstring = basic_shared_string<wchar_t>;
+
+} // namespace easystl
+
+#endif // !EASYSTL_SHARED_STRING_H
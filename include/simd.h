@@ -0,0 +1,1352 @@
+#ifndef EASYSTL_SIMD_H
+#define EASYSTL_SIMD_H
+
+// 连续存储的算术类型上的向量化内核
+//
+// find、find_last、count、sum、min_max、scan 以及 remove、unique 等流压缩
+// 供 algo.h 与 numeric.h 中的算法在指针区间上调用。x86 上以 SSE2 为基线；
+// 编译器支持 target 属性时另外编译一份 AVX2 版本，运行时检测 CPU 后选择，
+// 编译时已经打开 -mavx2 则直接使用 AVX2。
+//
+// 元素按照大小与符号映射到 int8_t、uint8_t、……、float、double 之一，
+// 不支持的类型（bool、long double 等）没有对应的内核。
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define EASYSTL_SIMD_SSE2 1
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define EASYSTL_SIMD_AVX2 1
+#define EASYSTL_SIMD_AVX2_TARGET
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EASYSTL_SIMD_AVX2 1
+#define EASYSTL_SIMD_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace easystl {
+namespace simd {
+
+/*
+ * 元素类型到内核使用的标量类型的映射，没有对应类型时为 void
+ * */
+template <class T, bool = std::is_floating_point<T>::value,
+          std::size_t = sizeof(T), bool = std::is_signed<T>::value>
+struct scalar_of {
+    typedef void type;
+};
+template <class T> struct scalar_of<T, false, 1, true> {
+    typedef std::int8_t type;
+};
+template <class T> struct scalar_of<T, false, 1, false> {
+    typedef std::uint8_t type;
+};
+template <class T> struct scalar_of<T, false, 2, true> {
+    typedef std::int16_t type;
+};
+template <class T> struct scalar_of<T, false, 2, false> {
+    typedef std::uint16_t type;
+};
+template <class T> struct scalar_of<T, false, 4, true> {
+    typedef std::int32_t type;
+};
+template <class T> struct scalar_of<T, false, 4, false> {
+    typedef std::uint32_t type;
+};
+template <class T> struct scalar_of<T, false, 8, true> {
+    typedef std::int64_t type;
+};
+template <class T> struct scalar_of<T, false, 8, false> {
+    typedef std::uint64_t type;
+};
+template <class T> struct scalar_of<T, true, 4, true> {
+    typedef float type;
+};
+template <class T> struct scalar_of<T, true, 8, true> {
+    typedef double type;
+};
+
+/*
+ * wrapping_add
+ * 内核的标量部分使用的加法。整数按 T 的位宽回绕，与向量加法的结果一致，
+ * 有符号数直接相加溢出是未定义行为；浮点数直接相加
+ * */
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, T>::type
+wrapping_add(T a, T b) noexcept {
+    typedef typename std::make_unsigned<T>::type U;
+    return static_cast<T>(static_cast<U>(static_cast<U>(a) + U(b)));
+}
+
+template <class T>
+typename std::enable_if<!std::is_integral<T>::value, T>::type
+wrapping_add(T a, T b) noexcept {
+    return a + b;
+}
+
+/*
+ * is_vectorizable
+ * 可以交给本文件中内核处理的元素类型
+ * */
+template <class T>
+struct is_vectorizable
+    : std::integral_constant<
+          bool,
+#ifdef EASYSTL_SIMD_SSE2
+          std::is_arithmetic<T>::value &&
+              !std::is_same<typename std::remove_cv<T>::type, bool>::value &&
+              !std::is_void<typename scalar_of<
+                  typename std::remove_cv<T>::type>::type>::value
+#else
+          false
+#endif
+          > {
+};
+
+/*
+ * is_scannable
+ * 可以交给 scan 的元素类型：4 字节的整数、float 与 double。8 字节的整数每个
+ * 向量只有 2 或 4 个通道，通道间移动的开销超过逐个累加的一次加法，不使用向量
+ * */
+template <class T>
+struct is_scannable
+    : std::integral_constant<bool,
+                             is_vectorizable<T>::value &&
+                                 (sizeof(T) == 4 ||
+                                  std::is_floating_point<T>::value)> {};
+
+/*
+ * is_compactable
+ * 可以交给 remove、remove_if、unique 与 partition 的元素类型：4 与 8 字节的
+ * 整数、float 与 double。其余类型调用这几个函数时不做任何处理
+ * */
+template <class T>
+struct is_compactable
+    : std::integral_constant<bool, is_vectorizable<T>::value &&
+                                       (sizeof(T) == 4 || sizeof(T) == 8)> {
+};
+
+template <class T>
+typename std::enable_if<!is_compactable<T>::value>::type remove(T *&, T *,
+                                                                T *&, T) {}
+
+template <class T, class Predicate>
+typename std::enable_if<!is_compactable<T>::value>::type
+remove_if(T *&, T *, T *&, Predicate &) {}
+
+template <class T>
+typename std::enable_if<!is_compactable<T>::value>::type unique(T *&, T *,
+                                                                T *&) {}
+
+template <class T, class Predicate>
+typename std::enable_if<!is_compactable<T>::value>::type
+partition(T *&, T *, T *&, T *&, Predicate &) {}
+
+#ifdef EASYSTL_SIMD_SSE2
+
+/*
+ * SSE2 的向量操作
+ * eq_mask 返回逐字节的比较掩码（_mm_movemask_epi8），unordered 对浮点数返回
+ * NaN 所在的通道，对整数返回全零。没有 SSE2 指令的最小、最大值用比较与
+ * 位运算组合，64 位整数不提供（has_minmax 为 false）
+ * */
+struct sse2_int_base {
+    typedef __m128i vec;
+    static vec load(const void *p) {
+        return _mm_loadu_si128(static_cast<const __m128i *>(p));
+    }
+    static void store(void *p, vec v) {
+        _mm_storeu_si128(static_cast<__m128i *>(p), v);
+    }
+    static vec zero() { return _mm_setzero_si128(); }
+    static vec unordered(vec) { return _mm_setzero_si128(); }
+    static vec bit_or(vec a, vec b) { return _mm_or_si128(a, b); }
+    static bool any(vec v) { return _mm_movemask_epi8(v) != 0; }
+    // mask 为真的通道取 a，否则取 b
+    static vec select(vec mask, vec a, vec b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+};
+
+template <class C> struct sse2_ops;
+
+template <> struct sse2_ops<std::uint8_t> : sse2_int_base {
+    typedef std::uint8_t scalar;
+    static const bool has_minmax = true;
+    static vec set1(scalar x) { return _mm_set1_epi8(static_cast<char>(x)); }
+    static unsigned eq_mask(vec a, vec b) {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    }
+    static vec add(vec a, vec b) { return _mm_add_epi8(a, b); }
+    static vec min(vec a, vec b) { return _mm_min_epu8(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_epu8(a, b); }
+};
+
+template <> struct sse2_ops<std::int8_t> : sse2_int_base {
+    typedef std::int8_t scalar;
+    static const bool has_minmax = true;
+    static vec set1(scalar x) { return _mm_set1_epi8(static_cast<char>(x)); }
+    static unsigned eq_mask(vec a, vec b) {
+        return sse2_ops<std::uint8_t>::eq_mask(a, b);
+    }
+    static vec add(vec a, vec b) { return _mm_add_epi8(a, b); }
+    static vec min(vec a, vec b) { return select(_mm_cmplt_epi8(a, b), a, b); }
+    static vec max(vec a, vec b) { return select(_mm_cmpgt_epi8(a, b), a, b); }
+};
+
+template <> struct sse2_ops<std::int16_t> : sse2_int_base {
+    typedef std::int16_t scalar;
+    static const bool has_minmax = true;
+    static vec set1(scalar x) { return _mm_set1_epi16(x); }
+    static unsigned eq_mask(vec a, vec b) {
+        return static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi16(a, b)));
+    }
+    static vec add(vec a, vec b) { return _mm_add_epi16(a, b); }
+    static vec min(vec a, vec b) { return _mm_min_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_epi16(a, b); }
+};
+
+template <> struct sse2_ops<std::uint16_t> : sse2_int_base {
+    typedef std::uint16_t scalar;
+    static const bool has_minmax = true;
+    static vec set1(scalar x) {
+        return _mm_set1_epi16(static_cast<short>(x));
+    }
+    static unsigned eq_mask(vec a, vec b) {
+        return sse2_ops<std::int16_t>::eq_mask(a, b);
+    }
+    static vec add(vec a, vec b) { return _mm_add_epi16(a, b); }
+    // 翻转符号位后按有符号数比较
+    static vec flip(vec a) {
+        return _mm_xor_si128(a, _mm_set1_epi16(static_cast<short>(0x8000)));
+    }
+    static vec min(vec a, vec b) {
+        return flip(_mm_min_epi16(flip(a), flip(b)));
+    }
+    static vec max(vec a, vec b) {
+        return flip(_mm_max_epi16(flip(a), flip(b)));
+    }
+};
+
+template <> struct sse2_ops<std::int32_t> : sse2_int_base {
+    typedef std::int32_t scalar;
+    static const bool has_minmax = true;
+    static vec set1(scalar x) { return _mm_set1_epi32(x); }
+    static unsigned eq_mask(vec a, vec b) {
+        return static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi32(a, b)));
+    }
+    static vec add(vec a, vec b) { return _mm_add_epi32(a, b); }
+    static vec min(vec a, vec b) { return select(_mm_cmplt_epi32(a, b), a, b); }
+    static vec max(vec a, vec b) { return select(_mm_cmpgt_epi32(a, b), a, b); }
+};
+
+template <> struct sse2_ops<std::uint32_t> : sse2_int_base {
+    typedef std::uint32_t scalar;
+    static const bool has_minmax = true;
+    static vec set1(scalar x) { return _mm_set1_epi32(static_cast<int>(x)); }
+    static unsigned eq_mask(vec a, vec b) {
+        return sse2_ops<std::int32_t>::eq_mask(a, b);
+    }
+    static vec add(vec a, vec b) { return _mm_add_epi32(a, b); }
+    static vec flip(vec a) {
+        return _mm_xor_si128(a, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    }
+    static vec min(vec a, vec b) {
+        return select(_mm_cmplt_epi32(flip(a), flip(b)), a, b);
+    }
+    static vec max(vec a, vec b) {
+        return select(_mm_cmpgt_epi32(flip(a), flip(b)), a, b);
+    }
+};
+
+template <> struct sse2_ops<std::int64_t> : sse2_int_base {
+    typedef std::int64_t scalar;
+    static const bool has_minmax = false;
+    static vec set1(scalar x) { return _mm_set1_epi64x(x); }
+    // 两个 32 位的半部分都相等
+    static unsigned eq_mask(vec a, vec b) {
+        const __m128i eq = _mm_cmpeq_epi32(a, b);
+        return static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)))));
+    }
+    static vec add(vec a, vec b) { return _mm_add_epi64(a, b); }
+    static vec min(vec a, vec) { return a; }
+    static vec max(vec a, vec) { return a; }
+};
+
+template <> struct sse2_ops<std::uint64_t> : sse2_ops<std::int64_t> {
+    typedef std::uint64_t scalar;
+    static vec set1(scalar x) {
+        return _mm_set1_epi64x(static_cast<long long>(x));
+    }
+};
+
+template <> struct sse2_ops<float> {
+    typedef float scalar;
+    typedef __m128 vec;
+    static const bool has_minmax = true;
+    static vec load(const void *p) {
+        return _mm_loadu_ps(static_cast<const float *>(p));
+    }
+    static void store(void *p, vec v) {
+        _mm_storeu_ps(static_cast<float *>(p), v);
+    }
+    static vec zero() { return _mm_setzero_ps(); }
+    static vec set1(scalar x) { return _mm_set1_ps(x); }
+    static unsigned eq_mask(vec a, vec b) {
+        return static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a, b))));
+    }
+    static vec add(vec a, vec b) { return _mm_add_ps(a, b); }
+    static vec min(vec a, vec b) { return _mm_min_ps(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_ps(a, b); }
+    static vec unordered(vec a) { return _mm_cmpunord_ps(a, a); }
+    static vec bit_or(vec a, vec b) { return _mm_or_ps(a, b); }
+    static bool any(vec v) { return _mm_movemask_ps(v) != 0; }
+};
+
+template <> struct sse2_ops<double> {
+    typedef double scalar;
+    typedef __m128d vec;
+    static const bool has_minmax = true;
+    static vec load(const void *p) {
+        return _mm_loadu_pd(static_cast<const double *>(p));
+    }
+    static void store(void *p, vec v) {
+        _mm_storeu_pd(static_cast<double *>(p), v);
+    }
+    static vec zero() { return _mm_setzero_pd(); }
+    static vec set1(scalar x) { return _mm_set1_pd(x); }
+    static unsigned eq_mask(vec a, vec b) {
+        return static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a, b))));
+    }
+    static vec add(vec a, vec b) { return _mm_add_pd(a, b); }
+    static vec min(vec a, vec b) { return _mm_min_pd(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_pd(a, b); }
+    static vec unordered(vec a) { return _mm_cmpunord_pd(a, a); }
+    static vec bit_or(vec a, vec b) { return _mm_or_pd(a, b); }
+    static bool any(vec v) { return _mm_movemask_pd(v) != 0; }
+};
+
+/*
+ * SSE2 内核
+ * T 为元素类型，Ops::scalar 是与 T 大小、表示都相同的标量类型
+ * */
+template <class Ops, class T>
+const T *sse2_find(const T *first, const T *last, T value) {
+    const std::ptrdiff_t lanes = 16 / sizeof(T);
+    const typename Ops::vec needle =
+        Ops::set1(static_cast<typename Ops::scalar>(value));
+    for (; last - first >= lanes; first += lanes) {
+        const unsigned m = Ops::eq_mask(Ops::load(first), needle);
+        if (m != 0) {
+            return first + __builtin_ctz(m) / sizeof(T);
+        }
+    }
+    for (; first != last && !(*first == value); ++first) {
+    }
+    return first;
+}
+
+template <class Ops, class T>
+const T *sse2_find_last(const T *first, const T *last, T value) {
+    const std::ptrdiff_t lanes = 16 / sizeof(T);
+    const typename Ops::vec needle =
+        Ops::set1(static_cast<typename Ops::scalar>(value));
+    const T *p = last;
+    for (; p - first >= lanes; p -= lanes) {
+        const unsigned m = Ops::eq_mask(Ops::load(p - lanes), needle);
+        if (m != 0) {
+            return p - lanes + (31 - __builtin_clz(m)) / sizeof(T);
+        }
+    }
+    while (p != first) {
+        if (*--p == value) {
+            return p;
+        }
+    }
+    return last;
+}
+
+template <class Ops, class T>
+std::size_t sse2_count(const T *first, const T *last, T value) {
+    const std::ptrdiff_t lanes = 16 / sizeof(T);
+    const typename Ops::vec needle =
+        Ops::set1(static_cast<typename Ops::scalar>(value));
+    std::size_t bits = 0;
+    for (; last - first >= lanes; first += lanes) {
+        bits += static_cast<std::size_t>(
+            __builtin_popcount(Ops::eq_mask(Ops::load(first), needle)));
+    }
+    std::size_t n = bits / sizeof(T);
+    for (; first != last; ++first) {
+        n += *first == value;
+    }
+    return n;
+}
+
+// 四个累加器互不依赖，隐藏加法的延迟
+template <class Ops, class T> T sse2_sum(const T *first, const T *last) {
+    typedef typename Ops::vec vec;
+    const std::ptrdiff_t lanes = 16 / sizeof(T);
+    vec acc0 = Ops::zero(), acc1 = Ops::zero();
+    vec acc2 = Ops::zero(), acc3 = Ops::zero();
+    for (; last - first >= 4 * lanes; first += 4 * lanes) {
+        acc0 = Ops::add(acc0, Ops::load(first));
+        acc1 = Ops::add(acc1, Ops::load(first + lanes));
+        acc2 = Ops::add(acc2, Ops::load(first + 2 * lanes));
+        acc3 = Ops::add(acc3, Ops::load(first + 3 * lanes));
+    }
+    for (; last - first >= lanes; first += lanes) {
+        acc0 = Ops::add(acc0, Ops::load(first));
+    }
+    acc0 = Ops::add(Ops::add(acc0, acc1), Ops::add(acc2, acc3));
+    T buf[16 / sizeof(T)];
+    Ops::store(buf, acc0);
+    T s = T();
+    for (std::ptrdiff_t i = 0; i < lanes; ++i) {
+        s = wrapping_add(s, buf[i]);
+    }
+    for (; first != last; ++first) {
+        s = wrapping_add(s, *first);
+    }
+    return s;
+}
+
+// 要求 last - first >= 16 / sizeof(T)；遇到 NaN 时返回 false
+template <class Ops, class T>
+bool sse2_min_max(const T *first, const T *last, T &mn, T &mx) {
+    typedef typename Ops::vec vec;
+    const std::ptrdiff_t lanes = 16 / sizeof(T);
+    vec vmin = Ops::load(first);
+    vec vmax = vmin;
+    vec nan = Ops::unordered(vmin);
+    for (first += lanes; last - first >= lanes; first += lanes) {
+        const vec v = Ops::load(first);
+        vmin = Ops::min(vmin, v);
+        vmax = Ops::max(vmax, v);
+        nan = Ops::bit_or(nan, Ops::unordered(v));
+    }
+    if (first != last) {
+        // 最后不足一个向量的部分与前面重叠读取，不影响最小、最大值
+        const vec v = Ops::load(last - lanes);
+        vmin = Ops::min(vmin, v);
+        vmax = Ops::max(vmax, v);
+        nan = Ops::bit_or(nan, Ops::unordered(v));
+    }
+    if (Ops::any(nan)) {
+        return false;
+    }
+    T lo[16 / sizeof(T)], hi[16 / sizeof(T)];
+    Ops::store(lo, vmin);
+    Ops::store(hi, vmax);
+    mn = lo[0];
+    mx = hi[0];
+    for (std::ptrdiff_t i = 1; i < lanes; ++i) {
+        mn = lo[i] < mn ? lo[i] : mn;
+        mx = mx < hi[i] ? hi[i] : mx;
+    }
+    return true;
+}
+
+/*
+ * 前缀和使用的向量操作，只提供 is_scannable 中的类型
+ * prefix 在寄存器内计算包含前缀和（log2(通道数) 次移位与加法），shift1 把
+ * 各通道向高位移动一个通道、最低通道补零，broadcast_last 把最高通道复制到所有
+ * 通道
+ * */
+template <class C, std::size_t = sizeof(C),
+          bool = std::is_floating_point<C>::value>
+struct sse2_scan_ops {};
+
+template <class C> struct sse2_scan_ops<C, 4, false> : sse2_ops<C> {
+    static __m128i shift1(__m128i x) { return _mm_slli_si128(x, 4); }
+    static __m128i prefix(__m128i x) {
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    }
+    static __m128i broadcast_last(__m128i x) {
+        return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+};
+
+template <> struct sse2_scan_ops<float, 4, true> : sse2_ops<float> {
+    static __m128 shift1(__m128 x) {
+        return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4));
+    }
+    static __m128 prefix(__m128 x) {
+        x = _mm_add_ps(x, shift1(x));
+        return _mm_add_ps(
+            x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+    }
+    static __m128 broadcast_last(__m128 x) {
+        return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+};
+
+template <> struct sse2_scan_ops<double, 8, true> : sse2_ops<double> {
+    static __m128d shift1(__m128d x) {
+        return _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8));
+    }
+    static __m128d prefix(__m128d x) { return _mm_add_pd(x, shift1(x)); }
+    static __m128d broadcast_last(__m128d x) { return _mm_unpackhi_pd(x, x); }
+};
+
+// 逐个处理向量内核剩下的不足一个向量的元素
+template <bool Exclusive, class T>
+T *scan_tail(const T *first, const T *last, T *result, T acc) {
+    for (; first != last; ++first, ++result) {
+        const T v = *first;
+        if (Exclusive) {
+            *result = acc;
+            acc = wrapping_add(acc, v);
+        } else {
+            acc = wrapping_add(acc, v);
+            *result = acc;
+        }
+    }
+    return result;
+}
+
+// 把 init 与 [first, first + i] 的和写入 result[i]（Exclusive 时不含 first[i]），
+// 返回输出的末尾。result 可以等于 first
+template <class Ops, bool Exclusive, class T>
+T *sse2_scan(const T *first, const T *last, T *result, T init) {
+    typedef typename Ops::vec vec;
+    const std::ptrdiff_t lanes = 16 / sizeof(T);
+    vec carry = Ops::set1(static_cast<typename Ops::scalar>(init));
+    for (; last - first >= lanes; first += lanes, result += lanes) {
+        // 进位的依赖链上只有一次加法，块内的前缀和可以提前计算
+        const vec x = Ops::prefix(Ops::load(first));
+        Ops::store(result, Ops::add(Exclusive ? Ops::shift1(x) : x, carry));
+        carry = Ops::add(carry, Ops::broadcast_last(x));
+    }
+    T buf[16 / sizeof(T)];
+    Ops::store(buf, carry);
+    return scan_tail<Exclusive>(first, last, result, buf[0]);
+}
+
+#endif // EASYSTL_SIMD_SSE2
+
+#ifdef EASYSTL_SIMD_AVX2
+
+/*
+ * AVX2 的向量操作，接口与 sse2_ops 相同
+ * */
+struct avx2_int_base {
+    typedef __m256i vec;
+    EASYSTL_SIMD_AVX2_TARGET static vec load(const void *p) {
+        return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static void store(void *p, vec v) {
+        _mm256_storeu_si256(static_cast<__m256i *>(p), v);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec zero() {
+        return _mm256_setzero_si256();
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec unordered(vec) {
+        return _mm256_setzero_si256();
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec bit_or(vec a, vec b) {
+        return _mm256_or_si256(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static bool any(vec v) {
+        return _mm256_movemask_epi8(v) != 0;
+    }
+    EASYSTL_SIMD_AVX2_TARGET static unsigned mask(vec v) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(v));
+    }
+};
+
+template <class C> struct avx2_ops;
+
+#define EASYSTL_SIMD_AVX2_INT_OPS(C, BITS, SET1, SET1_T, MIN, MAX)           \
+    template <> struct avx2_ops<C> : avx2_int_base {                           \
+        typedef C scalar;                                                      \
+        EASYSTL_SIMD_AVX2_TARGET static vec set1(scalar x) {                   \
+            return SET1(static_cast<SET1_T>(x));                               \
+        }                                                                      \
+        EASYSTL_SIMD_AVX2_TARGET static unsigned eq_mask(vec a, vec b) {       \
+            return mask(_mm256_cmpeq_epi##BITS(a, b));                         \
+        }                                                                      \
+        EASYSTL_SIMD_AVX2_TARGET static vec add(vec a, vec b) {                \
+            return _mm256_add_epi##BITS(a, b);                                 \
+        }                                                                      \
+        EASYSTL_SIMD_AVX2_TARGET static vec min(vec a, vec b) {                \
+            return MIN(a, b);                                                  \
+        }                                                                      \
+        EASYSTL_SIMD_AVX2_TARGET static vec max(vec a, vec b) {                \
+            return MAX(a, b);                                                  \
+        }                                                                      \
+    }
+
+EASYSTL_SIMD_AVX2_INT_OPS(std::int8_t, 8, _mm256_set1_epi8, char,
+                          _mm256_min_epi8, _mm256_max_epi8);
+EASYSTL_SIMD_AVX2_INT_OPS(std::uint8_t, 8, _mm256_set1_epi8, char,
+                          _mm256_min_epu8, _mm256_max_epu8);
+EASYSTL_SIMD_AVX2_INT_OPS(std::int16_t, 16, _mm256_set1_epi16, short,
+                          _mm256_min_epi16, _mm256_max_epi16);
+EASYSTL_SIMD_AVX2_INT_OPS(std::uint16_t, 16, _mm256_set1_epi16, short,
+                          _mm256_min_epu16, _mm256_max_epu16);
+EASYSTL_SIMD_AVX2_INT_OPS(std::int32_t, 32, _mm256_set1_epi32, int,
+                          _mm256_min_epi32, _mm256_max_epi32);
+EASYSTL_SIMD_AVX2_INT_OPS(std::uint32_t, 32, _mm256_set1_epi32, int,
+                          _mm256_min_epu32, _mm256_max_epu32);
+
+// 64 位整数没有 min/max 指令，用 cmpgt_epi64 选择；无符号数先翻转符号位
+EASYSTL_SIMD_AVX2_TARGET inline __m256i avx2_min_epi64(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+EASYSTL_SIMD_AVX2_TARGET inline __m256i avx2_max_epi64(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+EASYSTL_SIMD_AVX2_TARGET inline __m256i avx2_min_epu64(__m256i a, __m256i b) {
+    const __m256i s = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    const __m256i gt =
+        _mm256_cmpgt_epi64(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s));
+    return _mm256_blendv_epi8(a, b, gt);
+}
+EASYSTL_SIMD_AVX2_TARGET inline __m256i avx2_max_epu64(__m256i a, __m256i b) {
+    const __m256i s = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    const __m256i gt =
+        _mm256_cmpgt_epi64(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s));
+    return _mm256_blendv_epi8(b, a, gt);
+}
+
+EASYSTL_SIMD_AVX2_INT_OPS(std::int64_t, 64, _mm256_set1_epi64x, long long,
+                          avx2_min_epi64, avx2_max_epi64);
+EASYSTL_SIMD_AVX2_INT_OPS(std::uint64_t, 64, _mm256_set1_epi64x, long long,
+                          avx2_min_epu64, avx2_max_epu64);
+
+#undef EASYSTL_SIMD_AVX2_INT_OPS
+
+template <> struct avx2_ops<float> {
+    typedef float scalar;
+    typedef __m256 vec;
+    EASYSTL_SIMD_AVX2_TARGET static vec load(const void *p) {
+        return _mm256_loadu_ps(static_cast<const float *>(p));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static void store(void *p, vec v) {
+        _mm256_storeu_ps(static_cast<float *>(p), v);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec zero() { return _mm256_setzero_ps(); }
+    EASYSTL_SIMD_AVX2_TARGET static vec set1(scalar x) {
+        return _mm256_set1_ps(x);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static unsigned eq_mask(vec a, vec b) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec add(vec a, vec b) {
+        return _mm256_add_ps(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec min(vec a, vec b) {
+        return _mm256_min_ps(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec max(vec a, vec b) {
+        return _mm256_max_ps(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec unordered(vec a) {
+        return _mm256_cmp_ps(a, a, _CMP_UNORD_Q);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec bit_or(vec a, vec b) {
+        return _mm256_or_ps(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static bool any(vec v) {
+        return _mm256_movemask_ps(v) != 0;
+    }
+};
+
+template <> struct avx2_ops<double> {
+    typedef double scalar;
+    typedef __m256d vec;
+    EASYSTL_SIMD_AVX2_TARGET static vec load(const void *p) {
+        return _mm256_loadu_pd(static_cast<const double *>(p));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static void store(void *p, vec v) {
+        _mm256_storeu_pd(static_cast<double *>(p), v);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec zero() { return _mm256_setzero_pd(); }
+    EASYSTL_SIMD_AVX2_TARGET static vec set1(scalar x) {
+        return _mm256_set1_pd(x);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static unsigned eq_mask(vec a, vec b) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec add(vec a, vec b) {
+        return _mm256_add_pd(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec min(vec a, vec b) {
+        return _mm256_min_pd(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec max(vec a, vec b) {
+        return _mm256_max_pd(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec unordered(vec a) {
+        return _mm256_cmp_pd(a, a, _CMP_UNORD_Q);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static vec bit_or(vec a, vec b) {
+        return _mm256_or_pd(a, b);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static bool any(vec v) {
+        return _mm256_movemask_pd(v) != 0;
+    }
+};
+
+/*
+ * AVX2 内核，与对应的 SSE2 内核相同，每次处理 32 个字节
+ * */
+template <class Ops, class T>
+EASYSTL_SIMD_AVX2_TARGET const T *avx2_find(const T *first, const T *last,
+                                            T value) {
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    const typename Ops::vec needle =
+        Ops::set1(static_cast<typename Ops::scalar>(value));
+    for (; last - first >= 2 * lanes; first += 2 * lanes) {
+        const unsigned m0 = Ops::eq_mask(Ops::load(first), needle);
+        const unsigned m1 = Ops::eq_mask(Ops::load(first + lanes), needle);
+        if ((m0 | m1) != 0) {
+            return m0 != 0 ? first + __builtin_ctz(m0) / sizeof(T)
+                           : first + lanes + __builtin_ctz(m1) / sizeof(T);
+        }
+    }
+    for (; last - first >= lanes; first += lanes) {
+        const unsigned m = Ops::eq_mask(Ops::load(first), needle);
+        if (m != 0) {
+            return first + __builtin_ctz(m) / sizeof(T);
+        }
+    }
+    for (; first != last && !(*first == value); ++first) {
+    }
+    return first;
+}
+
+template <class Ops, class T>
+EASYSTL_SIMD_AVX2_TARGET const T *avx2_find_last(const T *first,
+                                                 const T *last, T value) {
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    const typename Ops::vec needle =
+        Ops::set1(static_cast<typename Ops::scalar>(value));
+    const T *p = last;
+    for (; p - first >= lanes; p -= lanes) {
+        const unsigned m = Ops::eq_mask(Ops::load(p - lanes), needle);
+        if (m != 0) {
+            return p - lanes + (31 - __builtin_clz(m)) / sizeof(T);
+        }
+    }
+    while (p != first) {
+        if (*--p == value) {
+            return p;
+        }
+    }
+    return last;
+}
+
+template <class Ops, class T>
+EASYSTL_SIMD_AVX2_TARGET std::size_t avx2_count(const T *first, const T *last,
+                                                T value) {
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    const typename Ops::vec needle =
+        Ops::set1(static_cast<typename Ops::scalar>(value));
+    std::size_t bits = 0;
+    for (; last - first >= lanes; first += lanes) {
+        bits += static_cast<std::size_t>(
+            __builtin_popcount(Ops::eq_mask(Ops::load(first), needle)));
+    }
+    std::size_t n = bits / sizeof(T);
+    for (; first != last; ++first) {
+        n += *first == value;
+    }
+    return n;
+}
+
+template <class Ops, class T>
+EASYSTL_SIMD_AVX2_TARGET T avx2_sum(const T *first, const T *last) {
+    typedef typename Ops::vec vec;
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    vec acc0 = Ops::zero(), acc1 = Ops::zero();
+    vec acc2 = Ops::zero(), acc3 = Ops::zero();
+    for (; last - first >= 4 * lanes; first += 4 * lanes) {
+        acc0 = Ops::add(acc0, Ops::load(first));
+        acc1 = Ops::add(acc1, Ops::load(first + lanes));
+        acc2 = Ops::add(acc2, Ops::load(first + 2 * lanes));
+        acc3 = Ops::add(acc3, Ops::load(first + 3 * lanes));
+    }
+    for (; last - first >= lanes; first += lanes) {
+        acc0 = Ops::add(acc0, Ops::load(first));
+    }
+    acc0 = Ops::add(Ops::add(acc0, acc1), Ops::add(acc2, acc3));
+    T buf[32 / sizeof(T)];
+    Ops::store(buf, acc0);
+    T s = T();
+    for (std::ptrdiff_t i = 0; i < lanes; ++i) {
+        s = wrapping_add(s, buf[i]);
+    }
+    for (; first != last; ++first) {
+        s = wrapping_add(s, *first);
+    }
+    return s;
+}
+
+template <class Ops, class T>
+EASYSTL_SIMD_AVX2_TARGET bool avx2_min_max(const T *first, const T *last,
+                                           T &mn, T &mx) {
+    typedef typename Ops::vec vec;
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    vec vmin = Ops::load(first);
+    vec vmax = vmin;
+    vec nan = Ops::unordered(vmin);
+    for (first += lanes; last - first >= lanes; first += lanes) {
+        const vec v = Ops::load(first);
+        vmin = Ops::min(vmin, v);
+        vmax = Ops::max(vmax, v);
+        nan = Ops::bit_or(nan, Ops::unordered(v));
+    }
+    if (first != last) {
+        const vec v = Ops::load(last - lanes);
+        vmin = Ops::min(vmin, v);
+        vmax = Ops::max(vmax, v);
+        nan = Ops::bit_or(nan, Ops::unordered(v));
+    }
+    if (Ops::any(nan)) {
+        return false;
+    }
+    T lo[32 / sizeof(T)], hi[32 / sizeof(T)];
+    Ops::store(lo, vmin);
+    Ops::store(hi, vmax);
+    mn = lo[0];
+    mx = hi[0];
+    for (std::ptrdiff_t i = 1; i < lanes; ++i) {
+        mn = lo[i] < mn ? lo[i] : mn;
+        mx = mx < hi[i] ? hi[i] : mx;
+    }
+    return true;
+}
+
+/*
+ * AVX2 前缀和使用的向量操作，与 sse2_scan_ops 相同。_mm256_slli_si256 只在
+ * 各自的 128 位通道内移动，跨越通道的部分用 _mm256_permute2x128_si256 把低半
+ * 部分移到高半部分：prefix 先在两个半部分内分别求前缀和，再把低半部分的最后
+ * 一个通道加到高半部分
+ * */
+template <std::size_t Size> struct avx2_scan_shuffle;
+
+template <> struct avx2_scan_shuffle<4> {
+    // 低半部分移到高半部分，低半部分补零
+    EASYSTL_SIMD_AVX2_TARGET static __m256i low_to_high(__m256i x) {
+        return _mm256_permute2x128_si256(x, x, 0x08);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256i shift1(__m256i x) {
+        return _mm256_alignr_epi8(x, low_to_high(x), 12);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256i prefix_add(__m256i x) {
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        return _mm256_add_epi32(
+            x, low_to_high(_mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3))));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256i broadcast_last(__m256i x) {
+        return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+    }
+};
+
+template <> struct avx2_scan_shuffle<8> {
+    EASYSTL_SIMD_AVX2_TARGET static __m256i low_to_high(__m256i x) {
+        return _mm256_permute2x128_si256(x, x, 0x08);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256i shift1(__m256i x) {
+        return _mm256_alignr_epi8(x, low_to_high(x), 8);
+    }
+};
+
+template <class C, std::size_t = sizeof(C),
+          bool = std::is_floating_point<C>::value>
+struct avx2_scan_ops {};
+
+template <class C> struct avx2_scan_ops<C, 4, false> : avx2_ops<C> {
+    typedef avx2_scan_shuffle<4> shuffle;
+    EASYSTL_SIMD_AVX2_TARGET static __m256i shift1(__m256i x) {
+        return shuffle::shift1(x);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256i prefix(__m256i x) {
+        return shuffle::prefix_add(x);
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256i broadcast_last(__m256i x) {
+        return shuffle::broadcast_last(x);
+    }
+};
+
+// 浮点数的移动与整数相同；prefix 的三步加法按浮点数计算
+template <> struct avx2_scan_ops<float, 4, true> : avx2_ops<float> {
+    typedef avx2_scan_shuffle<4> shuffle;
+    EASYSTL_SIMD_AVX2_TARGET static __m256 shift1(__m256 x) {
+        return _mm256_castsi256_ps(shuffle::shift1(_mm256_castps_si256(x)));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256 prefix(__m256 x) {
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(
+                                 _mm256_castps_si256(x), 4)));
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(
+                                 _mm256_castps_si256(x), 8)));
+        return _mm256_add_ps(
+            x, _mm256_castsi256_ps(shuffle::low_to_high(_mm256_castps_si256(
+                   _mm256_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3))))));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256 broadcast_last(__m256 x) {
+        return _mm256_permutevar8x32_ps(x, _mm256_set1_epi32(7));
+    }
+};
+
+template <> struct avx2_scan_ops<double, 8, true> : avx2_ops<double> {
+    typedef avx2_scan_shuffle<8> shuffle;
+    EASYSTL_SIMD_AVX2_TARGET static __m256d shift1(__m256d x) {
+        return _mm256_castsi256_pd(shuffle::shift1(_mm256_castpd_si256(x)));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256d prefix(__m256d x) {
+        x = _mm256_add_pd(x, _mm256_castsi256_pd(_mm256_slli_si256(
+                                 _mm256_castpd_si256(x), 8)));
+        return _mm256_add_pd(
+            x, _mm256_castsi256_pd(shuffle::low_to_high(_mm256_castpd_si256(
+                   _mm256_unpackhi_pd(x, x)))));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256d broadcast_last(__m256d x) {
+        return _mm256_permute4x64_pd(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+};
+
+template <class Ops, bool Exclusive, class T>
+EASYSTL_SIMD_AVX2_TARGET T *avx2_scan(const T *first, const T *last,
+                                      T *result, T init) {
+    typedef typename Ops::vec vec;
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    vec carry = Ops::set1(static_cast<typename Ops::scalar>(init));
+    for (; last - first >= lanes; first += lanes, result += lanes) {
+        const vec x = Ops::prefix(Ops::load(first));
+        Ops::store(result, Ops::add(Exclusive ? Ops::shift1(x) : x, carry));
+        carry = Ops::add(carry, Ops::broadcast_last(x));
+    }
+    T buf[32 / sizeof(T)];
+    Ops::store(buf, carry);
+    return scan_tail<Exclusive>(first, last, result, buf[0]);
+}
+
+/*
+ * 流压缩（left-pack）
+ * 把一个向量中保留的通道依次移到低位：保留的通道组成 8 位掩码，查表得到
+ * _mm256_permutevar8x32_epi32 的下标。8 字节的元素占两个 32 位通道，掩码的
+ * 每一位扩展为两位后使用同一张表。
+ * 每次把整个向量写入 out，多余的通道落在已经读过的位置上，由之后的写入覆盖，
+ * 所以 out 可以等于 first。内核只处理完整的向量，first 与 out 前进到处理完的
+ * 位置，剩下的元素由调用者逐个处理
+ * */
+struct compact_table {
+    std::uint64_t index[256];
+    unsigned char count[256];
+
+    compact_table() noexcept {
+        for (unsigned m = 0; m < 256; ++m) {
+            std::uint64_t idx = 0;
+            unsigned k = 0;
+            for (unsigned i = 0; i < 8; ++i) {
+                if (m >> i & 1) {
+                    idx |= static_cast<std::uint64_t>(i) << (8 * k++);
+                }
+            }
+            index[m] = idx;
+            count[m] = static_cast<unsigned char>(k);
+        }
+    }
+};
+
+inline const compact_table &get_compact_table() noexcept {
+    static const compact_table table;
+    return table;
+}
+
+template <std::size_t Size> struct avx2_compact;
+
+template <> struct avx2_compact<4> {
+    static const unsigned full = 0xFF;
+    static unsigned expand(unsigned keep) noexcept { return keep; }
+    EASYSTL_SIMD_AVX2_TARGET static unsigned lane_mask(__m256i m) {
+        return static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(m)));
+    }
+    // 每个通道换成它的前一个元素，第 0 个通道取 prev 的最后一个元素
+    EASYSTL_SIMD_AVX2_TARGET static __m256i previous(__m256i prev,
+                                                     __m256i cur) {
+        return _mm256_alignr_epi8(
+            cur, _mm256_permute2x128_si256(prev, cur, 0x21), 12);
+    }
+};
+
+template <> struct avx2_compact<8> {
+    static const unsigned full = 0xF;
+    // 0bdcba 扩展为 0bddccbbaa
+    static unsigned expand(unsigned keep) noexcept {
+        unsigned x = (keep | keep << 2) & 0x33;
+        x = (x | x << 1) & 0x55;
+        return x | x << 1;
+    }
+    EASYSTL_SIMD_AVX2_TARGET static unsigned lane_mask(__m256i m) {
+        return static_cast<unsigned>(
+            _mm256_movemask_pd(_mm256_castsi256_pd(m)));
+    }
+    EASYSTL_SIMD_AVX2_TARGET static __m256i previous(__m256i prev,
+                                                     __m256i cur) {
+        return _mm256_alignr_epi8(
+            cur, _mm256_permute2x128_si256(prev, cur, 0x21), 8);
+    }
+};
+
+// 逐通道比较相等，相等的通道全为 1。浮点数按 operator== 比较
+template <class C, bool = std::is_floating_point<C>::value>
+struct avx2_lane_eq {
+    EASYSTL_SIMD_AVX2_TARGET static __m256i eq(__m256i a, __m256i b) {
+        return sizeof(C) == 4 ? _mm256_cmpeq_epi32(a, b)
+                              : _mm256_cmpeq_epi64(a, b);
+    }
+};
+
+template <> struct avx2_lane_eq<float, true> {
+    EASYSTL_SIMD_AVX2_TARGET static __m256i eq(__m256i a, __m256i b) {
+        return _mm256_castps_si256(_mm256_cmp_ps(
+            _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+    }
+};
+
+template <> struct avx2_lane_eq<double, true> {
+    EASYSTL_SIMD_AVX2_TARGET static __m256i eq(__m256i a, __m256i b) {
+        return _mm256_castpd_si256(_mm256_cmp_pd(
+            _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+    }
+};
+
+template <class T>
+EASYSTL_SIMD_AVX2_TARGET __m256i avx2_load_bits(const T *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+// 把 v 中 keep 为 1 的通道依次写到 out，返回新的 out
+template <class T>
+EASYSTL_SIMD_AVX2_TARGET T *avx2_compress_store(T *out, __m256i v,
+                                                unsigned keep,
+                                                const compact_table &table) {
+    const unsigned m = avx2_compact<sizeof(T)>::expand(keep);
+    const __m256i idx = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&table.index[m])));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                        _mm256_permutevar8x32_epi32(v, idx));
+    return out + table.count[m] / (sizeof(T) / 4);
+}
+
+// 对一个向量的每个元素调用 pred，结果为真的通道置 1
+template <class T, class Predicate>
+unsigned lane_predicate(const T *p, Predicate &pred) {
+    unsigned mask = 0;
+    for (unsigned i = 0; i < 32 / sizeof(T); ++i) {
+        mask |= static_cast<unsigned>(static_cast<bool>(pred(p[i]))) << i;
+    }
+    return mask;
+}
+
+template <class C, class T>
+EASYSTL_SIMD_AVX2_TARGET void avx2_remove(T *&first, T *last, T *&out,
+                                          T value) {
+    typedef avx2_compact<sizeof(T)> compact;
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    const compact_table &table = get_compact_table();
+    T values[32 / sizeof(T)];
+    for (std::ptrdiff_t i = 0; i < lanes; ++i) {
+        values[i] = value;
+    }
+    const __m256i needle = avx2_load_bits(values);
+    for (; last - first >= lanes; first += lanes) {
+        const __m256i v = avx2_load_bits(first);
+        const unsigned remove =
+            compact::lane_mask(avx2_lane_eq<C>::eq(v, needle));
+        out = avx2_compress_store(out, v, ~remove & compact::full, table);
+    }
+}
+
+template <class T, class Predicate>
+EASYSTL_SIMD_AVX2_TARGET void avx2_remove_if(T *&first, T *last, T *&out,
+                                             Predicate &pred) {
+    typedef avx2_compact<sizeof(T)> compact;
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    const compact_table &table = get_compact_table();
+    for (; last - first >= lanes; first += lanes) {
+        const unsigned remove = lane_predicate(first, pred);
+        out = avx2_compress_store(out, avx2_load_bits(first),
+                                  ~remove & compact::full, table);
+    }
+}
+
+// first[-1] 是已经保留的元素。与前一个元素相等的元素被删除
+template <class C, class T>
+EASYSTL_SIMD_AVX2_TARGET void avx2_unique(T *&first, T *last, T *&out) {
+    typedef avx2_compact<sizeof(T)> compact;
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    if (last - first < lanes) {
+        return;
+    }
+    const compact_table &table = get_compact_table();
+    // 写入会覆盖 first 之前的元素，之后的前一个元素从寄存器中取
+    __m256i cur = avx2_load_bits(first);
+    __m256i prev = avx2_load_bits(first - 1);
+    while (true) {
+        const unsigned remove =
+            compact::lane_mask(avx2_lane_eq<C>::eq(cur, prev));
+        out = avx2_compress_store(out, cur, ~remove & compact::full, table);
+        first += lanes;
+        if (last - first < lanes) {
+            return;
+        }
+        const __m256i next = avx2_load_bits(first);
+        prev = compact::previous(cur, next);
+        cur = next;
+    }
+}
+
+// pred 为真的元素依次写到 out，其余的依次写到 rest
+template <class T, class Predicate>
+EASYSTL_SIMD_AVX2_TARGET void avx2_partition(T *&first, T *last, T *&out,
+                                             T *&rest, Predicate &pred) {
+    typedef avx2_compact<sizeof(T)> compact;
+    const std::ptrdiff_t lanes = 32 / sizeof(T);
+    const compact_table &table = get_compact_table();
+    for (; last - first >= lanes; first += lanes) {
+        const unsigned keep = lane_predicate(first, pred);
+        const __m256i v = avx2_load_bits(first);
+        out = avx2_compress_store(out, v, keep, table);
+        rest = avx2_compress_store(rest, v, ~keep & compact::full, table);
+    }
+}
+
+/*
+ * has_avx2
+ * 运行时检测 CPU 是否支持 AVX2，结果只计算一次
+ * */
+inline bool has_avx2() noexcept {
+#ifdef __AVX2__
+    return true;
+#else
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+#endif
+}
+
+#endif // EASYSTL_SIMD_AVX2
+
+#ifdef EASYSTL_SIMD_SSE2
+
+/*
+ * 对外的接口：按元素类型选择内核，有 AVX2 时优先使用
+ * 调用者保证 is_vectorizable<T>::value 为 true
+ * */
+template <class T> const T *find(const T *first, const T *last, T value) {
+    typedef typename scalar_of<T>::type C;
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return avx2_find<avx2_ops<C>>(first, last, value);
+    }
+#endif
+    return sse2_find<sse2_ops<C>>(first, last, value);
+}
+
+// 返回最后一个等于 value 的位置，不存在时返回 last
+template <class T>
+const T *find_last(const T *first, const T *last, T value) {
+    typedef typename scalar_of<T>::type C;
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return avx2_find_last<avx2_ops<C>>(first, last, value);
+    }
+#endif
+    return sse2_find_last<sse2_ops<C>>(first, last, value);
+}
+
+template <class T>
+std::size_t count(const T *first, const T *last, T value) {
+    typedef typename scalar_of<T>::type C;
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return avx2_count<avx2_ops<C>>(first, last, value);
+    }
+#endif
+    return sse2_count<sse2_ops<C>>(first, last, value);
+}
+
+// 整数按 T 的位宽回绕；浮点数的加法顺序与逐个累加不同
+template <class T> T sum(const T *first, const T *last) {
+    typedef typename scalar_of<T>::type C;
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return avx2_sum<avx2_ops<C>>(first, last);
+    }
+#endif
+    return sse2_sum<sse2_ops<C>>(first, last);
+}
+
+/*
+ * min_max
+ * 计算 [first, last) 中的最小值与最大值。元素太少、遇到 NaN 或者没有可用的
+ * 指令时返回 false，由调用者逐个比较
+ * */
+template <class T> bool min_max(const T *first, const T *last, T &mn, T &mx) {
+    typedef typename scalar_of<T>::type C;
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return last - first >= static_cast<std::ptrdiff_t>(32 / sizeof(T)) &&
+               avx2_min_max<avx2_ops<C>>(first, last, mn, mx);
+    }
+#endif
+    return sse2_ops<C>::has_minmax &&
+           last - first >= static_cast<std::ptrdiff_t>(16 / sizeof(T)) &&
+           sse2_min_max<sse2_ops<C>>(first, last, mn, mx);
+}
+
+/*
+ * scan
+ * 以 init 开始的前缀和，Exclusive 为 true 时 result[i] 不含 first[i]。
+ * result 可以等于 first。浮点数在向量内按对数步数相加，舍入可能与逐个累加不同
+ * 调用者保证 is_scannable<T>::value 为 true
+ * */
+template <bool Exclusive, class T>
+T *scan(const T *first, const T *last, T *result, T init) {
+    typedef typename scalar_of<T>::type C;
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return avx2_scan<avx2_scan_ops<C>, Exclusive>(first, last, result,
+                                                      init);
+    }
+#endif
+    return sse2_scan<sse2_scan_ops<C>, Exclusive>(first, last, result, init);
+}
+
+/*
+ * remove, remove_if, unique, partition
+ * 流压缩：连续存储的 4 或 8 字节元素在有 AVX2 时按向量处理，first 与 out
+ * （以及 rest）前进到处理完的位置，剩下的元素由调用者逐个处理；其余情况不做
+ * 任何处理。out 可以等于 first；rest 指向另一块至少能容纳 last - first 个元素
+ * 的缓冲区
+ * */
+template <class T>
+typename std::enable_if<is_compactable<T>::value>::type
+remove(T *&first, T *last, T *&out, T value) {
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        avx2_remove<typename scalar_of<T>::type>(first, last, out, value);
+    }
+#else
+    (void)first, (void)last, (void)out, (void)value;
+#endif
+}
+
+template <class T, class Predicate>
+typename std::enable_if<is_compactable<T>::value>::type
+remove_if(T *&first, T *last, T *&out, Predicate &pred) {
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        avx2_remove_if(first, last, out, pred);
+    }
+#else
+    (void)first, (void)last, (void)out, (void)pred;
+#endif
+}
+
+// 要求 first[-1] 是已经保留的元素
+template <class T>
+typename std::enable_if<is_compactable<T>::value>::type
+unique(T *&first, T *last, T *&out) {
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        avx2_unique<typename scalar_of<T>::type>(first, last, out);
+    }
+#else
+    (void)first, (void)last, (void)out;
+#endif
+}
+
+template <class T, class Predicate>
+typename std::enable_if<is_compactable<T>::value>::type
+partition(T *&first, T *last, T *&out, T *&rest, Predicate &pred) {
+#ifdef EASYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        avx2_partition(first, last, out, rest, pred);
+    }
+#else
+    (void)first, (void)last, (void)out, (void)rest, (void)pred;
+#endif
+}
+
+#else // !EASYSTL_SIMD_SSE2
+
+/*
+ * 没有 SSE2 时 is_vectorizable 为 false，algo.h 与 numeric.h 不会调用下面的
+ * 函数；保留逐个处理的版本，使这些头文件中的分派代码在任何平台上都能编译
+ * */
+template <class T> const T *find(const T *first, const T *last, T value) {
+    for (; first != last && !(*first == value); ++first) {
+    }
+    return first;
+}
+
+template <class T>
+const T *find_last(const T *first, const T *last, T value) {
+    for (const T *p = last; p != first;) {
+        if (*--p == value) {
+            return p;
+        }
+    }
+    return last;
+}
+
+template <class T>
+std::size_t count(const T *first, const T *last, T value) {
+    std::size_t n = 0;
+    for (; first != last; ++first) {
+        n += *first == value ? 1 : 0;
+    }
+    return n;
+}
+
+template <class T> T sum(const T *first, const T *last) {
+    T s = T();
+    for (; first != last; ++first) {
+        s = wrapping_add(s, *first);
+    }
+    return s;
+}
+
+template <class T> bool min_max(const T *, const T *, T &, T &) {
+    return false;
+}
+
+template <bool Exclusive, class T>
+T *scan(const T *first, const T *last, T *result, T init) {
+    for (; first != last; ++first, ++result) {
+        const T next = wrapping_add(init, *first);
+        *result = Exclusive ? init : next;
+        init = next;
+    }
+    return result;
+}
+
+#endif // EASYSTL_SIMD_SSE2
+
+} // namespace simd
+} // namespace easystl
+
+#endif // !EASYSTL_SIMD_H
@@ -0,0 +1,427 @@
+#ifndef EASYSTL_SPLIT_H
+#define EASYSTL_SPLIT_H
+
+// 惰性的字符串切分
+//
+// split、split_any_of 与 split_csv 返回一个区间，遍历时才查找下一个分隔符，
+// 每个字段都是指向原字符串的 basic_string_view，不分配内存。被切分的字符串必
+// 须在遍历期间保持有效，因此不接受临时的 basic_string。
+//
+// 与 Python 的 str.split(sep) 相同，n 个分隔符总是得到 n + 1 个字段，空字符串
+// 得到一个空字段。
+
+#include "basic_string.h"
+#include "char_traits.h"
+#include "iterator.h"
+#include "string_view.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define EASYSTL_SPLIT_SSE2 1
+#endif
+
+namespace easystl {
+
+/*
+ * 切分策略
+ * operator()(first, last, field) 把 [first, last) 中的第一个字段写入 field，
+ * 返回下一个字段的起点；这是最后一个字段时返回 nullptr。
+ * */
+
+// 单个字符作为分隔符，使用 traits_type::find，char 时即 memchr
+template <class CharType, class CharTraits> struct split_char_delimiter {
+    typedef basic_string_view<CharType, CharTraits> view_type;
+
+    CharType delim;
+
+    const CharType *operator()(const CharType *first, const CharType *last,
+                               view_type &field) const noexcept {
+        const CharType *p = CharTraits::find(
+            first, static_cast<std::size_t>(last - first), delim);
+        if (!p) {
+            field = view_type(first, static_cast<std::size_t>(last - first));
+            return nullptr;
+        }
+        field = view_type(first, static_cast<std::size_t>(p - first));
+        return p + 1;
+    }
+};
+
+// 字符串作为分隔符，空字符串不切分
+template <class CharType, class CharTraits> struct split_string_delimiter {
+    typedef basic_string_view<CharType, CharTraits> view_type;
+
+    view_type delim;
+
+    const CharType *operator()(const CharType *first, const CharType *last,
+                               view_type &field) const noexcept {
+        const view_type rest(first, static_cast<std::size_t>(last - first));
+        const std::size_t pos =
+            delim.empty() ? view_type::npos : rest.find(delim);
+        if (pos == view_type::npos) {
+            field = rest;
+            return nullptr;
+        }
+        field = view_type(first, pos);
+        return first + pos + delim.size();
+    }
+};
+
+// 一组字符中的任意一个作为分隔符
+template <class CharType, class CharTraits> struct split_any_delimiter {
+    typedef basic_string_view<CharType, CharTraits> view_type;
+
+    view_type delims;
+
+    explicit split_any_delimiter(view_type d) noexcept : delims(d) {}
+
+    const CharType *operator()(const CharType *first, const CharType *last,
+                               view_type &field) const noexcept {
+        const CharType *p = first;
+        for (; p != last; ++p) {
+            if (CharTraits::find(delims.data(), delims.size(), *p)) {
+                break;
+            }
+        }
+        field = view_type(first, static_cast<std::size_t>(p - first));
+        return p == last ? nullptr : p + 1;
+    }
+};
+
+/*
+ * char_traits<char> 的特化：逐字节相等即字符相等，可以按字节查表或做向量比较。
+ * 不超过 kVectorMax 个分隔符时每次比较 16 个字节，否则查 256 位的位图。
+ * */
+template <> struct split_any_delimiter<char, char_traits<char>> {
+    typedef basic_string_view<char, char_traits<char>> view_type;
+
+    static const std::size_t kVectorMax = 8;
+
+    view_type delims;
+    std::uint32_t bitmap[8];
+
+    explicit split_any_delimiter(view_type d) noexcept : delims(d) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            bitmap[i] = 0;
+        }
+        for (std::size_t i = 0; i < d.size(); ++i) {
+            const unsigned char c = static_cast<unsigned char>(d[i]);
+            bitmap[c >> 5] |= std::uint32_t(1) << (c & 31);
+        }
+    }
+
+    bool is_delim(char c) const noexcept {
+        const unsigned char u = static_cast<unsigned char>(c);
+        return (bitmap[u >> 5] >> (u & 31)) & 1;
+    }
+
+    const char *operator()(const char *first, const char *last,
+                           view_type &field) const noexcept {
+        const char *p = M_find(first, last);
+        field = view_type(first, static_cast<std::size_t>(p - first));
+        return p == last ? nullptr : p + 1;
+    }
+
+  private:
+    const char *M_find(const char *p, const char *last) const noexcept {
+        if (delims.empty()) {
+            return last;
+        }
+        if (delims.size() == 1) {
+            const char *r = char_traits<char>::find(
+                p, static_cast<std::size_t>(last - p), delims[0]);
+            return r ? r : last;
+        }
+#ifdef EASYSTL_SPLIT_SSE2
+        if (delims.size() <= kVectorMax) {
+            __m128i d[kVectorMax];
+            const std::size_t nd = delims.size();
+            for (std::size_t i = 0; i < nd; ++i) {
+                d[i] = _mm_set1_epi8(delims[i]);
+            }
+            for (; last - p >= 16; p += 16) {
+                const __m128i v =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                __m128i hit = _mm_cmpeq_epi8(v, d[0]);
+                for (std::size_t i = 1; i < nd; ++i) {
+                    hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, d[i]));
+                }
+                const int mask = _mm_movemask_epi8(hit);
+                if (mask) {
+                    return p + __builtin_ctz(static_cast<unsigned>(mask));
+                }
+            }
+        }
+#endif
+        for (; p != last && !is_delim(*p); ++p) {
+        }
+        return p;
+    }
+};
+
+/**
+ *  @brief  CSV 字段的切分策略
+ *
+ *  以 quote 开头的字段一直延伸到配对的 quote，其中的 sep 不切分，连续两个 quote
+ *  表示一个 quote 字符。字段不包含两端的 quote，转义的 quote 保持原样，需要时
+ *  用 csv_unescape 还原。只处理一条记录，记录之间的换行需要先切分。
+ */
+template <class CharType, class CharTraits> struct split_csv_delimiter {
+    typedef basic_string_view<CharType, CharTraits> view_type;
+
+    CharType sep;
+    CharType quote;
+
+    const CharType *operator()(const CharType *first, const CharType *last,
+                               view_type &field) const noexcept {
+        if (first == last || !CharTraits::eq(*first, quote)) {
+            return split_char_delimiter<CharType, CharTraits>{sep}(
+                first, last, field);
+        }
+        const CharType *begin = first + 1;
+        const CharType *p = begin;
+        for (;;) {
+            p = CharTraits::find(p, static_cast<std::size_t>(last - p), quote);
+            if (!p) {
+                // 没有配对的 quote，剩余部分都属于这个字段
+                field = view_type(begin, static_cast<std::size_t>(last - begin));
+                return nullptr;
+            }
+            if (p + 1 != last && CharTraits::eq(p[1], quote)) {
+                p += 2;
+                continue;
+            }
+            break;
+        }
+        field = view_type(begin, static_cast<std::size_t>(p - begin));
+        // 忽略配对的 quote 与 sep 之间的字符
+        const CharType *next = CharTraits::find(
+            p + 1, static_cast<std::size_t>(last - p - 1), sep);
+        return next ? next + 1 : nullptr;
+    }
+};
+
+/*
+ * basic_split_range
+ * 由切分策略驱动的惰性区间，迭代器为前向迭代器，解引用得到当前字段。
+ * */
+template <class CharType, class CharTraits, class Delimiter>
+class basic_split_range {
+  public:
+    typedef basic_string_view<CharType, CharTraits> view_type;
+
+    class iterator
+        : public easystl::iterator<forward_iterator_tag, view_type,
+                                   std::ptrdiff_t, const view_type *,
+                                   const view_type &> {
+      private:
+        const basic_split_range *M_range;
+        view_type M_field;
+        const CharType *M_next; // 下一个字段的起点，当前为最后一个字段时为空
+        bool M_done;
+
+        friend class basic_split_range;
+
+        iterator(const basic_split_range *r, bool done) noexcept
+            : M_range(r), M_field(), M_next(nullptr), M_done(done) {
+            if (!done) {
+                M_scan(r->M_str.data());
+            }
+        }
+
+        void M_scan(const CharType *p) noexcept {
+            M_next = M_range->M_delim(
+                p, M_range->M_str.data() + M_range->M_str.size(), M_field);
+        }
+
+      public:
+        iterator() noexcept
+            : M_range(nullptr), M_field(), M_next(nullptr), M_done(true) {}
+
+        const view_type &operator*() const noexcept { return M_field; }
+        const view_type *operator->() const noexcept { return &M_field; }
+
+        iterator &operator++() noexcept {
+            if (M_next) {
+                M_scan(M_next);
+            } else {
+                M_done = true;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator &rhs) const noexcept {
+            return M_done == rhs.M_done &&
+                   (M_done || M_field.data() == rhs.M_field.data());
+        }
+
+        bool operator!=(const iterator &rhs) const noexcept {
+            return !(*this == rhs);
+        }
+    };
+
+    typedef iterator const_iterator;
+
+  private:
+    view_type M_str;
+    Delimiter M_delim;
+
+  public:
+    basic_split_range(view_type str, const Delimiter &delim)
+        : M_str(str), M_delim(delim) {}
+
+    iterator begin() const noexcept { return iterator(this, false); }
+    iterator end() const noexcept { return iterator(this, true); }
+};
+
+template <class CharType, class CharTraits>
+using split_char_range =
+    basic_split_range<CharType, CharTraits,
+                      split_char_delimiter<CharType, CharTraits>>;
+
+template <class CharType, class CharTraits>
+using split_string_range =
+    basic_split_range<CharType, CharTraits,
+                      split_string_delimiter<CharType, CharTraits>>;
+
+template <class CharType, class CharTraits>
+using split_any_range =
+    basic_split_range<CharType, CharTraits,
+                      split_any_delimiter<CharType, CharTraits>>;
+
+template <class CharType, class CharTraits>
+using split_csv_range =
+    basic_split_range<CharType, CharTraits,
+                      split_csv_delimiter<CharType, CharTraits>>;
+
+/**
+ *  @brief  以单个字符切分
+ *  @param  str  被切分的字符串，遍历期间必须有效
+ *  @param  delim  分隔符
+ */
+template <class CharType, class CharTraits>
+inline split_char_range<CharType, CharTraits>
+split(basic_string_view<CharType, CharTraits> str, CharType delim) {
+    return split_char_range<CharType, CharTraits>(
+        str, split_char_delimiter<CharType, CharTraits>{delim});
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline split_char_range<CharType, CharTraits>
+split(const basic_string<CharType, CharTraits, Allocator> &str,
+      CharType delim) {
+    return easystl::split(basic_string_view<CharType, CharTraits>(str), delim);
+}
+
+template <class CharType>
+inline split_char_range<CharType, char_traits<CharType>>
+split(const CharType *str, CharType delim) {
+    return easystl::split(basic_string_view<CharType>(str), delim);
+}
+
+/**
+ *  @brief  以字符串切分，空的分隔符得到整个字符串
+ */
+template <class CharType, class CharTraits>
+inline split_string_range<CharType, CharTraits>
+split(basic_string_view<CharType, CharTraits> str,
+      typename string_view_identity<
+          basic_string_view<CharType, CharTraits>>::type delim) {
+    return split_string_range<CharType, CharTraits>(
+        str, split_string_delimiter<CharType, CharTraits>{delim});
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline split_string_range<CharType, CharTraits>
+split(const basic_string<CharType, CharTraits, Allocator> &str,
+      typename string_view_identity<
+          basic_string_view<CharType, CharTraits>>::type delim) {
+    return easystl::split(basic_string_view<CharType, CharTraits>(str), delim);
+}
+
+/**
+ *  @brief  以 @a delims 中的任意一个字符切分
+ */
+template <class CharType, class CharTraits>
+inline split_any_range<CharType, CharTraits>
+split_any_of(basic_string_view<CharType, CharTraits> str,
+             typename string_view_identity<
+                 basic_string_view<CharType, CharTraits>>::type delims) {
+    return split_any_range<CharType, CharTraits>(
+        str, split_any_delimiter<CharType, CharTraits>(delims));
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline split_any_range<CharType, CharTraits>
+split_any_of(const basic_string<CharType, CharTraits, Allocator> &str,
+             typename string_view_identity<
+                 basic_string_view<CharType, CharTraits>>::type delims) {
+    return easystl::split_any_of(basic_string_view<CharType, CharTraits>(str),
+                                 delims);
+}
+
+/**
+ *  @brief  切分一条 CSV 记录
+ *  @param  str  一条记录，不含换行
+ *  @param  sep  字段分隔符
+ *  @param  quote  引号字符
+ */
+template <class CharType, class CharTraits>
+inline split_csv_range<CharType, CharTraits>
+split_csv(basic_string_view<CharType, CharTraits> str,
+          CharType sep = CharType(','), CharType quote = CharType('"')) {
+    return split_csv_range<CharType, CharTraits>(
+        str, split_csv_delimiter<CharType, CharTraits>{sep, quote});
+}
+
+template <class CharType, class CharTraits, class Allocator>
+inline split_csv_range<CharType, CharTraits>
+split_csv(const basic_string<CharType, CharTraits, Allocator> &str,
+          CharType sep = CharType(','), CharType quote = CharType('"')) {
+    return easystl::split_csv(basic_string_view<CharType, CharTraits>(str), sep,
+                              quote);
+}
+
+// 临时字符串在区间遍历之前就已销毁
+template <class CharType, class CharTraits, class Allocator, class... Args>
+void split(basic_string<CharType, CharTraits, Allocator> &&, Args...) = delete;
+template <class CharType, class CharTraits, class Allocator, class... Args>
+void split_any_of(basic_string<CharType, CharTraits, Allocator> &&,
+                  Args...) = delete;
+template <class CharType, class CharTraits, class Allocator, class... Args>
+void split_csv(basic_string<CharType, CharTraits, Allocator> &&,
+               Args...) = delete;
+
+/**
+ *  @brief  还原 CSV 字段中转义的 quote，追加到 @a out
+ */
+template <class CharType, class CharTraits, class Allocator>
+void csv_unescape(basic_string_view<CharType, CharTraits> field,
+                  basic_string<CharType, CharTraits, Allocator> &out,
+                  CharType quote = CharType('"')) {
+    const CharType *p = field.data();
+    const CharType *last = p + field.size();
+    while (p != last) {
+        const CharType *q =
+            CharTraits::find(p, static_cast<std::size_t>(last - p), quote);
+        if (!q) {
+            out.append(p, static_cast<std::size_t>(last - p));
+            break;
+        }
+        out.append(p, static_cast<std::size_t>(q - p + 1));
+        p = (q + 1 != last && CharTraits::eq(q[1], quote)) ? q + 2 : q + 1;
+    }
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_SPLIT_H
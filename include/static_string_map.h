@@ -0,0 +1,270 @@
+#ifndef EASYSTL_STATIC_STRING_MAP_H
+#define EASYSTL_STATIC_STRING_MAP_H
+
+// 键集合固定的字符串映射
+//
+// 用于命令名、关键字等在编译时就确定的键表。构造时为这组键生成最小完美哈希
+// （hash and displace）：N 个键映射到 N 个槽位且互不冲突，查找只需计算一次
+// 哈希、读取一个位移值，再与槽位中的键比较一次。
+//
+// 以 C++20 编译时构造函数为 constexpr，可以用 constexpr 变量在编译期完成整
+// 个构造；更早的标准下在运行期构造一次，查找的代价相同。
+//
+//     constexpr easystl::static_string_entry<int> kCommands[] = {
+//         {"get", 1}, {"set", 2}, {"del", 3}};
+//     constexpr auto commands = easystl::make_static_string_map(kCommands);
+//     const int *op = commands.find(name);
+
+#include "basic_string.h"
+#include "char_traits.h"
+#include "exceptdef.h"
+#include "string_view.h"
+#include "type_traits.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace easystl {
+
+/**
+ *  @brief  static_string_map 的初始化项，key 必须是以 '\0' 结尾的字符串，并且
+ *          在映射的整个生命周期内有效（通常是字符串字面量）
+ */
+template <class Value> struct static_string_entry {
+    const char *key;
+    Value value;
+};
+
+template <class Value, std::size_t N> class static_string_map {
+    static_assert(N > 0, "static_string_map requires at least one key");
+    static_assert(N < (std::size_t(1) << 31),
+                  "static_string_map supports at most 2^31 - 1 keys");
+
+  public:
+    typedef char_traits<char> traits_type;
+    typedef std::size_t size_type;
+    typedef Value mapped_type;
+    typedef static_string_entry<Value> entry_type;
+
+    struct value_type {
+        const char *key;
+        size_type length;
+        Value value;
+    };
+
+    typedef const value_type *const_iterator;
+
+  private:
+    // 每个桶寻找位移值的上限，超过说明两个不同的键哈希值完全相同
+    static constexpr std::uint64_t S_max_seed = 1u << 16;
+
+    value_type M_slots[N];
+    // 每个桶一个值：非负数为第二次哈希使用的位移值；负数 -(i + 1) 表示桶中
+    // 只有一个键，直接存放在槽位 i
+    std::int32_t M_disp[N];
+
+  public:
+    /**
+     *  @brief  为 @a entries 中的键生成完美哈希
+     *  @throw  std::invalid_argument  键重复
+     *  @throw  std::logic_error  两个不同的键的 64 位哈希值相同
+     *
+     *  Value 需要可以默认构造。以 C++20 编译时可在编译期求值。
+     */
+    EASYSTL_CONSTEXPR20
+    explicit static_string_map(const entry_type (&entries)[N])
+        : M_slots(), M_disp() {
+        std::uint64_t hashes[N] = {};
+        size_type lengths[N] = {};
+        // 按桶对键做计数排序：桶 b 中的键为 order[start[b], start[b + 1])
+        size_type start[N + 1] = {};
+        size_type order[N] = {};
+        size_type max_bucket = 0;
+        for (size_type i = 0; i < N; ++i) {
+            lengths[i] = traits_type::length(entries[i].key);
+            hashes[i] = S_hash(entries[i].key, lengths[i]);
+            const size_type b = S_bucket(hashes[i]);
+            ++start[b + 1];
+            if (start[b + 1] > max_bucket) {
+                max_bucket = start[b + 1];
+            }
+        }
+        for (size_type b = 0; b < N; ++b) {
+            start[b + 1] += start[b];
+        }
+        {
+            size_type fill[N] = {};
+            for (size_type i = 0; i < N; ++i) {
+                const size_type b = S_bucket(hashes[i]);
+                order[start[b] + fill[b]++] = i;
+            }
+        }
+
+        bool used[N] = {};
+        // 从大桶到小桶依次为每个桶寻找一个能把桶中所有键放进空槽位的位移值
+        for (size_type count = max_bucket; count >= 2; --count) {
+            for (size_type b = 0; b < N; ++b) {
+                if (start[b + 1] - start[b] == count) {
+                    M_place(entries, hashes, lengths, order + start[b], count,
+                            used, b);
+                }
+            }
+        }
+        // 只有一个键的桶直接记录空槽位的下标
+        size_type free_slot = 0;
+        for (size_type b = 0; b < N; ++b) {
+            if (start[b + 1] - start[b] == 1) {
+                while (used[free_slot]) {
+                    ++free_slot;
+                }
+                used[free_slot] = true;
+                const size_type i = order[start[b]];
+                M_slots[free_slot] = {entries[i].key, lengths[i],
+                                      entries[i].value};
+                M_disp[b] = -static_cast<std::int32_t>(free_slot) - 1;
+            }
+        }
+    }
+
+  public:
+    EASYSTL_CONSTEXPR20 const_iterator begin() const noexcept {
+        return M_slots;
+    }
+    EASYSTL_CONSTEXPR20 const_iterator end() const noexcept {
+        return M_slots + N;
+    }
+    constexpr size_type size() const noexcept { return N; }
+
+    /**
+     *  @brief  查找键 [s, s + n)，计算一次哈希并比较一次字符
+     *  @return  对应值的指针，键不存在时返回 nullptr
+     */
+    EASYSTL_CONSTEXPR20
+    const Value *find(const char *s, size_type n) const noexcept {
+        const value_type &e = M_slots[M_slot(S_hash(s, n))];
+        return e.length == n && traits_type::compare(e.key, s, n) == 0
+                   ? &e.value
+                   : nullptr;
+    }
+
+    EASYSTL_CONSTEXPR20
+    const Value *find(basic_string_view<char> key) const noexcept {
+        return find(key.data(), key.size());
+    }
+
+    template <class Allocator>
+    EASYSTL_CONSTEXPR20 const Value *
+    find(const basic_string<char, traits_type, Allocator> &key) const noexcept {
+        return find(key.data(), key.size());
+    }
+
+    EASYSTL_CONSTEXPR20
+    bool contains(basic_string_view<char> key) const noexcept {
+        return find(key.data(), key.size()) != nullptr;
+    }
+
+    /**
+     *  @throw  std::out_of_range  键不存在
+     */
+    EASYSTL_CONSTEXPR20
+    const Value &at(basic_string_view<char> key) const {
+        const Value *v = find(key.data(), key.size());
+        THROW_OUT_OF_RANGE_IF(v == nullptr, "static_string_map::at");
+        return *v;
+    }
+
+  private:
+    // FNV-1a，64 位
+    EASYSTL_CONSTEXPR20
+    static std::uint64_t S_hash(const char *s, size_type n) noexcept {
+        std::uint64_t h = 14695981039346656037ull;
+        for (size_type i = 0; i < n; ++i) {
+            h = (h ^ static_cast<unsigned char>(s[i])) * 1099511628211ull;
+        }
+        return h;
+    }
+
+    // MurmurHash3 的 fmix64，使不同的位移值得到互不相关的槽位
+    static constexpr std::uint64_t S_mix(std::uint64_t h) noexcept {
+        return S_mix_step(
+            S_mix_step(S_mix_step(h, 33) * 0xff51afd7ed558ccdull, 33) *
+                0xc4ceb9fe1a85ec53ull,
+            33);
+    }
+
+    static constexpr std::uint64_t S_mix_step(std::uint64_t h,
+                                              unsigned shift) noexcept {
+        return h ^ (h >> shift);
+    }
+
+    static constexpr size_type S_bucket(std::uint64_t h) noexcept {
+        return static_cast<size_type>(S_mix(h) % N);
+    }
+
+    static constexpr size_type S_slot(std::uint64_t h,
+                                      std::uint64_t seed) noexcept {
+        return static_cast<size_type>(
+            S_mix(h + (seed + 1) * 0x9e3779b97f4a7c15ull) % N);
+    }
+
+    EASYSTL_CONSTEXPR20 size_type M_slot(std::uint64_t h) const noexcept {
+        const std::int32_t d = M_disp[S_bucket(h)];
+        return d < 0 ? static_cast<size_type>(-(d + 1))
+                     : S_slot(h, static_cast<std::uint64_t>(d));
+    }
+
+    // 为桶 b 中的 count 个键寻找位移值，使它们落在互不相同的空槽位上
+    EASYSTL_CONSTEXPR20
+    void M_place(const entry_type (&entries)[N], const std::uint64_t *hashes,
+                 const size_type *lengths, const size_type *members,
+                 size_type count, bool *used, size_type b) {
+        for (size_type x = 0; x < count; ++x) {
+            for (size_type y = x + 1; y < count; ++y) {
+                const size_type i = members[x];
+                const size_type j = members[y];
+                THROW_INVALID_ARGUMENT_IF(
+                    lengths[i] == lengths[j] &&
+                        traits_type::compare(entries[i].key, entries[j].key,
+                                             lengths[i]) == 0,
+                    "static_string_map: duplicate key");
+            }
+        }
+        for (std::uint64_t seed = 0; seed < S_max_seed; ++seed) {
+            bool ok = true;
+            for (size_type x = 0; ok && x < count; ++x) {
+                const size_type s = S_slot(hashes[members[x]], seed);
+                ok = !used[s];
+                for (size_type y = 0; ok && y < x; ++y) {
+                    ok = S_slot(hashes[members[y]], seed) != s;
+                }
+            }
+            if (ok) {
+                for (size_type x = 0; x < count; ++x) {
+                    const size_type i = members[x];
+                    const size_type s = S_slot(hashes[i], seed);
+                    used[s] = true;
+                    M_slots[s] = {entries[i].key, lengths[i],
+                                  entries[i].value};
+                }
+                M_disp[b] = static_cast<std::int32_t>(seed);
+                return;
+            }
+        }
+        THROW_LOGIC_ERROR_IF(true, "static_string_map: hash collision");
+    }
+};
+
+template <class Value, std::size_t N>
+constexpr std::uint64_t static_string_map<Value, N>::S_max_seed;
+
+/**
+ *  @brief  由初始化项数组构造 static_string_map，键的个数由数组长度推导
+ */
+template <class Value, std::size_t N>
+EASYSTL_CONSTEXPR20 static_string_map<Value, N>
+make_static_string_map(const static_string_entry<Value> (&entries)[N]) {
+    return static_string_map<Value, N>(entries);
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_STATIC_STRING_MAP_H
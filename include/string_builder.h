@@ -0,0 +1,320 @@
+#ifndef EASYSTL_STRING_BUILDER_H
+#define EASYSTL_STRING_BUILDER_H
+
+// 分块拼接字符串的构建器
+//
+// basic_string 每次扩容都需要把已有内容完整复制一遍，大量追加时代价很高。
+// basic_string_builder 把追加的内容写入由分配器分配的一串块中，已写入的字符
+// 永远不会被移动；最终通过 str() 一次性复制到 basic_string，或者通过
+// to_iovec() 把各个块直接交给 writev。
+
+#include "alloc_traits.h"
+#include "basic_string.h"
+#include "char_traits.h"
+#include "exceptdef.h"
+#include "utility.h"
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#define EASYSTL_HAS_IOVEC 1
+#endif
+
+namespace easystl {
+
+template <class CharType, class CharTraits = easystl::char_traits<CharType>,
+          class Allocator = easystl::allocator<CharType>>
+class basic_string_builder {
+  public:
+    typedef CharTraits traits_type;
+    typedef CharType value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef basic_string<CharType, CharTraits, Allocator> string_type;
+
+  private:
+    // 块头部，字符数据单独分配
+    struct chunk {
+        chunk *next;
+        CharType *data;
+        size_type size;
+        size_type capacity;
+    };
+
+    typedef easystl_cxx::alloc_traits<Allocator> char_alloc_traits;
+    typedef typename char_alloc_traits::template rebind<chunk>::other
+        chunk_alloc_type;
+    typedef easystl_cxx::alloc_traits<chunk_alloc_type> chunk_alloc_traits;
+
+    // 第一个块的容量以及块容量增长的上限
+    enum { S_min_chunk = 256 / sizeof(CharType) + 1 };
+    enum { S_max_chunk = (1 << 20) / sizeof(CharType) };
+
+    Allocator M_alloc;
+    chunk *M_head;
+    chunk *M_tail;
+    size_type M_size;
+    size_type M_chunks;
+
+  public:
+    /**
+     *  @brief  构造一个空的构建器，不分配内存
+     */
+    basic_string_builder() noexcept
+        : M_alloc(), M_head(nullptr), M_tail(nullptr), M_size(0),
+          M_chunks(0) {}
+
+    explicit basic_string_builder(const Allocator &a) noexcept
+        : M_alloc(a), M_head(nullptr), M_tail(nullptr), M_size(0),
+          M_chunks(0) {}
+
+    basic_string_builder(const basic_string_builder &) = delete;
+    basic_string_builder &operator=(const basic_string_builder &) = delete;
+
+    basic_string_builder(basic_string_builder &&rhs) noexcept
+        : M_alloc(easystl::move(rhs.M_alloc)), M_head(rhs.M_head),
+          M_tail(rhs.M_tail), M_size(rhs.M_size), M_chunks(rhs.M_chunks) {
+        rhs.M_head = rhs.M_tail = nullptr;
+        rhs.M_size = rhs.M_chunks = 0;
+    }
+
+    basic_string_builder &operator=(basic_string_builder &&rhs) noexcept {
+        if (this != &rhs) {
+            M_release();
+            M_alloc = easystl::move(rhs.M_alloc);
+            M_head = rhs.M_head;
+            M_tail = rhs.M_tail;
+            M_size = rhs.M_size;
+            M_chunks = rhs.M_chunks;
+            rhs.M_head = rhs.M_tail = nullptr;
+            rhs.M_size = rhs.M_chunks = 0;
+        }
+        return *this;
+    }
+
+    ~basic_string_builder() { M_release(); }
+
+  public:
+    size_type size() const noexcept { return M_size; }
+    size_type length() const noexcept { return M_size; }
+    bool empty() const noexcept { return M_size == 0; }
+
+    /**
+     *  @brief  已分配的块的数量，即 to_iovec() 需要的 iovec 数量上限
+     */
+    size_type chunk_count() const noexcept { return M_chunks; }
+
+    /**
+     *  @brief  预留至少 @a n 个字符的连续空间，之后 @a n 个字符的追加不会再分配
+     */
+    void reserve(size_type n) {
+        if (M_tail == nullptr || M_tail->capacity - M_tail->size < n) {
+            M_add_chunk(n);
+        }
+    }
+
+    /**
+     *  @brief  清空内容并释放所有块
+     */
+    void clear() noexcept { M_release(); }
+
+    /**
+     *  @brief  追加 C 字符串的前 @a n 个字符
+     */
+    basic_string_builder &append(const CharType *s, size_type n) {
+        easystl_require_string_len(s, n);
+        while (n > 0) {
+            size_type room = M_tail ? M_tail->capacity - M_tail->size : 0;
+            if (room == 0) {
+                M_add_chunk(n);
+                room = M_tail->capacity;
+            }
+            const size_type len = n < room ? n : room;
+            traits_type::copy(M_tail->data + M_tail->size, s, len);
+            M_tail->size += len;
+            M_size += len;
+            s += len;
+            n -= len;
+        }
+        return *this;
+    }
+
+    basic_string_builder &append(const CharType *s) {
+        easystl_require_string(s);
+        return append(s, traits_type::length(s));
+    }
+
+    template <class Alloc>
+    basic_string_builder &
+    append(const basic_string<CharType, CharTraits, Alloc> &str) {
+        return append(str.data(), str.size());
+    }
+
+    /**
+     *  @brief  追加 @a n 个字符 @a c
+     */
+    basic_string_builder &append(size_type n, CharType c) {
+        while (n > 0) {
+            size_type room = M_tail ? M_tail->capacity - M_tail->size : 0;
+            if (room == 0) {
+                M_add_chunk(n);
+                room = M_tail->capacity;
+            }
+            const size_type len = n < room ? n : room;
+            traits_type::assign(M_tail->data + M_tail->size, len, c);
+            M_tail->size += len;
+            M_size += len;
+            n -= len;
+        }
+        return *this;
+    }
+
+    void push_back(CharType c) {
+        if (M_tail == nullptr || M_tail->size == M_tail->capacity) {
+            M_add_chunk(1);
+        }
+        traits_type::assign(M_tail->data[M_tail->size++], c);
+        ++M_size;
+    }
+
+    basic_string_builder &operator+=(CharType c) {
+        push_back(c);
+        return *this;
+    }
+
+    basic_string_builder &operator+=(const CharType *s) { return append(s); }
+
+    template <class Alloc>
+    basic_string_builder &
+    operator+=(const basic_string<CharType, CharTraits, Alloc> &str) {
+        return append(str);
+    }
+
+    /**
+     *  @brief  将全部内容追加到 @a str 末尾，只分配一次内存
+     */
+    template <class Alloc>
+    void append_to(basic_string<CharType, CharTraits, Alloc> &str) const {
+        str.reserve(str.size() + M_size);
+        for (const chunk *c = M_head; c != nullptr; c = c->next) {
+            str.append(c->data, c->size);
+        }
+    }
+
+    /**
+     *  @brief  生成包含全部内容的字符串
+     */
+    string_type str() const {
+        string_type result(M_alloc);
+        append_to(result);
+        return result;
+    }
+
+    /**
+     *  @brief  按顺序对每个非空块调用 fn(const CharType *data, size_type n)
+     */
+    template <class Function> void for_each_chunk(Function fn) const {
+        for (const chunk *c = M_head; c != nullptr; c = c->next) {
+            if (c->size) {
+                fn(static_cast<const CharType *>(c->data), c->size);
+            }
+        }
+    }
+
+#ifdef EASYSTL_HAS_IOVEC
+    /**
+     *  @brief  将各个块填入 @a iov，用于 writev 等分散写接口
+     *  @param  iov  iovec 数组
+     *  @param  n  数组的长度，不小于 chunk_count() 时可以装下全部内容
+     *  @return  实际填入的 iovec 数量
+     *
+     *  iovec 指向构建器内部的内存，在下一次修改构建器之前有效。
+     */
+    size_type to_iovec(struct iovec *iov, size_type n) const noexcept {
+        size_type count = 0;
+        for (const chunk *c = M_head; c != nullptr && count < n; c = c->next) {
+            if (c->size) {
+                iov[count].iov_base = static_cast<void *>(c->data);
+                iov[count].iov_len = c->size * sizeof(CharType);
+                ++count;
+            }
+        }
+        return count;
+    }
+#endif
+
+    void swap(basic_string_builder &rhs) noexcept {
+        easystl::swap(M_alloc, rhs.M_alloc);
+        easystl::swap(M_head, rhs.M_head);
+        easystl::swap(M_tail, rhs.M_tail);
+        easystl::swap(M_size, rhs.M_size);
+        easystl::swap(M_chunks, rhs.M_chunks);
+    }
+
+  private:
+    /**
+     *  @brief  在末尾添加一个新块，容量至少为 @a need
+     *
+     *  块的容量随已写入的总长度增长，但不超过 1 MiB（S_max_chunk）。
+     *  总长度不到 1 MiB 时块的数量是 O(log n) 的，之后随长度线性增长。
+     */
+    void M_add_chunk(size_type need) {
+        size_type capacity = M_size < size_type(S_min_chunk)
+                                 ? size_type(S_min_chunk)
+                                 : M_size;
+        if (capacity > size_type(S_max_chunk)) {
+            capacity = size_type(S_max_chunk);
+        }
+        if (capacity < need) {
+            capacity = need;
+        }
+
+        chunk_alloc_type calloc(M_alloc);
+        chunk *c = chunk_alloc_traits::allocate(calloc, 1);
+        try {
+            c->data = char_alloc_traits::allocate(M_alloc, capacity);
+        } catch (...) {
+            chunk_alloc_traits::deallocate(calloc, c, 1);
+            throw;
+        }
+        c->next = nullptr;
+        c->size = 0;
+        c->capacity = capacity;
+
+        if (M_tail) {
+            M_tail->next = c;
+        } else {
+            M_head = c;
+        }
+        M_tail = c;
+        ++M_chunks;
+    }
+
+    void M_release() noexcept {
+        chunk_alloc_type calloc(M_alloc);
+        while (M_head) {
+            chunk *next = M_head->next;
+            char_alloc_traits::deallocate(M_alloc, M_head->data,
+                                          M_head->capacity);
+            chunk_alloc_traits::deallocate(calloc, M_head, 1);
+            M_head = next;
+        }
+        M_tail = nullptr;
+        M_size = 0;
+        M_chunks = 0;
+    }
+};
+
+template <class CharType, class CharTraits, class Allocator>
+inline void
+swap(basic_string_builder<CharType, CharTraits, Allocator> &lhs,
+     basic_string_builder<CharType, CharTraits, Allocator> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+using string_builder = basic_string_builder<char>;
+using wstring_builder = basic_string_builder<wchar_t>;
+
+} // namespace easystl
+
+#endif // !EASYSTL_STRING_BUILDER_H
@@ -0,0 +1,343 @@
+#ifndef EASYSTL_STRING_VIEW_H
+#define EASYSTL_STRING_VIEW_H
+
+// 字符串视图
+//
+// basic_string_view 只保存指向字符序列的指针与长度，不拥有字符，复制的代价与
+// 两个指针相同。被引用的字符必须在视图使用期间保持有效。
+
+#include "char_traits.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "type_traits.h"
+#include <cstddef>
+#include <ostream>
+
+namespace easystl {
+
+template <class CharType, class CharTraits = easystl::char_traits<CharType>>
+class basic_string_view {
+  public:
+    typedef CharTraits traits_type;
+    typedef CharType value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const CharType &const_reference;
+    typedef const CharType *const_pointer;
+    typedef const CharType *const_iterator;
+    typedef const_iterator iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+  private:
+    const CharType *M_str;
+    size_type M_len;
+
+  public:
+    constexpr basic_string_view() noexcept : M_str(nullptr), M_len(0) {}
+
+    constexpr basic_string_view(const CharType *s, size_type n) noexcept
+        : M_str(s), M_len(n) {}
+
+    EASYSTL_CONSTEXPR20
+    basic_string_view(const CharType *s) noexcept
+        : M_str(s), M_len(traits_type::length(s)) {}
+
+    basic_string_view(const basic_string_view &) = default;
+    basic_string_view &operator=(const basic_string_view &) = default;
+
+  public:
+    constexpr const_iterator begin() const noexcept { return M_str; }
+    constexpr const_iterator end() const noexcept { return M_str + M_len; }
+    constexpr const_iterator cbegin() const noexcept { return M_str; }
+    constexpr const_iterator cend() const noexcept { return M_str + M_len; }
+
+    constexpr size_type size() const noexcept { return M_len; }
+    constexpr size_type length() const noexcept { return M_len; }
+    constexpr bool empty() const noexcept { return M_len == 0; }
+    constexpr const CharType *data() const noexcept { return M_str; }
+
+    EASYSTL_CONSTEXPR20
+    const_reference operator[](size_type n) const noexcept {
+        EASYSTL_DEBUG(n < M_len);
+        return M_str[n];
+    }
+
+    EASYSTL_CONSTEXPR20
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(n >= M_len, "basic_string_view::at");
+        return M_str[n];
+    }
+
+    EASYSTL_CONSTEXPR20
+    const_reference front() const noexcept { return M_str[0]; }
+    EASYSTL_CONSTEXPR20
+    const_reference back() const noexcept { return M_str[M_len - 1]; }
+
+    EASYSTL_CONSTEXPR20
+    void remove_prefix(size_type n) noexcept {
+        EASYSTL_DEBUG(n <= M_len);
+        M_str += n;
+        M_len -= n;
+    }
+
+    EASYSTL_CONSTEXPR20
+    void remove_suffix(size_type n) noexcept {
+        EASYSTL_DEBUG(n <= M_len);
+        M_len -= n;
+    }
+
+    EASYSTL_CONSTEXPR20
+    void swap(basic_string_view &rhs) noexcept {
+        const basic_string_view tmp(*this);
+        *this = rhs;
+        rhs = tmp;
+    }
+
+    /**
+     *  @brief  返回 [pos, pos + n) 的视图
+     *  @throw  std::out_of_range  pos > size()
+     */
+    EASYSTL_CONSTEXPR20
+    basic_string_view substr(size_type pos = 0, size_type n = npos) const {
+        THROW_OUT_OF_RANGE_IF(pos > M_len, "basic_string_view::substr");
+        return basic_string_view(M_str + pos, n < M_len - pos ? n : M_len - pos);
+    }
+
+    EASYSTL_CONSTEXPR20
+    int compare(basic_string_view sv) const noexcept {
+        const size_type n = M_len < sv.M_len ? M_len : sv.M_len;
+        const int r = n == 0 ? 0 : traits_type::compare(M_str, sv.M_str, n);
+        if (r != 0) {
+            return r;
+        }
+        return M_len < sv.M_len ? -1 : (M_len > sv.M_len ? 1 : 0);
+    }
+
+    EASYSTL_CONSTEXPR20
+    bool starts_with(basic_string_view sv) const noexcept {
+        return M_len >= sv.M_len &&
+               (sv.M_len == 0 ||
+                traits_type::compare(M_str, sv.M_str, sv.M_len) == 0);
+    }
+
+    EASYSTL_CONSTEXPR20
+    bool ends_with(basic_string_view sv) const noexcept {
+        return M_len >= sv.M_len &&
+               (sv.M_len == 0 ||
+                traits_type::compare(M_str + M_len - sv.M_len, sv.M_str,
+                                     sv.M_len) == 0);
+    }
+
+    EASYSTL_CONSTEXPR20
+    size_type find(CharType c, size_type pos = 0) const noexcept {
+        if (pos >= M_len) {
+            return npos;
+        }
+        const CharType *p = traits_type::find(M_str + pos, M_len - pos, c);
+        return p ? static_cast<size_type>(p - M_str) : npos;
+    }
+
+    /**
+     *  @brief  查找子串，先用 traits_type::find 定位首字符，再比较其余字符
+     */
+    EASYSTL_CONSTEXPR20
+    size_type find(basic_string_view sv, size_type pos = 0) const noexcept {
+        if (sv.M_len == 0) {
+            return pos <= M_len ? pos : npos;
+        }
+        if (sv.M_len > M_len) {
+            return npos;
+        }
+        const size_type last = M_len - sv.M_len;
+        while (pos <= last) {
+            const CharType *p =
+                traits_type::find(M_str + pos, last - pos + 1, sv.M_str[0]);
+            if (!p) {
+                return npos;
+            }
+            pos = static_cast<size_type>(p - M_str);
+            if (traits_type::compare(p + 1, sv.M_str + 1, sv.M_len - 1) == 0) {
+                return pos;
+            }
+            ++pos;
+        }
+        return npos;
+    }
+
+    EASYSTL_CONSTEXPR20
+    size_type rfind(CharType c, size_type pos = npos) const noexcept {
+        if (M_len == 0) {
+            return npos;
+        }
+        size_type i = pos < M_len - 1 ? pos : M_len - 1;
+        for (++i; i-- > 0;) {
+            if (traits_type::eq(M_str[i], c)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    EASYSTL_CONSTEXPR20
+    size_type find_first_of(basic_string_view sv, size_type pos = 0) const
+        noexcept {
+        for (; pos < M_len; ++pos) {
+            if (traits_type::find(sv.M_str, sv.M_len, M_str[pos])) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    EASYSTL_CONSTEXPR20
+    size_type find_first_not_of(basic_string_view sv, size_type pos = 0) const
+        noexcept {
+        for (; pos < M_len; ++pos) {
+            if (!traits_type::find(sv.M_str, sv.M_len, M_str[pos])) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+};
+
+template <class CharType, class CharTraits>
+constexpr typename basic_string_view<CharType, CharTraits>::size_type
+    basic_string_view<CharType, CharTraits>::npos;
+
+// 第二个参数不参与推导，使得 const CharType* 与 basic_string 可以隐式转换后比较
+template <class Tp> struct string_view_identity {
+    typedef Tp type;
+};
+
+template <class CharType, class CharTraits>
+EASYSTL_CONSTEXPR20
+inline bool operator==(basic_string_view<CharType, CharTraits> lhs,
+                       basic_string_view<CharType, CharTraits> rhs) noexcept {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+EASYSTL_CONSTEXPR20
+inline bool operator==(
+    basic_string_view<CharType, CharTraits> lhs,
+    typename string_view_identity<basic_string_view<CharType, CharTraits>>::type
+        rhs) noexcept {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+EASYSTL_CONSTEXPR20
+inline bool operator==(
+    typename string_view_identity<basic_string_view<CharType, CharTraits>>::type
+        lhs,
+    basic_string_view<CharType, CharTraits> rhs) noexcept {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+EASYSTL_CONSTEXPR20
+inline bool operator!=(basic_string_view<CharType, CharTraits> lhs,
+                       basic_string_view<CharType, CharTraits> rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <class CharType, class CharTraits>
+EASYSTL_CONSTEXPR20
+inline bool operator!=(
+    basic_string_view<CharType, CharTraits> lhs,
+    typename string_view_identity<basic_string_view<CharType, CharTraits>>::type
+        rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <class CharType, class CharTraits>
+EASYSTL_CONSTEXPR20
+inline bool operator<(basic_string_view<CharType, CharTraits> lhs,
+                      basic_string_view<CharType, CharTraits> rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+template <class CharType, class CharTraits>
+inline std::basic_ostream<CharType> &
+operator<<(std::basic_ostream<CharType> &os,
+           basic_string_view<CharType, CharTraits> sv) {
+    return std::__ostream_insert(os, sv.data(), sv.size());
+}
+
+/*
+ * 字符串的哈希
+ * CharTraits::eq 认为相等的字符序列必须得到相同的哈希值。CharTraits 提供
+ * fold（如 ci_char_traits）时先把字符折叠为规范形式再求哈希，否则直接对字节
+ * 求哈希
+ * */
+template <class CharTraits, class = void>
+struct traits_has_fold : std::false_type {};
+
+template <class CharTraits>
+struct traits_has_fold<CharTraits,
+                       decltype(void(CharTraits::fold(
+                           typename CharTraits::char_type())))>
+    : std::true_type {};
+
+template <class CharTraits>
+inline std::uint64_t
+traits_hash_bytes(const typename CharTraits::char_type *s, std::size_t n,
+                  std::uint64_t seed, std::false_type) noexcept {
+    return easystl::hash_bytes(s, n * sizeof(*s), seed);
+}
+
+// 按 64 个字符一块折叠后依次求哈希，前一块的结果作为后一块的种子
+template <class CharTraits>
+inline std::uint64_t
+traits_hash_bytes(const typename CharTraits::char_type *s, std::size_t n,
+                  std::uint64_t seed, std::true_type) noexcept {
+    if (n == 0) {
+        return easystl::hash_bytes(s, 0, seed);
+    }
+    typename CharTraits::char_type buf[64];
+    while (n > 0) {
+        const std::size_t len = n < 64 ? n : 64;
+        for (std::size_t i = 0; i < len; ++i) {
+            buf[i] = CharTraits::fold(s[i]);
+        }
+        seed = easystl::hash_bytes(buf, len * sizeof(*s), seed);
+        s += len;
+        n -= len;
+    }
+    return seed;
+}
+
+/**
+ *  @brief  按 CharTraits 的相等关系计算字符序列的哈希值
+ *  @param  s  字符序列的起点
+ *  @param  n  字符数
+ *  @param  seed  传给 hash_bytes 的种子
+ */
+template <class CharTraits>
+inline std::uint64_t
+traits_hash_bytes(const typename CharTraits::char_type *s, std::size_t n,
+                  std::uint64_t seed = 0) noexcept {
+    return easystl::traits_hash_bytes<CharTraits>(
+        s, n, seed, traits_has_fold<CharTraits>());
+}
+
+// 与内容相同的 basic_string 得到相同的哈希值
+template <class CharType, class CharTraits>
+struct hash<basic_string_view<CharType, CharTraits>> {
+    std::size_t
+    operator()(basic_string_view<CharType, CharTraits> sv) const noexcept {
+        return static_cast<std::size_t>(
+            easystl::traits_hash_bytes<CharTraits>(sv.data(), sv.size()));
+    }
+};
+
+using string_view = basic_string_view<char>;
+using wstring_view = basic_string_view<wchar_t>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+
+} // namespace easystl
+
+#endif // !EASYSTL_STRING_VIEW_H
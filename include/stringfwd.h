@@ -1,7 +1,7 @@
 #ifndef EASYSTL_ASTRING_H_
 #define EASYSTL_ASTRING_H_
 
-// 定义了 string, wstring, u16string, u32string 类型
+// 定义了 string, wstring, u16string, u32string, ci_string 类型
 
 #include "basic_string.h"
 
@@ -12,5 +12,8 @@ using wstring = easystl::basic_string<wchar_t>;
 using u16string = easystl::basic_string<char16_t>;
 using u32string = easystl::basic_string<char32_t>;
 
+// 对 ASCII 字母不区分大小写的字符串
+using ci_string = easystl::basic_string<char, ci_char_traits<char>>;
+
 } // namespace easystl
 #endif // !EASYSTL_ASTRING_H_
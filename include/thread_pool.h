@@ -0,0 +1,17 @@
+#ifndef EASYSTL_THREAD_POOL_H
+#define EASYSTL_THREAD_POOL_H
+
+// 线程池
+//
+// 线程池由 scheduler.h 中的工作窃取调度器实现，thread_pool 是 scheduler 的
+// 别名，保留 submit、try_run_one、run_chunks、size 与 instance 等接口。
+
+#include "scheduler.h"
+
+namespace easystl {
+
+typedef scheduler thread_pool;
+
+} // namespace easystl
+
+#endif // !EASYSTL_THREAD_POOL_H
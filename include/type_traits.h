@@ -3,8 +3,30 @@
 
 #include <type_traits>
 
+// C++20 起 char_traits、basic_string 与 algobase 中的算法可以在编译期求值
+#if __cplusplus >= 202002L
+#define EASYSTL_HAS_CONSTEXPR20 1
+#define EASYSTL_CONSTEXPR20 constexpr
+#else
+#define EASYSTL_CONSTEXPR20
+#endif
+
 namespace easystl {
 
+/**
+ *  @brief  当前是否处于常量求值中
+ *
+ *  常量求值时不能调用 memcpy 等库函数，也不能使用 SIMD 指令，需要改用逐个元素
+ *  的实现。C++20 之前总是返回 false。
+ */
+constexpr bool is_constant_evaluated() noexcept {
+#ifdef EASYSTL_HAS_CONSTEXPR20
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
 template <class T, T v> struct m_integral_constant {
     static constexpr T value = v;
 };
@@ -0,0 +1,678 @@
+#ifndef EASYSTL_UTF_H
+#define EASYSTL_UTF_H
+
+// UTF-8 校验以及 UTF-8、UTF-16、UTF-32 之间的转换
+//
+// 校验：输入中的 ASCII 块整块跳过；x86 上如果 CPU 支持 AVX2，每次处理 32 个
+// 字节，使用查表法（Keiser & Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte", 2021）一次检查所有多字节序列；否则逐个字符按
+// Unicode 标准表 3-7 检查。
+//
+// 转换：先扫描一遍得到输出的长度，然后通过 resize_and_overwrite 直接写入目标
+// 字符串的缓冲区，只分配一次内存。ASCII 块使用 SSE2 整块展开或压缩。
+
+#include "basic_string.h"
+#include "exceptdef.h"
+#include "stringfwd.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define EASYSTL_UTF_SSE2 1
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define EASYSTL_UTF_AVX2 1
+#endif
+
+namespace easystl {
+
+/*
+ * 标量实现
+ * */
+
+/**
+ *  @brief  逐个字符校验 UTF-8，拒绝过长编码、代理区码点和大于 U+10FFFF 的码点
+ */
+inline bool utf8_validate_scalar(const unsigned char *p,
+                                 const unsigned char *end) noexcept {
+    while (p != end) {
+        // 一次跳过 8 个 ASCII 字符
+        if (end - p >= 8) {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            if ((v & 0x8080808080808080u) == 0) {
+                p += 8;
+                continue;
+            }
+        }
+        const unsigned c = *p;
+        if (c < 0x80) {
+            ++p;
+        } else if (c < 0xC2) {
+            return false;
+        } else if (c < 0xE0) {
+            if (end - p < 2 || (p[1] & 0xC0) != 0x80) {
+                return false;
+            }
+            p += 2;
+        } else if (c < 0xF0) {
+            if (end - p < 3) {
+                return false;
+            }
+            const unsigned c1 = p[1];
+            if (c == 0xE0   ? (c1 < 0xA0 || c1 > 0xBF)
+                : c == 0xED ? (c1 < 0x80 || c1 > 0x9F)
+                            : (c1 & 0xC0) != 0x80) {
+                return false;
+            }
+            if ((p[2] & 0xC0) != 0x80) {
+                return false;
+            }
+            p += 3;
+        } else if (c < 0xF5) {
+            if (end - p < 4) {
+                return false;
+            }
+            const unsigned c1 = p[1];
+            if (c == 0xF0   ? (c1 < 0x90 || c1 > 0xBF)
+                : c == 0xF4 ? (c1 < 0x80 || c1 > 0x8F)
+                            : (c1 & 0xC0) != 0x80) {
+                return false;
+            }
+            if ((p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80) {
+                return false;
+            }
+            p += 4;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef EASYSTL_UTF_AVX2
+
+/*
+ * AVX2 实现
+ * */
+
+// 每个字节右移 4 位
+__attribute__((target("avx2"))) inline __m256i
+utf8_avx2_high_nibble(__m256i v) {
+    return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+}
+
+// 返回 input 之前第 N 个字节组成的向量，跨越上一块的末尾
+template <int N>
+__attribute__((target("avx2"))) inline __m256i utf8_avx2_prev(__m256i input,
+                                                              __m256i prev) {
+    return _mm256_alignr_epi8(
+        input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+/**
+ *  @brief  检查一个 32 字节块中的所有 UTF-8 序列
+ *  @return  有错误的位置不为零
+ *
+ *  用前一个字节的高、低 4 位和当前字节的高 4 位分别查表，三个结果按位与后不
+ *  为零即为两字节之间的非法组合；再用前第 2、3 个字节检查三、四字节序列的后
+ *  续字节是否为延续字节。
+ */
+__attribute__((target("avx2"))) inline __m256i
+utf8_avx2_check_block(__m256i input, __m256i prev_input) {
+    // 每一位代表一类错误
+    const char too_short = 1 << 0;  // 11______ 0_______ 或 11______ 11______
+    const char too_long = 1 << 1;   // 0_______ 10______
+    const char overlong_3 = 1 << 2; // 11100000 100_____
+    const char too_large = 1 << 3;  // 11110100 1001____ 等
+    const char surrogate = 1 << 4;  // 11101101 101_____
+    const char overlong_2 = 1 << 5; // 1100000_ 10______
+    const char too_large_1000 = 1 << 6; // 11110101 1000____ 等
+    const char overlong_4 = 1 << 6;     // 11110000 1000____
+    const char two_conts = static_cast<char>(1 << 7); // 10______ 10______
+    const char carry = too_short | too_long | two_conts;
+
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        too_long, two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2, too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4,
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        too_long, two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2, too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4);
+    const char l0 = carry | overlong_3 | overlong_2 | overlong_4;
+    const char l1 = carry | overlong_2;
+    const char l4 = carry | too_large;
+    const char lx = carry | too_large | too_large_1000;
+    const char ld = carry | too_large | too_large_1000 | surrogate;
+    const __m256i byte_1_low_table =
+        _mm256_setr_epi8(l0, l1, carry, carry, l4, lx, lx, lx, lx, lx, lx, lx,
+                         lx, ld, lx, lx, l0, l1, carry, carry, l4, lx, lx, lx,
+                         lx, lx, lx, lx, lx, ld, lx, lx);
+    const char h8 = too_long | overlong_2 | two_conts | overlong_3 |
+                    too_large_1000 | overlong_4;
+    const char h9 = too_long | overlong_2 | two_conts | overlong_3 | too_large;
+    const char hab = too_long | overlong_2 | two_conts | surrogate | too_large;
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+        too_short, too_short, too_short, too_short, too_short, too_short,
+        too_short, too_short, h8, h9, hab, hab, too_short, too_short,
+        too_short, too_short, too_short, too_short, too_short, too_short,
+        too_short, too_short, too_short, too_short, h8, h9, hab, hab,
+        too_short, too_short, too_short, too_short);
+
+    const __m256i prev1 = utf8_avx2_prev<1>(input, prev_input);
+    const __m256i byte_1_high = _mm256_shuffle_epi8(
+        byte_1_high_table, utf8_avx2_high_nibble(prev1));
+    const __m256i byte_1_low = _mm256_shuffle_epi8(
+        byte_1_low_table, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    const __m256i byte_2_high = _mm256_shuffle_epi8(
+        byte_2_high_table, utf8_avx2_high_nibble(input));
+    const __m256i special = _mm256_and_si256(
+        _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // 前第 2 个字节为 111_____ 或前第 3 个字节为 1111____ 时当前字节必须是延续
+    // 字节，这种情况下 special 恰好为 two_conts
+    const __m256i prev2 = utf8_avx2_prev<2>(input, prev_input);
+    const __m256i prev3 = utf8_avx2_prev<3>(input, prev_input);
+    const __m256i is_third = _mm256_subs_epu8(
+        prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m256i is_fourth = _mm256_subs_epu8(
+        prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m256i must23 =
+        _mm256_and_si256(_mm256_or_si256(is_third, is_fourth),
+                         _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must23, special);
+}
+
+// 块的末尾是否有未结束的多字节序列
+__attribute__((target("avx2"))) inline __m256i
+utf8_avx2_incomplete(__m256i input) {
+    const __m256i max_value = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1),
+        static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    return _mm256_subs_epu8(input, max_value);
+}
+
+__attribute__((target("avx2"))) inline bool
+utf8_validate_avx2(const unsigned char *p, std::size_t n) {
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i input =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        if (_mm256_movemask_epi8(input) == 0) {
+            // 全部是 ASCII，只需确认上一块没有未结束的序列
+            error = _mm256_or_si256(error, prev_incomplete);
+        } else {
+            error = _mm256_or_si256(error,
+                                    utf8_avx2_check_block(input, prev_input));
+            prev_incomplete = utf8_avx2_incomplete(input);
+        }
+        prev_input = input;
+    }
+    // 剩余的字节补零后作为最后一块处理，零是 ASCII，未结束的序列会被发现
+    unsigned char tail[32] = {0};
+    std::memcpy(tail, p + i, n - i);
+    const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail));
+    error = _mm256_or_si256(error, utf8_avx2_check_block(input, prev_input));
+    error = _mm256_or_si256(error, utf8_avx2_incomplete(input));
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+// 非延续字节的数量，以及四字节序列首字节的数量
+__attribute__((target("avx2,popcnt"))) inline void
+utf8_avx2_count(const unsigned char *p, std::size_t n, std::size_t &chars,
+                std::size_t &quads) {
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i input =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        // 有符号比较：延续字节 0x80 ~ 0xBF 即 -128 ~ -65
+        const unsigned lead = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_cmpgt_epi8(input, _mm256_set1_epi8(-65))));
+        const unsigned four = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(
+                _mm256_max_epu8(input,
+                                _mm256_set1_epi8(static_cast<char>(0xF0))),
+                input)));
+        chars += static_cast<std::size_t>(__builtin_popcount(lead));
+        quads += static_cast<std::size_t>(__builtin_popcount(four));
+    }
+    for (; i < n; ++i) {
+        chars += static_cast<signed char>(p[i]) > -65;
+        quads += p[i] >= 0xF0;
+    }
+}
+
+inline bool utf_cpu_has_avx2() {
+    static const bool has = __builtin_cpu_supports("avx2") != 0;
+    return has;
+}
+
+#endif // EASYSTL_UTF_AVX2
+
+/*
+ * UTF-8 校验
+ * */
+
+/**
+ *  @brief  判断 [s, s + n) 是否为合法的 UTF-8
+ *
+ *  与 Unicode 标准一致，过长编码、代理区码点（U+D800 ~ U+DFFF）以及大于
+ *  U+10FFFF 的码点都是非法的。
+ */
+inline bool utf8_validate(const char *s, std::size_t n) noexcept {
+    easystl_require_string_len(s, n);
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+#ifdef EASYSTL_UTF_AVX2
+    if (n >= 64 && utf_cpu_has_avx2()) {
+        return utf8_validate_avx2(p, n);
+    }
+#endif
+    return utf8_validate_scalar(p, p + n);
+}
+
+template <class CharTraits, class Allocator>
+inline bool
+utf8_validate(const basic_string<char, CharTraits, Allocator> &str) noexcept {
+    return easystl::utf8_validate(str.data(), str.size());
+}
+
+/*
+ * 输出长度
+ * */
+
+/**
+ *  @brief  合法 UTF-8 转换为 UTF-16 与 UTF-32 后的长度
+ *  @param  utf16  UTF-16 编码单元的数量
+ *  @param  utf32  码点的数量
+ */
+inline void utf8_count(const char *s, std::size_t n, std::size_t &utf16,
+                       std::size_t &utf32) noexcept {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+    std::size_t chars = 0;
+    std::size_t quads = 0;
+#ifdef EASYSTL_UTF_AVX2
+    if (n >= 64 && utf_cpu_has_avx2()) {
+        utf8_avx2_count(p, n, chars, quads);
+        utf16 = chars + quads;
+        utf32 = chars;
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        chars += static_cast<signed char>(p[i]) > -65;
+        quads += p[i] >= 0xF0;
+    }
+    // 四字节序列在 UTF-16 中为一对代理
+    utf16 = chars + quads;
+    utf32 = chars;
+}
+
+/**
+ *  @brief  UTF-16 转换为 UTF-8 后的长度
+ *  @return  遇到不成对的代理时返回 size_t(-1)
+ */
+inline std::size_t utf16_to_utf8_length(const char16_t *s,
+                                        std::size_t n) noexcept {
+    std::size_t len = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const unsigned c = s[i];
+        if (c < 0x80) {
+            len += 1;
+        } else if (c < 0x800) {
+            len += 2;
+        } else if (c < 0xD800 || c > 0xDFFF) {
+            len += 3;
+        } else if (c <= 0xDBFF && i + 1 < n && s[i + 1] >= 0xDC00 &&
+                   s[i + 1] <= 0xDFFF) {
+            len += 4;
+            ++i;
+        } else {
+            return static_cast<std::size_t>(-1);
+        }
+    }
+    return len;
+}
+
+/**
+ *  @brief  UTF-32 转换为 UTF-8 后的长度
+ *  @return  遇到代理区码点或大于 U+10FFFF 的值时返回 size_t(-1)
+ */
+inline std::size_t utf32_to_utf8_length(const char32_t *s,
+                                        std::size_t n) noexcept {
+    std::size_t len = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t c = s[i];
+        if (c < 0x80) {
+            len += 1;
+        } else if (c < 0x800) {
+            len += 2;
+        } else if (c < 0x10000) {
+            if (c >= 0xD800 && c <= 0xDFFF) {
+                return static_cast<std::size_t>(-1);
+            }
+            len += 3;
+        } else if (c <= 0x10FFFF) {
+            len += 4;
+        } else {
+            return static_cast<std::size_t>(-1);
+        }
+    }
+    return len;
+}
+
+/*
+ * 转换的核心循环，输入已经校验过，输出空间已经足够
+ * */
+
+// 解码一个码点，p 向后移动
+inline char32_t utf8_decode_one(const unsigned char *&p) noexcept {
+    const unsigned c = *p;
+    if (c < 0xE0) {
+        const char32_t cp = ((c & 0x1F) << 6) | (p[1] & 0x3F);
+        p += 2;
+        return cp;
+    }
+    if (c < 0xF0) {
+        const char32_t cp =
+            ((c & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        p += 3;
+        return cp;
+    }
+    const char32_t cp = ((c & 0x07) << 18) | ((p[1] & 0x3F) << 12) |
+                        ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+    p += 4;
+    return cp;
+}
+
+inline char16_t *utf8_to_utf16_unchecked(const unsigned char *p,
+                                         const unsigned char *end,
+                                         char16_t *out) noexcept {
+    while (p != end) {
+#ifdef EASYSTL_UTF_SSE2
+        if (end - p >= 16) {
+            const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            if (_mm_movemask_epi8(v) == 0) {
+                const __m128i zero = _mm_setzero_si128();
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                                 _mm_unpacklo_epi8(v, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8),
+                                 _mm_unpackhi_epi8(v, zero));
+                p += 16;
+                out += 16;
+                continue;
+            }
+        }
+#endif
+        if (*p < 0x80) {
+            *out++ = *p++;
+            continue;
+        }
+        const char32_t cp = utf8_decode_one(p);
+        if (cp < 0x10000) {
+            *out++ = static_cast<char16_t>(cp);
+        } else {
+            *out++ = static_cast<char16_t>(0xD7C0 + (cp >> 10));
+            *out++ = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+        }
+    }
+    return out;
+}
+
+inline char32_t *utf8_to_utf32_unchecked(const unsigned char *p,
+                                         const unsigned char *end,
+                                         char32_t *out) noexcept {
+    while (p != end) {
+#ifdef EASYSTL_UTF_SSE2
+        if (end - p >= 16) {
+            const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            if (_mm_movemask_epi8(v) == 0) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                __m128i *dst = reinterpret_cast<__m128i *>(out);
+                _mm_storeu_si128(dst, _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(hi, zero));
+                p += 16;
+                out += 16;
+                continue;
+            }
+        }
+#endif
+        if (*p < 0x80) {
+            *out++ = *p++;
+            continue;
+        }
+        *out++ = utf8_decode_one(p);
+    }
+    return out;
+}
+
+// 编码一个码点
+inline char *utf8_encode_one(char32_t cp, char *out) noexcept {
+    if (cp < 0x80) {
+        *out++ = static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (cp >> 6));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (cp >> 12));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (cp >> 18));
+        *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+inline char *utf16_to_utf8_unchecked(const char16_t *p, const char16_t *end,
+                                     char *out) noexcept {
+    while (p != end) {
+#ifdef EASYSTL_UTF_SSE2
+        if (end - p >= 8) {
+            const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const __m128i high = _mm_and_si128(
+                v, _mm_set1_epi16(static_cast<short>(0xFF80)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) ==
+                0xFFFF) {
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(out),
+                                 _mm_packus_epi16(v, v));
+                p += 8;
+                out += 8;
+                continue;
+            }
+        }
+#endif
+        const unsigned c = *p++;
+        if (c >= 0xD800 && c <= 0xDBFF) {
+            const char32_t cp =
+                0x10000 + ((c - 0xD800) << 10) + (static_cast<unsigned>(*p++) -
+                                                  0xDC00);
+            out = utf8_encode_one(cp, out);
+        } else {
+            out = utf8_encode_one(c, out);
+        }
+    }
+    return out;
+}
+
+inline char *utf32_to_utf8_unchecked(const char32_t *p, const char32_t *end,
+                                     char *out) noexcept {
+    while (p != end) {
+#ifdef EASYSTL_UTF_SSE2
+        if (end - p >= 8) {
+            const __m128i a =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const __m128i b =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 4));
+            const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+            const __m128i high =
+                _mm_or_si128(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) ==
+                0xFFFF) {
+                const __m128i words = _mm_packs_epi32(a, b);
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(out),
+                                 _mm_packus_epi16(words, words));
+                p += 8;
+                out += 8;
+                continue;
+            }
+        }
+#endif
+        out = utf8_encode_one(*p++, out);
+    }
+    return out;
+}
+
+/*
+ * 转换接口
+ * 输出追加到目标字符串的末尾；输入非法时返回 false，目标字符串保持不变
+ * */
+
+template <class CharTraits, class Allocator>
+bool utf8_to_utf16(const char *s, std::size_t n,
+                   basic_string<char16_t, CharTraits, Allocator> &out) {
+    if (!easystl::utf8_validate(s, n)) {
+        return false;
+    }
+    std::size_t len16 = 0;
+    std::size_t len32 = 0;
+    easystl::utf8_count(s, n, len16, len32);
+    const std::size_t old_size = out.size();
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+    out.resize_and_overwrite(old_size + len16,
+                             [=](char16_t *buf, std::size_t) {
+                                 return static_cast<std::size_t>(
+                                     utf8_to_utf16_unchecked(p, p + n,
+                                                             buf + old_size) -
+                                     buf);
+                             });
+    return true;
+}
+
+template <class CharTraits, class Allocator>
+bool utf8_to_utf32(const char *s, std::size_t n,
+                   basic_string<char32_t, CharTraits, Allocator> &out) {
+    if (!easystl::utf8_validate(s, n)) {
+        return false;
+    }
+    std::size_t len16 = 0;
+    std::size_t len32 = 0;
+    easystl::utf8_count(s, n, len16, len32);
+    const std::size_t old_size = out.size();
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+    out.resize_and_overwrite(old_size + len32,
+                             [=](char32_t *buf, std::size_t) {
+                                 return static_cast<std::size_t>(
+                                     utf8_to_utf32_unchecked(p, p + n,
+                                                             buf + old_size) -
+                                     buf);
+                             });
+    return true;
+}
+
+template <class CharTraits, class Allocator>
+bool utf16_to_utf8(const char16_t *s, std::size_t n,
+                   basic_string<char, CharTraits, Allocator> &out) {
+    const std::size_t len = easystl::utf16_to_utf8_length(s, n);
+    if (len == static_cast<std::size_t>(-1)) {
+        return false;
+    }
+    const std::size_t old_size = out.size();
+    out.resize_and_overwrite(old_size + len, [=](char *buf, std::size_t) {
+        return static_cast<std::size_t>(
+            utf16_to_utf8_unchecked(s, s + n, buf + old_size) - buf);
+    });
+    return true;
+}
+
+template <class CharTraits, class Allocator>
+bool utf32_to_utf8(const char32_t *s, std::size_t n,
+                   basic_string<char, CharTraits, Allocator> &out) {
+    const std::size_t len = easystl::utf32_to_utf8_length(s, n);
+    if (len == static_cast<std::size_t>(-1)) {
+        return false;
+    }
+    const std::size_t old_size = out.size();
+    out.resize_and_overwrite(old_size + len, [=](char *buf, std::size_t) {
+        return static_cast<std::size_t>(
+            utf32_to_utf8_unchecked(s, s + n, buf + old_size) - buf);
+    });
+    return true;
+}
+
+/**
+ *  @brief  将 UTF-8 字符串转换为 UTF-16 字符串
+ *  @throw  std::invalid_argument  输入不是合法的 UTF-8
+ */
+template <class CharTraits, class Allocator>
+u16string to_u16string(const basic_string<char, CharTraits, Allocator> &str) {
+    u16string result;
+    THROW_INVALID_ARGUMENT_IF(
+        !easystl::utf8_to_utf16(str.data(), str.size(), result),
+        "to_u16string: invalid UTF-8");
+    return result;
+}
+
+/**
+ *  @brief  将 UTF-8 字符串转换为 UTF-32 字符串
+ *  @throw  std::invalid_argument  输入不是合法的 UTF-8
+ */
+template <class CharTraits, class Allocator>
+u32string to_u32string(const basic_string<char, CharTraits, Allocator> &str) {
+    u32string result;
+    THROW_INVALID_ARGUMENT_IF(
+        !easystl::utf8_to_utf32(str.data(), str.size(), result),
+        "to_u32string: invalid UTF-8");
+    return result;
+}
+
+/**
+ *  @brief  将 UTF-16 字符串转换为 UTF-8 字符串
+ *  @throw  std::invalid_argument  输入含有不成对的代理
+ */
+template <class CharTraits, class Allocator>
+string to_utf8(const basic_string<char16_t, CharTraits, Allocator> &str) {
+    string result;
+    THROW_INVALID_ARGUMENT_IF(
+        !easystl::utf16_to_utf8(str.data(), str.size(), result),
+        "to_utf8: invalid UTF-16");
+    return result;
+}
+
+/**
+ *  @brief  将 UTF-32 字符串转换为 UTF-8 字符串
+ *  @throw  std::invalid_argument  输入含有代理区码点或大于 U+10FFFF 的值
+ */
+template <class CharTraits, class Allocator>
+string to_utf8(const basic_string<char32_t, CharTraits, Allocator> &str) {
+    string result;
+    THROW_INVALID_ARGUMENT_IF(
+        !easystl::utf32_to_utf8(str.data(), str.size(), result),
+        "to_utf8: invalid UTF-32");
+    return result;
+}
+
+} // namespace easystl
+
+#endif // !EASYSTL_UTF_H
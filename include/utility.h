@@ -1,30 +1,34 @@
 #ifndef EASYSTL_UTILITY_H
 #define EASYSTL_UTILITY_H
 
+#include "type_traits.h"
 #include <type_traits>
 
 namespace easystl {
 
 // move
 template <class T>
-typename std::remove_reference<T>::type &&move(T &&arg) noexcept {
+constexpr typename std::remove_reference<T>::type &&move(T &&arg) noexcept {
     return static_cast<typename std::remove_reference<T>::type &&>(arg);
 }
 
 // forward
 template <class T>
-T &&forward(typename std::remove_reference<T>::type &arg) noexcept {
+constexpr T &&forward(typename std::remove_reference<T>::type &arg) noexcept {
     return static_cast<T &&>(arg);
 }
 
 template <class T>
-T &&forward(typename std::remove_reference<T>::type &&arg) noexcept {
+constexpr T &&forward(typename std::remove_reference<T>::type &&arg) noexcept {
     static_assert(!std::is_lvalue_reference<T>::value, "bad forward");
     return static_cast<T &&>(arg);
 }
 
 // swap
-template <class Tp> void swap(Tp &lhs, Tp &rhs) {
+template <class Tp>
+EASYSTL_CONSTEXPR20 void
+swap(Tp &lhs, Tp &rhs) noexcept(std::is_nothrow_move_constructible<Tp>::value &&
+                                std::is_nothrow_move_assignable<Tp>::value) {
     auto tmp = easystl::move(lhs);
     lhs = easystl::move(rhs);
     rhs = easystl::move(tmp);
@@ -3,6 +3,7 @@
 
 #include "algo.h"
 #include "allocator.h"
+#include "construct.h"
 #include "exceptdef.h"
 #include "iterator.h"
 #include "memory.h"
@@ -217,6 +218,15 @@ template <class T> struct vector {
     iterator erase(const_iterator first, const_iterator last);
     void clear() { erase(begin(), end()); }
 
+    // erase_if() 删除所有满足 pred 的元素，返回删除的个数。用 remove_if 一次
+    // 移动完剩下的元素，不会像逐个 erase 那样每次移动后面的全部元素
+    template <class Predicate> size_type erase_if(Predicate pred) {
+        const iterator new_end = easystl::remove_if(begin_, end_, pred);
+        const auto n = static_cast<size_type>(end_ - new_end);
+        erase(new_end, end_);
+        return n;
+    }
+
     // resize / reverse
     void resize(size_type new_size) { return resize(new_size, value_type()); }
     void resize(size_type new_size, const value_type &value);
@@ -270,7 +280,7 @@ template <class T> vector<T> &vector<T>::operator=(const vector &rhs) {
             swap(tmp);
         } else if (size() >= len) {
             auto i = copy(rhs.begin(), rhs.end(), begin());
-            data_allocator::destroy(i, end_);
+            easystl::destroy(i, end_);
             end_ = begin_ + len;
         } else {
             copy(rhs.begin(), rhs.begin() + size(), begin_);
@@ -301,9 +311,9 @@ template <class T> void vector<T>::reserve(size_type n) {
             "n can not larger than max_size() in vector<T>::reserve(n)");
 
         const auto old_size = size();
-        auto tmp = data_allocator::allocate(n);
+        auto tmp = data_allocator().allocate(n);
         uninitialized_move(begin_, end_, tmp);
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        data_allocator().deallocate(begin_, cap_ - begin_);
         begin_ = tmp;
         end_ = tmp + old_size;
         cap_ = begin_ + n;
@@ -326,11 +336,11 @@ typename vector<T>::iterator vector<T>::emplace(const_iterator pos,
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = xpos - begin_;
     if (end_ != cap_ && xpos == end_) { // begin < pos = end < cap
-        data_allocator::construct(address_of(*end_), forward<Args>(args)...);
+        data_allocator().construct(address_of(*end_), forward<Args>(args)...);
         ++end_;
     } else if (end_ != cap_) { // begin < pos < end < cap
         auto new_end = end_;
-        data_allocator::construct(address_of(*end_), *(end_ - 1));
+        data_allocator().construct(address_of(*end_), *(end_ - 1));
         ++new_end;
         copy_backward(xpos, end_ - 1, end_);
         *xpos = value_type(forward<Args>(args)...);
@@ -346,7 +356,7 @@ template <class T>
 template <class... Args>
 void vector<T>::emplace_back(Args &&...args) {
     if (end_ < cap_) {
-        data_allocator::construct(address_of(*end_), forward<Args>(args)...);
+        data_allocator().construct(address_of(*end_), forward<Args>(args)...);
         ++end_;
     } else {
         reallocate_emplace(end_, forward<Args>(args)...);
@@ -356,7 +366,7 @@ void vector<T>::emplace_back(Args &&...args) {
 // push_back() 在尾部插入元素
 template <class T> void vector<T>::push_back(const value_type &value) {
     if (end_ != cap_) {
-        data_allocator::construct(address_of((*end_)), value);
+        data_allocator().construct(address_of((*end_)), value);
         ++end_;
     } else {
         reallocate_insert(end_, value);
@@ -366,7 +376,7 @@ template <class T> void vector<T>::push_back(const value_type &value) {
 // pop_back() 弹出尾部元素
 template <class T> void vector<T>::pop_back() {
     EASYSTL_DEBUG(!empty());
-    data_allocator::destroy(end_ - 1);
+    easystl::destroy(end_ - 1);
     --end_;
 }
 
@@ -378,11 +388,11 @@ typename vector<T>::iterator vector<T>::insert(const_iterator pos,
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = pos - begin_;
     if (end_ != cap_ && xpos == end_) {
-        data_allocator::construct(address_of(*end_), value);
+        data_allocator().construct(address_of(*end_), value);
         ++end_;
     } else if (end_ != cap_) {
         auto new_end = end_;
-        data_allocator::construct(address_of(*end_), *(end_ - 1));
+        data_allocator().construct(address_of(*end_), *(end_ - 1));
         ++new_end;
         auto value_copy = value;
         copy_backward(xpos, end_ - 1, end_);
@@ -400,7 +410,7 @@ typename vector<T>::iterator vector<T>::erase(const_iterator pos) {
     EASYSTL_DEBUG(pos >= begin() && pos < end());
     iterator xpos = begin_ + (pos - begin());
     move(xpos + 1, end_, xpos);
-    data_allocator::destroy(end_ - 1);
+    easystl::destroy(end_ - 1);
     --end_;
     return xpos;
 }
@@ -412,7 +422,7 @@ typename vector<T>::iterator vector<T>::erase(const_iterator first,
     EASYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
     const auto n = first - begin();
     iterator r = begin_ + (first - begin());
-    data_allocator::destroy(move(r + (last - first), end_, r), end_);
+    easystl::destroy(move(r + (last - first), end_, r), end_);
     end_ = end_ - (last - first);
     return begin_ + n;
 }
@@ -441,7 +451,7 @@ template <class T> void vector<T>::swap(vector<T> &rhs) noexcept {
 // try_init() 分配失败则忽略，不抛出异常
 template <class T> void vector<T>::try_init() noexcept {
     try {
-        begin_ = data_allocator::allocate(16);
+        begin_ = data_allocator().allocate(16);
         end_ = begin_;
         cap_ = begin_ + 16;
     } catch (...) {
@@ -454,7 +464,7 @@ template <class T> void vector<T>::try_init() noexcept {
 // init_space() 分配 cap 大小的空间，失败则抛出异常
 template <class T> void vector<T>::init_space(size_type size, size_type cap) {
     try {
-        begin_ = data_allocator::allocate(cap);
+        begin_ = data_allocator().allocate(cap);
         end_ = begin_ + size;
         cap_ = begin_ + cap;
     } catch (...) {
@@ -488,8 +498,8 @@ void vector<T>::range_init(Iter first, Iter last) {
 template <class T>
 void vector<T>::destroy_and_recover(iterator first, iterator last,
                                     size_type n) {
-    data_allocator::destroy(first, last);
-    data_allocator::deallocate(first, n);
+    easystl::destroy(first, last);
+    data_allocator().deallocate(first, n);
 }
 
 // get_new_cap() 容量将要满时确定扩容大小
@@ -548,7 +558,7 @@ void vector<T>::copy_assign(FIter first, FIter last, forward_iterator_tag) {
         swap(tmp);
     } else if (size() >= len) {
         auto new_end = copy(first, last, begin_);
-        data_allocator::destroy(new_end, end_);
+        easystl::destroy(new_end, end_);
         end_ = new_end;
     } else {
         auto mid = first;
@@ -564,15 +574,15 @@ template <class T>
 template <class... Args>
 void vector<T>::reallocate_emplace(iterator pos, Args &&...args) {
     const auto new_size = get_new_cap(1);
-    auto new_begin = data_allocator::allocate(new_size);
+    auto new_begin = data_allocator().allocate(new_size);
     auto new_end = new_begin;
     try {
         new_end = uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(address_of(*new_end), forward<Args>(args)...);
+        data_allocator().construct(address_of(*new_end), forward<Args>(args)...);
         ++new_end;
         new_end = uninitialized_move(pos, end_, new_end);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        data_allocator().deallocate(new_begin, new_size);
         throw;
     }
     destroy_and_recover(begin_, end_, cap_ - begin_);
@@ -585,16 +595,16 @@ void vector<T>::reallocate_emplace(iterator pos, Args &&...args) {
 template <class T>
 void vector<T>::reallocate_insert(iterator pos, const value_type &value) {
     const auto new_size = get_new_cap(1);
-    auto new_begin = data_allocator::allocate(new_size);
+    auto new_begin = data_allocator().allocate(new_size);
     auto new_end = new_begin;
     const value_type &value_copy = value;
     try {
         new_end = uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(address_of(*new_end), value_copy);
+        data_allocator().construct(address_of(*new_end), value_copy);
         ++new_end;
         new_end = uninitialized_move(pos, end_, new_end);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        data_allocator().deallocate(new_begin, new_size);
         throw;
     }
     destroy_and_recover(begin_, end_, cap_ - begin_);
@@ -629,7 +639,7 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n,
         }
     } else {
         const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator::allocate(new_size);
+        auto new_begin = data_allocator().allocate(new_size);
         auto new_end = new_begin;
         try {
             new_end = uninitialized_move(begin_, pos, new_begin);
@@ -639,7 +649,7 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n,
             destroy_and_recover(new_begin, new_end, new_size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        data_allocator().deallocate(begin_, cap_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = begin_ + new_size;
@@ -673,7 +683,7 @@ void vector<T>::copy_insert(iterator pos, IIter first, IIter last) {
         }
     } else {
         const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator::allocate(new_size);
+        auto new_begin = data_allocator().allocate(new_size);
         auto new_end = new_begin;
         try {
             new_end = uninitialized_move(begin_, pos, new_begin);
@@ -683,7 +693,7 @@ void vector<T>::copy_insert(iterator pos, IIter first, IIter last) {
             destroy_and_recover(new_begin, new_end, new_size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        data_allocator().deallocate(begin_, cap_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = begin_ + new_size;
@@ -692,14 +702,14 @@ void vector<T>::copy_insert(iterator pos, IIter first, IIter last) {
 
 // reinsert
 template <class T> void vector<T>::reinsert(size_type size) {
-    auto new_begin = data_allocator::allocate(size);
+    auto new_begin = data_allocator().allocate(size);
     try {
         uninitialized_move(begin_, end_, new_begin);
     } catch (...) {
-        data_allocator::deallocate(new_begin, size);
+        data_allocator().deallocate(new_begin, size);
         throw;
     }
-    data_allocator::deallocate(begin_, cap_ - begin_);
+    data_allocator().deallocate(begin_, cap_ - begin_);
     begin_ = new_begin;
     end_ = new_begin + size;
     cap_ = begin_ + size;
@@ -733,7 +743,9 @@ template <class T> bool operator>=(const vector<T> &lhs, const vector<T> &rhs) {
 }
 
 // 重载 mystl 的 swap
-template <class T> void swap(vector<T> &lhs, vector<T> &rhs) { lhs.swap(rhs); }
+template <class T> void swap(vector<T> &lhs, vector<T> &rhs) noexcept {
+    lhs.swap(rhs);
+}
 
 } // namespace easystl
 
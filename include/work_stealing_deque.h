@@ -0,0 +1,181 @@
+#ifndef EASYSTL_WORK_STEALING_DEQUE_H
+#define EASYSTL_WORK_STEALING_DEQUE_H
+
+// Chase-Lev 工作窃取双端队列
+//
+// 只有拥有者线程可以调用 push 与 take，在底部进行后进先出的操作；任意线程
+// 可以调用 steal，从顶部取走最早放入的元素。拥有者的操作在没有竞争时不加锁，
+// 只有队列中剩最后一个元素时才与窃取者竞争一次 CAS。
+//
+// 实现按照 Lê 等人的 "Correct and Efficient Work-Stealing for Weak Memory
+// Models"（PPoPP 2013），为了能被 ThreadSanitizer 检查，用 seq_cst 的原子
+// 操作代替了独立的内存栅栏。
+//
+// 元素必须是可以放在 std::atomic 中的平凡类型，通常是指针。环形数组写满时
+// 扩容为两倍，旧数组可能仍在被窃取者读取，保留到队列销毁时再释放。
+
+#include "allocator.h"
+#include "construct.h"
+#include "vector.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace easystl {
+
+template <class T> class work_stealing_deque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "work_stealing_deque requires a trivially copyable type");
+
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+  private:
+    struct ring {
+        std::int64_t mask;
+        std::atomic<T> *slots;
+
+        T get(std::int64_t i) const noexcept {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+        void put(std::int64_t i, T x) noexcept {
+            slots[i & mask].store(x, std::memory_order_relaxed);
+        }
+    };
+
+    typedef easystl::allocator<ring> ring_allocator;
+    typedef easystl::allocator<std::atomic<T>> slot_allocator;
+
+    // top 由窃取者修改，bottom 只由拥有者修改，用填充分开放在不同的缓存行
+    std::atomic<std::int64_t> M_top;
+    char M_pad[64 - sizeof(std::atomic<std::int64_t>)];
+    std::atomic<std::int64_t> M_bottom;
+    std::atomic<ring *> M_ring;
+    // 扩容后替换下来的数组
+    vector<ring *> M_retired;
+
+  public:
+    /**
+     *  @brief  创建容量为 @a capacity 的空队列，capacity 向上取为 2 的幂
+     */
+    explicit work_stealing_deque(size_type capacity = 256)
+        : M_top(0), M_bottom(0), M_ring(nullptr) {
+        size_type n = 1;
+        while (n < capacity) {
+            n *= 2;
+        }
+        M_ring.store(S_make_ring(n), std::memory_order_relaxed);
+    }
+
+    work_stealing_deque(const work_stealing_deque &) = delete;
+    work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+    ~work_stealing_deque() {
+        S_free_ring(M_ring.load(std::memory_order_relaxed));
+        for (ring *r : M_retired) {
+            S_free_ring(r);
+        }
+    }
+
+    /**
+     *  @brief  队列中的元素个数，其他线程同时操作时只是一个近似值
+     */
+    size_type size() const noexcept {
+        const std::int64_t b = M_bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = M_top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     *  @brief  放入底部，只能由拥有者调用
+     */
+    void push(T x) {
+        const std::int64_t b = M_bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = M_top.load(std::memory_order_acquire);
+        ring *r = M_ring.load(std::memory_order_relaxed);
+        if (b - t > r->mask) {
+            r = M_grow(r, t, b);
+        }
+        r->put(b, x);
+        M_bottom.store(b + 1, std::memory_order_seq_cst);
+    }
+
+    /**
+     *  @brief  从底部取出最后放入的元素，只能由拥有者调用
+     *  @return  队列为空时返回 false
+     */
+    bool take(T &x) noexcept {
+        const std::int64_t b = M_bottom.load(std::memory_order_relaxed) - 1;
+        ring *r = M_ring.load(std::memory_order_relaxed);
+        M_bottom.store(b, std::memory_order_seq_cst);
+        std::int64_t t = M_top.load(std::memory_order_seq_cst);
+        if (t > b) {
+            M_bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        x = r->get(b);
+        if (t == b) {
+            // 最后一个元素，与窃取者竞争
+            const bool won = M_top.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst,
+                std::memory_order_relaxed);
+            M_bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     *  @brief  从顶部取出最早放入的元素，可以由任意线程调用
+     *  @return  队列为空或者与其他线程竞争失败时返回 false
+     */
+    bool steal(T &x) noexcept {
+        std::int64_t t = M_top.load(std::memory_order_seq_cst);
+        const std::int64_t b = M_bottom.load(std::memory_order_seq_cst);
+        if (t >= b) {
+            return false;
+        }
+        ring *r = M_ring.load(std::memory_order_acquire);
+        x = r->get(t);
+        return M_top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed);
+    }
+
+  private:
+    static ring *S_make_ring(size_type n) {
+        slot_allocator slots;
+        ring_allocator rings;
+        ring *r = rings.allocate(1);
+        r->mask = static_cast<std::int64_t>(n) - 1;
+        r->slots = slots.allocate(n);
+        for (size_type i = 0; i < n; ++i) {
+            easystl::construct(r->slots + i, T());
+        }
+        return r;
+    }
+
+    static void S_free_ring(ring *r) noexcept {
+        slot_allocator().deallocate(r->slots,
+                                    static_cast<size_type>(r->mask + 1));
+        ring_allocator().deallocate(r, 1);
+    }
+
+    ring *M_grow(ring *old, std::int64_t t, std::int64_t b) {
+        ring *r = S_make_ring(static_cast<size_type>(old->mask + 1) * 2);
+        for (std::int64_t i = t; i < b; ++i) {
+            r->put(i, old->get(i));
+        }
+        M_retired.push_back(old);
+        M_ring.store(r, std::memory_order_release);
+        return r;
+    }
+};
+
+} // namespace easystl
+
+#endif // !EASYSTL_WORK_STEALING_DEQUE_H
@@ -0,0 +1,472 @@
+#include "algo.h"
+#include "functional.h"
+#include "heap_algo.h"
+#include "utility.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace algo_test {
+
+// 各种容易让快速排序退化的输入
+std::vector<int> make_input(int pattern, int n) {
+    std::mt19937 gen(12345u + static_cast<unsigned>(n));
+    std::vector<int> v(static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        switch (pattern) {
+        case 0: v[i] = static_cast<int>(gen()); break;        // 随机
+        case 1: v[i] = i; break;                              // 升序
+        case 2: v[i] = n - i; break;                          // 降序
+        case 3: v[i] = static_cast<int>(gen() % 4); break;    // 大量重复
+        case 4: v[i] = i < n / 2 ? i : n - i; break;          // 先升后降
+        case 5: v[i] = i % 2 ? i : n - i; break;              // 交错
+        default: v[i] = 7; break;                             // 全部相同
+        }
+    }
+    if (pattern == 1 && n > 10) {
+        // 几乎有序
+        std::swap(v[n / 3], v[n / 2]);
+    }
+    return v;
+}
+
+const int kSizes[] = {0, 1, 2, 3, 23, 24, 25, 100, 129, 1000, 5000, 100000};
+
+TEST(AlgoSortTest, Patterns) {
+    for (int pattern = 0; pattern < 7; ++pattern) {
+        for (int n : kSizes) {
+            std::vector<int> v = make_input(pattern, n);
+            std::vector<int> expected = v;
+            std::sort(expected.begin(), expected.end());
+            easystl::sort(v.data(), v.data() + v.size());
+            ASSERT_EQ(v, expected) << "pattern " << pattern << " n " << n;
+        }
+    }
+}
+
+TEST(AlgoSortTest, Comparators) {
+    std::vector<int> v = make_input(0, 10000);
+    std::vector<int> expected = v;
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    std::vector<int> w = v;
+    easystl::sort(w.data(), w.data() + w.size(), easystl::greater<int>());
+    EXPECT_EQ(w, expected);
+    // 非默认比较函数走有分支的分区
+    w = v;
+    easystl::sort(w.data(), w.data() + w.size(),
+                  [](int a, int b) { return a > b; });
+    EXPECT_EQ(w, expected);
+
+    std::vector<double> d(3000);
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i] = static_cast<double>((i * 7919) % 3001) / 7.0;
+    }
+    std::vector<double> de = d;
+    std::sort(de.begin(), de.end());
+    easystl::sort(d.data(), d.data() + d.size());
+    EXPECT_EQ(d, de);
+}
+
+TEST(AlgoSortTest, NonTrivialType) {
+    std::vector<std::string> v;
+    for (int i = 0; i < 2000; ++i) {
+        v.push_back(std::to_string((i * 7919) % 2003));
+    }
+    std::vector<std::string> expected = v;
+    std::sort(expected.begin(), expected.end());
+    easystl::sort(v.data(), v.data() + v.size());
+    EXPECT_EQ(v, expected);
+}
+
+TEST(AlgoSortTest, StableSort) {
+    for (int n : kSizes) {
+        // first 为键，second 记录原始位置
+        std::mt19937 gen(static_cast<unsigned>(n));
+        std::vector<easystl::pair<int, int>> v;
+        for (int i = 0; i < n; ++i) {
+            v.push_back(easystl::make_pair(static_cast<int>(gen() % 16), i));
+        }
+        auto by_key = [](const easystl::pair<int, int> &a,
+                         const easystl::pair<int, int> &b) {
+            return a.first < b.first;
+        };
+        easystl::stable_sort(v.data(), v.data() + v.size(), by_key);
+        for (int i = 1; i < n; ++i) {
+            ASSERT_LE(v[i - 1].first, v[i].first);
+            if (v[i - 1].first == v[i].first) {
+                ASSERT_LT(v[i - 1].second, v[i].second);
+            }
+        }
+    }
+    for (int pattern = 0; pattern < 7; ++pattern) {
+        std::vector<int> v = make_input(pattern, 5000);
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+        easystl::stable_sort(v.data(), v.data() + v.size());
+        ASSERT_EQ(v, expected) << "pattern " << pattern;
+    }
+}
+
+TEST(AlgoSortTest, StableSortThrowingComparator) {
+    // 比较第 k 次时抛出异常：缓冲区被释放，所有元素仍在原区间中
+    std::vector<std::string> v;
+    for (int i = 0; i < 500; ++i) {
+        v.push_back(std::to_string((i * 7919) % 503) + std::string(20, 'x'));
+    }
+    std::vector<std::string> sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    // 前 4492 次比较在插入排序中，其后是各轮合并
+    for (int k : {1, 100, 3000, 4600, 5000, 5500, 6000, 6400}) {
+        std::vector<std::string> w = v;
+        int calls = 0;
+        auto throwing = [&calls, k](const std::string &a,
+                                    const std::string &b) {
+            if (++calls == k) {
+                throw std::runtime_error("comp");
+            }
+            return a < b;
+        };
+        bool thrown = false;
+        try {
+            easystl::stable_sort(w.data(), w.data() + w.size(), throwing);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown) << k;
+        std::sort(w.begin(), w.end());
+        ASSERT_EQ(w, sorted) << k;
+    }
+}
+
+TEST(AlgoSortTest, PartialSort) {
+    std::vector<int> v = make_input(0, 1000);
+    std::vector<int> expected = v;
+    std::sort(expected.begin(), expected.end());
+    for (std::size_t k : {0u, 1u, 10u, 500u, 1000u}) {
+        std::vector<int> w = v;
+        easystl::partial_sort(w.data(), w.data() + k, w.data() + w.size());
+        EXPECT_TRUE(std::equal(w.begin(), w.begin() + k, expected.begin()));
+        std::sort(w.begin() + k, w.end());
+        std::sort(w.begin(), w.end());
+        EXPECT_EQ(w, expected);
+    }
+}
+
+TEST(AlgoSortTest, HeapAlgorithms) {
+    int a[64];
+    for (int i = 0; i < 64; ++i) {
+        a[i] = (i * 37) % 64;
+    }
+    easystl::make_heap(a, a + 32);
+    EXPECT_TRUE(std::is_heap(a, a + 32));
+    for (int i = 33; i <= 64; ++i) {
+        easystl::push_heap(a, a + i);
+        ASSERT_TRUE(std::is_heap(a, a + i));
+    }
+    easystl::pop_heap(a, a + 64);
+    EXPECT_EQ(a[63], 63);
+    EXPECT_TRUE(std::is_heap(a, a + 63));
+    easystl::sort_heap(a, a + 63);
+    for (int i = 0; i < 63; ++i) {
+        EXPECT_EQ(a[i], i);
+    }
+}
+
+template <class T> void check_reverse() {
+    for (int n : {0, 1, 2, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 1001}) {
+        std::vector<T> v(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            v[i] = static_cast<T>(i * 37 + 11);
+        }
+        std::vector<T> expected(v.rbegin(), v.rend());
+        easystl::reverse(v.data(), v.data() + v.size());
+        ASSERT_EQ(v, expected) << "sizeof " << sizeof(T) << " n " << n;
+    }
+}
+
+struct rgb {
+    unsigned char r, g, b;
+    bool operator==(const rgb &o) const {
+        return r == o.r && g == o.g && b == o.b;
+    }
+};
+
+TEST(AlgoReverseTest, Reverse) {
+    check_reverse<unsigned char>();
+    check_reverse<short>();
+    check_reverse<float>();
+    check_reverse<std::uint64_t>();
+
+    // 3 字节的类型与非 trivial 的类型逐个交换
+    std::vector<rgb> c(100);
+    for (int i = 0; i < 100; ++i) {
+        c[i] = rgb{static_cast<unsigned char>(i), 0, 1};
+    }
+    std::vector<rgb> expected_c(c.rbegin(), c.rend());
+    easystl::reverse(c.data(), c.data() + c.size());
+    EXPECT_EQ(c, expected_c);
+
+    std::vector<std::string> s;
+    for (int i = 0; i < 50; ++i) {
+        s.push_back(std::to_string(i));
+    }
+    std::vector<std::string> expected_s(s.rbegin(), s.rend());
+    easystl::reverse(s.data(), s.data() + s.size());
+    EXPECT_EQ(s, expected_s);
+}
+
+struct forward_iter : easystl::iterator<easystl::forward_iterator_tag, int> {
+    int *p;
+    explicit forward_iter(int *x) : p(x) {}
+    int &operator*() const { return *p; }
+    forward_iter &operator++() {
+        ++p;
+        return *this;
+    }
+    forward_iter operator++(int) {
+        forward_iter t = *this;
+        ++p;
+        return t;
+    }
+    bool operator==(const forward_iter &o) const { return p == o.p; }
+    bool operator!=(const forward_iter &o) const { return p != o.p; }
+};
+
+TEST(AlgoRotateTest, Rotate) {
+    for (int n : {0, 1, 2, 7, 100, 1000, 5000}) {
+        for (int k : {0, 1, 3, n / 3, n / 2, n - 1, n}) {
+            if (k < 0 || k > n) {
+                continue;
+            }
+            std::vector<int> v(static_cast<std::size_t>(n));
+            for (int i = 0; i < n; ++i) {
+                v[i] = i;
+            }
+            std::vector<int> expected = v;
+            std::rotate(expected.begin(), expected.begin() + k,
+                        expected.end());
+
+            std::vector<int> w = v;
+            int *r = easystl::rotate(w.data(), w.data() + k, w.data() + n);
+            ASSERT_EQ(w, expected) << "n " << n << " k " << k;
+            EXPECT_EQ(r, w.data() + (n - k));
+
+            w = v;
+            forward_iter fr = easystl::rotate(forward_iter(w.data()),
+                                              forward_iter(w.data() + k),
+                                              forward_iter(w.data() + n));
+            ASSERT_EQ(w, expected) << "n " << n << " k " << k;
+            EXPECT_EQ(fr.p, w.data() + (n - k));
+        }
+    }
+
+    // 非 trivial 的类型使用块交换
+    std::vector<std::string> s;
+    for (int i = 0; i < 300; ++i) {
+        s.push_back(std::to_string(i));
+    }
+    std::vector<std::string> expected = s;
+    std::rotate(expected.begin(), expected.begin() + 110, expected.end());
+    easystl::rotate(s.data(), s.data() + 110, s.data() + s.size());
+    EXPECT_EQ(s, expected);
+}
+
+template <class T> void check_remove_unique() {
+    std::mt19937 gen(7);
+    for (int n : {0, 1, 2, 7, 8, 9, 31, 33, 100, 1000, 5003}) {
+        std::vector<T> v(static_cast<std::size_t>(n));
+        for (auto &x : v) {
+            // 取值范围小，有大量相邻的重复元素与要删除的元素
+            x = static_cast<T>(gen() % 4);
+        }
+        const T value = static_cast<T>(1);
+        auto odd = [](const T &x) { return static_cast<long long>(x) % 2; };
+
+        std::vector<T> w = v;
+        std::vector<T> expected = v;
+        T *r = easystl::remove(w.data(), w.data() + w.size(), value);
+        expected.erase(std::remove(expected.begin(), expected.end(), value),
+                       expected.end());
+        ASSERT_EQ(std::vector<T>(w.data(), r), expected) << "n " << n;
+
+        w = v;
+        expected = v;
+        r = easystl::remove_if(w.data(), w.data() + w.size(), odd);
+        expected.erase(std::remove_if(expected.begin(), expected.end(), odd),
+                       expected.end());
+        ASSERT_EQ(std::vector<T>(w.data(), r), expected) << "n " << n;
+
+        w = v;
+        expected = v;
+        r = easystl::unique(w.data(), w.data() + w.size());
+        expected.erase(std::unique(expected.begin(), expected.end()),
+                       expected.end());
+        ASSERT_EQ(std::vector<T>(w.data(), r), expected) << "n " << n;
+
+        w = v;
+        expected = v;
+        r = easystl::stable_partition(w.data(), w.data() + w.size(), odd);
+        std::stable_partition(expected.begin(), expected.end(), odd);
+        ASSERT_EQ(w, expected) << "n " << n;
+        EXPECT_EQ(r - w.data(), std::count_if(v.begin(), v.end(), odd));
+    }
+}
+
+TEST(AlgoRemoveTest, RemoveUnique) {
+    check_remove_unique<int>();
+    check_remove_unique<unsigned>();
+    check_remove_unique<std::int64_t>();
+    check_remove_unique<float>();
+    check_remove_unique<double>();
+    check_remove_unique<unsigned char>();
+    check_remove_unique<short>();
+
+    // 非 trivial 的类型与自定义的相等判断
+    std::vector<std::string> s = {"a", "b", "b", "c", "a", "a", "b"};
+    auto end = easystl::remove(s.begin(), s.end(), std::string("a"));
+    EXPECT_EQ(std::vector<std::string>(s.begin(), end),
+              (std::vector<std::string>{"b", "b", "c", "b"}));
+    s = {"x", "xy", "y", "yz", "yzw", "z"};
+    end = easystl::unique(s.begin(), s.end(),
+                          [](const std::string &a, const std::string &b) {
+                              return a[0] == b[0];
+                          });
+    EXPECT_EQ(std::vector<std::string>(s.begin(), end),
+              (std::vector<std::string>{"x", "y", "z"}));
+
+    // 浮点数：NaN 不等于自身，+0.0 等于 -0.0
+    std::vector<double> d = {std::nan(""), std::nan(""), 0.0, -0.0, 1.0};
+    d.resize(40, 2.0);
+    EXPECT_EQ(easystl::unique(d.data(), d.data() + d.size()) - d.data(), 5);
+    std::vector<double> z = {1.0, 0.0, -0.0, 2.0};
+    z.resize(40, 0.0);
+    EXPECT_EQ(easystl::remove(z.data(), z.data() + z.size(), 0.0) - z.data(),
+              2);
+}
+
+TEST(AlgoRemoveTest, Partition) {
+    auto even = [](int x) { return x % 2 == 0; };
+    for (int n : {0, 1, 2, 3, 10, 100, 1001}) {
+        std::vector<int> v(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            v[i] = (i * 7919) % 1000;
+        }
+        const auto evens = std::count_if(v.begin(), v.end(), even);
+
+        std::vector<int> w = v;
+        int *r = easystl::partition(w.data(), w.data() + n, even);
+        EXPECT_EQ(r - w.data(), evens);
+        EXPECT_TRUE(std::is_partitioned(w.begin(), w.end(), even));
+        EXPECT_TRUE(std::is_permutation(w.begin(), w.end(), v.begin()));
+
+        w = v;
+        forward_iter fr = easystl::partition(forward_iter(w.data()),
+                                             forward_iter(w.data() + n),
+                                             even);
+        EXPECT_EQ(fr.p - w.data(), evens);
+        EXPECT_TRUE(std::is_partitioned(w.begin(), w.end(), even));
+        EXPECT_TRUE(std::is_permutation(w.begin(), w.end(), v.begin()));
+    }
+
+    // stable_partition 保持两部分的相对顺序，非 trivial 的类型使用缓冲区
+    std::vector<std::string> s;
+    for (int i = 0; i < 300; ++i) {
+        s.push_back(std::to_string(i));
+    }
+    std::vector<std::string> expected = s;
+    auto short_str = [](const std::string &x) { return x.size() < 3; };
+    std::stable_partition(expected.begin(), expected.end(), short_str);
+    auto mid = easystl::stable_partition(s.begin(), s.end(), short_str);
+    EXPECT_EQ(s, expected);
+    EXPECT_EQ(mid - s.begin(), 100);
+
+    // pred 抛出异常时缓冲区被释放，移走的元素放回原区间，不丢失元素
+    int calls = 0;
+    auto throwing = [&calls](const std::string &x) {
+        if (++calls == 150) {
+            throw std::runtime_error("pred");
+        }
+        return x.size() < 3;
+    };
+    std::vector<std::string> sorted = s;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_THROW(easystl::stable_partition(s.begin(), s.end(), throwing),
+                 std::runtime_error);
+    std::sort(s.begin(), s.end());
+    EXPECT_EQ(s, sorted);
+    std::vector<int> ints(1000);
+    for (int i = 0; i < 1000; ++i) {
+        ints[static_cast<std::size_t>(i)] = i;
+    }
+    calls = 0;
+    auto throwing_int = [&calls](int x) {
+        if (++calls == 700) {
+            throw std::runtime_error("pred");
+        }
+        return x % 3 == 0;
+    };
+    EXPECT_THROW(easystl::stable_partition(ints.data(),
+                                           ints.data() + ints.size(),
+                                           throwing_int),
+                 std::runtime_error);
+    std::sort(ints.begin(), ints.end());
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(ints[static_cast<std::size_t>(i)], i);
+    }
+}
+
+TEST(AlgoSearchTest, BinarySearch) {
+    // 大量重复的元素，覆盖预取的阈值两侧
+    for (int n : {0, 1, 2, 3, 10, 1000, 40000}) {
+        std::vector<int> v(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            v[i] = i / 3 * 2;
+        }
+        const int *first = v.data();
+        const int *last = v.data() + v.size();
+        for (int x = -1; x <= n; ++x) {
+            ASSERT_EQ(easystl::lower_bound(first, last, x),
+                      std::lower_bound(first, last, x))
+                << "n " << n << " x " << x;
+            ASSERT_EQ(easystl::upper_bound(first, last, x),
+                      std::upper_bound(first, last, x));
+            ASSERT_EQ(easystl::binary_search(first, last, x),
+                      std::binary_search(first, last, x));
+            const auto r = easystl::equal_range(first, last, x);
+            const auto e = std::equal_range(first, last, x);
+            ASSERT_EQ(r.first, e.first);
+            ASSERT_EQ(r.second, e.second);
+        }
+    }
+
+    std::vector<int> v = {9, 7, 7, 5, 3, 1};
+    int *lo = easystl::lower_bound(v.data(), v.data() + v.size(), 7,
+                                   easystl::greater<int>());
+    EXPECT_EQ(lo, v.data() + 1);
+    EXPECT_EQ(easystl::upper_bound(v.data(), v.data() + v.size(), 7,
+                                   easystl::greater<int>()),
+              v.data() + 3);
+
+    // 前向迭代器
+    std::vector<int> w = {1, 2, 2, 2, 5, 8};
+    forward_iter f = easystl::lower_bound(forward_iter(w.data()),
+                                          forward_iter(w.data() + w.size()), 2);
+    EXPECT_EQ(f.p, w.data() + 1);
+    f = easystl::upper_bound(forward_iter(w.data()),
+                             forward_iter(w.data() + w.size()), 2);
+    EXPECT_EQ(f.p, w.data() + 4);
+    EXPECT_FALSE(easystl::binary_search(forward_iter(w.data()),
+                                        forward_iter(w.data() + w.size()), 3));
+
+    // 元素与 value 的类型不同时不做转换
+    std::vector<long long> big = {1, 1LL << 40, 1LL << 41};
+    EXPECT_EQ(easystl::lower_bound(big.data(), big.data() + big.size(), 2),
+              big.data() + 1);
+}
+
+} // namespace algo_test
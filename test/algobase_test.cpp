@@ -0,0 +1,293 @@
+#include "algobase.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace algobase_test {
+
+// 在每个长度、每个位置放一个不同的元素，与 std 的结果比较
+template <class Tp> void check_compare_all_positions(Tp low, Tp high) {
+    for (std::size_t len = 0; len <= 70; ++len) {
+        std::vector<Tp> a(len, low);
+        EXPECT_TRUE(easystl::equal(a.data(), a.data() + len, a.data()));
+        EXPECT_FALSE(easystl::lexicographical_compare(
+            a.data(), a.data() + len, a.data(), a.data() + len));
+        for (std::size_t pos = 0; pos < len; ++pos) {
+            std::vector<Tp> b(a);
+            b[pos] = high;
+            const Tp *pa = a.data();
+            const Tp *pb = b.data();
+            EXPECT_FALSE(easystl::equal(pa, pa + len, pb)) << len << " " << pos;
+            EXPECT_TRUE(easystl::lexicographical_compare(pa, pa + len, pb,
+                                                         pb + len))
+                << len << " " << pos;
+            EXPECT_FALSE(easystl::lexicographical_compare(pb, pb + len, pa,
+                                                          pa + len))
+                << len << " " << pos;
+        }
+    }
+}
+
+TEST(AlgobaseCompareTest, IntegralAllPositions) {
+    check_compare_all_positions<int>(1, 2);
+    check_compare_all_positions<std::uint64_t>(0x100, 0x200);
+    check_compare_all_positions<std::int16_t>(-5, 3);
+    check_compare_all_positions<signed char>(-1, 1);
+}
+
+TEST(AlgobaseCompareTest, SignedElementsCompareByValue) {
+    // 按字节比较时 -1 (0xFF...) 大于 1，逐元素比较时应当小于 1
+    const int a[] = {0, -1};
+    const int b[] = {0, 1};
+    EXPECT_TRUE(easystl::lexicographical_compare(a, a + 2, b, b + 2));
+    EXPECT_FALSE(easystl::lexicographical_compare(b, b + 2, a, a + 2));
+
+    // 低位字节相同、高位字节不同
+    const std::uint32_t c[] = {0x01000000u};
+    const std::uint32_t d[] = {0x000000ffu};
+    EXPECT_FALSE(easystl::lexicographical_compare(c, c + 1, d, d + 1));
+    EXPECT_TRUE(easystl::lexicographical_compare(d, d + 1, c, c + 1));
+}
+
+TEST(AlgobaseCompareTest, DifferentLengths) {
+    const long a[] = {1, 2, 3};
+    const long b[] = {1, 2, 3, 4};
+    EXPECT_TRUE(easystl::lexicographical_compare(a, a + 3, b, b + 4));
+    EXPECT_FALSE(easystl::lexicographical_compare(b, b + 4, a, a + 3));
+    EXPECT_TRUE(easystl::lexicographical_compare(a, a, b, b + 1));
+    EXPECT_FALSE(easystl::lexicographical_compare(a, a + 1, b, b));
+
+    const unsigned char x[] = {1, 2, 200};
+    const unsigned char y[] = {1, 2, 100, 0};
+    EXPECT_FALSE(easystl::lexicographical_compare(x, x + 3, y, y + 4));
+    EXPECT_TRUE(easystl::lexicographical_compare(y, y + 4, x, x + 3));
+}
+
+TEST(AlgobaseCompareTest, RandomAgainstStd) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> value(-3, 3);
+    std::uniform_int_distribution<int> length(0, 40);
+    for (int round = 0; round < 2000; ++round) {
+        std::vector<int> a(length(gen));
+        std::vector<int> b(length(gen));
+        for (auto &v : a) {
+            v = value(gen);
+        }
+        for (std::size_t i = 0; i < b.size(); ++i) {
+            b[i] = i < a.size() && value(gen) != 0 ? a[i] : value(gen);
+        }
+        const int *pa = a.data();
+        const int *pb = b.data();
+        EXPECT_EQ(easystl::lexicographical_compare(pa, pa + a.size(), pb,
+                                                   pb + b.size()),
+                  std::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                               b.end()));
+        if (a.size() <= b.size()) {
+            EXPECT_EQ(easystl::equal(pa, pa + a.size(), pb),
+                      std::equal(a.begin(), a.end(), b.begin()));
+        }
+    }
+}
+
+enum class color { red, green, blue };
+
+TEST(AlgobaseCompareTest, EnumsPointersAndFloats) {
+    const color a[] = {color::red, color::green, color::blue};
+    color b[] = {color::red, color::green, color::blue};
+    EXPECT_TRUE(easystl::equal(a, a + 3, b));
+    b[2] = color::red;
+    EXPECT_FALSE(easystl::equal(a, a + 3, b));
+
+    int x = 0, y = 0;
+    int *p[] = {&x, &y};
+    int *q[] = {&x, &y};
+    EXPECT_TRUE(easystl::equal(p, p + 2, q));
+
+    // 浮点数仍然逐个比较：+0.0 与 -0.0 相等，NaN 与自身不等
+    const double d1[] = {0.0, 1.0};
+    const double d2[] = {-0.0, 1.0};
+    EXPECT_TRUE(easystl::equal(d1, d1 + 2, d2));
+    const double nan[] = {std::numeric_limits<double>::quiet_NaN()};
+    EXPECT_FALSE(easystl::equal(nan, nan + 1, nan));
+}
+
+typedef easystl::string::iterator string_iter;
+typedef easystl::string::const_iterator string_citer;
+static_assert(easystl::is_contiguous_iterator<int *>::value, "");
+static_assert(easystl::is_contiguous_iterator<string_iter>::value, "");
+static_assert(easystl::is_contiguous_iterator<string_citer>::value, "");
+static_assert(
+    !easystl::is_contiguous_iterator<easystl::string::reverse_iterator>::value,
+    "");
+static_assert(std::is_same<decltype(easystl::niter_base(string_iter())),
+                           char *>::value,
+              "normal_iterator unwraps to a pointer");
+
+TEST(AlgobaseContiguousTest, NormalIterator) {
+    easystl::string s("abcdefghij");
+    easystl::string d(10, '.');
+    string_iter r = easystl::copy(s.cbegin(), s.cbegin() + 4, d.begin() + 2);
+    EXPECT_EQ(r, d.begin() + 6);
+    EXPECT_EQ(d, "..abcd....");
+
+    r = easystl::copy_backward(s.begin(), s.begin() + 3, d.end());
+    EXPECT_EQ(r, d.end() - 3);
+    EXPECT_EQ(d, "..abcd.abc");
+
+    // 重叠区间
+    r = easystl::move(d.begin() + 2, d.end(), d.begin());
+    EXPECT_EQ(r, d.end() - 2);
+    EXPECT_EQ(d, "abcd.abcbc");
+    r = easystl::move_backward(d.begin(), d.begin() + 4, d.begin() + 6);
+    EXPECT_EQ(r, d.begin() + 2);
+    EXPECT_EQ(d, "ababcdbcbc");
+
+    easystl::fill(d.begin() + 1, d.begin() + 3, 'x');
+    EXPECT_EQ(d, "axxbcdbcbc");
+    r = easystl::fill_n(d.begin(), 2, 'y');
+    EXPECT_EQ(r, d.begin() + 2);
+    EXPECT_EQ(d, "yyxbcdbcbc");
+
+    EXPECT_TRUE(easystl::equal(d.cbegin() + 4, d.cbegin() + 6, s.cbegin() + 2));
+    EXPECT_FALSE(easystl::equal(d.begin(), d.end(), s.begin()));
+}
+
+TEST(AlgobaseContiguousTest, LexicographicalCompare) {
+    const easystl::string a("abcdefghijklmnopqrstuvwxyz0123456789");
+    easystl::string b(a);
+    EXPECT_FALSE(easystl::lexicographical_compare(a.begin(), a.end(),
+                                                  b.cbegin(), b.cend()));
+    b[30] = '9';
+    EXPECT_TRUE(easystl::lexicographical_compare(a.cbegin(), a.cend(),
+                                                 b.begin(), b.end()));
+    EXPECT_FALSE(easystl::lexicographical_compare(b.begin(), b.end(),
+                                                  a.begin(), a.end()));
+    EXPECT_TRUE(easystl::lexicographical_compare(a.begin(), a.begin() + 30,
+                                                 a.begin(), a.end()));
+    // char 为有符号类型时 '\x80' 小于 'a'，与逐元素比较的结果一致
+    const easystl::string hi("ab\x80");
+    const easystl::string lo("aba");
+    EXPECT_EQ(easystl::lexicographical_compare(hi.begin(), hi.end(),
+                                               lo.begin(), lo.end()),
+              std::lexicographical_compare(hi.data(), hi.data() + 3,
+                                           lo.data(), lo.data() + 3));
+    EXPECT_TRUE(easystl::lexicographical_compare(a.rbegin(), a.rend(),
+                                                 b.rbegin(), b.rend()));
+}
+
+TEST(AlgobaseContiguousTest, ReverseIterator) {
+    easystl::string s("abcdef");
+    easystl::string d(6, '.');
+    // 反向复制：d 的末尾依次写入 s 的末尾
+    auto r = easystl::copy(s.rbegin(), s.rbegin() + 3, d.rbegin());
+    EXPECT_EQ(r, d.rbegin() + 3);
+    EXPECT_EQ(d, "...def");
+
+    r = easystl::copy_backward(s.rbegin(), s.rbegin() + 2, d.rend());
+    EXPECT_EQ(r, d.rend() - 2);
+    EXPECT_EQ(d, "ef.def");
+
+    // 同一个字符串内重叠的反向移动
+    int a[] = {1, 2, 3, 4, 5, 6};
+    typedef easystl::reverse_iterator<int *> rev;
+    easystl::move(rev(a + 4), rev(a), rev(a + 6));
+    EXPECT_EQ(a[2], 1);
+    EXPECT_EQ(a[3], 2);
+    EXPECT_EQ(a[4], 3);
+    EXPECT_EQ(a[5], 4);
+}
+
+struct rgb {
+    unsigned char r, g, b;
+};
+
+struct quad {
+    std::uint32_t v[4];
+};
+
+struct triple {
+    std::uint32_t v[3];
+};
+
+// 在 [1, len + 1) 填充，检查两侧的哨兵没有被改写
+template <class Tp, class Eq>
+void check_fill(const Tp &guard, const Tp &value, Eq eq) {
+    for (std::size_t len = 0; len <= 150; ++len) {
+        std::vector<Tp> buf(len + 2, guard);
+        Tp *r = easystl::fill_n(buf.data() + 1, len, value);
+        EXPECT_EQ(r, buf.data() + 1 + len);
+        EXPECT_TRUE(eq(buf[0], guard)) << len;
+        EXPECT_TRUE(eq(buf[len + 1], guard)) << len;
+        for (std::size_t i = 1; i <= len; ++i) {
+            ASSERT_TRUE(eq(buf[i], value)) << len << " " << i;
+        }
+    }
+}
+
+template <class Tp> bool bytes_equal(const Tp &a, const Tp &b) {
+    return std::memcmp(&a, &b, sizeof(Tp)) == 0;
+}
+
+TEST(AlgobaseFillTest, PatternSizes) {
+    auto eq = [](double a, double b) { return bytes_equal(a, b); };
+    check_fill<std::uint16_t>(7, 0xABCD, std::equal_to<std::uint16_t>());
+    check_fill<int>(7, -2, std::equal_to<int>());
+    check_fill<int>(7, 0, std::equal_to<int>());
+    check_fill<std::uint64_t>(7, 0x0102030405060708ull,
+                              std::equal_to<std::uint64_t>());
+    check_fill<double>(1.0, -0.0, eq);
+    check_fill<char>('.', 'x', std::equal_to<char>());
+    check_fill(quad{{9, 9, 9, 9}}, quad{{1, 2, 3, 4}}, bytes_equal<quad>);
+    check_fill(triple{{9, 9, 9}}, triple{{1, 2, 3}}, bytes_equal<triple>);
+    check_fill(rgb{0, 0, 0}, rgb{1, 2, 3}, bytes_equal<rgb>);
+    check_fill(rgb{1, 1, 1}, rgb{0, 0, 0}, bytes_equal<rgb>);
+}
+
+TEST(AlgobaseFillTest, ConvertedValue) {
+    // value 先转换为元素类型
+    long a[40];
+    easystl::fill(a, a + 40, 5);
+    for (long v : a) {
+        EXPECT_EQ(v, 5);
+    }
+    unsigned char b[100];
+    easystl::fill_n(b, 100, 0x1ff);
+    for (unsigned char v : b) {
+        EXPECT_EQ(v, 0xff);
+    }
+    bool c[100] = {};
+    easystl::fill_n(c, 100, 2);
+    for (bool v : c) {
+        EXPECT_TRUE(v);
+    }
+}
+
+TEST(AlgobaseFillTest, NonTemporal) {
+    // 超过阈值、起点不按 16 字节对齐
+    const std::size_t n = EASYSTL_FILL_NONTEMPORAL_THRESHOLD / 2 + 37;
+    std::vector<std::uint16_t> buf(n + 3, 1);
+    easystl::fill(buf.data() + 1, buf.data() + n + 1, std::uint16_t(0x1234));
+    EXPECT_EQ(buf[0], 1);
+    EXPECT_EQ(buf[n + 1], 1);
+    EXPECT_EQ(buf[n + 2], 1);
+    for (std::size_t i = 1; i <= n; ++i) {
+        ASSERT_EQ(buf[i], 0x1234) << i;
+    }
+
+    std::vector<std::uint64_t> big(EASYSTL_FILL_NONTEMPORAL_THRESHOLD / 8 + 3,
+                                   0);
+    easystl::fill_n(big.data() + 1, big.size() - 2, 0x1122334455667788ull);
+    EXPECT_EQ(big.front(), 0u);
+    EXPECT_EQ(big.back(), 0u);
+    for (std::size_t i = 1; i + 1 < big.size(); ++i) {
+        ASSERT_EQ(big[i], 0x1122334455667788ull) << i;
+    }
+}
+
+} // namespace algobase_test
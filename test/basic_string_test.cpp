@@ -1,11 +1,17 @@
 #include "char_traits.h"
+#include "hashed_string.h"
 #include "stringfwd.h"
 #include "utility.h"
 #include "gtest/gtest.h"
+#include <cfloat>
 #include <climits>
+#include <clocale>
+#include <cmath>
 #include <cstring>
 #include <initializer_list>
 #include <list>
+#include <set>
+#include <sstream>
 #include <string>
 
 // 1. basic_string()
@@ -2841,3 +2847,538 @@ TEST(BasicStringOperatorPlusTest, StrConcatMoveStr) {
 }
 
 } // namespace operator_plus_test
+
+namespace numeric_conversion_test {
+TEST(BasicStringResizeAndOverwriteTest, KeepsPrefix) {
+    easystl::string str("abc");
+    str.resize_and_overwrite(100, [](char *p, std::size_t n) {
+        EXPECT_EQ(std::memcmp(p, "abc", 3), 0);
+        std::memset(p + 3, 'x', n - 3);
+        return std::size_t(10);
+    });
+    EXPECT_EQ(str, "abcxxxxxxx");
+    EXPECT_GE(str.capacity(), 100);
+}
+TEST(BasicStringToStringTest, Integers) {
+    EXPECT_EQ(easystl::to_string(0), "0");
+    EXPECT_EQ(easystl::to_string(-7), "-7");
+    EXPECT_EQ(easystl::to_string(1234567890u), "1234567890");
+    EXPECT_EQ(easystl::to_string(INT_MIN), "-2147483648");
+    EXPECT_EQ(easystl::to_string(LLONG_MIN), "-9223372036854775808");
+    EXPECT_EQ(easystl::to_string(ULLONG_MAX), "18446744073709551615");
+    for (long long v = 1; v > 0 && v < LLONG_MAX / 3; v = v * 3 + 1) {
+        EXPECT_EQ(easystl::to_string(v), std::to_string(v).c_str());
+        EXPECT_EQ(easystl::to_string(-v), std::to_string(-v).c_str());
+    }
+}
+TEST(BasicStringToStringTest, ShortestFloatingPoint) {
+    EXPECT_EQ(easystl::to_string(0.0), "0");
+    EXPECT_EQ(easystl::to_string(-0.0), "-0");
+    EXPECT_EQ(easystl::to_string(0.1), "0.1");
+    EXPECT_EQ(easystl::to_string(1.5f), "1.5");
+    EXPECT_EQ(easystl::to_string(0.3f), "0.3");
+    EXPECT_EQ(easystl::to_string(100.0), "100");
+    EXPECT_EQ(easystl::to_string(123456.0), "123456");
+    EXPECT_EQ(easystl::to_string(33554448.0f), "33554448");
+    EXPECT_EQ(easystl::to_string(1e300), "1e+300");
+    EXPECT_EQ(easystl::to_string(1.25e-7), "1.25e-07");
+    EXPECT_EQ(easystl::to_string(0.001), "0.001");
+    EXPECT_EQ(easystl::to_string(5e-324), "5e-324");
+    EXPECT_EQ(easystl::to_string(1.7976931348623157e308),
+              "1.7976931348623157e+308");
+    EXPECT_EQ(easystl::to_string(std::numeric_limits<double>::infinity()),
+              "inf");
+    EXPECT_EQ(easystl::to_string(-std::numeric_limits<float>::infinity()),
+              "-inf");
+    EXPECT_EQ(easystl::to_string(std::numeric_limits<double>::quiet_NaN()),
+              "nan");
+}
+TEST(BasicStringAppendNumberTest, AppendsInPlace) {
+    easystl::string str("cpu=");
+    easystl::append_number(str, 42);
+    str.append(",load=");
+    easystl::append_number(str, 0.75);
+    str.append(",t=");
+    easystl::append_number(str, -1234567890123LL);
+    EXPECT_EQ(str, "cpu=42,load=0.75,t=-1234567890123");
+}
+TEST(BasicStringStoiTest, ParsesLikeStrtol) {
+    std::size_t idx = 0;
+    EXPECT_EQ(easystl::stoi(easystl::string("  -42abc"), &idx), -42);
+    EXPECT_EQ(idx, 5);
+    EXPECT_EQ(easystl::stoi(easystl::string("+17")), 17);
+    EXPECT_EQ(easystl::stoi(easystl::string("ff"), nullptr, 16), 255);
+    EXPECT_EQ(easystl::stoi(easystl::string("0x1A"), nullptr, 0), 26);
+    EXPECT_EQ(easystl::stoi(easystl::string("017"), nullptr, 0), 15);
+    EXPECT_EQ(easystl::stoi(easystl::string("0x"), &idx, 16), 0);
+    EXPECT_EQ(idx, 1);
+    EXPECT_EQ(easystl::stoi(easystl::string("-2147483648")), INT_MIN);
+    EXPECT_EQ(easystl::stoll(easystl::string("123456789012345678")),
+              123456789012345678LL);
+    EXPECT_EQ(easystl::stoull(easystl::string("18446744073709551615")),
+              ULLONG_MAX);
+    EXPECT_EQ(easystl::stoul(easystl::string("-1")), ULONG_MAX);
+    EXPECT_THROW(easystl::stoi(easystl::string("abc")), std::invalid_argument);
+    EXPECT_THROW(easystl::stoi(easystl::string("")), std::invalid_argument);
+    EXPECT_THROW(easystl::stoi(easystl::string("2147483648")),
+                 std::out_of_range);
+    EXPECT_THROW(easystl::stoull(easystl::string("18446744073709551616")),
+                 std::out_of_range);
+}
+TEST(BasicStringStodTest, ParsesFloatingPoint) {
+    std::size_t idx = 0;
+    EXPECT_EQ(easystl::stod(easystl::string(" 3.25e2xyz"), &idx), 325.0);
+    EXPECT_EQ(idx, 7);
+    EXPECT_EQ(easystl::stod(easystl::string("+0.1")), 0.1);
+    EXPECT_EQ(easystl::stod(easystl::string("-.5")), -0.5);
+    EXPECT_EQ(easystl::stof(easystl::string("1.17549435e-38")), FLT_MIN);
+    EXPECT_EQ(easystl::stod(easystl::string("2.2250738585072014e-308")),
+              DBL_MIN);
+    EXPECT_EQ(easystl::stod(easystl::string("123456789012345678901234567890")),
+              123456789012345678901234567890.0);
+    EXPECT_TRUE(std::isinf(easystl::stod(easystl::string("-Infinity"))));
+    EXPECT_TRUE(std::isnan(easystl::stod(easystl::string("nan"))));
+    EXPECT_THROW(easystl::stod(easystl::string(".")), std::invalid_argument);
+    EXPECT_THROW(easystl::stod(easystl::string("1e999")), std::out_of_range);
+    EXPECT_THROW(easystl::stof(easystl::string("1e39")), std::out_of_range);
+}
+TEST(BasicStringFromCharsTest, RoundTrip) {
+    char buf[32];
+    const double values[] = {0.1, 1.0 / 3, 6.02214076e23, 5e-324, 1e23,
+                             9007199254740993.0, 4.35, 1.7976931348623157e308};
+    for (double v : values) {
+        const easystl::to_chars_result r = easystl::to_chars(buf, buf + 32, v);
+        ASSERT_EQ(r.ec, std::errc());
+        double parsed = 0;
+        const easystl::from_chars_result p =
+            easystl::from_chars(buf, r.ptr, parsed);
+        EXPECT_EQ(p.ec, std::errc());
+        EXPECT_EQ(p.ptr, r.ptr);
+        EXPECT_EQ(parsed, v);
+    }
+    unsigned long long u = 0;
+    const char digits[] = "12345678901234567890";
+    EXPECT_EQ(easystl::from_chars(digits, digits + 19, u).ec, std::errc());
+    EXPECT_EQ(u, 1234567890123456789ULL);
+    EXPECT_EQ(easystl::from_chars(digits, digits + 20, u).ec, std::errc());
+    EXPECT_EQ(u, 12345678901234567890ULL);
+    const char big[] = "18446744073709551616";
+    EXPECT_EQ(easystl::from_chars(big, big + 20, u).ec,
+              std::errc::result_out_of_range);
+    unsigned v = 7;
+    const char neg[] = "-1";
+    EXPECT_EQ(easystl::from_chars(neg, neg + 2, v).ec,
+              std::errc::invalid_argument);
+    EXPECT_EQ(v, 7);
+    EXPECT_EQ(easystl::to_chars(buf, buf + 3, 1234).ec,
+              std::errc::value_too_large);
+    const easystl::to_chars_result r = easystl::to_chars(buf, buf + 32, 255, 16);
+    EXPECT_EQ(std::string(buf, r.ptr), "ff");
+}
+double parse_double(const char *s) {
+    double v = -1;
+    const easystl::from_chars_result r =
+        easystl::from_chars(s, s + std::strlen(s), v);
+    EXPECT_EQ(r.ec, std::errc()) << s;
+    EXPECT_EQ(r.ptr, s + std::strlen(s)) << s;
+    return v;
+}
+TEST(BasicStringFromCharsTest, SlowPathRoundsCorrectly) {
+    // 恰好位于 1 与下一个 double 正中间：舍入到偶数，多出的非零位则进位
+    const double next = std::nextafter(1.0, 2.0);
+    EXPECT_EQ(parse_double(
+                  "1.00000000000000011102230246251565404236316680908203125"),
+              1.0);
+    EXPECT_EQ(parse_double(
+                  "1.000000000000000111022302462515654042363166809082031251"),
+              next);
+    EXPECT_EQ(parse_double("1.0000000000000001110223024625156540423631668"
+                           "0908203125000000000000000000000000000000000000"
+                           "0000001"),
+              next);
+    EXPECT_EQ(parse_double("1.5e300"), 1.5e300);
+    EXPECT_EQ(parse_double("2.4703282292062328e-324"), 5e-324);
+    EXPECT_EQ(parse_double("2.2250738585072011e-308"),
+              std::nextafter(DBL_MIN, 0.0));
+    EXPECT_EQ(parse_double("1.7976931348623158e308"), DBL_MAX);
+    float f = 0;
+    const char flt_max[] = "3.4028235677973366e38";
+    EXPECT_EQ(easystl::from_chars(flt_max, flt_max + 21, f).ec, std::errc());
+    EXPECT_EQ(f, FLT_MAX);
+    const char tiny[] = "2.4703282292062327e-324";
+    double d = 7;
+    EXPECT_EQ(easystl::from_chars(tiny, tiny + 23, d).ec,
+              std::errc::result_out_of_range);
+    EXPECT_EQ(d, 7);
+}
+TEST(BasicStringFromCharsTest, IgnoresLocale) {
+    // 以逗号为小数点的 locale 下 strtod 会在 '.' 处停止；没有安装时退化为
+    // 在默认 locale 下检查
+    const char *const names[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8",
+                                 "fr_FR.utf8", "ru_RU.UTF-8", "de_DE"};
+    const std::string saved = std::setlocale(LC_NUMERIC, nullptr);
+    for (const char *name : names) {
+        if (std::setlocale(LC_NUMERIC, name) != nullptr) {
+            break;
+        }
+    }
+    EXPECT_EQ(parse_double("1.5e300"), 1.5e300);
+    EXPECT_EQ(parse_double("123456789012345678901.25"),
+              123456789012345678901.25);
+    EXPECT_EQ(parse_double("0.1e-310"), 0.1e-310);
+    std::setlocale(LC_NUMERIC, saved.c_str());
+}
+} // namespace numeric_conversion_test
+
+namespace stream_input_test {
+TEST(BasicStringGetlineTest, ReadsLines) {
+    std::istringstream is("first line\nsecond\n\nlast");
+    easystl::string line;
+    ASSERT_TRUE(easystl::getline(is, line));
+    EXPECT_EQ(line, "first line");
+    ASSERT_TRUE(easystl::getline(is, line));
+    EXPECT_EQ(line, "second");
+    ASSERT_TRUE(easystl::getline(is, line));
+    EXPECT_EQ(line, "");
+    ASSERT_TRUE(easystl::getline(is, line));
+    EXPECT_EQ(line, "last");
+    EXPECT_TRUE(is.eof());
+    EXPECT_FALSE(easystl::getline(is, line));
+    EXPECT_TRUE(is.fail());
+}
+TEST(BasicStringGetlineTest, CustomDelimiterAndReusedCapacity) {
+    std::istringstream is("a,bb,ccc");
+    easystl::string field;
+    field.reserve(64);
+    const std::size_t cap = field.capacity();
+    std::string joined;
+    while (easystl::getline(is, field, ',')) {
+        joined.append(field.data(), field.size());
+        joined += '|';
+    }
+    EXPECT_EQ(joined, "a|bb|ccc|");
+    EXPECT_EQ(field.capacity(), cap);
+}
+TEST(BasicStringGetlineTest, LongLinesAcrossBufferRefills) {
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text.append(static_cast<std::size_t>(i * 97 % 5000), 'x');
+        text += '\n';
+    }
+    std::istringstream is(text);
+    // 不带缓冲区的流逐字符读取，结果应与整块扫描一致
+    std::stringbuf unbuffered(text);
+    unbuffered.pubsetbuf(nullptr, 0);
+    std::istream is2(&unbuffered);
+    easystl::string line;
+    easystl::string line2;
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(easystl::getline(is, line));
+        ASSERT_TRUE(easystl::getline(is2, line2));
+        EXPECT_EQ(line.size(), static_cast<std::size_t>(i * 97 % 5000));
+        EXPECT_EQ(line, line2);
+    }
+    EXPECT_FALSE(easystl::getline(is, line));
+}
+TEST(BasicStringExtractTest, ReadsWords) {
+    std::istringstream is("  alpha\tbeta\n\n gamma  ");
+    easystl::string word;
+    ASSERT_TRUE(is >> word);
+    EXPECT_EQ(word, "alpha");
+    ASSERT_TRUE(is >> word);
+    EXPECT_EQ(word, "beta");
+    ASSERT_TRUE(is >> word);
+    EXPECT_EQ(word, "gamma");
+    EXPECT_FALSE(is >> word);
+    EXPECT_TRUE(is.eof());
+}
+TEST(BasicStringExtractTest, HonoursWidth) {
+    std::istringstream is("abcdefgh ij");
+    easystl::string word;
+    is.width(3);
+    ASSERT_TRUE(is >> word);
+    EXPECT_EQ(word, "abc");
+    EXPECT_EQ(is.width(), 0);
+    ASSERT_TRUE(is >> word);
+    EXPECT_EQ(word, "defgh");
+    ASSERT_TRUE(is >> word);
+    EXPECT_EQ(word, "ij");
+    EXPECT_TRUE(is.eof());
+}
+TEST(BasicStringExtractTest, WideStrings) {
+    std::wistringstream is(L"one two\nthree");
+    easystl::wstring s;
+    ASSERT_TRUE(is >> s);
+    EXPECT_TRUE(s == L"one");
+    ASSERT_TRUE(easystl::getline(is, s));
+    EXPECT_TRUE(s == L" two");
+}
+} // namespace stream_input_test
+
+namespace hash_test {
+TEST(BasicStringHashTest, EqualStringsHashEqual) {
+    easystl::hash<easystl::string> h;
+    EXPECT_EQ(h(easystl::string("hello")), h(easystl::string("hello")));
+    EXPECT_NE(h(easystl::string("hello")), h(easystl::string("hellp")));
+    EXPECT_NE(h(easystl::string("")), h(easystl::string(1, '\0')));
+    easystl::string long_str(1000, 'a');
+    const std::size_t before = h(long_str);
+    long_str[999] = 'b';
+    EXPECT_NE(h(long_str), before);
+}
+TEST(BasicStringHashTest, FewCollisionsAcrossLengths) {
+    // 覆盖 0-3、4-16、17-48 和大于 48 字节的各条路径
+    easystl::hash<easystl::string> h;
+    std::set<std::size_t> seen;
+    std::size_t count = 0;
+    for (int len = 0; len < 120; ++len) {
+        for (int i = 0; i < 50; ++i) {
+            easystl::string s(static_cast<std::size_t>(len), 'k');
+            if (len > 0) {
+                s[static_cast<std::size_t>(i % len)] =
+                    static_cast<char>('a' + i % 26);
+                s[static_cast<std::size_t>(len - 1)] =
+                    static_cast<char>('A' + i / 26);
+            }
+            seen.insert(h(s));
+            ++count;
+        }
+    }
+    std::set<std::string> distinct;
+    for (int len = 0; len < 120; ++len) {
+        for (int i = 0; i < 50; ++i) {
+            std::string s(static_cast<std::size_t>(len), 'k');
+            if (len > 0) {
+                s[static_cast<std::size_t>(i % len)] =
+                    static_cast<char>('a' + i % 26);
+                s[static_cast<std::size_t>(len - 1)] =
+                    static_cast<char>('A' + i / 26);
+            }
+            distinct.insert(s);
+        }
+    }
+    EXPECT_EQ(seen.size(), distinct.size());
+    EXPECT_GT(count, distinct.size() / 2);
+}
+TEST(BasicStringHashTest, SeededHashDependsOnSeed) {
+    const easystl::string key("attacker-chosen-key");
+    easystl::seeded_hash<easystl::string> h1(1);
+    easystl::seeded_hash<easystl::string> h2(2);
+    EXPECT_NE(h1(key), h2(key));
+    EXPECT_EQ(h1(key), easystl::seeded_hash<easystl::string>(1)(key));
+    easystl::seeded_hash<easystl::string> r1;
+    easystl::seeded_hash<easystl::string> r2;
+    EXPECT_EQ(r1.seed, easystl::hash_seed());
+    EXPECT_EQ(r1(key), r2(key));
+}
+TEST(BasicStringHashTest, HashedStringCachesHash) {
+    easystl::hashed_string a(easystl::string("metric.cpu.user"));
+    easystl::hashed_string b("metric.cpu.user");
+    easystl::hashed_string c("metric.cpu.sys");
+    EXPECT_EQ(a.hash(), easystl::hash<easystl::string>()(a.str()));
+    EXPECT_EQ(easystl::hash<easystl::hashed_string>()(a), a.hash());
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+    EXPECT_TRUE(c < a);
+    const easystl::string s = b.release();
+    EXPECT_EQ(s, "metric.cpu.user");
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(b.hash(), easystl::hashed_string().hash());
+}
+TEST(BasicStringHashTest, HashedStringWithSeededHash) {
+    typedef easystl::seeded_hash<easystl::string> seeded;
+    typedef easystl::basic_hashed_string<
+        char, easystl::char_traits<char>, easystl::allocator<char>, seeded>
+        seeded_string;
+    const easystl::string key("session-id");
+    seeded_string a(key, seeded(1));
+    seeded_string b(key, seeded(2));
+    seeded_string c(key);
+    EXPECT_NE(a.hash(), b.hash());
+    // 种子不同，哈希值不同，但内容相同
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a == c);
+    EXPECT_TRUE(a != seeded_string(easystl::string("other"), seeded(1)));
+    // release 之后仍使用构造时的种子
+    a.release();
+    EXPECT_EQ(a.hash(), seeded(1)(easystl::string()));
+    EXPECT_EQ(a.hash_function().seed, 1u);
+}
+} // namespace hash_test
+
+namespace ci_string_test {
+TEST(CiStringTest, CompareIgnoresAsciiCase) {
+    const easystl::ci_string a("Content-Length");
+    EXPECT_TRUE(a == "content-length");
+    EXPECT_TRUE(a == "CONTENT-LENGTH");
+    EXPECT_FALSE(a == "content-lengtx");
+    EXPECT_EQ(a.compare("CONTENT-LENGTH"), 0);
+    EXPECT_LT(a.compare("content-type"), 0);
+    EXPECT_GT(easystl::ci_string("Z").compare("a"), 0);
+    // '[' 位于 'Z' 与 'a' 之间，字母折叠为小写后比较
+    EXPECT_LT(easystl::ci_string("[").compare("Z"), 0);
+    EXPECT_TRUE(easystl::ci_string("Accept") < easystl::ci_string("b"));
+}
+TEST(CiStringTest, LongStringsUseBlockCompare) {
+    std::string lower;
+    std::string mixed;
+    for (int i = 0; i < 100; ++i) {
+        const char c = static_cast<char>('a' + i % 26);
+        lower += c;
+        mixed += (i % 3) ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    const easystl::ci_string a(lower.data(), lower.size());
+    easystl::ci_string b(mixed.data(), mixed.size());
+    EXPECT_TRUE(a == b);
+    for (std::size_t pos : {0u, 15u, 16u, 31u, 77u, 99u}) {
+        easystl::ci_string c(b);
+        c[pos] = '@';
+        EXPECT_FALSE(a == c) << pos;
+        EXPECT_GT(a.compare(c), 0) << pos;
+    }
+    // 非字母字符不被折叠
+    EXPECT_FALSE(easystl::ci_string(100, '@') == easystl::ci_string(100, '`'));
+}
+TEST(CiStringTest, FindIgnoresAsciiCase) {
+    const easystl::ci_string header(
+        "x-forwarded-for: 10.0.0.1; X-Request-ID: ABCDEF0123456789");
+    EXPECT_EQ(header.find("x-request-id"), 27);
+    EXPECT_EQ(header.find('F'), 2);
+    EXPECT_EQ(header.find("abcdef"), 41);
+    EXPECT_EQ(header.find(':'), 15);
+    EXPECT_EQ(header.find("missing"), easystl::ci_string::npos);
+    EXPECT_EQ(header.rfind('x'), 27);
+}
+TEST(CiStringTest, HashMatchesEquality) {
+    typedef easystl::basic_string_view<char, easystl::ci_char_traits<char>>
+        ci_string_view;
+    easystl::hash<easystl::ci_string> h;
+    easystl::seeded_hash<easystl::ci_string> sh(7);
+    EXPECT_EQ(h(easystl::ci_string("ABC")), h(easystl::ci_string("abc")));
+    EXPECT_EQ(sh(easystl::ci_string("ABC")), sh(easystl::ci_string("abc")));
+    EXPECT_NE(h(easystl::ci_string("abc")), h(easystl::ci_string("abd")));
+    EXPECT_EQ(h(easystl::ci_string()), h(easystl::ci_string("")));
+    // 跨过 64 个字符的分块边界
+    std::string lower;
+    std::string upper;
+    for (int i = 0; i < 200; ++i) {
+        lower += static_cast<char>('a' + i % 26);
+        upper += static_cast<char>('A' + i % 26);
+    }
+    for (std::size_t n : {63u, 64u, 65u, 128u, 200u}) {
+        const easystl::ci_string a(lower.data(), n);
+        const easystl::ci_string b(upper.data(), n);
+        ASSERT_TRUE(a == b);
+        EXPECT_EQ(h(a), h(b)) << n;
+        EXPECT_EQ(sh(a), sh(b)) << n;
+        EXPECT_EQ(easystl::hash<ci_string_view>()(ci_string_view(b.data(), n)),
+                  h(a))
+            << n;
+    }
+    EXPECT_NE(h(easystl::ci_string(lower.data(), 64)),
+              h(easystl::ci_string(lower.data(), 65)));
+}
+} // namespace ci_string_test
+
+namespace string_view_test {
+TEST(StringViewTest, ConvertWithBasicString) {
+    const easystl::string str("hello, world");
+    easystl::string_view sv = str;
+    EXPECT_EQ(sv.data(), str.data());
+    EXPECT_EQ(sv.size(), str.size());
+    EXPECT_TRUE(sv == "hello, world");
+    EXPECT_TRUE("hello, world" == sv);
+
+    const easystl::string copy(sv.substr(7));
+    EXPECT_EQ(std::strcmp(copy.c_str(), "world"), 0);
+    EXPECT_EQ(easystl::hash<easystl::string_view>()(sv),
+              easystl::hash<easystl::string>()(str));
+}
+TEST(StringViewTest, FindAndTrim) {
+    easystl::string_view sv("  key = value  ");
+    sv.remove_prefix(sv.find_first_not_of(" "));
+    sv.remove_suffix(sv.size() - 1 - sv.rfind('e'));
+    EXPECT_TRUE(sv == "key = value");
+    EXPECT_EQ(sv.find('='), 4u);
+    EXPECT_EQ(sv.find("value"), 6u);
+    EXPECT_EQ(sv.find("valuex"), easystl::string_view::npos);
+    EXPECT_EQ(sv.find_first_of("=v"), 4u);
+    EXPECT_TRUE(sv.starts_with("key"));
+    EXPECT_TRUE(sv.ends_with("value"));
+    EXPECT_FALSE(sv.ends_with("key"));
+    EXPECT_THROW(sv.substr(12), std::out_of_range);
+    EXPECT_TRUE(easystl::string_view("abc") < easystl::string_view("abd"));
+    EXPECT_TRUE(easystl::string_view() == "");
+}
+} // namespace string_view_test
+
+namespace replace_all_test {
+TEST(ReplaceAllTest, GrowingReplacement) {
+    easystl::string s("a<b>&c<");
+    s.replace_all("<", "&lt;");
+    EXPECT_STREQ(s.c_str(), "a&lt;b>&c&lt;");
+    EXPECT_EQ(s.size(), std::strlen("a&lt;b>&c&lt;"));
+
+    easystl::string big(1000, 'x');
+    big.replace_all("x", "yz");
+    EXPECT_EQ(big.size(), 2000u);
+    EXPECT_EQ(big.find("xy"), easystl::string::npos);
+}
+TEST(ReplaceAllTest, ShrinkingReplacementIsInPlace) {
+    easystl::string s("one&amp;two&amp;&amp;three and some padding text");
+    const char *data = s.data();
+    s.replace_all("&amp;", "&");
+    EXPECT_STREQ(s.c_str(), "one&two&&three and some padding text");
+    EXPECT_EQ(s.data(), data);
+
+    s.replace_all(" ", "");
+    EXPECT_STREQ(s.c_str(), "one&two&&threeandsomepaddingtext");
+    s.replace_all("missing", "x");
+    s.replace_all("", "x");
+    EXPECT_STREQ(s.c_str(), "one&two&&threeandsomepaddingtext");
+}
+TEST(ReplaceAllTest, NonOverlappingLeftToRight) {
+    easystl::string s("aaaa");
+    s.replace_all("aa", "b");
+    EXPECT_STREQ(s.c_str(), "bb");
+    easystl::string t("aaa");
+    t.replace_all("aa", "aaa");
+    EXPECT_STREQ(t.c_str(), "aaaa");
+}
+TEST(ReplaceAllTest, ArgumentsAliasingThis) {
+    easystl::string s("abcabc");
+    s.replace_all(easystl::string_view(s.data(), 3),
+                  easystl::string_view(s.data() + 1, 2));
+    EXPECT_STREQ(s.c_str(), "bcbc");
+    const easystl::string from("bc"), to("xyz");
+    s.replace_all(from, to);
+    EXPECT_STREQ(s.c_str(), "xyzxyz");
+}
+TEST(ReplaceEachTest, EscapeAndUnescapeHtml) {
+    easystl::string s("<a href=\"x\">Tom & Jerry</a>");
+    s.replace_each({{"&", "&amp;"},
+                    {"<", "&lt;"},
+                    {">", "&gt;"},
+                    {"\"", "&quot;"}});
+    EXPECT_STREQ(s.c_str(),
+                 "&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&lt;/a&gt;");
+    // 替换得到的字符不会再被匹配
+    s.replace_each({{"&lt;", "<"},
+                    {"&gt;", ">"},
+                    {"&quot;", "\""},
+                    {"&amp;", "&"}});
+    EXPECT_STREQ(s.c_str(), "<a href=\"x\">Tom & Jerry</a>");
+}
+TEST(ReplaceEachTest, FirstMatchingPairWins) {
+    easystl::string s("abcd");
+    s.replace_each({{"ab", "1"}, {"abc", "2"}, {"d", ""}, {"", "never"}});
+    EXPECT_STREQ(s.c_str(), "1c");
+    easystl::string t("unchanged");
+    t.replace_each({{"x", "y"}});
+    EXPECT_STREQ(t.c_str(), "unchanged");
+
+    easystl::ci_string ci("Hello HELLO hello");
+    ci.replace_each({{"hello", "bye"}});
+    EXPECT_TRUE(ci == "bye bye bye");
+}
+} // namespace replace_all_test
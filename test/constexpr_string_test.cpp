@@ -0,0 +1,86 @@
+#include "algobase.h"
+#include "basic_string.h"
+#include "char_traits.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+
+// 同一组函数在运行期执行；以 C++20 编译时再用 static_assert 在编译期执行一遍
+
+namespace constexpr_string_test {
+
+EASYSTL_CONSTEXPR20 bool short_string() {
+    easystl::string s("hello");
+    s.append(", world");
+    s.insert(0, "> ");
+    return s.size() == 14 && s.compare("> hello, world") == 0 &&
+           s.find("world") == 9 && s.rfind('o') == 10 && s[2] == 'h';
+}
+
+// 超过 SSO 缓冲区后在编译期申请堆内存，求值结束前由析构函数释放
+EASYSTL_CONSTEXPR20 bool long_string() {
+    easystl::string s;
+    for (int i = 0; i < 100; ++i) {
+        s.push_back(static_cast<char>('a' + i % 26));
+    }
+    easystl::string t(s);
+    t.replace(0, 26, "xyz");
+    s.erase(26);
+    return s.size() == 26 && t.size() == 77 && t.substr(0, 4) == "xyza" &&
+           s.find('z') == 25 && s < t;
+}
+
+EASYSTL_CONSTEXPR20 bool self_replace() {
+    easystl::string s("abcdefghijklmnopqrstuvwxyz");
+    // 源区间与自身重叠，走 M_disjunct 判断失败后的路径
+    s.replace(2, 3, s.c_str() + 10, 8);
+    s.replace_all("kl", "--");
+    return s == "ab--mnopqrfghij--mnopqrstuvwxyz";
+}
+
+EASYSTL_CONSTEXPR20 bool traits() {
+    char buf[8] = {};
+    easystl::char_traits<char>::assign(buf, 7, 'x');
+    easystl::char_traits<char>::move(buf + 1, buf, 3);
+    easystl::char_traits<char>::copy(buf, "ab", 2);
+    return easystl::char_traits<char>::length(buf) == 7 &&
+           easystl::char_traits<char>::compare(buf, "abxxxxx", 7) == 0 &&
+           easystl::char_traits<char>::find(buf, 7, 'x') == buf + 2 &&
+           easystl::ascii_ci_traits::compare("Content-Length: 42 bytes",
+                                             "content-length: 42 BYTES",
+                                             24) == 0;
+}
+
+EASYSTL_CONSTEXPR20 bool algorithms() {
+    int a[6] = {1, 2, 3, 4, 5, 6};
+    int b[6] = {};
+    easystl::copy(a, a + 6, b);
+    easystl::copy_backward(b, b + 4, b + 6);
+    easystl::fill_n(a, 2, 9);
+    unsigned char x[3] = {1, 2, 3};
+    unsigned char y[3] = {1, 2, 4};
+    return b[0] == 1 && b[2] == 1 && b[5] == 4 && a[1] == 9 && a[2] == 3 &&
+           easystl::max(a[0], a[5]) == 9 &&
+           easystl::lexicographical_compare(
+               static_cast<const unsigned char *>(x),
+               static_cast<const unsigned char *>(x + 3),
+               static_cast<const unsigned char *>(y),
+               static_cast<const unsigned char *>(y + 3));
+}
+
+#ifdef EASYSTL_HAS_CONSTEXPR20
+static_assert(short_string(), "constexpr short string");
+static_assert(long_string(), "constexpr long string");
+static_assert(self_replace(), "constexpr overlapping replace");
+static_assert(traits(), "constexpr char_traits");
+static_assert(algorithms(), "constexpr algobase");
+#endif
+
+TEST(ConstexprStringTest, Runtime) {
+    EXPECT_TRUE(short_string());
+    EXPECT_TRUE(long_string());
+    EXPECT_TRUE(self_replace());
+    EXPECT_TRUE(traits());
+    EXPECT_TRUE(algorithms());
+}
+
+} // namespace constexpr_string_test
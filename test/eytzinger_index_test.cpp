@@ -0,0 +1,62 @@
+#include "eytzinger_index.h"
+#include "functional.h"
+#include "vector.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace eytzinger_index_test {
+
+TEST(EytzingerIndexTest, LowerBound) {
+    for (std::size_t n : {0u, 1u, 2u, 3u, 7u, 8u, 9u, 100u, 1023u, 5000u}) {
+        easystl::vector<int> keys;
+        for (std::size_t i = 0; i < n; ++i) {
+            keys.push_back(static_cast<int>(i / 2 * 3));
+        }
+        easystl::eytzinger_index<int> index(keys);
+        ASSERT_EQ(index.size(), n);
+        for (int x = -1; x <= static_cast<int>(n * 2); ++x) {
+            const std::size_t expected = static_cast<std::size_t>(
+                std::lower_bound(keys.data(), keys.data() + keys.size(), x) -
+                keys.data());
+            ASSERT_EQ(index.lower_bound(x), expected)
+                << "n " << n << " x " << x;
+            ASSERT_EQ(index.contains(x),
+                      std::binary_search(keys.data(),
+                                         keys.data() + keys.size(), x));
+            const int *p = index.find_lower_bound(x);
+            if (expected == n) {
+                EXPECT_EQ(p, nullptr);
+            } else {
+                ASSERT_NE(p, nullptr);
+                EXPECT_EQ(*p, keys[expected]);
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(index[i], keys[i]);
+        }
+    }
+}
+
+TEST(EytzingerIndexTest, CompareAndRange) {
+    std::mt19937_64 gen(42);
+    std::vector<std::uint64_t> keys(100000);
+    for (auto &k : keys) {
+        k = gen();
+    }
+    std::sort(keys.begin(), keys.end(), std::greater<std::uint64_t>());
+    easystl::eytzinger_index<std::uint64_t, easystl::greater<std::uint64_t>>
+        index(keys.data(), keys.data() + keys.size());
+    for (int i = 0; i < 10000; ++i) {
+        const std::uint64_t x = i % 2 ? gen() : keys[gen() % keys.size()];
+        const std::size_t expected = static_cast<std::size_t>(
+            std::lower_bound(keys.begin(), keys.end(), x,
+                             std::greater<std::uint64_t>()) -
+            keys.begin());
+        ASSERT_EQ(index.lower_bound(x), expected);
+    }
+}
+
+} // namespace eytzinger_index_test
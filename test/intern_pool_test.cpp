@@ -0,0 +1,133 @@
+#include "intern_pool.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace intern_pool_test {
+TEST(InternPoolTest, SameContentSameHandle) {
+    easystl::intern_pool pool;
+    EXPECT_TRUE(pool.empty());
+    const auto a = pool.intern("service");
+    const auto b = pool.intern(easystl::string("host"));
+    const auto c = pool.intern(easystl::string_view("service:x", 7));
+    EXPECT_EQ(a, c);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.find("host"), b);
+    EXPECT_EQ(pool.find("missing"), easystl::intern_pool::npos);
+    EXPECT_EQ(pool.size(), 2u);
+}
+TEST(InternPoolTest, ViewsAndHashes) {
+    easystl::intern_pool pool;
+    const auto empty = pool.intern("");
+    const auto h = pool.intern("region=eu-west");
+    EXPECT_TRUE(pool.view(empty).empty());
+    EXPECT_TRUE(pool.view(h) == "region=eu-west");
+    EXPECT_EQ(std::strcmp(pool.c_str(h), "region=eu-west"), 0);
+    EXPECT_EQ(pool.hash(h),
+              easystl::hash<easystl::string>()(easystl::string("region=eu-west")));
+    EXPECT_EQ(pool.intern(""), empty);
+}
+TEST(InternPoolTest, ViewsStayStableWhileGrowing) {
+    easystl::intern_pool pool;
+    const auto first = pool.intern("first");
+    const char *data = pool.view(first).data();
+    std::vector<easystl::intern_pool::handle> handles;
+    for (int i = 0; i < 20000; ++i) {
+        handles.push_back(pool.intern(("tag" + std::to_string(i)).c_str()));
+    }
+    // 超过 arena 块大小的字符串单独分配
+    const std::string big(10000, 'x');
+    const auto large = pool.intern(big.c_str());
+    EXPECT_EQ(pool.view(large).size(), big.size());
+    EXPECT_EQ(pool.view(first).data(), data);
+    EXPECT_EQ(pool.size(), 20002u);
+    for (int i = 0; i < 20000; ++i) {
+        const std::string s = "tag" + std::to_string(i);
+        ASSERT_EQ(pool.find(s.c_str()), handles[i]);
+        ASSERT_TRUE(pool.view(handles[i]) == s.c_str());
+    }
+}
+TEST(InternPoolTest, ConcurrentIntern) {
+    easystl::intern_pool pool;
+    const int kThreads = 4, kTags = 3000;
+    std::vector<std::vector<easystl::intern_pool::handle>> seen(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&pool, &seen, t] {
+            for (int i = 0; i < kTags; ++i) {
+                // 每个线程以不同的顺序驻留同一组字符串
+                const int k = (i * (t + 1) * 7919) % kTags;
+                const std::string s = "metric." + std::to_string(k);
+                const auto h = pool.intern(s.c_str());
+                EXPECT_TRUE(pool.view(h) == s.c_str());
+                seen[t].push_back(h);
+            }
+        });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(pool.size(), static_cast<std::size_t>(kTags));
+    for (int t = 0; t < kThreads; ++t) {
+        for (int i = 0; i < kTags; ++i) {
+            const int k = (i * (t + 1) * 7919) % kTags;
+            const std::string s = "metric." + std::to_string(k);
+            ASSERT_EQ(seen[t][i], pool.find(s.c_str()));
+        }
+    }
+}
+// g_alloc_fail 为 true 时抛出 std::bad_alloc 的分配器
+bool g_alloc_fail = false;
+
+template <class T> struct failing_allocator {
+    typedef T value_type;
+    template <class U> struct rebind {
+        typedef failing_allocator<U> other;
+    };
+    failing_allocator() = default;
+    template <class U> failing_allocator(const failing_allocator<U> &) {}
+    T *allocate(std::size_t n) {
+        if (g_alloc_fail) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T *p, std::size_t) { ::operator delete(p); }
+};
+
+TEST(InternPoolTest, AllocationFailureLeavesPoolUnchanged) {
+    typedef easystl::basic_intern_pool<char, easystl::char_traits<char>,
+                                       failing_allocator<char>>
+        pool_type;
+    pool_type pool;
+    std::size_t failures = 0;
+    for (int i = 0; i < 3000; ++i) {
+        // 每隔一段插入超过 arena 块大小四分之一的字符串，单独分配
+        const std::string s = i % 97 == 0 ? std::string(5000, 'a' + i % 26) +
+                                                std::to_string(i)
+                                          : "key." + std::to_string(i);
+        g_alloc_fail = true;
+        try {
+            const pool_type::handle h = pool.intern(s.c_str());
+            g_alloc_fail = false;
+            ASSERT_EQ(h, static_cast<pool_type::handle>(i));
+            continue;
+        } catch (const std::bad_alloc &) {
+            ++failures;
+        }
+        g_alloc_fail = false;
+        ASSERT_EQ(pool.size(), static_cast<std::size_t>(i));
+        ASSERT_EQ(pool.find(s.c_str()), pool_type::npos);
+        // 失败不浪费句柄
+        ASSERT_EQ(pool.intern(s.c_str()), static_cast<pool_type::handle>(i));
+    }
+    EXPECT_GT(failures, 30u);
+    EXPECT_EQ(pool.size(), 3000u);
+    EXPECT_TRUE(pool.view(2000) == "key.2000");
+}
+} // namespace intern_pool_test
@@ -0,0 +1,229 @@
+#include "parallel_algo.h"
+#include "stringfwd.h"
+#include "thread_pool.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace parallel_algo_test {
+
+// 与机器的核数无关，固定使用 4 个工作线程，并用较小的粒度强制分块
+easystl::thread_pool &pool() {
+    static easystl::thread_pool p(4);
+    return p;
+}
+
+const easystl::execution::parallel_policy kPar =
+    easystl::execution::par.with_grain(1000).on(pool());
+const easystl::execution::parallel_unsequenced_policy kParUnseq =
+    easystl::execution::par_unseq.with_grain(1000).on(pool());
+
+struct forward_iter
+    : easystl::iterator<easystl::forward_iterator_tag, int> {
+    int *p;
+    explicit forward_iter(int *x) : p(x) {}
+    int &operator*() const { return *p; }
+    forward_iter &operator++() {
+        ++p;
+        return *this;
+    }
+    bool operator==(const forward_iter &o) const { return p == o.p; }
+    bool operator!=(const forward_iter &o) const { return p != o.p; }
+};
+
+TEST(ThreadPoolTest, RunChunks) {
+    std::vector<int> hits(10000, 0);
+    pool().run_chunks(hits.size(), [&hits](std::size_t i) { ++hits[i]; });
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 10000);
+
+    // 在工作线程中嵌套调用
+    std::atomic<int> total(0);
+    pool().run_chunks(8, [&total](std::size_t) {
+        pool().run_chunks(100, [&total](std::size_t) { ++total; });
+    });
+    EXPECT_EQ(total.load(), 800);
+
+    EXPECT_THROW(pool().run_chunks(100,
+                                   [](std::size_t i) {
+                                       if (i == 42) {
+                                           throw std::runtime_error("42");
+                                       }
+                                   }),
+                 std::runtime_error);
+}
+
+TEST(ThreadPoolTest, Submit) {
+    std::atomic<int> done(0);
+    {
+        easystl::thread_pool p(3);
+        for (int i = 0; i < 1000; ++i) {
+            p.submit([&done] { ++done; });
+        }
+    }
+    // 析构时执行完所有已提交的任务
+    EXPECT_EQ(done.load(), 1000);
+
+    easystl::thread_pool inline_pool(0);
+    inline_pool.submit([&done] { ++done; });
+    EXPECT_TRUE(inline_pool.try_run_one());
+    EXPECT_FALSE(inline_pool.try_run_one());
+    EXPECT_EQ(done.load(), 1001);
+}
+
+TEST(ParallelAlgoTest, CopyFillTransform) {
+    std::vector<std::uint32_t> a(100003);
+    easystl::fill(kPar, a.data(), a.data() + a.size(), 7u);
+    EXPECT_EQ(std::count(a.begin(), a.end(), 7u), 100003);
+
+    std::iota(a.begin(), a.end(), 0u);
+    std::vector<std::uint32_t> b(a.size());
+    EXPECT_EQ(easystl::copy(kParUnseq, a.data(), a.data() + a.size(),
+                            b.data()),
+              b.data() + b.size());
+    EXPECT_EQ(a, b);
+
+    easystl::transform(kPar, a.data(), a.data() + a.size(), b.data(),
+                       [](std::uint32_t x) { return x * 3; });
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        ASSERT_EQ(b[i], i * 3);
+    }
+    std::vector<std::uint32_t> c(a.size());
+    easystl::transform(kPar, a.data(), a.data() + a.size(), b.data(),
+                       c.data(),
+                       [](std::uint32_t x, std::uint32_t y) { return y - x; });
+    for (std::size_t i = 0; i < c.size(); ++i) {
+        ASSERT_EQ(c[i], i * 2);
+    }
+
+    // 不支持随机访问的迭代器退化为顺序版本
+    int in[5] = {1, 2, 3, 4, 5};
+    std::vector<int> out(5, 0);
+    easystl::copy(kPar, forward_iter(in), forward_iter(in + 5), out.data());
+    EXPECT_EQ(out, std::vector<int>(in, in + 5));
+}
+
+TEST(ParallelAlgoTest, ReduceFindCount) {
+    std::vector<std::uint64_t> a(200000);
+    std::iota(a.begin(), a.end(), 1u);
+    const std::uint64_t n = a.size();
+    EXPECT_EQ(easystl::reduce(kPar, a.data(), a.data() + a.size()),
+              n * (n + 1) / 2);
+    EXPECT_EQ(easystl::reduce(easystl::execution::seq, a.data(),
+                              a.data() + a.size(), std::uint64_t(10)),
+              n * (n + 1) / 2 + 10);
+    // 非交换的运算：块的合并顺序与元素顺序一致
+    std::vector<easystl::string> words(5000, "x");
+    words[0] = "[";
+    words.back() = "]";
+    const easystl::string joined =
+        easystl::reduce(kPar, words.data(), words.data() + words.size(),
+                        easystl::string(">"));
+    EXPECT_EQ(joined.size(), 5001u);
+    EXPECT_EQ(joined.substr(0, 3), ">[x");
+    EXPECT_EQ(joined.back(), ']');
+
+    EXPECT_EQ(easystl::find(kPar, a.data(), a.data() + a.size(), 150001u),
+              a.data() + 150000);
+    EXPECT_EQ(easystl::find(kPar, a.data(), a.data() + a.size(), 0u),
+              a.data() + a.size());
+    a[120000] = 5;
+    EXPECT_EQ(easystl::find(kPar, a.data(), a.data() + a.size(), 5u),
+              a.data() + 4);
+    EXPECT_EQ(easystl::find_if(kPar, a.data(), a.data() + a.size(),
+                               [](std::uint64_t x) { return x > 199990; }),
+              a.data() + 199990);
+
+    EXPECT_EQ(easystl::count(kPar, a.data(), a.data() + a.size(), 5u), 2);
+    EXPECT_EQ(easystl::count_if(kPar, a.data(), a.data() + a.size(),
+                                [](std::uint64_t x) { return x % 2 == 0; }),
+              100000);
+}
+
+TEST(ParallelAlgoTest, Scan) {
+    std::mt19937 gen(11);
+    std::vector<long long> v(100003);
+    for (auto &x : v) {
+        x = static_cast<long long>(gen() % 1000);
+    }
+    std::vector<long long> inclusive(v.size()), exclusive(v.size());
+    std::partial_sum(v.begin(), v.end(), inclusive.begin());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        exclusive[i] = 7 + (i == 0 ? 0 : inclusive[i - 1]);
+    }
+
+    std::vector<long long> out(v.size());
+    EXPECT_EQ(easystl::inclusive_scan(kPar, v.begin(), v.end(), out.begin()),
+              out.end());
+    EXPECT_EQ(out, inclusive);
+    easystl::exclusive_scan(kParUnseq, v.data(), v.data() + v.size(),
+                            out.data(), 7LL);
+    EXPECT_EQ(out, exclusive);
+    easystl::transform_exclusive_scan(
+        kPar, v.begin(), v.end(), out.begin(), 7LL,
+        easystl::plus<long long>(), [](long long x) { return 2 * x; });
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(out[i], 2 * exclusive[i] - 7) << i;
+    }
+
+    // 原地计算；不满足交换律的操作也按顺序合并各块
+    std::vector<long long> w = v;
+    easystl::inclusive_scan(kPar, w.begin(), w.end(), w.begin());
+    EXPECT_EQ(w, inclusive);
+    std::vector<std::string> s(5000);
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        s[i] = std::string(1, static_cast<char>('a' + i % 26));
+    }
+    std::vector<std::string> cat(s.size());
+    easystl::exclusive_scan(kPar, s.begin(), s.end(), cat.begin(),
+                            std::string(">"), easystl::plus<std::string>());
+    EXPECT_EQ(cat[0], ">");
+    EXPECT_EQ(cat[4999].size(), 5000u);
+    EXPECT_EQ(cat[4999].substr(0, 4), ">abc");
+
+    // 顺序策略与前向迭代器退化为顺序版本
+    std::vector<int> small = {1, 2, 3};
+    std::vector<int> small_out(3);
+    easystl::inclusive_scan(easystl::execution::seq, small.begin(),
+                            small.end(), small_out.begin());
+    EXPECT_EQ(small_out, (std::vector<int>{1, 3, 6}));
+    easystl::exclusive_scan(kPar, forward_iter(small.data()),
+                            forward_iter(small.data() + 3),
+                            forward_iter(small_out.data()), 0);
+    EXPECT_EQ(small_out, (std::vector<int>{0, 1, 3}));
+}
+
+TEST(ParallelAlgoTest, Sort) {
+    for (std::size_t n : {0u, 1u, 999u, 1000u, 4096u, 100000u, 1000003u}) {
+        std::mt19937 gen(static_cast<unsigned>(n));
+        std::vector<int> v(n);
+        for (int &x : v) {
+            x = static_cast<int>(gen() % 5000);
+        }
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+        easystl::sort(kPar, v.data(), v.data() + v.size());
+        ASSERT_EQ(v, expected) << n;
+
+        std::sort(expected.begin(), expected.end(), std::greater<int>());
+        easystl::sort(easystl::execution::seq, v.data(), v.data() + v.size(),
+                      easystl::greater<int>());
+        ASSERT_EQ(v, expected) << n;
+    }
+
+    std::vector<easystl::string> s(20000);
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        s[i] = easystl::to_string((i * 7919) % 20011);
+    }
+    std::vector<easystl::string> expected = s;
+    easystl::sort(expected.data(), expected.data() + expected.size());
+    easystl::sort(kPar, s.data(), s.data() + s.size());
+    EXPECT_EQ(s, expected);
+}
+
+} // namespace parallel_algo_test
@@ -0,0 +1,372 @@
+#include "queue.h"
+#include "heap_algo.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <queue>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// 剩余的分配次数，为 0 时 operator new 抛出 std::bad_alloc，为负数时不限制。
+// easystl::vector 没有分配器参数，只能替换全局的 operator new
+static int g_new_budget = -1;
+
+void *operator new(std::size_t n) {
+    if (g_new_budget == 0) {
+        throw std::bad_alloc();
+    }
+    if (g_new_budget > 0) {
+        --g_new_budget;
+    }
+    void *p = std::malloc(n == 0 ? 1 : n);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+// 不内联，免得编译器把 new 与 free 配对而报告不匹配
+__attribute__((noinline)) void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace queue_test {
+
+// 检查 [first, last) 是否为 Arity 叉的大根堆
+template <std::size_t Arity, class T>
+bool is_dary_heap(const T *first, const T *last) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    for (std::size_t i = 1; i < n; ++i) {
+        if (first[(i - 1) / Arity] < first[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t Arity> void check_heap_algorithms() {
+    std::mt19937 gen(Arity);
+    for (int n : {0, 1, 2, 3, 4, 5, 8, 9, 63, 64, 65, 1000}) {
+        std::vector<int> v(static_cast<std::size_t>(n));
+        for (auto &x : v) {
+            x = static_cast<int>(gen() % 100);
+        }
+        std::vector<int> sorted = v;
+        std::sort(sorted.begin(), sorted.end());
+
+        std::vector<int> h = v;
+        easystl::make_heap<Arity>(h.data(), h.data() + n);
+        ASSERT_TRUE(is_dary_heap<Arity>(h.data(), h.data() + n)) << n;
+        easystl::sort_heap<Arity>(h.data(), h.data() + n);
+        ASSERT_EQ(h, sorted) << n;
+
+        // 逐个 push，再逐个 pop
+        h = v;
+        for (int i = 1; i <= n; ++i) {
+            easystl::push_heap<Arity>(h.data(), h.data() + i);
+            ASSERT_TRUE(is_dary_heap<Arity>(h.data(), h.data() + i));
+        }
+        for (int i = n; i > 1; --i) {
+            easystl::pop_heap<Arity>(h.data(), h.data() + i);
+            ASSERT_EQ(h[i - 1], sorted[i - 1]);
+            ASSERT_TRUE(is_dary_heap<Arity>(h.data(), h.data() + i - 1));
+        }
+    }
+}
+
+TEST(HeapTest, DaryHeapAlgorithms) {
+    check_heap_algorithms<2>();
+    check_heap_algorithms<3>();
+    check_heap_algorithms<4>();
+    check_heap_algorithms<8>();
+
+    // 自定义比较：小根堆
+    std::vector<std::string> s = {"d", "a", "c", "b", "e"};
+    easystl::make_heap<4>(s.begin(), s.end(), std::greater<std::string>());
+    easystl::sort_heap<4>(s.begin(), s.end(), std::greater<std::string>());
+    EXPECT_EQ(s, (std::vector<std::string>{"e", "d", "c", "b", "a"}));
+}
+
+template <std::size_t Arity> void check_priority_queue() {
+    std::mt19937 gen(1);
+    easystl::priority_queue<int, easystl::vector<int>, easystl::less<int>,
+                            Arity>
+        q;
+    std::priority_queue<int> expected;
+    for (int i = 0; i < 5000; ++i) {
+        if (gen() % 3 != 0 || expected.empty()) {
+            const int x = static_cast<int>(gen() % 1000);
+            q.push(x);
+            expected.push(x);
+        } else {
+            ASSERT_EQ(q.top(), expected.top());
+            q.pop();
+            expected.pop();
+        }
+        ASSERT_EQ(q.size(), expected.size());
+    }
+    while (!expected.empty()) {
+        ASSERT_EQ(q.top(), expected.top());
+        q.pop();
+        expected.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+struct task {
+    int cost;
+    int id;
+    task() : cost(0), id(0) {}
+    task(int c, int i) : cost(c), id(i) {}
+    bool operator<(const task &rhs) const { return cost < rhs.cost; }
+};
+
+TEST(PriorityQueueTest, MatchesStd) {
+    check_priority_queue<2>();
+    check_priority_queue<4>();
+    check_priority_queue<8>();
+
+    // 由区间与初始化列表构造，小根堆
+    const int v[] = {5, 3, 8, 1, 9, 2};
+    easystl::priority_queue<int, easystl::vector<int>, easystl::greater<int>>
+        q(v, v + 6);
+    EXPECT_EQ(q.top(), 1);
+    q.pop();
+    EXPECT_EQ(q.top(), 2);
+
+    // emplace 就地构造，比较 cost
+    easystl::priority_queue<task> s = {task(2, 0), task(3, 1), task(1, 2)};
+    s.emplace(9, 3);
+    EXPECT_EQ(s.top().id, 3);
+    s.pop();
+    EXPECT_EQ(s.top().id, 1);
+    easystl::priority_queue<task> t;
+    t.swap(s);
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(t.size(), 3u);
+}
+
+TEST(IndexedPriorityQueueTest, DecreaseKey) {
+    // 默认为小根堆，模拟定时器：按句柄提前、推迟与取消
+    easystl::indexed_priority_queue<int> q;
+    std::vector<std::size_t> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.push_back(q.push(1000 + i * 10));
+    }
+    EXPECT_EQ(q.top(), 1000);
+    EXPECT_EQ(q.top_handle(), handles[0]);
+
+    q.decrease_key(handles[50], 5);
+    EXPECT_EQ(q.top(), 5);
+    EXPECT_EQ(q.top_handle(), handles[50]);
+    q.increase_key(handles[50], 5000);
+    EXPECT_EQ(q.top(), 1000);
+    EXPECT_EQ(q[handles[50]], 5000);
+    q.update(handles[99], 1);
+    EXPECT_EQ(q.top_handle(), handles[99]);
+    q.erase(handles[99]);
+    EXPECT_FALSE(q.contains(handles[99]));
+    EXPECT_EQ(q.size(), 99u);
+
+    // 句柄会被复用
+    const std::size_t h = q.push(7);
+    EXPECT_EQ(h, handles[99]);
+    EXPECT_EQ(q.top(), 7);
+    q.pop();
+    EXPECT_FALSE(q.contains(h));
+
+    // 剩下的元素按顺序出队
+    int last = 0;
+    std::size_t count = 0;
+    while (!q.empty()) {
+        EXPECT_LE(last, q.top());
+        last = q.top();
+        q.pop();
+        ++count;
+    }
+    EXPECT_EQ(count, 99u);
+}
+
+TEST(IndexedPriorityQueueTest, RandomOperations) {
+    // 与逐个查找最大值的朴素实现比较
+    std::mt19937 gen(3);
+    easystl::indexed_priority_queue<int, easystl::less<int>, 8> q;
+    std::vector<int> value;
+    std::vector<bool> alive;
+    for (int step = 0; step < 20000; ++step) {
+        const unsigned op = gen() % 5;
+        if (op <= 1 || q.empty()) {
+            const int x = static_cast<int>(gen() % 10000);
+            const std::size_t h = q.push(x);
+            if (h >= value.size()) {
+                value.resize(h + 1);
+                alive.resize(h + 1);
+            }
+            value[h] = x;
+            alive[h] = true;
+        } else {
+            std::size_t h = gen() % value.size();
+            while (!alive[h]) {
+                h = (h + 1) % value.size();
+            }
+            const int x = static_cast<int>(gen() % 10000);
+            if (op == 2) {
+                q.update(h, x);
+                value[h] = x;
+            } else if (op == 3) {
+                q.erase(h);
+                alive[h] = false;
+            } else {
+                alive[q.top_handle()] = false;
+                q.pop();
+            }
+        }
+        int best = -1;
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            if (alive[i]) {
+                ASSERT_TRUE(q.contains(i));
+                ASSERT_EQ(q[i], value[i]);
+                best = std::max(best, value[i]);
+            } else {
+                ASSERT_FALSE(q.contains(i));
+            }
+        }
+        if (!q.empty()) {
+            ASSERT_EQ(q.top(), best);
+        }
+    }
+}
+
+// 默认的小根堆上随机调小、调大优先级，与逐个查找最小值的朴素实现比较
+template <std::size_t Arity> void check_key_changes() {
+    std::mt19937 gen(Arity);
+    easystl::indexed_priority_queue<int, easystl::greater<int>, Arity> q;
+    std::vector<int> value;
+    for (int i = 0; i < 500; ++i) {
+        const int x = static_cast<int>(gen() % 100000);
+        ASSERT_EQ(q.push(x), value.size());
+        value.push_back(x);
+    }
+    for (int step = 0; step < 20000; ++step) {
+        const std::size_t h = gen() % value.size();
+        const int delta = static_cast<int>(gen() % 1000);
+        if (gen() % 2 == 0) {
+            value[h] -= delta;
+            q.decrease_key(h, value[h]);
+        } else {
+            value[h] += delta;
+            q.increase_key(h, value[h]);
+        }
+        ASSERT_EQ(q[h], value[h]);
+        ASSERT_EQ(q.top(), *std::min_element(value.begin(), value.end()));
+    }
+    // 全部出队时按从小到大的顺序
+    std::sort(value.begin(), value.end());
+    for (int x : value) {
+        ASSERT_EQ(q.top(), x);
+        q.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(IndexedPriorityQueueTest, RandomKeyChanges) {
+    static_assert(
+        std::is_same<easystl::indexed_priority_queue<int>::value_compare,
+                     easystl::greater<int>>::value,
+        "indexed_priority_queue is a min-heap by default");
+    check_key_changes<2>();
+    check_key_changes<4>();
+    check_key_changes<8>();
+}
+
+// 在 budget 次分配之后让 operator new 失败，返回 f 是否抛出了 bad_alloc
+template <class F> bool fails_with_budget(int budget, F f) {
+    g_new_budget = budget;
+    try {
+        f();
+    } catch (const std::bad_alloc &) {
+        g_new_budget = -1;
+        return true;
+    }
+    g_new_budget = -1;
+    return false;
+}
+
+TEST(IndexedPriorityQueueTest, AllocationFailureKeepsState) {
+    typedef easystl::indexed_priority_queue<int> queue_type;
+    queue_type q;
+    int failures = 0;
+    for (int i = 0; i < 200; ++i) {
+        // 依次让 M_heap、M_pos 的扩容失败；失败的 push 不占用句柄
+        for (int budget = 0; budget < 2; ++budget) {
+            queue_type::handle_type h = 0;
+            if (!fails_with_budget(budget, [&] { h = q.push(i); })) {
+                ASSERT_EQ(h, static_cast<queue_type::handle_type>(i));
+                break;
+            }
+            ++failures;
+            ASSERT_EQ(q.size(), static_cast<std::size_t>(i));
+            ASSERT_FALSE(q.contains(static_cast<queue_type::handle_type>(i)));
+            if (budget == 1) {
+                ASSERT_EQ(q.push(i), static_cast<queue_type::handle_type>(i));
+            }
+        }
+    }
+    ASSERT_EQ(q.size(), 200u);
+    // M_free 扩容失败时被删除的元素仍在队列中
+    for (int i = 0; i < 100; ++i) {
+        const queue_type::handle_type h = static_cast<queue_type::handle_type>(i);
+        if (fails_with_budget(0, [&] { q.erase(h); })) {
+            ++failures;
+            ASSERT_TRUE(q.contains(h));
+            ASSERT_EQ(q[h], i);
+            ASSERT_EQ(q.size(), static_cast<std::size_t>(200 - i));
+            q.erase(h);
+        }
+        ASSERT_FALSE(q.contains(h));
+    }
+    EXPECT_GE(failures, 4);
+    for (int v = 100; v < 200; ++v) {
+        ASSERT_EQ(q.top(), v);
+        q.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+// 交换比较器可能抛出异常时 swap 不是 noexcept
+struct throwing_less {
+    throwing_less() = default;
+    throwing_less(const throwing_less &) {}
+    throwing_less &operator=(const throwing_less &) { return *this; }
+    bool operator()(int a, int b) const { return a < b; }
+};
+
+static_assert(noexcept(std::declval<easystl::priority_queue<int> &>().swap(
+                  std::declval<easystl::priority_queue<int> &>())),
+              "");
+static_assert(
+    !noexcept(std::declval<easystl::priority_queue<
+                  int, easystl::vector<int>, throwing_less> &>()
+                  .swap(std::declval<easystl::priority_queue<
+                            int, easystl::vector<int>, throwing_less> &>())),
+    "");
+static_assert(noexcept(easystl::swap(
+                  std::declval<easystl::indexed_priority_queue<int> &>(),
+                  std::declval<easystl::indexed_priority_queue<int> &>())),
+              "");
+static_assert(
+    !noexcept(easystl::swap(
+        std::declval<easystl::indexed_priority_queue<int, throwing_less> &>(),
+        std::declval<
+            easystl::indexed_priority_queue<int, throwing_less> &>())),
+    "");
+
+} // namespace queue_test
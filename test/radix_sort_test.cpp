@@ -0,0 +1,141 @@
+#include "radix_sort.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace radix_sort_test {
+
+const std::size_t kSizes[] = {0, 1, 2, 63, 64, 65, 1000, 100000};
+
+template <class T> std::vector<T> random_values(std::size_t n, unsigned seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<T> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<T>(gen());
+    }
+    return v;
+}
+
+TEST(RadixSortTest, Integers) {
+    for (std::size_t n : kSizes) {
+        std::vector<std::uint64_t> u = random_values<std::uint64_t>(n, 1);
+        std::vector<std::uint64_t> ue = u;
+        std::sort(ue.begin(), ue.end());
+        easystl::radix_sort(u.data(), u.data() + u.size());
+        ASSERT_EQ(u, ue) << n;
+
+        std::vector<int> s = random_values<int>(n, 2);
+        std::vector<int> se = s;
+        std::sort(se.begin(), se.end());
+        easystl::radix_sort(s.data(), s.data() + s.size());
+        ASSERT_EQ(s, se) << n;
+
+        std::vector<std::int8_t> c = random_values<std::int8_t>(n, 3);
+        std::vector<std::int8_t> ce = c;
+        std::sort(ce.begin(), ce.end());
+        easystl::radix_sort(c.data(), c.data() + c.size());
+        ASSERT_EQ(c, ce) << n;
+    }
+}
+
+TEST(RadixSortTest, SkipsConstantBytes) {
+    // 高位全部相同，只需要一趟；奇数趟后结果在原区间
+    std::vector<std::uint32_t> v(5000);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i] = 0xabcd0000u | static_cast<std::uint32_t>((i * 7919) % 251);
+    }
+    std::vector<std::uint32_t> expected = v;
+    std::sort(expected.begin(), expected.end());
+    easystl::radix_sort(v.data(), v.data() + v.size());
+    EXPECT_EQ(v, expected);
+
+    std::vector<std::int64_t> same(1000, -5);
+    easystl::radix_sort(same.data(), same.data() + same.size());
+    EXPECT_EQ(same, std::vector<std::int64_t>(1000, -5));
+}
+
+TEST(RadixSortTest, FloatingPoint) {
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+    std::vector<float> f(20000);
+    for (float &x : f) {
+        x = dist(gen);
+    }
+    f[0] = std::numeric_limits<float>::infinity();
+    f[1] = -std::numeric_limits<float>::infinity();
+    f[2] = 0.0f;
+    f[3] = std::numeric_limits<float>::denorm_min();
+    std::vector<float> fe = f;
+    std::sort(fe.begin(), fe.end());
+    easystl::radix_sort(f.data(), f.data() + f.size());
+    EXPECT_EQ(f, fe);
+
+    std::vector<double> d(20000);
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i] = (static_cast<double>(i % 997) - 500.0) / 3.0;
+    }
+    std::vector<double> de = d;
+    std::sort(de.begin(), de.end());
+    easystl::radix_sort(d.data(), d.data() + d.size());
+    EXPECT_EQ(d, de);
+
+    // -0.0 排在 0.0 之前
+    double z[2] = {0.0, -0.0};
+    easystl::radix_sort(z, z + 2);
+    EXPECT_TRUE(std::signbit(z[0]));
+    EXPECT_FALSE(std::signbit(z[1]));
+}
+
+struct record {
+    std::uint16_t id;
+    int order;
+    easystl::string name;
+};
+
+TEST(RadixSortTest, KeyExtractorIsStable) {
+    std::mt19937 gen(5);
+    std::vector<record> v;
+    for (int i = 0; i < 3000; ++i) {
+        v.push_back({static_cast<std::uint16_t>(gen() % 300), i,
+                     easystl::to_string(i)});
+    }
+    easystl::radix_sort(v.data(), v.data() + v.size(),
+                        [](const record &r) { return r.id; });
+    for (std::size_t i = 1; i < v.size(); ++i) {
+        ASSERT_LE(v[i - 1].id, v[i].id);
+        if (v[i - 1].id == v[i].id) {
+            ASSERT_LT(v[i - 1].order, v[i].order);
+        }
+        ASSERT_EQ(v[i].name, easystl::to_string(v[i].order));
+    }
+}
+
+TEST(RadixSortTest, Strings) {
+    std::mt19937 gen(6);
+    std::vector<easystl::string> v;
+    for (int i = 0; i < 20000; ++i) {
+        easystl::string s;
+        // 短前缀集中在少数几个字符上，并包含空串、前缀关系与高位字节
+        const int len = static_cast<int>(gen() % 12);
+        for (int j = 0; j < len; ++j) {
+            s.push_back(static_cast<char>("ab\xff"[gen() % 3]));
+        }
+        v.push_back(s);
+    }
+    // 长的公共前缀
+    const easystl::string prefix(5000, 'p');
+    for (int i = 0; i < 200; ++i) {
+        v.push_back(prefix + easystl::to_string(i % 50));
+    }
+    std::vector<easystl::string> expected = v;
+    easystl::sort(expected.data(), expected.data() + expected.size());
+    easystl::radix_sort(v.data(), v.data() + v.size());
+    EXPECT_EQ(v, expected);
+}
+
+} // namespace radix_sort_test
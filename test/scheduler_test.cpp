@@ -0,0 +1,149 @@
+#include "scheduler.h"
+#include "work_stealing_deque.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace scheduler_test {
+
+TEST(WorkStealingDequeTest, OwnerAndThief) {
+    // 容量从 4 开始，放入 100 个元素时需要多次扩容
+    easystl::work_stealing_deque<int> d(4);
+    EXPECT_TRUE(d.empty());
+    for (int i = 0; i < 100; ++i) {
+        d.push(i);
+    }
+    EXPECT_EQ(d.size(), 100u);
+
+    int x = -1;
+    // 拥有者后进先出，窃取者先进先出
+    EXPECT_TRUE(d.take(x));
+    EXPECT_EQ(x, 99);
+    EXPECT_TRUE(d.steal(x));
+    EXPECT_EQ(x, 0);
+    EXPECT_TRUE(d.steal(x));
+    EXPECT_EQ(x, 1);
+    EXPECT_EQ(d.size(), 97u);
+
+    for (int i = 98; i >= 2; --i) {
+        ASSERT_TRUE(d.take(x));
+        EXPECT_EQ(x, i);
+    }
+    EXPECT_FALSE(d.take(x));
+    EXPECT_FALSE(d.steal(x));
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentSteal) {
+    const int n = 200000;
+    easystl::work_stealing_deque<int> d(16);
+    std::vector<std::atomic<int>> seen(n);
+    for (auto &s : seen) {
+        s.store(0);
+    }
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            int x;
+            while (!done.load()) {
+                if (d.steal(x)) {
+                    seen[x].fetch_add(1);
+                }
+            }
+            while (d.steal(x)) {
+                seen[x].fetch_add(1);
+            }
+        });
+    }
+    int x;
+    for (int i = 0; i < n; ++i) {
+        d.push(i);
+        // 拥有者也不断取回，与窃取者争抢最后一个元素
+        if (i % 3 == 0 && d.take(x)) {
+            seen[x].fetch_add(1);
+        }
+    }
+    while (d.take(x)) {
+        seen[x].fetch_add(1);
+    }
+    done.store(true);
+    for (auto &t : thieves) {
+        t.join();
+    }
+
+    // 每个元素恰好被取出一次
+    int once = 0;
+    for (auto &s : seen) {
+        once += s.load() == 1;
+    }
+    EXPECT_EQ(once, n);
+}
+
+std::uint64_t fib(easystl::scheduler &s, unsigned n) {
+    if (n < 12) {
+        return n < 2 ? n : fib(s, n - 1) + fib(s, n - 2);
+    }
+    std::uint64_t left = 0;
+    easystl::task_group g(s);
+    g.spawn([&s, &left, n] { left = fib(s, n - 1); });
+    const std::uint64_t right = fib(s, n - 2);
+    g.sync();
+    return left + right;
+}
+
+TEST(SchedulerTest, SpawnSync) {
+    easystl::scheduler s(4);
+    EXPECT_EQ(s.size(), 4u);
+    EXPECT_EQ(fib(s, 25), 75025u);
+
+    // 没有工作线程时由调用 sync 的线程执行全部任务
+    easystl::scheduler inline_scheduler(0);
+    EXPECT_EQ(fib(inline_scheduler, 20), 6765u);
+
+    easystl::task_group g(s);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 100; ++i) {
+        g.spawn([&done, i] {
+            if (i == 42) {
+                throw std::runtime_error("42");
+            }
+            ++done;
+        });
+    }
+    EXPECT_THROW(g.sync(), std::runtime_error);
+    // 一个任务失败不影响其他任务
+    EXPECT_EQ(done.load(), 99);
+    EXPECT_NO_THROW(g.sync());
+}
+
+TEST(SchedulerTest, RunChunksAndIdle) {
+    easystl::scheduler_options options;
+    options.threads = 3;
+    options.pin_threads = true;
+    easystl::scheduler s(options);
+
+    std::atomic<int> total(0);
+    s.run_chunks(8, [&s, &total](std::size_t) {
+        s.run_chunks(100, [&total](std::size_t) { ++total; });
+    });
+    EXPECT_EQ(total.load(), 800);
+
+    // 工作线程进入休眠后，新提交的任务仍能唤醒它们
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::atomic<int> done(0);
+    for (int i = 0; i < 1000; ++i) {
+        s.submit([&done] { ++done; });
+    }
+    while (done.load() != 1000) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(done.load(), 1000);
+}
+
+} // namespace scheduler_test
@@ -0,0 +1,121 @@
+#include "shared_string.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace shared_string_test {
+TEST(SharedStringTest, DefaultIsEmpty) {
+    easystl::shared_string s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.size(), 0u);
+    EXPECT_EQ(s.use_count(), 0u);
+    EXPECT_EQ(s.data()[0], '\0');
+    EXPECT_TRUE(s == "");
+}
+TEST(SharedStringTest, ConstructAndAccess) {
+    easystl::shared_string s("hello world");
+    EXPECT_EQ(s.size(), 11u);
+    EXPECT_EQ(s[0], 'h');
+    EXPECT_EQ(s.back(), 'd');
+    EXPECT_EQ(s.data()[11], '\0');
+    EXPECT_THROW(s.at(11), std::out_of_range);
+    EXPECT_EQ(std::string(s.begin(), s.end()), "hello world");
+
+    easystl::shared_string t("abcdef", 3);
+    EXPECT_TRUE(t == "abc");
+}
+TEST(SharedStringTest, CopySharesBuffer) {
+    easystl::shared_string a("shared buffer");
+    EXPECT_EQ(a.use_count(), 1u);
+    {
+        easystl::shared_string b(a);
+        easystl::shared_string c;
+        c = b;
+        EXPECT_EQ(b.data(), a.data());
+        EXPECT_EQ(c.data(), a.data());
+        EXPECT_EQ(a.use_count(), 3u);
+    }
+    EXPECT_EQ(a.use_count(), 1u);
+
+    easystl::shared_string m(std::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(m.use_count(), 1u);
+    EXPECT_TRUE(m == "shared buffer");
+}
+TEST(SharedStringTest, SubstrIsSlice) {
+    easystl::shared_string s("key=value");
+    easystl::shared_string key = s.substr(0, s.find('='));
+    easystl::shared_string value = s.substr(s.find('=') + 1);
+    EXPECT_TRUE(key == "key");
+    EXPECT_TRUE(value == "value");
+    EXPECT_EQ(key.data(), s.data());
+    EXPECT_EQ(value.data(), s.data() + 4);
+    EXPECT_EQ(s.use_count(), 3u);
+    EXPECT_TRUE(s.substr(9).empty());
+    EXPECT_THROW(s.substr(10), std::out_of_range);
+
+    // 原对象销毁后切片仍然有效
+    s = easystl::shared_string();
+    EXPECT_EQ(key.use_count(), 2u);
+    EXPECT_TRUE(value.substr(1, 3) == "alu");
+}
+TEST(SharedStringTest, ConvertWithBasicString) {
+    easystl::string str("from basic_string");
+    easystl::shared_string s(str);
+    EXPECT_TRUE(s == "from basic_string");
+    easystl::string back = s.substr(5).str();
+    EXPECT_EQ(std::strcmp(back.c_str(), "basic_string"), 0);
+
+    easystl::string out("prefix:");
+    s.substr(0, 4).append_to(out);
+    EXPECT_EQ(std::strcmp(out.c_str(), "prefix:from"), 0);
+}
+TEST(SharedStringTest, CompareAndFind) {
+    easystl::shared_string a("apple"), b("apples"), c("banana");
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(b < c);
+    EXPECT_FALSE(c < a);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(a == b.substr(0, 5));
+    EXPECT_EQ(c.find("nan"), 2u);
+    EXPECT_EQ(c.find("nan", 3), easystl::shared_string::npos);
+    EXPECT_EQ(c.find('a', 2), 3u);
+    EXPECT_EQ(c.find(""), 0u);
+    // pos 接近 npos 时 pos + n 会回绕
+    EXPECT_EQ(c.find("ab", easystl::shared_string::npos, 2),
+              easystl::shared_string::npos);
+    EXPECT_EQ(c.find("a", easystl::shared_string::npos - 1, 1),
+              easystl::shared_string::npos);
+    EXPECT_EQ(c.find("", c.size() + 1, 0), easystl::shared_string::npos);
+    EXPECT_EQ(c.find("", c.size(), 0), c.size());
+
+    std::ostringstream os;
+    os << c.substr(2, 3);
+    EXPECT_EQ(os.str(), "nan");
+}
+TEST(SharedStringTest, HashMatchesBasicString) {
+    easystl::shared_string s("some token here");
+    EXPECT_EQ(easystl::hash<easystl::shared_string>()(s.substr(5, 5)),
+              easystl::hash<easystl::string>()(easystl::string("token")));
+}
+TEST(SharedStringTest, ConcurrentCopies) {
+    easystl::shared_string s("config value shared across threads");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&s] {
+            for (int i = 0; i < 10000; ++i) {
+                easystl::shared_string copy(s);
+                easystl::shared_string part = copy.substr(7, 5);
+                EXPECT_TRUE(part == "value");
+            }
+        });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(s.use_count(), 1u);
+}
+} // namespace shared_string_test
@@ -0,0 +1,285 @@
+#include "algo.h"
+#include "numeric.h"
+#include "simd.h"
+#include "vector.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace simd_test {
+
+const int kSizes[] = {0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+                      100, 1000, 1027};
+
+template <class T> std::vector<T> make_input(int n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<T> v(static_cast<std::size_t>(n));
+    for (auto &x : v) {
+        // 取值范围小，保证有重复的最值；包含类型的极值
+        const unsigned r = gen() % 200;
+        if (r == 0) {
+            x = std::numeric_limits<T>::lowest();
+        } else if (r == 1) {
+            x = std::numeric_limits<T>::max();
+        } else {
+            x = static_cast<T>(static_cast<int>(r % 50) - 20);
+        }
+    }
+    return v;
+}
+
+// 浮点数没有对应的无符号类型，保持原样
+template <class T, bool = std::is_integral<T>::value>
+struct make_unsigned_or_self : std::make_unsigned<T> {};
+
+template <class T> struct make_unsigned_or_self<T, false> {
+    typedef T type;
+};
+
+template <class T> void check_type() {
+    for (int n : kSizes) {
+        for (unsigned seed = 0; seed < 4; ++seed) {
+            std::vector<T> v = make_input<T>(n, seed);
+            const T *first = v.data();
+            const T *last = v.data() + v.size();
+            for (int k = -21; k < 32; k += 3) {
+                const T x = static_cast<T>(k);
+                ASSERT_EQ(easystl::find(first, last, x),
+                          std::find(first, last, x))
+                    << "n " << n << " x " << k;
+                ASSERT_EQ(easystl::count(first, last, x),
+                          std::count(first, last, x));
+            }
+            ASSERT_EQ(easystl::min_element(first, last),
+                      std::min_element(first, last))
+                << "n " << n << " seed " << seed;
+            ASSERT_EQ(easystl::max_element(first, last),
+                      std::max_element(first, last));
+            const auto mm = easystl::minmax_element(first, last);
+            const auto expected = std::minmax_element(first, last);
+            ASSERT_EQ(mm.first, expected.first);
+            ASSERT_EQ(mm.second, expected.second);
+            if (std::is_integral<T>::value) {
+                // 按无符号数累加再转换回 T，与 simd 的回绕结果一致，
+                // 有符号数直接相加溢出是未定义行为
+                typedef typename make_unsigned_or_self<T>::type U;
+                const U sum = std::accumulate(
+                    first, last, U(),
+                    [](U a, T b) { return static_cast<U>(a + U(b)); });
+                ASSERT_EQ(easystl::reduce(first, last), static_cast<T>(sum));
+            }
+        }
+    }
+}
+
+TEST(SimdTest, IntegerTypes) {
+    check_type<signed char>();
+    check_type<unsigned char>();
+    check_type<short>();
+    check_type<unsigned short>();
+    check_type<int>();
+    check_type<unsigned>();
+    check_type<long long>();
+    check_type<unsigned long long>();
+
+    std::vector<int> v(1000, 3);
+    EXPECT_EQ(easystl::accumulate(v.data(), v.data() + v.size(), 5), 3005);
+    // 非 const 指针与 easystl::vector 的迭代器同样走快速路径
+    easystl::vector<std::uint8_t> w(300, 2);
+    w[299] = 9;
+    EXPECT_EQ(easystl::find(w.begin(), w.end(), std::uint8_t(9)),
+              w.begin() + 299);
+    EXPECT_EQ(easystl::count(w.begin(), w.end(), std::uint8_t(2)), 299);
+    // 回绕到 uint8_t
+    EXPECT_EQ(easystl::reduce(w.begin(), w.end()),
+              static_cast<std::uint8_t>(299 * 2 + 9));
+    // value 与元素类型不同时按 operator== 比较，300 不会截断为 44
+    std::vector<unsigned char> c(100, 44);
+    EXPECT_EQ(easystl::find(c.data(), c.data() + c.size(), 300),
+              c.data() + c.size());
+}
+
+TEST(SimdTest, FloatingPoint) {
+    check_type<float>();
+    check_type<double>();
+
+    // 小整数的和没有舍入，改变累加顺序不影响结果
+    std::vector<double> d(1001);
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i] = static_cast<double>(i % 17);
+    }
+    EXPECT_EQ(easystl::reduce(d.data(), d.data() + d.size()),
+              std::accumulate(d.begin(), d.end(), 0.0));
+    EXPECT_EQ(easystl::reduce(d.data(), d.data() + d.size(), 0.5),
+              std::accumulate(d.begin(), d.end(), 0.5));
+
+    // +0.0 与 -0.0 相等，NaN 与任何值都不相等
+    std::vector<double> z(40, 1.0);
+    z[5] = -0.0;
+    z[9] = 0.0;
+    z[30] = std::nan("");
+    EXPECT_EQ(easystl::find(z.data(), z.data() + z.size(), 0.0),
+              z.data() + 5);
+    EXPECT_EQ(easystl::count(z.data(), z.data() + z.size(), -0.0), 2);
+    EXPECT_EQ(easystl::find(z.data(), z.data() + z.size(), z[30]),
+              z.data() + z.size());
+    // 有 NaN 时与逐个比较的结果相同
+    EXPECT_EQ(easystl::min_element(z.data(), z.data() + z.size()),
+              std::min_element(z.data(), z.data() + z.size()));
+    EXPECT_EQ(easystl::max_element(z.data(), z.data() + z.size()),
+              std::max_element(z.data(), z.data() + z.size()));
+    z[30] = 1.0;
+    EXPECT_EQ(easystl::min_element(z.data(), z.data() + z.size()),
+              z.data() + 5);
+    EXPECT_EQ(easystl::minmax_element(z.data(), z.data() + z.size()).second,
+              z.data() + z.size() - 1);
+}
+
+template <class T> void check_scan() {
+    for (int n : kSizes) {
+        std::vector<T> v(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            v[static_cast<std::size_t>(i)] = static_cast<T>(i % 13 - 4);
+        }
+        // 逐个累加的结果。元素都是小整数，浮点数的和也没有舍入
+        std::vector<T> inclusive(v.size()), exclusive(v.size());
+        T acc = T(5);
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            exclusive[i] = acc;
+            acc = static_cast<T>(acc + v[i]);
+            inclusive[i] = static_cast<T>(acc - T(5));
+        }
+
+        std::vector<T> out(v.size());
+        EXPECT_EQ(easystl::inclusive_scan(v.data(), v.data() + v.size(),
+                                          out.data()),
+                  out.data() + out.size());
+        EXPECT_EQ(out, inclusive) << "n " << n;
+        easystl::exclusive_scan(v.data(), v.data() + v.size(), out.data(),
+                                T(5));
+        EXPECT_EQ(out, exclusive) << "n " << n;
+
+        // 原地计算
+        std::vector<T> w = v;
+        easystl::exclusive_scan(w.data(), w.data() + w.size(), w.data(),
+                                T(5));
+        EXPECT_EQ(w, exclusive) << "n " << n;
+        w = v;
+        easystl::inclusive_scan(w.data(), w.data() + w.size(), w.data());
+        EXPECT_EQ(w, inclusive) << "n " << n;
+    }
+}
+
+TEST(SimdTest, Scan) {
+    check_scan<int>();
+    check_scan<unsigned>();
+    check_scan<long long>();
+    check_scan<unsigned long long>();
+    check_scan<float>();
+    check_scan<double>();
+    check_scan<short>();
+
+    // CSR 的行偏移：由各行的长度求出，easystl::vector 的迭代器走快速路径
+    easystl::vector<int> len = {3, 0, 2, 5, 1};
+    easystl::vector<int> offset(len.size() + 1);
+    EXPECT_EQ(easystl::exclusive_scan(len.begin(), len.end(),
+                                      offset.begin(), 0),
+              offset.end() - 1);
+    offset.back() = offset[len.size() - 1] + len.back();
+    const int expected_offset[] = {0, 3, 3, 5, 10, 11};
+    EXPECT_TRUE(std::equal(offset.begin(), offset.end(), expected_offset));
+
+    // 自定义操作与初值，以及 transform_exclusive_scan
+    std::vector<int> v = {1, 2, 3, 4};
+    std::vector<int> out(4);
+    easystl::inclusive_scan(v.begin(), v.end(), out.begin(),
+                            [](int a, int b) { return a * b; }, 10);
+    EXPECT_EQ(out, (std::vector<int>{10, 20, 60, 240}));
+    easystl::inclusive_scan(v.begin(), v.end(), out.begin(),
+                            easystl::plus<int>());
+    EXPECT_EQ(out, (std::vector<int>{1, 3, 6, 10}));
+    easystl::exclusive_scan(v.begin(), v.end(), out.begin(), 1,
+                            [](int a, int b) { return a * b; });
+    EXPECT_EQ(out, (std::vector<int>{1, 1, 2, 6}));
+    std::vector<std::string> words = {"a", "bcd", "", "ef"};
+    std::vector<std::size_t> pos(words.size());
+    easystl::transform_exclusive_scan(
+        words.begin(), words.end(), pos.begin(), std::size_t(0),
+        easystl::plus<std::size_t>(),
+        [](const std::string &w) { return w.size(); });
+    EXPECT_EQ(pos, (std::vector<std::size_t>{0, 1, 4, 4}));
+    // 输入与输出类型不同时逐个计算
+    std::vector<long long> wide(4);
+    easystl::inclusive_scan(v.begin(), v.end(), wide.begin());
+    EXPECT_EQ(wide, (std::vector<long long>{1, 3, 6, 10}));
+}
+
+#ifdef EASYSTL_SIMD_SSE2
+// 直接调用 SSE2 与 AVX2 的内核，不依赖运行时选择的结果
+TEST(SimdTest, Kernels) {
+    typedef easystl::simd::sse2_ops<std::int32_t> sse2;
+    std::vector<std::int32_t> v = make_input<std::int32_t>(1027, 3);
+    const std::int32_t *first = v.data();
+    const std::int32_t *last = v.data() + v.size();
+    std::int32_t mn = 0, mx = 0;
+    const std::int32_t *found_last = last;
+    for (const std::int32_t *p = last; p != first;) {
+        if (*--p == 7) {
+            found_last = p;
+            break;
+        }
+    }
+    EXPECT_EQ(easystl::simd::sse2_find<sse2>(first, last, 7),
+              std::find(first, last, 7));
+    EXPECT_EQ(easystl::simd::sse2_find_last<sse2>(first, last, 7),
+              found_last);
+    EXPECT_EQ(easystl::simd::sse2_count<sse2>(first, last, 7),
+              static_cast<std::size_t>(std::count(first, last, 7)));
+    ASSERT_TRUE(easystl::simd::sse2_min_max<sse2>(first, last, mn, mx));
+    EXPECT_EQ(mn, *std::min_element(first, last));
+    EXPECT_EQ(mx, *std::max_element(first, last));
+    // 输入含有 int32 的极值，参考结果按无符号数累加，与内核一样回绕
+    std::vector<std::int32_t> inclusive(v.size()), exclusive(v.size());
+    std::vector<std::int32_t> out(v.size());
+    std::uint32_t acc = 0;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        exclusive[i] = static_cast<std::int32_t>(acc + 3u);
+        acc += static_cast<std::uint32_t>(v[i]);
+        inclusive[i] = static_cast<std::int32_t>(acc);
+    }
+    typedef easystl::simd::sse2_scan_ops<std::int32_t> sse2_scan;
+    easystl::simd::sse2_scan<sse2_scan, false>(first, last, out.data(), 0);
+    EXPECT_EQ(out, inclusive);
+    easystl::simd::sse2_scan<sse2_scan, true>(first, last, out.data(), 3);
+    EXPECT_EQ(out, exclusive);
+#ifdef EASYSTL_SIMD_AVX2
+    if (easystl::simd::has_avx2()) {
+        typedef easystl::simd::avx2_ops<std::int32_t> avx2;
+        EXPECT_EQ(easystl::simd::avx2_find<avx2>(first, last, 7),
+                  std::find(first, last, 7));
+        EXPECT_EQ(easystl::simd::avx2_find_last<avx2>(first, last, 7),
+                  found_last);
+        EXPECT_EQ(easystl::simd::avx2_count<avx2>(first, last, 7),
+                  static_cast<std::size_t>(std::count(first, last, 7)));
+        ASSERT_TRUE(easystl::simd::avx2_min_max<avx2>(first, last, mn, mx));
+        EXPECT_EQ(mn, *std::min_element(first, last));
+        EXPECT_EQ(mx, *std::max_element(first, last));
+        typedef easystl::simd::avx2_scan_ops<std::int32_t> avx2_scan;
+        easystl::simd::avx2_scan<avx2_scan, false>(first, last, out.data(),
+                                                   0);
+        EXPECT_EQ(out, inclusive);
+        easystl::simd::avx2_scan<avx2_scan, true>(first, last, out.data(), 3);
+        EXPECT_EQ(out, exclusive);
+    }
+#endif
+}
+#endif
+
+} // namespace simd_test
@@ -0,0 +1,108 @@
+#include "split.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+namespace split_test {
+template <class Range> std::vector<std::string> collect(const Range &r) {
+    std::vector<std::string> out;
+    for (const auto &field : r) {
+        out.emplace_back(field.data(), field.size());
+    }
+    return out;
+}
+
+typedef std::vector<std::string> fields;
+
+TEST(SplitTest, SingleCharacter) {
+    const easystl::string line("a\tbb\t\tccc");
+    EXPECT_EQ(collect(easystl::split(line, '\t')),
+              fields({"a", "bb", "", "ccc"}));
+    EXPECT_EQ(collect(easystl::split("a,b,", ',')), fields({"a", "b", ""}));
+    EXPECT_EQ(collect(easystl::split(",", ',')), fields({"", ""}));
+    EXPECT_EQ(collect(easystl::split("", ',')), fields({""}));
+    EXPECT_EQ(collect(easystl::split("no delimiter", ',')),
+              fields({"no delimiter"}));
+
+    // 字段指向原字符串，不复制
+    auto r = easystl::split(line, '\t');
+    auto it = r.begin();
+    ++it;
+    EXPECT_EQ(it->data(), line.data() + 2);
+    EXPECT_EQ(it->size(), 2u);
+}
+TEST(SplitTest, IteratorIsForward) {
+    typedef easystl::split_char_range<char, easystl::char_traits<char>> range;
+    static_assert(
+        std::is_same<easystl::iterator_traits<range::iterator>::iterator_category,
+                     easystl::forward_iterator_tag>::value,
+        "split iterator should be a forward iterator");
+    auto r = easystl::split("x:y:z", ':');
+    auto a = r.begin();
+    auto b = a++;
+    EXPECT_TRUE(*b == "x");
+    EXPECT_TRUE(*a == "y");
+    EXPECT_TRUE(b != a);
+    ++b;
+    EXPECT_TRUE(b == a);
+    int n = 0;
+    for (auto i = r.begin(); i != r.end(); ++i) {
+        ++n;
+    }
+    EXPECT_EQ(n, 3);
+}
+TEST(SplitTest, StringDelimiter) {
+    const easystl::string s("k1 => v1 => k2 =>");
+    EXPECT_EQ(collect(easystl::split(s, " => ")), fields({"k1", "v1", "k2 =>"}));
+    EXPECT_EQ(collect(easystl::split(easystl::string_view("abab"), "ab")),
+              fields({"", "", ""}));
+    EXPECT_EQ(collect(easystl::split(s, "")), fields({"k1 => v1 => k2 =>"}));
+}
+TEST(SplitTest, AnyOf) {
+    const easystl::string ws("a b\tc\nd");
+    EXPECT_EQ(collect(easystl::split_any_of(ws, easystl::string_view(" \t\n"))),
+              fields({"a", "b", "c", "d"}));
+    // 超过 16 个字节，经过向量比较的路径
+    const easystl::string long_line(
+        "alpha beta;gamma,delta epsilon;zeta,eta theta;iota");
+    const fields expected({"alpha", "beta", "gamma", "delta", "epsilon",
+                           "zeta", "eta", "theta", "iota"});
+    EXPECT_EQ(collect(easystl::split_any_of(long_line, " ;,")), expected);
+    // 分隔符较多时查位图
+    EXPECT_EQ(collect(easystl::split_any_of(long_line, " ;,!?#$%&*+")),
+              expected);
+    EXPECT_EQ(collect(easystl::split_any_of(long_line, "")),
+              fields({long_line.c_str()}));
+
+    const easystl::ci_string ci("oneXtwoxthree");
+    fields got;
+    for (const auto &f : easystl::split_any_of(ci, "x")) {
+        got.emplace_back(f.data(), f.size());
+    }
+    EXPECT_EQ(got, fields({"one", "two", "three"}));
+}
+TEST(SplitTest, Csv) {
+    const easystl::string rec(
+        "plain,\"quoted, with comma\",\"say \"\"hi\"\"\",,\"\",tail");
+    const fields got = collect(easystl::split_csv(rec));
+    EXPECT_EQ(got, fields({"plain", "quoted, with comma", "say \"\"hi\"\"",
+                           "", "", "tail"}));
+
+    auto r = easystl::split_csv(rec);
+    auto it = r.begin();
+    ++it;
+    ++it;
+    easystl::string unescaped;
+    easystl::csv_unescape(*it, unescaped);
+    EXPECT_EQ(std::string(unescaped.c_str()), "say \"hi\"");
+
+    EXPECT_EQ(collect(easystl::split_csv(easystl::string_view("a;\"b;c\";d"),
+                                         ';')),
+              fields({"a", "b;c", "d"}));
+    EXPECT_EQ(collect(easystl::split_csv(easystl::string_view("\"open,x"))),
+              fields({"open,x"}));
+    EXPECT_EQ(collect(easystl::split_csv(easystl::string_view("\"q\"junk,next"))),
+              fields({"q", "next"}));
+}
+} // namespace split_test
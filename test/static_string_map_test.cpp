@@ -0,0 +1,94 @@
+#include "static_string_map.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <stdexcept>
+
+namespace static_string_map_test {
+
+constexpr easystl::static_string_entry<int> kKeywords[] = {
+    {"alignas", 0}, {"alignof", 1}, {"and", 2}, {"asm", 3},
+    {"auto", 4}, {"bool", 5}, {"break", 6}, {"case", 7},
+    {"catch", 8}, {"char", 9}, {"class", 10}, {"const", 11},
+    {"constexpr", 12}, {"continue", 13}, {"decltype", 14}, {"default", 15},
+    {"delete", 16}, {"do", 17}, {"double", 18}, {"else", 19},
+    {"enum", 20}, {"explicit", 21}, {"extern", 22}, {"false", 23},
+    {"float", 24}, {"for", 25}, {"friend", 26}, {"goto", 27},
+    {"if", 28}, {"inline", 29}, {"int", 30}, {"long", 31},
+    {"mutable", 32}, {"namespace", 33}, {"new", 34}, {"noexcept", 35},
+    {"nullptr", 36}, {"operator", 37}, {"private", 38}, {"public", 39},
+    {"return", 40}, {"short", 41}, {"sizeof", 42}, {"static", 43},
+    {"struct", 44}, {"switch", 45}, {"template", 46}, {"this", 47},
+    {"throw", 48}, {"true", 49}, {"try", 50}, {"typedef", 51},
+    {"union", 52}, {"using", 53}, {"virtual", 54}, {"void", 55},
+    {"", 56}};
+
+#ifdef EASYSTL_HAS_CONSTEXPR20
+constexpr auto kKeywordMap = easystl::make_static_string_map(kKeywords);
+static_assert(*kKeywordMap.find("constexpr") == 12, "compile-time lookup");
+static_assert(kKeywordMap.find("constexp") == nullptr, "compile-time miss");
+#else
+const auto kKeywordMap = easystl::make_static_string_map(kKeywords);
+#endif
+
+TEST(StaticStringMapTest, FindsEveryKey) {
+    EXPECT_EQ(kKeywordMap.size(), 57u);
+    for (const auto &e : kKeywords) {
+        const int *v = kKeywordMap.find(e.key);
+        ASSERT_NE(v, nullptr) << e.key;
+        EXPECT_EQ(*v, e.value);
+    }
+    // 每个槽位恰好存放一个键
+    int seen[57] = {};
+    for (const auto &slot : kKeywordMap) {
+        ++seen[slot.value];
+    }
+    for (int n : seen) {
+        EXPECT_EQ(n, 1);
+    }
+}
+
+TEST(StaticStringMapTest, RejectsOtherKeys) {
+    EXPECT_EQ(kKeywordMap.find("Class"), nullptr);
+    EXPECT_EQ(kKeywordMap.find("classes"), nullptr);
+    EXPECT_EQ(kKeywordMap.find("clas"), nullptr);
+    EXPECT_EQ(kKeywordMap.find("unsigned"), nullptr);
+    EXPECT_FALSE(kKeywordMap.contains("register"));
+    EXPECT_TRUE(kKeywordMap.contains(""));
+    EXPECT_THROW(kKeywordMap.at("register"), std::out_of_range);
+}
+
+TEST(StaticStringMapTest, KeyTypes) {
+    const easystl::string s("virtual");
+    EXPECT_EQ(*kKeywordMap.find(s), 54);
+    EXPECT_EQ(*kKeywordMap.find(easystl::string_view(s)), 54);
+    // 键只比较 [data, data + n)，不要求以 '\0' 结尾
+    const char buf[] = "while(true)";
+    EXPECT_EQ(kKeywordMap.find(buf, 5), nullptr);
+    EXPECT_EQ(*kKeywordMap.find(buf + 6, 4), 49);
+    EXPECT_EQ(kKeywordMap.at("typedef"), 51);
+}
+
+TEST(StaticStringMapTest, ManyKeys) {
+    static char names[500][8];
+    static easystl::static_string_entry<int> entries[500];
+    for (int i = 0; i < 500; ++i) {
+        std::snprintf(names[i], sizeof(names[i]), "cmd%d", i);
+        entries[i] = {names[i], i};
+    }
+    const auto m = easystl::make_static_string_map(entries);
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_NE(m.find(names[i]), nullptr);
+        EXPECT_EQ(*m.find(names[i]), i);
+    }
+    EXPECT_EQ(m.find("cmd500"), nullptr);
+    EXPECT_EQ(m.find("cmd"), nullptr);
+}
+
+TEST(StaticStringMapTest, DuplicateKey) {
+    const easystl::static_string_entry<int> dup[] = {
+        {"a", 1}, {"b", 2}, {"a", 3}};
+    EXPECT_THROW(easystl::make_static_string_map(dup), std::invalid_argument);
+}
+
+} // namespace static_string_map_test
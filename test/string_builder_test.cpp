@@ -0,0 +1,244 @@
+#include "rope.h"
+#include "string_builder.h"
+#include "stringfwd.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace string_builder_test {
+TEST(StringBuilderTest, EmptyBuilder) {
+    easystl::string_builder sb;
+    EXPECT_TRUE(sb.empty());
+    EXPECT_EQ(sb.size(), 0);
+    EXPECT_EQ(sb.chunk_count(), 0);
+    EXPECT_EQ(sb.str(), "");
+}
+
+TEST(StringBuilderTest, AppendMixed) {
+    easystl::string_builder sb;
+    sb.append("hello");
+    sb += ' ';
+    sb += easystl::string("world");
+    sb.append(3, '!');
+    EXPECT_EQ(sb.size(), 14);
+    EXPECT_EQ(sb.str(), "hello world!!!");
+}
+
+TEST(StringBuilderTest, LargeAppendSpansChunks) {
+    easystl::string_builder sb;
+    std::string expect;
+    for (int i = 0; i < 20000; ++i) {
+        const char c = static_cast<char>('a' + i % 26);
+        const std::string piece(i % 37 + 1, c);
+        sb.append(piece.data(), piece.size());
+        expect += piece;
+    }
+    EXPECT_GT(sb.chunk_count(), 1);
+    // 块容量按几何级数增长
+    EXPECT_LT(sb.chunk_count(), 32);
+    const easystl::string s = sb.str();
+    ASSERT_EQ(s.size(), expect.size());
+    EXPECT_EQ(std::string(s.data(), s.size()), expect);
+}
+
+TEST(StringBuilderTest, AppendToKeepsPrefix) {
+    easystl::string_builder sb;
+    sb.append(1000, 'x');
+    easystl::string s("prefix:");
+    sb.append_to(s);
+    EXPECT_EQ(s.size(), 1007);
+    EXPECT_EQ(s.substr(0, 8), "prefix:x");
+}
+
+TEST(StringBuilderTest, ForEachChunkAndIovec) {
+    easystl::string_builder sb;
+    for (int i = 0; i < 1000; ++i) {
+        sb.append("0123456789");
+    }
+    std::string joined;
+    sb.for_each_chunk(
+        [&](const char *p, std::size_t n) { joined.append(p, n); });
+    EXPECT_EQ(joined.size(), 10000);
+
+#ifdef EASYSTL_HAS_IOVEC
+    struct iovec iov[64];
+    const std::size_t n = sb.to_iovec(iov, 64);
+    EXPECT_EQ(n, sb.chunk_count());
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += iov[i].iov_len;
+    }
+    EXPECT_EQ(total, sb.size());
+#endif
+}
+
+TEST(StringBuilderTest, MoveAndClear) {
+    easystl::string_builder sb;
+    sb.append(500, 'a');
+    easystl::string_builder other(easystl::move(sb));
+    EXPECT_TRUE(sb.empty());
+    EXPECT_EQ(other.size(), 500);
+    other.clear();
+    EXPECT_TRUE(other.empty());
+    other.append("abc");
+    EXPECT_EQ(other.str(), "abc");
+}
+} // namespace string_builder_test
+
+namespace rope_test {
+TEST(RopeTest, ConstructAndIndex) {
+    easystl::rope r("hello world");
+    EXPECT_EQ(r.size(), 11);
+    EXPECT_EQ(r[0], 'h');
+    EXPECT_EQ(r[10], 'd');
+    EXPECT_EQ(r.str(), "hello world");
+    EXPECT_THROW(r.at(11), std::out_of_range);
+}
+
+TEST(RopeTest, InsertEraseMiddle) {
+    easystl::rope r("hello world");
+    r.insert(5, ",");
+    EXPECT_EQ(r.str(), "hello, world");
+    r.erase(0, 7);
+    EXPECT_EQ(r.str(), "world");
+    r.insert(5, "!!");
+    r.insert(0, ">> ");
+    EXPECT_EQ(r.str(), ">> world!!");
+    EXPECT_THROW(r.insert(100, "x"), std::out_of_range);
+}
+
+TEST(RopeTest, CopiesArePersistent) {
+    easystl::rope a(easystl::string(5000, 'a'));
+    easystl::rope b(a);
+    b.insert(2500, "XYZ");
+    b.erase(0, 10);
+    EXPECT_EQ(a.size(), 5000);
+    EXPECT_EQ(a.str(), easystl::string(5000, 'a'));
+    EXPECT_EQ(b.size(), 4993);
+    EXPECT_EQ(b[2490], 'X');
+
+    easystl::rope c = b.substr(2490, 3);
+    EXPECT_EQ(c.str(), "XYZ");
+    EXPECT_EQ(b.size(), 4993);
+}
+
+TEST(RopeTest, StaysBalancedUnderRandomEdits) {
+    std::srand(42);
+    easystl::rope r;
+    std::string expect;
+    for (int i = 0; i < 5000; ++i) {
+        const std::size_t pos = expect.empty() ? 0 : std::rand() % expect.size();
+        if (std::rand() % 4 == 0 && !expect.empty()) {
+            const std::size_t n = std::rand() % 50;
+            r.erase(pos, n);
+            expect.erase(pos, n);
+        } else {
+            const std::string piece(std::rand() % 100 + 1,
+                                    static_cast<char>('a' + i % 26));
+            r.insert(pos, piece.data(), piece.size());
+            expect.insert(pos, piece);
+        }
+    }
+    ASSERT_EQ(r.size(), expect.size());
+    const easystl::string s = r.str();
+    EXPECT_EQ(std::string(s.data(), s.size()), expect);
+    // AVL 树的高度不超过 1.44 log2(叶子数) + 2
+    std::size_t leaves = 0;
+    r.for_each_chunk([&](const char *, std::size_t) { ++leaves; });
+    std::size_t log2 = 0;
+    while ((std::size_t(1) << log2) < leaves) {
+        ++log2;
+    }
+    EXPECT_LE(r.height(), log2 * 3 / 2 + 2);
+}
+
+TEST(RopeTest, AppendRope) {
+    easystl::rope a("abc");
+    easystl::rope b("def");
+    a.append(b);
+    a.append(a);
+    EXPECT_EQ(a.str(), "abcdefabcdef");
+    EXPECT_EQ(b.str(), "def");
+}
+// 分配次数用尽后抛出 std::bad_alloc 的分配器，用于检查异常安全
+int g_alloc_budget = -1;
+
+template <class T> struct failing_allocator {
+    typedef T value_type;
+    template <class U> struct rebind {
+        typedef failing_allocator<U> other;
+    };
+    failing_allocator() = default;
+    template <class U> failing_allocator(const failing_allocator<U> &) {}
+    T *allocate(std::size_t n) {
+        if (g_alloc_budget == 0) {
+            throw std::bad_alloc();
+        }
+        if (g_alloc_budget > 0) {
+            --g_alloc_budget;
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T *p, std::size_t) { ::operator delete(p); }
+};
+
+typedef easystl::basic_rope<char, easystl::char_traits<char>,
+                            failing_allocator<char>>
+    failing_rope;
+
+std::string rope_content(const failing_rope &r) {
+    std::string s;
+    r.for_each_chunk([&](const char *p, std::size_t n) { s.append(p, n); });
+    return s;
+}
+
+TEST(RopeTest, StrongGuaranteeOnAllocationFailure) {
+    failing_rope base;
+    for (int i = 0; i < 40; ++i) {
+        const std::string piece(300, static_cast<char>('a' + i % 26));
+        base.insert(base.size() / 3, piece.data(), piece.size());
+    }
+    const std::string expect = rope_content(base);
+    const std::string piece(2000, '#');
+    // 依次让第 0、1、2 ... 次分配失败，直到操作成功；失败时内容不变，
+    // 已分配的节点全部释放（由 AddressSanitizer 检查泄漏）
+    for (int op = 0; op < 4; ++op) {
+        for (int budget = 0;; ++budget) {
+            failing_rope r(base);
+            g_alloc_budget = budget;
+            bool done = true;
+            try {
+                if (op == 0) {
+                    r.insert(5000, piece.data(), piece.size());
+                } else if (op == 1) {
+                    r.erase(1234, 5000);
+                } else if (op == 2) {
+                    r.append(piece.data(), piece.size());
+                } else {
+                    failing_rope sub = r.substr(777, 6000);
+                    EXPECT_EQ(rope_content(sub), expect.substr(777, 6000));
+                }
+            } catch (const std::bad_alloc &) {
+                done = false;
+            }
+            g_alloc_budget = -1;
+            if (!done) {
+                ASSERT_EQ(rope_content(r), expect) << op << " " << budget;
+                continue;
+            }
+            std::string after = expect;
+            if (op == 0) {
+                after.insert(5000, piece);
+            } else if (op == 1) {
+                after.erase(1234, 5000);
+            } else if (op == 2) {
+                after += piece;
+            }
+            ASSERT_EQ(rope_content(r), after) << op;
+            ASSERT_EQ(rope_content(base), expect);
+            break;
+        }
+    }
+}
+} // namespace rope_test
@@ -0,0 +1,100 @@
+#include "stringfwd.h"
+#include "utf.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace utf_test {
+TEST(Utf8ValidateTest, AcceptsValidSequences) {
+    EXPECT_TRUE(easystl::utf8_validate("", 0));
+    EXPECT_TRUE(easystl::utf8_validate(easystl::string("plain ascii")));
+    EXPECT_TRUE(easystl::utf8_validate(easystl::string("\xC2\xA9 caf\xC3\xA9")));
+    EXPECT_TRUE(easystl::utf8_validate(easystl::string("\xE4\xB8\xAD\xE6\x96\x87")));
+    EXPECT_TRUE(easystl::utf8_validate(easystl::string("\xF0\x9F\x98\x80")));
+    EXPECT_TRUE(easystl::utf8_validate(easystl::string("\xF4\x8F\xBF\xBF")));
+    EXPECT_TRUE(easystl::utf8_validate(easystl::string("\xEF\xBB\xBF")));
+}
+TEST(Utf8ValidateTest, RejectsInvalidSequences) {
+    const char *bad[] = {
+        "\x80",             // 单独的延续字节
+        "\xC0\xAF",         // 过长编码
+        "\xE0\x80\xAF",     // 过长编码
+        "\xF0\x80\x80\xAF", // 过长编码
+        "\xED\xA0\x80",     // 代理区码点 U+D800
+        "\xF4\x90\x80\x80", // 大于 U+10FFFF
+        "\xF8\x88\x80\x80\x80",
+        "\xC3",             // 截断
+        "\xE4\xB8",         // 截断
+        "\xC3\x28",         // 缺少延续字节
+    };
+    for (const char *s : bad) {
+        EXPECT_FALSE(easystl::utf8_validate(s, std::strlen(s))) << s;
+    }
+}
+TEST(Utf8ValidateTest, LongInputsAgreeWithScalar) {
+    // 长度不小于 64 时会使用向量化实现，在块边界附近放置错误
+    std::mt19937 rng(7);
+    for (int round = 0; round < 2000; ++round) {
+        std::string s;
+        while (s.size() < 200) {
+            switch (rng() % 4) {
+            case 0: s += "\xE4\xB8\xAD"; break;
+            case 1: s += "\xF0\x9F\x98\x80"; break;
+            case 2: s += "\xD0\x96"; break;
+            default: s += static_cast<char>('a' + rng() % 26); break;
+            }
+        }
+        if (round % 2) {
+            s[rng() % s.size()] = static_cast<char>(rng() % 256);
+        }
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(s.data());
+        EXPECT_EQ(easystl::utf8_validate(s.data(), s.size()),
+                  easystl::utf8_validate_scalar(p, p + s.size()));
+    }
+}
+TEST(UtfTranscodeTest, Utf8ToUtf16AndBack) {
+    const easystl::string utf8("a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80z");
+    const easystl::u16string u16 = easystl::to_u16string(utf8);
+    ASSERT_EQ(u16.size(), 6);
+    EXPECT_EQ(u16[0], u'a');
+    EXPECT_EQ(u16[1], u'é');
+    EXPECT_EQ(u16[2], u'中');
+    EXPECT_EQ(u16[3], 0xD83D);
+    EXPECT_EQ(u16[4], 0xDE00);
+    EXPECT_EQ(u16[5], u'z');
+    EXPECT_EQ(easystl::to_utf8(u16), utf8);
+}
+TEST(UtfTranscodeTest, Utf8ToUtf32AndBack) {
+    const easystl::string utf8("a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80z");
+    const easystl::u32string u32 = easystl::to_u32string(utf8);
+    ASSERT_EQ(u32.size(), 5);
+    EXPECT_EQ(u32[3], U'\U0001F600');
+    EXPECT_EQ(easystl::to_utf8(u32), utf8);
+}
+TEST(UtfTranscodeTest, LongAsciiRunsAndAppend) {
+    easystl::string utf8(1000, 'x');
+    utf8.append("\xE2\x82\xAC");
+    utf8.append(37, 'y');
+    easystl::u16string u16(u"prefix");
+    ASSERT_TRUE(easystl::utf8_to_utf16(utf8.data(), utf8.size(), u16));
+    EXPECT_EQ(u16.size(), 6 + 1000 + 1 + 37);
+    EXPECT_EQ(u16[6 + 1000], 0x20AC);
+    easystl::string back;
+    ASSERT_TRUE(easystl::utf16_to_utf8(u16.data() + 6, u16.size() - 6, back));
+    EXPECT_EQ(back, utf8);
+}
+TEST(UtfTranscodeTest, InvalidInputLeavesTargetUnchanged) {
+    easystl::u16string u16(u"keep");
+    EXPECT_FALSE(easystl::utf8_to_utf16("\xC3\x28", 2, u16));
+    EXPECT_EQ(u16.size(), 4);
+    const char16_t lone[] = {u'a', 0xD800, u'b'};
+    easystl::string out("keep");
+    EXPECT_FALSE(easystl::utf16_to_utf8(lone, 3, out));
+    EXPECT_EQ(out, "keep");
+    const char32_t big[] = {0x110000};
+    EXPECT_FALSE(easystl::utf32_to_utf8(big, 1, out));
+    EXPECT_THROW(easystl::to_u32string(easystl::string("\xFF")),
+                 std::invalid_argument);
+}
+} // namespace utf_test
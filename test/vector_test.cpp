@@ -191,6 +191,20 @@ TEST(VectorTest, EraseTest) {
     vec1.clear();
     EXPECT_EQ(vec1.size(), 0);
     EXPECT_EQ(vec1.capacity(), 16);
+
+    // erase_if
+    easystl::vector<int> vec2;
+    for (int i = 0; i < 1000; ++i) {
+        vec2.push_back(i);
+    }
+    EXPECT_EQ(vec2.erase_if([](int x) { return x % 3 != 0; }), 666u);
+    EXPECT_EQ(vec2.size(), 334u);
+    for (std::size_t i = 0; i < vec2.size(); ++i) {
+        EXPECT_EQ(vec2[i], static_cast<int>(i * 3));
+    }
+    EXPECT_EQ(vec2.erase_if([](int) { return false; }), 0u);
+    EXPECT_EQ(vec2.erase_if([](int) { return true; }), 334u);
+    EXPECT_TRUE(vec2.empty());
 }
 
 TEST(VectorTest, ResizeTest) {